@@ -0,0 +1,113 @@
+/**
+ * =============================================================================
+ * @file    blockdev.h
+ * @brief   Interface comum de dispositivo de blocos (setores de 512 bytes)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Espelha as três funções de baixo nível do FatFS (disk_read,
+ *          disk_write e disk_ioctl) para que drivers, caches e backends de
+ *          teste possam ser empilhados e ligados ao diskio.c sem conversão:
+ *
+ *          ┌──────────┐    ┌───────────────┐    ┌──────────────────────────┐
+ *          │ diskio.c │ ─▶ │ blockdev_t    │ ─▶ │ blockdev_t               │
+ *          │ (FatFS)  │    │ (ex.: cache)  │    │ (ex.: cartão SD via SPI) │
+ *          └──────────┘    └───────────────┘    └──────────────────────────┘
+ *
+ *          Os códigos de retorno e os comandos de ioctl têm os mesmos valores
+ *          de DRESULT e de CTRL_SYNC/GET_SECTOR_COUNT/... em ff.h/diskio.h.
+ * =============================================================================
+ */
+
+#ifndef BLOCKDEV_H
+#define BLOCKDEV_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONSTANTES
+ * =============================================================================
+ */
+
+/** Tamanho do setor em bytes */
+#define BLOCKDEV_SECTOR_SIZE 512u
+
+/** Comandos de ioctl (mesmos valores do diskio.h do FatFS) */
+#define BLOCKDEV_CTRL_SYNC        0u  /**< Grava tudo o que estiver pendente */
+#define BLOCKDEV_GET_SECTOR_COUNT 1u  /**< buff: uint32_t* (LBA_t) */
+#define BLOCKDEV_GET_SECTOR_SIZE  2u  /**< buff: uint16_t* (WORD) */
+#define BLOCKDEV_GET_BLOCK_SIZE   3u  /**< buff: uint32_t* (DWORD), em setores */
+#define BLOCKDEV_CTRL_TRIM        4u  /**< buff: uint32_t[2] {início, fim} */
+
+/**
+ * @brief Primeiro código livre para ioctls específicos de cada camada
+ *
+ * @details O FatFS só usa códigos abaixo de 0x40 (incluindo os opcionais
+ *          de MMC/ATA); cada módulo reserva uma faixa a partir daqui.
+ */
+#define BLOCKDEV_IOCTL_USER 0x40u
+
+/**
+ * @enum blockdev_result_t
+ * @brief Resultado das operações (mesmos valores de DRESULT)
+ */
+typedef enum {
+    BLOCKDEV_OK = 0,      /**< RES_OK */
+    BLOCKDEV_ERROR = 1,   /**< RES_ERROR: erro de leitura/escrita */
+    BLOCKDEV_WRPRT = 2,   /**< RES_WRPRT: protegido contra escrita */
+    BLOCKDEV_NOTRDY = 3,  /**< RES_NOTRDY: dispositivo não inicializado */
+    BLOCKDEV_PARERR = 4,  /**< RES_PARERR: parâmetro inválido */
+} blockdev_result_t;
+
+/* =============================================================================
+ * SEÇÃO 2: INTERFACE
+ * =============================================================================
+ */
+
+/**
+ * @struct blockdev_t
+ * @brief Dispositivo de blocos: contexto + três operações
+ *
+ * @var blockdev_t::read  Lê `count` setores a partir de `lba` em `buf`
+ * @var blockdev_t::write Grava `count` setores a partir de `lba`
+ * @var blockdev_t::ioctl Comandos BLOCKDEV_* (e faixas próprias >= BLOCKDEV_IOCTL_USER)
+ */
+typedef struct {
+    void *ctx;
+    blockdev_result_t (*read)(void *ctx, uint8_t *buf, uint32_t lba, uint32_t count);
+    blockdev_result_t (*write)(void *ctx, const uint8_t *buf, uint32_t lba, uint32_t count);
+    blockdev_result_t (*ioctl)(void *ctx, uint8_t cmd, void *buff);
+} blockdev_t;
+
+static inline blockdev_result_t blockdev_read(const blockdev_t *dev, uint8_t *buf,
+                                              uint32_t lba, uint32_t count) {
+    return dev->read(dev->ctx, buf, lba, count);
+}
+
+static inline blockdev_result_t blockdev_write(const blockdev_t *dev, const uint8_t *buf,
+                                               uint32_t lba, uint32_t count) {
+    return dev->write(dev->ctx, buf, lba, count);
+}
+
+static inline blockdev_result_t blockdev_ioctl(const blockdev_t *dev, uint8_t cmd, void *buff) {
+    return dev->ioctl(dev->ctx, cmd, buff);
+}
+
+static inline blockdev_result_t blockdev_sync(const blockdev_t *dev) {
+    return dev->ioctl(dev->ctx, BLOCKDEV_CTRL_SYNC, 0);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCKDEV_H */
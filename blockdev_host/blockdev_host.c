@@ -0,0 +1,290 @@
+/**
+ * =============================================================================
+ * @file    blockdev_host.c
+ * @brief   (Host) Implementação do dispositivo de blocos em RAM/imagem
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ * =============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "blockdev_host.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SECTOR BLOCKDEV_SECTOR_SIZE
+
+enum { MODE_IDLE = 0, MODE_READING = 1, MODE_WRITING = 2 };
+
+/* =============================================================================
+ * SEÇÃO 1: ABERTURA
+ * =============================================================================
+ */
+
+static void reset_state(blockdev_host_t *h, uint8_t *data, uint32_t sectors, int fd) {
+    memset(h, 0, sizeof *h);
+    h->data = data;
+    h->sectors = sectors;
+    h->fd = fd;
+}
+
+bool blockdev_host_init_ram(blockdev_host_t *h, uint8_t *buf, uint32_t sectors) {
+    if (!h || !buf || sectors == 0) {
+        return false;
+    }
+    reset_state(h, buf, sectors, -1);
+    return true;
+}
+
+bool blockdev_host_open_image(blockdev_host_t *h, const char *path, uint32_t sectors,
+                              bool create) {
+    if (!h || !path) {
+        return false;
+    }
+    const int fd = open(path, O_RDWR | (create ? O_CREAT : 0), 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return false;
+    }
+    if (sectors == 0) {
+        sectors = (uint32_t)((uint64_t)st.st_size / SECTOR);
+    }
+    const size_t len = (size_t)sectors * SECTOR;
+    if (sectors == 0 ||
+        ((uint64_t)st.st_size < len && ftruncate(fd, (off_t)len) != 0)) {
+        close(fd);
+        return false;
+    }
+
+    void *map = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    reset_state(h, (uint8_t *)map, sectors, fd);
+    return true;
+}
+
+void blockdev_host_close(blockdev_host_t *h) {
+    if (h->fd >= 0) {
+        const size_t len = (size_t)h->sectors * SECTOR;
+        (void)msync(h->data, len, MS_SYNC);
+        (void)munmap(h->data, len);
+        close(h->fd);
+    }
+    h->data = NULL;
+    h->sectors = 0;
+    h->fd = -1;
+}
+
+void blockdev_host_set_latency(blockdev_host_t *h, const blockdev_host_latency_t *lat) {
+    h->lat = *lat;
+    h->mode = MODE_IDLE;
+}
+
+void blockdev_host_set_write_protect(blockdev_host_t *h, bool on) {
+    h->write_protected = on;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: LATÊNCIA SIMULADA
+ * =============================================================================
+ */
+
+/** Espera ativa: nanosleep arredonda para o tick do escalonador */
+static void spin_ns(uint64_t ns) {
+    struct timespec t0, t;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &t);
+    } while ((uint64_t)(t.tv_sec - t0.tv_sec) * 1000000000u +
+                 (uint64_t)(t.tv_nsec - t0.tv_nsec) < ns);
+}
+
+/** Soma o tempo simulado ao relógio virtual (e espera, em tempo real) */
+static void advance(blockdev_host_t *h, uint64_t ns) {
+    h->now_ns += ns;
+    h->stats.busy_ns += ns;
+    if (h->lat.realtime && ns) {
+        spin_ns(ns);
+    }
+}
+
+/** Encerra o fluxo simulado; uma escrita paga o token de parada e o busy final */
+static uint64_t close_stream(blockdev_host_t *h) {
+    const uint64_t ns = (h->mode == MODE_WRITING) ? h->lat.commit_ns : 0u;
+    h->mode = MODE_IDLE;
+    return ns;
+}
+
+/** Custo de uma transferência de `count` setores a partir de `lba` */
+static void charge(blockdev_host_t *h, uint8_t mode, uint32_t lba, uint32_t count) {
+    const blockdev_host_latency_t *lat = &h->lat;
+    uint64_t ns = (uint64_t)lat->byte_ns * count * SECTOR;
+
+    if (!lat->coalesce || h->mode != mode || h->next_lba != lba) {
+        ns += close_stream(h) + lat->cmd_ns;
+        h->stats.commands++;
+    }
+    if (mode == MODE_WRITING) {
+        ns += (uint64_t)lat->program_ns * count;
+    }
+    h->mode = mode;
+    h->next_lba = lba + count;
+    if (!lat->coalesce) {
+        /* Sem fluxos: cada chamada é uma transação completa */
+        ns += close_stream(h);
+    }
+    advance(h, ns);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: OPERAÇÕES
+ * =============================================================================
+ */
+
+static blockdev_result_t check_range(const blockdev_host_t *h, const void *buf, uint32_t lba,
+                                     uint32_t count) {
+    if (!h->data) {
+        return BLOCKDEV_NOTRDY;
+    }
+    if (!buf || count == 0 || lba >= h->sectors || count > h->sectors - lba) {
+        return BLOCKDEV_PARERR;
+    }
+    return BLOCKDEV_OK;
+}
+
+blockdev_result_t blockdev_host_read(blockdev_host_t *h, uint8_t *buf, uint32_t lba,
+                                     uint32_t count) {
+    const blockdev_result_t r = check_range(h, buf, lba, count);
+    if (r != BLOCKDEV_OK) {
+        return r;
+    }
+    memcpy(buf, h->data + (size_t)lba * SECTOR, (size_t)count * SECTOR);
+    charge(h, MODE_READING, lba, count);
+    h->stats.reads++;
+    h->stats.sectors_read += count;
+    return BLOCKDEV_OK;
+}
+
+blockdev_result_t blockdev_host_write(blockdev_host_t *h, const uint8_t *buf, uint32_t lba,
+                                      uint32_t count) {
+    const blockdev_result_t r = check_range(h, buf, lba, count);
+    if (r != BLOCKDEV_OK) {
+        return r;
+    }
+    if (h->write_protected) {
+        return BLOCKDEV_WRPRT;
+    }
+    memcpy(h->data + (size_t)lba * SECTOR, buf, (size_t)count * SECTOR);
+    charge(h, MODE_WRITING, lba, count);
+    h->stats.writes++;
+    h->stats.sectors_written += count;
+    return BLOCKDEV_OK;
+}
+
+blockdev_result_t blockdev_host_ioctl(blockdev_host_t *h, uint8_t cmd, void *buff) {
+    if (!h->data) {
+        return BLOCKDEV_NOTRDY;
+    }
+    switch (cmd) {
+    case BLOCKDEV_CTRL_SYNC:
+        /* O sync fecha o fluxo simulado, como o token 0xFD / CMD12 */
+        advance(h, close_stream(h) + h->lat.sync_ns);
+        h->stats.syncs++;
+        if (h->fd >= 0 && msync(h->data, (size_t)h->sectors * SECTOR, MS_ASYNC) != 0) {
+            return BLOCKDEV_ERROR;
+        }
+        return BLOCKDEV_OK;
+
+    case BLOCKDEV_GET_SECTOR_COUNT:
+        if (!buff) {
+            return BLOCKDEV_PARERR;
+        }
+        *(uint32_t *)buff = h->sectors;
+        return BLOCKDEV_OK;
+
+    case BLOCKDEV_GET_SECTOR_SIZE:
+        if (!buff) {
+            return BLOCKDEV_PARERR;
+        }
+        *(uint16_t *)buff = (uint16_t)SECTOR;
+        return BLOCKDEV_OK;
+
+    case BLOCKDEV_GET_BLOCK_SIZE:
+        /* Bloco de apagamento típico de cartões SDHC: 4 MiB */
+        if (!buff) {
+            return BLOCKDEV_PARERR;
+        }
+        *(uint32_t *)buff = 8192u;
+        return BLOCKDEV_OK;
+
+    case BLOCKDEV_CTRL_TRIM: {
+        const uint32_t *range = (const uint32_t *)buff;
+        if (!range || range[0] > range[1] || range[1] >= h->sectors) {
+            return BLOCKDEV_PARERR;
+        }
+        if (h->write_protected) {
+            return BLOCKDEV_WRPRT;
+        }
+        memset(h->data + (size_t)range[0] * SECTOR, 0,
+               (size_t)(range[1] - range[0] + 1u) * SECTOR);
+        return BLOCKDEV_OK;
+    }
+
+    case BLOCKDEV_HOST_IOCTL_GET_STATS:
+        if (!buff) {
+            return BLOCKDEV_PARERR;
+        }
+        *(blockdev_host_stats_t *)buff = h->stats;
+        return BLOCKDEV_OK;
+
+    case BLOCKDEV_HOST_IOCTL_RESET_STATS:
+        memset(&h->stats, 0, sizeof h->stats);
+        return BLOCKDEV_OK;
+
+    default:
+        return BLOCKDEV_PARERR;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: ADAPTADOR blockdev_t
+ * =============================================================================
+ */
+
+static blockdev_result_t dev_read(void *ctx, uint8_t *buf, uint32_t lba, uint32_t count) {
+    return blockdev_host_read((blockdev_host_t *)ctx, buf, lba, count);
+}
+
+static blockdev_result_t dev_write(void *ctx, const uint8_t *buf, uint32_t lba,
+                                   uint32_t count) {
+    return blockdev_host_write((blockdev_host_t *)ctx, buf, lba, count);
+}
+
+static blockdev_result_t dev_ioctl(void *ctx, uint8_t cmd, void *buff) {
+    return blockdev_host_ioctl((blockdev_host_t *)ctx, cmd, buff);
+}
+
+void blockdev_host_blockdev(blockdev_host_t *h, blockdev_t *dev) {
+    dev->ctx = h;
+    dev->read = dev_read;
+    dev->write = dev_write;
+    dev->ioctl = dev_ioctl;
+}
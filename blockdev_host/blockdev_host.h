@@ -0,0 +1,181 @@
+/**
+ * =============================================================================
+ * @file    blockdev_host.h
+ * @brief   (Host) Dispositivo de blocos em RAM ou em imagem mapeada (mmap)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Backend blockdev_t para Linux/macOS: coloca o FatFS, o sd_cache e
+ *          os benchmarks de sistema de arquivos para rodar sem cartão. Os
+ *          setores ficam num buffer do chamador ou num arquivo de imagem
+ *          mapeado em memória (que pode ser montado com `mount -o loop`).
+ *
+ *          MODELO DE LATÊNCIA (simula um cartão SD em SPI):
+ *          ┌────────────────┬─────────────────────────────────────────────┐
+ *          │ cmd_ns         │ Cada comando (abrir uma leitura/escrita)    │
+ *          │ byte_ns        │ Cada byte transferido (clock SPI)           │
+ *          │ program_ns     │ Cada setor gravado dentro de um fluxo       │
+ *          │ commit_ns      │ Fim de um fluxo de escrita (token de parada │
+ *          │                │ e busy final da programação)                │
+ *          │ sync_ns        │ Cada CTRL_SYNC (além do commit pendente)    │
+ *          │ coalesce       │ Acesso contíguo na mesma direção continua o │
+ *          │                │ fluxo anterior sem novo comando (sd_stream) │
+ *          └────────────────┴─────────────────────────────────────────────┘
+ *
+ *          O tempo simulado sempre se acumula num relógio virtual
+ *          (blockdev_host_now_ns), que dá resultados determinísticos e
+ *          rápidos; com `realtime` a chamada também espera esse tempo.
+ * =============================================================================
+ */
+
+#ifndef BLOCKDEV_HOST_H
+#define BLOCKDEV_HOST_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "blockdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** ioctls do backend (faixa BLOCKDEV_IOCTL_USER + 0x10 .. 0x1F) */
+#define BLOCKDEV_HOST_IOCTL_GET_STATS   (BLOCKDEV_IOCTL_USER + 0x10u) /**< buff: blockdev_host_stats_t* */
+#define BLOCKDEV_HOST_IOCTL_RESET_STATS (BLOCKDEV_IOCTL_USER + 0x11u) /**< buff: ignorado */
+
+/**
+ * @struct blockdev_host_latency_t
+ * @brief Custos simulados (tudo zero = sem latência)
+ */
+typedef struct {
+    uint32_t cmd_ns;
+    uint32_t byte_ns;
+    uint32_t program_ns;
+    uint32_t commit_ns;
+    uint32_t sync_ns;
+    bool coalesce;
+    bool realtime;        /**< Também espera o tempo simulado de verdade */
+} blockdev_host_latency_t;
+
+/**
+ * Inicializador para um cartão em SPI a 25 MHz (0,32 us/byte, 30 us por setor
+ * num fluxo, 1 ms para encerrar uma escrita):
+ * `blockdev_host_latency_t lat = BLOCKDEV_HOST_LATENCY_SD_SPI;`
+ */
+#define BLOCKDEV_HOST_LATENCY_SD_SPI { 20000u, 320u, 30000u, 1000000u, 500000u, true, false }
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct blockdev_host_stats_t
+ * @brief Contadores do backend
+ *
+ * @var blockdev_host_stats_t::reads           Chamadas de leitura
+ * @var blockdev_host_stats_t::writes          Chamadas de escrita
+ * @var blockdev_host_stats_t::sectors_read    Setores lidos
+ * @var blockdev_host_stats_t::sectors_written Setores gravados
+ * @var blockdev_host_stats_t::commands        Comandos simulados (após coalescência)
+ * @var blockdev_host_stats_t::syncs           CTRL_SYNC recebidos
+ * @var blockdev_host_stats_t::busy_ns         Tempo simulado acumulado
+ */
+typedef struct {
+    uint32_t reads;
+    uint32_t writes;
+    uint32_t sectors_read;
+    uint32_t sectors_written;
+    uint32_t commands;
+    uint32_t syncs;
+    uint64_t busy_ns;
+} blockdev_host_stats_t;
+
+/**
+ * @struct blockdev_host_t
+ * @brief Estado do backend
+ */
+typedef struct {
+    uint8_t *data;                  /**< sectors * 512 bytes */
+    uint32_t sectors;
+    int fd;                         /**< -1 para RAM */
+    bool write_protected;
+
+    blockdev_host_latency_t lat;
+    uint64_t now_ns;                /**< Relógio virtual */
+    uint32_t next_lba;              /**< Continuação do fluxo aberto */
+    uint8_t mode;                   /**< 0 ocioso, 1 lendo, 2 gravando */
+
+    blockdev_host_stats_t stats;
+} blockdev_host_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Usa um buffer do chamador como disco (sem latência)
+ *
+ * @param buf     sectors * 512 bytes
+ * @param sectors Número de setores
+ * @return false se os parâmetros forem inválidos
+ */
+bool blockdev_host_init_ram(blockdev_host_t *h, uint8_t *buf, uint32_t sectors);
+
+/**
+ * @brief Mapeia um arquivo de imagem como disco (sem latência)
+ *
+ * @param path    Caminho da imagem
+ * @param sectors Tamanho em setores; se o arquivo for menor (ou não existir,
+ *                com `create`), ele é estendido. 0 usa o tamanho atual.
+ * @param create  Cria o arquivo se não existir
+ * @return false se o arquivo não puder ser aberto, estendido ou mapeado
+ */
+bool blockdev_host_open_image(blockdev_host_t *h, const char *path, uint32_t sectors,
+                              bool create);
+
+/** Grava a imagem no arquivo e desfaz o mapeamento (nada a fazer em RAM) */
+void blockdev_host_close(blockdev_host_t *h);
+
+/** Troca o modelo de latência (fecha o fluxo simulado) */
+void blockdev_host_set_latency(blockdev_host_t *h, const blockdev_host_latency_t *lat);
+
+/** Simula um cartão travado: escritas devolvem BLOCKDEV_WRPRT */
+void blockdev_host_set_write_protect(blockdev_host_t *h, bool on);
+
+/** Relógio virtual: soma do tempo simulado desde a abertura */
+static inline uint64_t blockdev_host_now_ns(const blockdev_host_t *h) {
+    return h->now_ns;
+}
+
+blockdev_result_t blockdev_host_read(blockdev_host_t *h, uint8_t *buf, uint32_t lba,
+                                     uint32_t count);
+blockdev_result_t blockdev_host_write(blockdev_host_t *h, const uint8_t *buf, uint32_t lba,
+                                      uint32_t count);
+
+/**
+ * @brief ioctl: CTRL_SYNC (msync na imagem), GET_SECTOR_COUNT/SIZE,
+ *        GET_BLOCK_SIZE, CTRL_TRIM (zera a faixa) e BLOCKDEV_HOST_IOCTL_*
+ */
+blockdev_result_t blockdev_host_ioctl(blockdev_host_t *h, uint8_t cmd, void *buff);
+
+/** Preenche um blockdev_t para o backend */
+void blockdev_host_blockdev(blockdev_host_t *h, blockdev_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BLOCKDEV_HOST_H */
@@ -0,0 +1,350 @@
+/**
+ * =============================================================================
+ * @file    blockdev_host_test.c
+ * @brief   (Host) Testes do backend blockdev_host (RAM, imagem e latência)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details - ida e volta de leituras e escritas na RAM e numa imagem mapeada
+ *            (inclusive reabrindo o arquivo e conferindo o conteúdo em disco);
+ *          - LBAs e contagens fora da faixa devolvem BLOCKDEV_PARERR
+ *            (RES_PARERR) sem tocar no disco nem no relógio;
+ *          - proteção contra escrita: BLOCKDEV_WRPRT em escrita e TRIM,
+ *            leituras continuam;
+ *          - custo exato no relógio virtual de uma sequência conhecida, com
+ *            e sem coalescência, e com BLOCKDEV_HOST_LATENCY_SD_SPI.
+ *
+ *          Uso: blockdev_host_test
+ *          Retorno: 0 se tudo conferiu, 1 caso contrário.
+ * =============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "blockdev_host.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SECTOR  BLOCKDEV_SECTOR_SIZE
+#define SECTORS 64u
+
+static uint8_t disk[SECTORS * SECTOR];
+static uint8_t buf[SECTORS * SECTOR];
+static uint8_t pattern[SECTORS * SECTOR];
+
+/** Conteúdo distinto por setor e por passada */
+static void fill(uint8_t *p, uint32_t lba, uint32_t count, uint8_t seed) {
+    for (size_t i = 0; i < (size_t)count * SECTOR; i++) {
+        p[i] = (uint8_t)(seed * 31u + (lba + i / SECTOR) * 7u + i * 13u);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 1: IDA E VOLTA
+ * =============================================================================
+ */
+
+/** Escritas e leituras pelo blockdev_t; `h` já aberto com SECTORS setores */
+static void roundtrip(const char *name, blockdev_host_t *h) {
+    const unsigned before = failures;
+    blockdev_t dev;
+    blockdev_host_blockdev(h, &dev);
+
+    static const uint32_t ops[][2] = { { 0, 1 }, { 1, 7 }, { 8, 16 }, { SECTORS - 1, 1 },
+                                       { 30, 10 }, { 0, SECTORS } };
+    uint8_t seed = 1;
+    for (size_t i = 0; i < sizeof ops / sizeof ops[0]; i++, seed++) {
+        const uint32_t lba = ops[i][0], n = ops[i][1];
+        fill(pattern, lba, n, seed);
+        CHECK(blockdev_write(&dev, pattern, lba, n) == BLOCKDEV_OK, "%s: escrita %u+%u", name,
+              (unsigned)lba, (unsigned)n);
+        memset(buf, 0, sizeof buf);
+        CHECK(blockdev_read(&dev, buf, lba, n) == BLOCKDEV_OK, "%s: leitura %u+%u", name,
+              (unsigned)lba, (unsigned)n);
+        CHECK(memcmp(buf, pattern, (size_t)n * SECTOR) == 0, "%s: %u+%u lido difere", name,
+              (unsigned)lba, (unsigned)n);
+        CHECK(memcmp(h->data + (size_t)lba * SECTOR, pattern, (size_t)n * SECTOR) == 0,
+              "%s: %u+%u não chegou ao disco", name, (unsigned)lba, (unsigned)n);
+    }
+
+    /* Leitura parcial de uma escrita maior e setores vizinhos intactos */
+    fill(pattern, 20, 4, 99);
+    CHECK(blockdev_write(&dev, pattern, 20, 4) == BLOCKDEV_OK, "%s: escrita 20+4", name);
+    CHECK(blockdev_read(&dev, buf, 21, 2) == BLOCKDEV_OK &&
+              memcmp(buf, pattern + SECTOR, 2u * SECTOR) == 0,
+          "%s: leitura 21+2 de 20+4", name);
+    fill(pattern, 0, SECTORS, (uint8_t)(seed - 1u));
+    CHECK(memcmp(h->data + 19u * SECTOR, pattern + 19u * SECTOR, SECTOR) == 0 &&
+              memcmp(h->data + 24u * SECTOR, pattern + 24u * SECTOR, SECTOR) == 0,
+          "%s: vizinhos de 20+4 alterados", name);
+
+    /* Geometria, TRIM e sync */
+    uint32_t count = 0, block = 0;
+    uint16_t size = 0;
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_GET_SECTOR_COUNT, &count) == BLOCKDEV_OK &&
+              count == SECTORS,
+          "%s: GET_SECTOR_COUNT = %u", name, (unsigned)count);
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_GET_SECTOR_SIZE, &size) == BLOCKDEV_OK && size == SECTOR,
+          "%s: GET_SECTOR_SIZE = %u", name, size);
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_GET_BLOCK_SIZE, &block) == BLOCKDEV_OK && block > 0,
+          "%s: GET_BLOCK_SIZE", name);
+    uint32_t range[2] = { 10, 12 };
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_CTRL_TRIM, range) == BLOCKDEV_OK, "%s: TRIM", name);
+    static const uint8_t zero[3 * SECTOR];
+    CHECK(blockdev_read(&dev, buf, 9, 5) == BLOCKDEV_OK && memcmp(buf + SECTOR, zero, 3u * SECTOR) == 0 &&
+              memcmp(buf, pattern + 9u * SECTOR, SECTOR) == 0 &&
+              memcmp(buf + 4u * SECTOR, pattern + 13u * SECTOR, SECTOR) == 0,
+          "%s: TRIM 10..12 não zerou só a faixa", name);
+    CHECK(blockdev_sync(&dev) == BLOCKDEV_OK, "%s: CTRL_SYNC", name);
+
+    blockdev_host_stats_t st;
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_HOST_IOCTL_GET_STATS, &st) == BLOCKDEV_OK &&
+              st.writes == 7u && st.reads == 8u && st.syncs == 1u &&
+              st.sectors_written == 1u + 7u + 16u + 1u + 10u + SECTORS + 4u,
+          "%s: contadores (%u escritas, %u leituras, %u syncs, %u setores gravados)", name,
+          (unsigned)st.writes, (unsigned)st.reads, (unsigned)st.syncs,
+          (unsigned)st.sectors_written);
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_HOST_IOCTL_RESET_STATS, NULL) == BLOCKDEV_OK &&
+              blockdev_ioctl(&dev, BLOCKDEV_HOST_IOCTL_GET_STATS, &st) == BLOCKDEV_OK &&
+              st.writes == 0u && st.reads == 0u,
+          "%s: RESET_STATS", name);
+
+    printf("%-32s %s\n", name, failures == before ? "ok" : "FALHA");
+}
+
+static void test_image(void) {
+    const unsigned before = failures;
+    const char *tmp = getenv("TMPDIR");
+    char path[256];
+    snprintf(path, sizeof path, "%s/blockdev_host_test_XXXXXX", tmp && tmp[0] ? tmp : "/tmp");
+    const int fd = mkstemp(path);
+    if (fd < 0) {
+        CHECK(0, "mkstemp(%s)", path);
+        return;
+    }
+    close(fd);
+
+    static blockdev_host_t h;
+    CHECK(blockdev_host_open_image(&h, path, SECTORS, true), "imagem: abertura");
+    if (!h.data) {
+        unlink(path);
+        return;
+    }
+    roundtrip("imagem (mmap): ida e volta", &h);
+    memcpy(disk, h.data, sizeof disk);
+    blockdev_host_close(&h);
+    CHECK(h.data == NULL && blockdev_host_read(&h, buf, 0, 1) == BLOCKDEV_NOTRDY,
+          "imagem: leitura depois de fechar não devolveu NOTRDY");
+
+    /* O arquivo guarda exatamente o que foi gravado */
+    FILE *f = fopen(path, "rb");
+    size_t got = 0;
+    if (f) {
+        got = fread(buf, 1, sizeof buf, f);
+        CHECK(fgetc(f) == EOF, "imagem: arquivo maior que %u setores", SECTORS);
+        fclose(f);
+    }
+    CHECK(got == sizeof buf && memcmp(buf, disk, sizeof buf) == 0,
+          "imagem: conteúdo do arquivo (%zu bytes) difere do gravado", got);
+
+    /* Reabrir com sectors = 0 usa o tamanho do arquivo */
+    CHECK(blockdev_host_open_image(&h, path, 0, false) && h.sectors == SECTORS,
+          "imagem: reabertura com o tamanho do arquivo");
+    if (h.data) {
+        CHECK(blockdev_host_read(&h, buf, 0, SECTORS) == BLOCKDEV_OK &&
+                  memcmp(buf, disk, sizeof buf) == 0,
+              "imagem: conteúdo após reabrir difere");
+        blockdev_host_close(&h);
+    }
+    unlink(path);
+    CHECK(!blockdev_host_open_image(&h, path, SECTORS, false),
+          "imagem: abriu arquivo inexistente sem create");
+    printf("%-32s %s\n", "imagem (mmap): persistência", failures == before ? "ok" : "FALHA");
+}
+
+/* =============================================================================
+ * SEÇÃO 2: ERROS
+ * =============================================================================
+ */
+
+static void test_errors(void) {
+    const unsigned before = failures;
+    static blockdev_host_t h;
+    CHECK(!blockdev_host_init_ram(&h, disk, 0) && !blockdev_host_init_ram(&h, NULL, SECTORS),
+          "init_ram aceitou parâmetros inválidos");
+    blockdev_host_init_ram(&h, disk, SECTORS);
+    const blockdev_host_latency_t lat = BLOCKDEV_HOST_LATENCY_SD_SPI;
+    blockdev_host_set_latency(&h, &lat);
+    memset(disk, 0x5A, sizeof disk);
+
+    /* {lba, count}: fim do disco, estouro de lba + count, contagem zero */
+    static const uint32_t bad[][2] = { { SECTORS, 1 }, { SECTORS - 1, 2 }, { 0, SECTORS + 1 },
+                                       { 1, 0xFFFFFFFFu }, { 0xFFFFFFFFu, 2 }, { 0, 0 },
+                                       { 0xFFFFFFFFu, 0xFFFFFFFFu } };
+    for (size_t i = 0; i < sizeof bad / sizeof bad[0]; i++) {
+        const blockdev_result_t r = blockdev_host_read(&h, buf, bad[i][0], bad[i][1]);
+        const blockdev_result_t w = blockdev_host_write(&h, pattern, bad[i][0], bad[i][1]);
+        CHECK(r == BLOCKDEV_PARERR && w == BLOCKDEV_PARERR,
+              "lba %u, %u setores: leitura %d, escrita %d (esperado RES_PARERR)",
+              (unsigned)bad[i][0], (unsigned)bad[i][1], r, w);
+    }
+    CHECK(blockdev_host_read(&h, NULL, 0, 1) == BLOCKDEV_PARERR &&
+              blockdev_host_write(&h, NULL, 0, 1) == BLOCKDEV_PARERR,
+          "buffer nulo não devolveu RES_PARERR");
+    uint32_t range[2] = { 5, SECTORS };
+    CHECK(blockdev_host_ioctl(&h, BLOCKDEV_CTRL_TRIM, range) == BLOCKDEV_PARERR,
+          "TRIM além do fim");
+    range[0] = 9;
+    range[1] = 8;
+    CHECK(blockdev_host_ioctl(&h, BLOCKDEV_CTRL_TRIM, range) == BLOCKDEV_PARERR,
+          "TRIM invertido");
+    CHECK(blockdev_host_ioctl(&h, BLOCKDEV_GET_SECTOR_COUNT, NULL) == BLOCKDEV_PARERR &&
+              blockdev_host_ioctl(&h, 0x7Eu, NULL) == BLOCKDEV_PARERR,
+          "ioctl sem buffer ou desconhecido");
+    CHECK(blockdev_host_now_ns(&h) == 0 && h.stats.reads == 0 && h.stats.writes == 0 &&
+              h.stats.commands == 0,
+          "pedidos inválidos custaram %llu ns", (unsigned long long)blockdev_host_now_ns(&h));
+
+    /* Proteção contra escrita: nada muda, nem o relógio */
+    blockdev_host_set_write_protect(&h, true);
+    fill(pattern, 3, 2, 7);
+    CHECK(blockdev_host_write(&h, pattern, 3, 2) == BLOCKDEV_WRPRT, "escrita protegida");
+    range[0] = 0;
+    range[1] = 3;
+    CHECK(blockdev_host_ioctl(&h, BLOCKDEV_CTRL_TRIM, range) == BLOCKDEV_WRPRT, "TRIM protegido");
+    CHECK(disk[3u * SECTOR] == 0x5A && disk[0] == 0x5A && h.stats.writes == 0 &&
+              blockdev_host_now_ns(&h) == 0,
+          "escrita protegida alterou o disco ou o relógio");
+    CHECK(blockdev_host_read(&h, buf, 3, 2) == BLOCKDEV_OK && buf[0] == 0x5A,
+          "leitura com proteção contra escrita");
+    blockdev_host_set_write_protect(&h, false);
+    CHECK(blockdev_host_write(&h, pattern, 3, 2) == BLOCKDEV_OK &&
+              memcmp(disk + 3u * SECTOR, pattern, 2u * SECTOR) == 0,
+          "escrita após remover a proteção");
+
+    printf("%-32s %s\n", "RES_PARERR e RES_WRPRT", failures == before ? "ok" : "FALHA");
+}
+
+/* =============================================================================
+ * SEÇÃO 3: RELÓGIO VIRTUAL
+ * =============================================================================
+ */
+
+enum { OP_READ, OP_WRITE, OP_SYNC };
+
+typedef struct {
+    int op;
+    uint32_t lba;
+    uint32_t count;
+    uint64_t cost_ns;    /**< Custo esperado desta chamada */
+    uint32_t commands;   /**< Comandos acumulados após a chamada */
+} step_t;
+
+static void run_steps(const char *name, const blockdev_host_latency_t *lat, const step_t *steps,
+                      size_t n) {
+    const unsigned before = failures;
+    static blockdev_host_t h;
+    blockdev_host_init_ram(&h, disk, SECTORS);
+    blockdev_host_set_latency(&h, lat);
+    uint64_t total = 0;
+    for (size_t i = 0; i < n; i++) {
+        const step_t *s = &steps[i];
+        const uint64_t t0 = blockdev_host_now_ns(&h);
+        blockdev_result_t r = BLOCKDEV_OK;
+        if (s->op == OP_READ) {
+            r = blockdev_host_read(&h, buf, s->lba, s->count);
+        } else if (s->op == OP_WRITE) {
+            r = blockdev_host_write(&h, pattern, s->lba, s->count);
+        } else {
+            r = blockdev_host_ioctl(&h, BLOCKDEV_CTRL_SYNC, NULL);
+        }
+        const uint64_t dt = blockdev_host_now_ns(&h) - t0;
+        total += s->cost_ns;
+        CHECK(r == BLOCKDEV_OK && dt == s->cost_ns && h.stats.commands == s->commands,
+              "%s, passo %zu: %llu ns e %u comandos (esperado %llu ns e %u)", name, i,
+              (unsigned long long)dt, (unsigned)h.stats.commands,
+              (unsigned long long)s->cost_ns, (unsigned)s->commands);
+    }
+    CHECK(blockdev_host_now_ns(&h) == total && h.stats.busy_ns == total,
+          "%s: relógio %llu ns, busy %llu ns, esperado %llu ns", name,
+          (unsigned long long)blockdev_host_now_ns(&h), (unsigned long long)h.stats.busy_ns,
+          (unsigned long long)total);
+    printf("%-32s %9llu ns  %s\n", name, (unsigned long long)total,
+           failures == before ? "ok" : "FALHA");
+}
+
+static void test_clock(void) {
+    /* cmd 1 us, 2 ns/byte (1024 ns/setor), programação 30 us/setor,
+     * commit 500 us, sync 70 us */
+    const blockdev_host_latency_t lat = { 1000u, 2u, 30000u, 500000u, 70000u, true, false };
+    static const step_t stream[] = {
+        { OP_READ, 0, 4, 1000u + 4096u, 1 },                   /* CMD18 + 4 setores */
+        { OP_READ, 4, 2, 2048u, 1 },                           /* continua o fluxo */
+        { OP_READ, 10, 1, 1000u + 1024u, 2 },                  /* salto: novo comando */
+        { OP_WRITE, 10, 2, 1000u + 2048u + 60000u, 3 },        /* CMD25 + 2 programações */
+        { OP_WRITE, 12, 3, 3072u + 90000u, 3 },                /* continua a escrita */
+        { OP_READ, 12, 1, 500000u + 1000u + 1024u, 4 },        /* commit + CMD18 */
+        { OP_SYNC, 0, 0, 70000u, 4 },                          /* leitura: só o sync */
+        { OP_WRITE, 0, 1, 1000u + 1024u + 30000u, 5 },
+        { OP_SYNC, 0, 0, 500000u + 70000u, 5 },                /* commit pendente + sync */
+        { OP_SYNC, 0, 0, 70000u, 5 },                          /* nada pendente */
+        { OP_WRITE, 1, 1, 1000u + 1024u + 30000u, 6 },         /* após sync: novo fluxo */
+    };
+    run_steps("relógio: com coalescência", &lat, stream, sizeof stream / sizeof stream[0]);
+
+    blockdev_host_latency_t single = lat;
+    single.coalesce = false;
+    static const step_t each[] = {
+        { OP_READ, 0, 1, 1000u + 1024u, 1 },
+        { OP_READ, 1, 1, 1000u + 1024u, 2 },                   /* contíguo, mas sem fluxo */
+        { OP_WRITE, 2, 2, 1000u + 2048u + 60000u + 500000u, 3 },
+        { OP_WRITE, 4, 1, 1000u + 1024u + 30000u + 500000u, 4 },
+        { OP_SYNC, 0, 0, 70000u, 4 },
+    };
+    run_steps("relógio: sem coalescência", &single, each, sizeof each / sizeof each[0]);
+
+    /* SD em SPI a 25 MHz: 20 us de comando, 320 ns/byte, 30 us, 1 ms, 500 us */
+    const blockdev_host_latency_t sd = BLOCKDEV_HOST_LATENCY_SD_SPI;
+    static const step_t sd_steps[] = {
+        { OP_WRITE, 0, 8, 20000u + 8u * 163840u + 8u * 30000u, 1 },
+        { OP_WRITE, 8, 8, 8u * 163840u + 8u * 30000u, 1 },
+        { OP_SYNC, 0, 0, 1000000u + 500000u, 1 },
+        { OP_READ, 0, 16, 20000u + 16u * 163840u, 2 },
+    };
+    run_steps("relógio: LATENCY_SD_SPI", &sd, sd_steps, sizeof sd_steps / sizeof sd_steps[0]);
+
+    /* realtime: a chamada espera de verdade o tempo simulado */
+    const blockdev_host_latency_t rt = { 3000000u, 0u, 0u, 0u, 0u, true, true };
+    static blockdev_host_t h;
+    blockdev_host_init_ram(&h, disk, SECTORS);
+    blockdev_host_set_latency(&h, &rt);
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    blockdev_host_read(&h, buf, 0, 1);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+    const double waited = (double)(t1.tv_sec - t0.tv_sec) + (double)(t1.tv_nsec - t0.tv_nsec) * 1e-9;
+    CHECK(waited >= 0.003 && blockdev_host_now_ns(&h) == 3000000u,
+          "realtime: esperou %.6f s para 3 ms simulados", waited);
+}
+
+int main(void) {
+    static blockdev_host_t h;
+    CHECK(blockdev_host_init_ram(&h, disk, SECTORS), "init_ram");
+    roundtrip("RAM: ida e volta", &h);
+    CHECK(blockdev_host_now_ns(&h) == 0, "RAM sem latência avançou o relógio");
+    test_image();
+    test_errors();
+    test_clock();
+
+    return test_check_summary();
+}
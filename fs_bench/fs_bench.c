@@ -0,0 +1,474 @@
+/**
+ * =============================================================================
+ * @file    fs_bench.c
+ * @brief   Implementação do benchmark de arquivo (padrão de acesso do FatFS)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details VOLUME EMULADO (FAT32, volume recém-formatado), montado dentro da
+ *          região da configuração (base_lba, n_sectors):
+ *          ┌──────────────┬────────────────────────────────────────────────┐
+ *          │ base_lba     │ FAT1, FAT2: 4 bytes por cluster da região,     │
+ *          │              │ cópias gravadas juntas                         │
+ *          │ Cluster 2    │ Diretório raiz (entrada do arquivo)            │
+ *          │ Cluster 3..  │ Arquivo, clusters contíguos                    │
+ *          └──────────────┴────────────────────────────────────────────────┘
+ * =============================================================================
+ */
+
+#include "fs_bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SECTOR      BLOCKDEV_SECTOR_SIZE
+#define NO_LBA      0xFFFFFFFFu
+#define FIRST_CLUST 3u          /**< Primeiro cluster do arquivo */
+#define FAT_EOC     0x0FFFFFFFu
+
+/* =============================================================================
+ * SEÇÃO 1: DISPOSITIVO E CONTEÚDO
+ * =============================================================================
+ */
+
+/** Acesso fora da região: falha em vez de tocar o volume real do cartão */
+static inline bool in_region(const fs_bench_t *b, uint32_t lba, uint32_t count) {
+    return lba >= b->region_lba && lba < b->region_end && count <= b->region_end - lba;
+}
+
+static void dev_read(fs_bench_t *b, uint8_t *buf, uint32_t lba, uint32_t count) {
+    if (!b->failed && (!in_region(b, lba, count) ||
+                       blockdev_read(&b->dev, buf, lba, count) != BLOCKDEV_OK)) {
+        b->failed = true;
+    }
+}
+
+static void dev_write(fs_bench_t *b, const uint8_t *buf, uint32_t lba, uint32_t count) {
+    if (!b->failed && (!in_region(b, lba, count) ||
+                       blockdev_write(&b->dev, buf, lba, count) != BLOCKDEV_OK)) {
+        b->failed = true;
+    }
+}
+
+/** Conteúdo do arquivo: função da posição, para verificar sem guardar cópia */
+static inline uint8_t pattern(const fs_bench_t *b, uint32_t pos) {
+    return (uint8_t)((pos ^ (pos >> 9) ^ (pos >> 17)) * 31u + b->pattern_seed);
+}
+
+static void fill(const fs_bench_t *b, uint8_t *dst, uint32_t pos, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        dst[i] = pattern(b, pos + i);
+    }
+}
+
+static bool matches(const fs_bench_t *b, const uint8_t *src, uint32_t pos, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        if (src[i] != pattern(b, pos + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static inline uint32_t xorshift32(uint32_t *s) {
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *s = x;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: JANELA DO VOLUME E FAT
+ * =============================================================================
+ */
+
+static void win_flush(fs_bench_t *b) {
+    if (!b->win_dirty) {
+        return;
+    }
+    dev_write(b, b->win, b->win_lba, 1);
+    if (b->win_lba >= b->fat_lba && b->win_lba < b->fat_lba + b->fat_sectors) {
+        dev_write(b, b->win, b->win_lba + b->fat_sectors, 1);  /* FAT2 */
+        b->fat_writes += 2u;
+    } else {
+        b->dir_writes++;
+    }
+    b->win_dirty = false;
+}
+
+/** move_window() do FatFS: um único setor de FAT/diretório em RAM */
+static void move_window(fs_bench_t *b, uint32_t lba) {
+    if (b->win_lba == lba) {
+        return;
+    }
+    win_flush(b);
+    dev_read(b, b->win, lba, 1);
+    b->win_lba = lba;
+}
+
+static void fat_put(fs_bench_t *b, uint32_t clust, uint32_t value) {
+    const uint32_t off = clust * 4u;
+    move_window(b, b->fat_lba + off / SECTOR);
+    uint8_t *e = &b->win[off % SECTOR];
+    e[0] = (uint8_t)value;
+    e[1] = (uint8_t)(value >> 8);
+    e[2] = (uint8_t)(value >> 16);
+    e[3] = (uint8_t)(value >> 24);
+    b->win_dirty = true;
+}
+
+/** create_chain(): o novo cluster vira o fim da cadeia e o anterior aponta para ele */
+static void alloc_cluster(fs_bench_t *b) {
+    const uint32_t clust = FIRST_CLUST + b->alloc_clusters;
+    if (b->alloc_clusters > 0) {
+        fat_put(b, clust - 1u, clust);
+    }
+    fat_put(b, clust, FAT_EOC);
+    b->alloc_clusters++;
+}
+
+/** f_expand(): a cadeia inteira de uma vez */
+static void expand(fs_bench_t *b, uint32_t clusters) {
+    while (b->alloc_clusters < clusters && !b->failed) {
+        alloc_cluster(b);
+    }
+    win_flush(b);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: ARQUIVO
+ * =============================================================================
+ */
+
+static void fbuf_flush(fs_bench_t *b) {
+    if (b->fbuf_dirty) {
+        dev_write(b, b->fbuf, b->fbuf_lba, 1);
+        b->fbuf_dirty = false;
+    }
+}
+
+/** Leva o setor `lba` ao buffer do arquivo; `load` lê o conteúdo atual */
+static void fbuf_load(fs_bench_t *b, uint32_t lba, bool load) {
+    if (b->fbuf_lba == lba) {
+        return;
+    }
+    fbuf_flush(b);
+    if (load) {
+        dev_read(b, b->fbuf, lba, 1);
+    }
+    b->fbuf_lba = lba;
+}
+
+/** Setores inteiros a partir de `pos` que cabem no cluster atual */
+static uint32_t direct_sectors(const fs_bench_t *b, uint32_t pos, uint32_t len) {
+    const uint32_t left = b->clust_sect - (pos / SECTOR) % b->clust_sect;
+    const uint32_t n = len / SECTOR;
+    return n < left ? n : left;
+}
+
+static void file_write(fs_bench_t *b, uint32_t pos, const uint8_t *src, uint32_t len) {
+    const uint32_t clust_bytes = b->clust_sect * SECTOR;
+    while (len > 0 && !b->failed) {
+        if (pos / clust_bytes >= b->alloc_clusters) {
+            alloc_cluster(b);
+            continue;
+        }
+        const uint32_t off = pos % SECTOR;
+        const uint32_t lba = b->file_lba + pos / SECTOR;
+        uint32_t done;
+
+        if (off == 0 && len >= SECTOR) {
+            const uint32_t n = direct_sectors(b, pos, len);
+            dev_write(b, src, lba, n);
+            if (b->fbuf_lba - lba < n) {
+                /* O buffer cobre um setor recém-gravado: fica limpo e atual */
+                memcpy(b->fbuf, src + (b->fbuf_lba - lba) * SECTOR, SECTOR);
+                b->fbuf_dirty = false;
+            }
+            done = n * SECTOR;
+        } else {
+            /* Setor parcial: só lê do cartão se já houver dados nele */
+            fbuf_load(b, lba, pos - off < b->file_size);
+            done = SECTOR - off < len ? SECTOR - off : len;
+            memcpy(b->fbuf + off, src, done);
+            b->fbuf_dirty = true;
+        }
+        pos += done;
+        src += done;
+        len -= done;
+        if (pos > b->file_size) {
+            b->file_size = pos;
+        }
+    }
+}
+
+static void file_read(fs_bench_t *b, uint32_t pos, uint8_t *dst, uint32_t len) {
+    while (len > 0 && !b->failed) {
+        const uint32_t off = pos % SECTOR;
+        const uint32_t lba = b->file_lba + pos / SECTOR;
+        uint32_t done;
+
+        if (off == 0 && len >= SECTOR) {
+            const uint32_t n = direct_sectors(b, pos, len);
+            dev_read(b, dst, lba, n);
+            if (b->fbuf_dirty && b->fbuf_lba - lba < n) {
+                memcpy(dst + (b->fbuf_lba - lba) * SECTOR, b->fbuf, SECTOR);
+            }
+            done = n * SECTOR;
+        } else {
+            fbuf_load(b, lba, true);
+            done = SECTOR - off < len ? SECTOR - off : len;
+            memcpy(dst, b->fbuf + off, done);
+        }
+        pos += done;
+        dst += done;
+        len -= done;
+    }
+}
+
+/** f_sync(): buffer do arquivo, entrada de diretório (tamanho), FAT, CTRL_SYNC */
+static void file_sync(fs_bench_t *b) {
+    fbuf_flush(b);
+    move_window(b, b->dir_lba);
+    b->win[28] = (uint8_t)b->file_size;
+    b->win[29] = (uint8_t)(b->file_size >> 8);
+    b->win[30] = (uint8_t)(b->file_size >> 16);
+    b->win[31] = (uint8_t)(b->file_size >> 24);
+    b->win_dirty = true;
+    win_flush(b);
+    if (!b->failed && blockdev_sync(&b->dev) != BLOCKDEV_OK) {
+        b->failed = true;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: EXECUÇÃO
+ * =============================================================================
+ */
+
+bool fs_bench_init(fs_bench_t *b, const blockdev_t *dev, uint64_t (*now_ns)(void *ctx),
+                   void *clock_ctx, uint8_t *io, uint32_t io_size, uint32_t *samples,
+                   uint32_t max_samples) {
+    if (!b || !dev || !now_ns || !io || io_size < SECTOR || !samples || max_samples == 0) {
+        return false;
+    }
+    memset(b, 0, sizeof *b);
+    b->dev = *dev;
+    b->now_ns = now_ns;
+    b->clock_ctx = clock_ctx;
+    b->io = io;
+    b->io_size = io_size;
+    b->samples = samples;
+    b->max_samples = max_samples;
+    return true;
+}
+
+/** Formata o volume emulado dentro da região da configuração */
+static bool volume_reset(fs_bench_t *b, const fs_bench_cfg_t *cfg) {
+    /* Sem região explícita não há execução: o padrão seria o volume do usuário */
+    uint32_t dev_sectors = 0;
+    if (cfg->n_sectors == 0 ||
+        blockdev_ioctl(&b->dev, BLOCKDEV_GET_SECTOR_COUNT, &dev_sectors) != BLOCKDEV_OK ||
+        cfg->base_lba >= dev_sectors || cfg->n_sectors > dev_sectors - cfg->base_lba) {
+        return false;
+    }
+    b->region_lba = cfg->base_lba;
+    b->region_end = cfg->base_lba + cfg->n_sectors;
+
+    b->clust_sect = cfg->cluster_bytes / SECTOR;
+    const uint32_t clusters = cfg->n_sectors / b->clust_sect;
+    b->fat_lba = b->region_lba;
+    b->fat_sectors = (clusters * 4u + SECTOR - 1u) / SECTOR;
+    b->dir_lba = b->fat_lba + 2u * b->fat_sectors;
+    b->file_lba = b->dir_lba + b->clust_sect;
+
+    const uint32_t file_clusters = (cfg->file_bytes + cfg->cluster_bytes - 1u) / cfg->cluster_bytes;
+    if (b->file_lba >= b->region_end ||
+        file_clusters > (b->region_end - b->file_lba) / b->clust_sect) {
+        return false;
+    }
+
+    b->alloc_clusters = 0;
+    b->file_size = 0;
+    b->win_lba = NO_LBA;
+    b->win_dirty = false;
+    b->fbuf_lba = NO_LBA;
+    b->fbuf_dirty = false;
+    b->failed = false;
+    b->pattern_seed = cfg->seed * 0x9E3779B9u + (uint32_t)cfg->access;
+    return true;
+}
+
+/** Cria o arquivo completo fora da medição (para leitura e regravação) */
+static void create_file(fs_bench_t *b, uint32_t file_bytes) {
+    const uint32_t chunk = b->io_size / SECTOR * SECTOR;
+    for (uint32_t pos = 0; pos < file_bytes && !b->failed; pos += chunk) {
+        const uint32_t n = file_bytes - pos < chunk ? file_bytes - pos : chunk;
+        fill(b, b->io, pos, n);
+        file_write(b, pos, b->io, n);
+    }
+    file_sync(b);
+}
+
+/** Confere o arquivo inteiro diretamente no dispositivo */
+static bool verify_file(fs_bench_t *b, uint32_t file_bytes) {
+    const uint32_t chunk = b->io_size / SECTOR;
+    for (uint32_t sect = 0; sect * SECTOR < file_bytes && !b->failed; sect += chunk) {
+        const uint32_t pos = sect * SECTOR;
+        const uint32_t n = file_bytes - pos < chunk * SECTOR ? file_bytes - pos : chunk * SECTOR;
+        dev_read(b, b->io, b->file_lba + sect, (n + SECTOR - 1u) / SECTOR);
+        if (!matches(b, b->io, pos, n)) {
+            return false;
+        }
+    }
+    return !b->failed;
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static inline uint32_t clamp_u32(uint64_t v) {
+    return v > 0xFFFFFFFFu ? 0xFFFFFFFFu : (uint32_t)v;
+}
+
+bool fs_bench_run(fs_bench_t *b, const fs_bench_cfg_t *cfg, fs_bench_result_t *res) {
+    memset(res, 0, sizeof *res);
+    if (!cfg || cfg->file_bytes == 0 || cfg->buf_bytes == 0 || cfg->buf_bytes > b->io_size ||
+        cfg->buf_bytes > cfg->file_bytes || cfg->cluster_bytes < SECTOR ||
+        cfg->cluster_bytes % SECTOR != 0 || !volume_reset(b, cfg)) {
+        return false;
+    }
+
+    const bool writing = cfg->access == FS_BENCH_SEQ_WRITE || cfg->access == FS_BENCH_RAND_WRITE;
+    const bool random = cfg->access == FS_BENCH_RAND_WRITE || cfg->access == FS_BENCH_RAND_READ;
+    const uint32_t clusters = (cfg->file_bytes + cfg->cluster_bytes - 1u) / cfg->cluster_bytes;
+
+    /* Preparação (fora do total): f_expand e, se preciso, o arquivo existente */
+    uint64_t t0 = b->now_ns(b->clock_ctx);
+    if (cfg->preallocate) {
+        expand(b, clusters);
+    }
+    if (cfg->access != FS_BENCH_SEQ_WRITE) {
+        create_file(b, cfg->file_bytes);
+    }
+    res->setup_ns = b->now_ns(b->clock_ctx) - t0;
+    b->fat_writes = 0;
+    b->dir_writes = 0;
+
+    const uint32_t records = cfg->file_bytes / cfg->buf_bytes;
+    const uint32_t calls = random ? records
+                                  : (cfg->file_bytes + cfg->buf_bytes - 1u) / cfg->buf_bytes;
+    uint32_t rng = cfg->seed ? cfg->seed : 1u;
+    uint64_t sum_ns = 0;
+    bool data_ok = true;
+
+    for (uint32_t i = 0; i < calls && !b->failed; i++) {
+        const uint32_t pos = random ? (xorshift32(&rng) % records) * cfg->buf_bytes
+                                    : i * cfg->buf_bytes;
+        const uint32_t len = cfg->file_bytes - pos < cfg->buf_bytes ? cfg->file_bytes - pos
+                                                                     : cfg->buf_bytes;
+        if (writing) {
+            fill(b, b->io, pos, len);
+        }
+
+        t0 = b->now_ns(b->clock_ctx);
+        if (writing) {
+            file_write(b, pos, b->io, len);
+        } else {
+            file_read(b, pos, b->io, len);
+        }
+        if (cfg->sync_every && (i + 1u) % cfg->sync_every == 0) {
+            file_sync(b);
+        }
+        const uint64_t dt = b->now_ns(b->clock_ctx) - t0;
+
+        if (i < b->max_samples) {
+            b->samples[i] = clamp_u32(dt);
+        }
+        if (dt > res->max_ns) {
+            res->max_ns = clamp_u32(dt);
+        }
+        sum_ns += dt;
+        res->bytes += len;
+        if (!writing && !matches(b, b->io, pos, len)) {
+            data_ok = false;
+        }
+    }
+    res->calls = calls;
+
+    /* f_close */
+    t0 = b->now_ns(b->clock_ctx);
+    file_sync(b);
+    res->total_ns = sum_ns + (b->now_ns(b->clock_ctx) - t0);
+
+    res->fat_writes = b->fat_writes;
+    res->dir_writes = b->dir_writes;
+    res->mean_ns = calls ? clamp_u32(sum_ns / calls) : 0;
+    res->kb_per_s = res->total_ns ? clamp_u32(res->bytes * 1000000u / res->total_ns) : 0;
+
+    const uint32_t n = calls < b->max_samples ? calls : b->max_samples;
+    if (n > 0) {
+        qsort(b->samples, n, sizeof b->samples[0], cmp_u32);
+        res->p50_ns = b->samples[(n - 1u) * 50u / 100u];
+        res->p99_ns = b->samples[(n - 1u) * 99u / 100u];
+    }
+
+    res->verified = data_ok && !b->failed && verify_file(b, cfg->file_bytes);
+    return !b->failed;
+}
+
+/* =============================================================================
+ * SEÇÃO 5: SAÍDA CSV
+ * =============================================================================
+ */
+
+const char *fs_bench_access_name(fs_bench_access_t access) {
+    switch (access) {
+    case FS_BENCH_SEQ_WRITE:  return "seq_write";
+    case FS_BENCH_SEQ_READ:   return "seq_read";
+    case FS_BENCH_RAND_WRITE: return "rand_write";
+    case FS_BENCH_RAND_READ:  return "rand_read";
+    default:                  return "?";
+    }
+}
+
+const char *fs_bench_csv_header(void) {
+    return "access,file_bytes,buf_bytes,cluster_bytes,prealloc,sync_every,calls,"
+           "mb_per_s,mean_us,p50_us,p99_us,max_us,total_ms,setup_ms,"
+           "fat_writes,dir_writes,verified";
+}
+
+int fs_bench_format_csv(char *dst, size_t size, const char *label, const fs_bench_cfg_t *cfg,
+                        const fs_bench_result_t *res) {
+    const bool has_label = label && label[0];
+    return snprintf(dst, size,
+                    "%s%s%s,%lu,%lu,%lu,%d,%lu,%lu,"
+                    "%lu.%03lu,%lu.%01lu,%lu.%01lu,%lu.%01lu,%lu.%01lu,%lu.%03lu,%lu.%03lu,"
+                    "%lu,%lu,%d",
+                    has_label ? label : "", has_label ? "," : "",
+                    fs_bench_access_name(cfg->access), (unsigned long)cfg->file_bytes,
+                    (unsigned long)cfg->buf_bytes, (unsigned long)cfg->cluster_bytes,
+                    cfg->preallocate ? 1 : 0, (unsigned long)cfg->sync_every,
+                    (unsigned long)res->calls,
+                    (unsigned long)(res->kb_per_s / 1000u), (unsigned long)(res->kb_per_s % 1000u),
+                    (unsigned long)(res->mean_ns / 1000u), (unsigned long)(res->mean_ns % 1000u / 100u),
+                    (unsigned long)(res->p50_ns / 1000u), (unsigned long)(res->p50_ns % 1000u / 100u),
+                    (unsigned long)(res->p99_ns / 1000u), (unsigned long)(res->p99_ns % 1000u / 100u),
+                    (unsigned long)(res->max_ns / 1000u), (unsigned long)(res->max_ns % 1000u / 100u),
+                    (unsigned long)(res->total_ns / 1000000u),
+                    (unsigned long)(res->total_ns / 1000u % 1000u),
+                    (unsigned long)(res->setup_ns / 1000000u),
+                    (unsigned long)(res->setup_ns / 1000u % 1000u),
+                    (unsigned long)res->fat_writes, (unsigned long)res->dir_writes,
+                    res->verified ? 1 : 0);
+}
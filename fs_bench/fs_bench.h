@@ -0,0 +1,218 @@
+/**
+ * =============================================================================
+ * @file    fs_bench.h
+ * @brief   Benchmark parametrizado de vazão e latência de arquivo sobre blockdev_t
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Generaliza o big_file_test (grava um arquivo, verifica, imprime o
+ *          tempo) em uma execução parametrizada que reproduz o padrão de
+ *          acesso do FatFS ao dispositivo de blocos:
+ *
+ *          ┌──────────────────────┬───────────────────────────────────────────┐
+ *          │ Trecho do f_write    │ Acesso emulado                            │
+ *          ├──────────────────────┼───────────────────────────────────────────┤
+ *          │ Setores inteiros     │ disk_write direto, até o fim do cluster   │
+ *          │ Setor parcial        │ buffer do arquivo (512 B): lê o setor se  │
+ *          │                      │ já existir, grava ao trocar de setor      │
+ *          │ Novo cluster (append)│ atualiza a FAT pela janela do volume      │
+ *          │                      │ (leitura + escrita das duas cópias)       │
+ *          │ f_expand             │ cadeia inteira gravada antes (setup_ns)   │
+ *          │ f_sync               │ buffer do arquivo, entrada de diretório,  │
+ *          │                      │ janela da FAT e CTRL_SYNC                 │
+ *          └──────────────────────┴───────────────────────────────────────────┘
+ *
+ *          Cada chamada (f_write/f_read de buf_bytes) é cronometrada com o
+ *          relógio fornecido; o resultado traz MB/s, latência média, p50,
+ *          p99 e o pior travamento, e pode ser formatado como linha CSV.
+ *          O conteúdo gravado é uma função da posição no arquivo e é
+ *          verificado ao final (como o check_big_file).
+ *
+ *          Sem dependências de plataforma: no firmware, o dispositivo é o
+ *          sd_stream (com ou sem sd_cache) e o relógio é time_us_64(); no
+ *          host, o blockdev_host com o relógio virtual.
+ * =============================================================================
+ */
+
+#ifndef FS_BENCH_H
+#define FS_BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "blockdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @enum fs_bench_access_t
+ * @brief Padrão de acesso ao arquivo
+ */
+typedef enum {
+    FS_BENCH_SEQ_WRITE = 0,   /**< Gravação sequencial (log com append) */
+    FS_BENCH_SEQ_READ,        /**< Leitura sequencial de arquivo existente */
+    FS_BENCH_RAND_WRITE,      /**< Regravação de registros em posições aleatórias */
+    FS_BENCH_RAND_READ,       /**< Leitura de registros em posições aleatórias */
+} fs_bench_access_t;
+
+/**
+ * @struct fs_bench_cfg_t
+ * @brief Parâmetros de uma execução
+ *
+ * @var fs_bench_cfg_t::file_bytes    Tamanho do arquivo
+ * @var fs_bench_cfg_t::buf_bytes     Bytes por chamada (BUFFSZ do big_file_test)
+ * @var fs_bench_cfg_t::cluster_bytes Tamanho do cluster (múltiplo de 512)
+ * @var fs_bench_cfg_t::preallocate   f_expand antes de gravar (sem FAT no caminho)
+ * @var fs_bench_cfg_t::sync_every    f_sync a cada N chamadas (0 = só no fim)
+ * @var fs_bench_cfg_t::seed          Semente das posições aleatórias
+ * @var fs_bench_cfg_t::base_lba      Primeiro setor da região de rascunho
+ * @var fs_bench_cfg_t::n_sectors     Setores da região (obrigatório, != 0)
+ *
+ * @note O volume emulado (FAT, diretório e arquivo) é montado dentro de
+ *       [base_lba, base_lba + n_sectors) e nenhum setor fora dela é lido ou
+ *       gravado. No firmware, a região deve ser um arquivo de rascunho
+ *       pré-alocado (f_expand contíguo), nunca o cartão inteiro.
+ */
+typedef struct {
+    fs_bench_access_t access;
+    uint32_t file_bytes;
+    uint32_t buf_bytes;
+    uint32_t cluster_bytes;
+    bool preallocate;
+    uint32_t sync_every;
+    uint32_t seed;
+    uint32_t base_lba;
+    uint32_t n_sectors;
+} fs_bench_cfg_t;
+
+/**
+ * @struct fs_bench_result_t
+ * @brief Resultado de uma execução (tempos em ns do relógio fornecido)
+ *
+ * @var fs_bench_result_t::total_ns      Chamadas + f_sync/f_close final
+ * @var fs_bench_result_t::setup_ns      Preparação (f_expand e, para leitura ou
+ *                                       regravação, o arquivo), fora do total
+ * @var fs_bench_result_t::kb_per_s      Vazão em kB/s (MB/s * 1000)
+ * @var fs_bench_result_t::p50_ns        Mediana por chamada
+ * @var fs_bench_result_t::p99_ns        Percentil 99 por chamada
+ * @var fs_bench_result_t::max_ns        Pior travamento de uma chamada
+ * @var fs_bench_result_t::fat_writes    Setores de FAT gravados
+ * @var fs_bench_result_t::dir_writes    Setores de diretório gravados
+ * @var fs_bench_result_t::verified      Conteúdo conferido após a execução
+ */
+typedef struct {
+    uint32_t calls;
+    uint64_t bytes;
+    uint64_t total_ns;
+    uint64_t setup_ns;
+    uint32_t kb_per_s;
+    uint32_t mean_ns;
+    uint32_t p50_ns;
+    uint32_t p99_ns;
+    uint32_t max_ns;
+    uint32_t fat_writes;
+    uint32_t dir_writes;
+    bool verified;
+} fs_bench_result_t;
+
+/**
+ * @struct fs_bench_t
+ * @brief Contexto: dispositivo, relógio, buffers do chamador e o estado do
+ *        volume emulado (instância estática, sem malloc)
+ */
+typedef struct {
+    blockdev_t dev;
+    uint64_t (*now_ns)(void *ctx);
+    void *clock_ctx;
+    uint8_t *io;                  /**< Buffer da aplicação (>= buf_bytes) */
+    uint32_t io_size;
+    uint32_t *samples;            /**< Latências por chamada (para p50/p99) */
+    uint32_t max_samples;
+
+    /* Volume emulado, dentro de [region_lba, region_end) */
+    uint32_t region_lba;
+    uint32_t region_end;
+    uint32_t fat_lba;
+    uint32_t fat_sectors;
+    uint32_t dir_lba;
+    uint32_t file_lba;
+    uint32_t clust_sect;
+    uint32_t alloc_clusters;
+    uint32_t file_size;
+    uint32_t pattern_seed;
+
+    uint8_t win[512];             /**< Janela do volume (FAT/diretório) */
+    uint32_t win_lba;
+    bool win_dirty;
+    uint8_t fbuf[512];            /**< Buffer de setor do arquivo */
+    uint32_t fbuf_lba;
+    bool fbuf_dirty;
+
+    uint32_t fat_writes;
+    uint32_t dir_writes;
+    bool failed;
+} fs_bench_t;
+
+/* =============================================================================
+ * SEÇÃO 2: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Prepara o contexto
+ *
+ * @param dev         Dispositivo (copiado); só a região de cada
+ *                    configuração é sobrescrita
+ * @param now_ns      Relógio em ns (ex.: time_us_64() * 1000)
+ * @param io          Buffer de dados da aplicação
+ * @param io_size     Tamanho de `io` (limita buf_bytes)
+ * @param samples     Espaço para as latências (p50/p99 usam as primeiras
+ *                    max_samples chamadas; média e máximo usam todas)
+ * @return true se os parâmetros forem válidos
+ */
+bool fs_bench_init(fs_bench_t *b, const blockdev_t *dev, uint64_t (*now_ns)(void *ctx),
+                   void *clock_ctx, uint8_t *io, uint32_t io_size, uint32_t *samples,
+                   uint32_t max_samples);
+
+/**
+ * @brief Executa uma configuração
+ *
+ * @return false se a configuração for inválida (inclusive sem região ou com
+ *         região além do fim do dispositivo), a região for pequena demais
+ *         para o arquivo ou o dispositivo falhar (verified também fica false)
+ */
+bool fs_bench_run(fs_bench_t *b, const fs_bench_cfg_t *cfg, fs_bench_result_t *res);
+
+/** Nome curto do padrão de acesso ("seq_write", ...) */
+const char *fs_bench_access_name(fs_bench_access_t access);
+
+/** Cabeçalho das colunas de fs_bench_format_csv() (sem as colunas do `label`) */
+const char *fs_bench_csv_header(void);
+
+/**
+ * @brief Formata uma linha CSV
+ *
+ * @param label Colunas extras no início da linha (ex.: "25000000,cache"), já
+ *              separadas por vírgula; NULL ou "" para nenhuma
+ * @return Comprimento escrito (como snprintf)
+ */
+int fs_bench_format_csv(char *dst, size_t size, const char *label, const fs_bench_cfg_t *cfg,
+                        const fs_bench_result_t *res);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* FS_BENCH_H */
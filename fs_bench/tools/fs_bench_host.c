@@ -0,0 +1,230 @@
+/**
+ * =============================================================================
+ * @file    fs_bench_host.c
+ * @brief   (Host) Varredura do fs_bench sobre o blockdev_host, saída em CSV
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Varre clock SPI, cache (sd_cache ligado/desligado), padrão de
+ *          acesso, tamanho de buffer, tamanho de cluster e append/f_expand
+ *          sobre um disco em RAM com latência de cartão SD simulada. Os
+ *          tempos vêm do relógio virtual do blockdev_host, então o resultado
+ *          é determinístico e serve de referência para regressões.
+ *
+ *          O volume emulado fica numa região do disco com guardas antes e
+ *          depois (como o arquivo de rascunho no firmware); ao final, as
+ *          guardas são conferidas, assim como a recusa de execuções sem
+ *          região ou com região além do fim do disco.
+ *
+ *          Uso: fs_bench_host [-q] [-f kib] [-s n] [-o saida.csv]
+ *            -q  varredura reduzida (rápida)
+ *            -f  tamanho do arquivo em KiB (padrão: 1024)
+ *            -s  f_sync a cada n chamadas (padrão: 0, só no fim)
+ *            -o  grava o CSV no arquivo em vez da saída padrão
+ *          Retorno: 0 se todas as execuções forem verificadas.
+ * =============================================================================
+ */
+
+#include "bench_report.h"
+#include "blockdev_host.h"
+#include "fs_bench.h"
+#include "sd_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define DISK_SECTORS 32768u         /* 16 MiB */
+#define GUARD        32u            /* Setores intocáveis antes e depois da região */
+#define GUARD_BYTE   0xA5u
+#define IO_BYTES     65536u
+#define MAX_SAMPLES  65536u
+#define CACHE_SETS   16u
+#define CACHE_WAYS   4u
+
+static uint8_t disk[DISK_SECTORS * BLOCKDEV_SECTOR_SIZE];
+static uint8_t io[IO_BYTES];
+static uint32_t samples[MAX_SAMPLES];
+static sd_cache_line_t cache_lines[CACHE_SETS * CACHE_WAYS];
+static uint8_t cache_data[CACHE_SETS * CACHE_WAYS * BLOCKDEV_SECTOR_SIZE];
+
+static blockdev_host_t host;
+static sd_cache_t cache;
+static fs_bench_t bench;
+
+static uint64_t virtual_now(void *ctx) {
+    return blockdev_host_now_ns((const blockdev_host_t *)ctx);
+}
+
+static bool guards_intact(void) {
+    static const size_t guard_bytes = (size_t)GUARD * BLOCKDEV_SECTOR_SIZE;
+    const uint8_t *tail = disk + sizeof disk - guard_bytes;
+    for (size_t i = 0; i < guard_bytes; i++) {
+        if (disk[i] != GUARD_BYTE || tail[i] != GUARD_BYTE) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Sem região, ou com região além do fim do disco, nada pode ser gravado */
+static unsigned check_region_rejects(void) {
+    blockdev_t dev;
+    blockdev_host_init_ram(&host, disk, DISK_SECTORS);
+    blockdev_host_blockdev(&host, &dev);
+    fs_bench_init(&bench, &dev, virtual_now, &host, io, IO_BYTES, samples, MAX_SAMPLES);
+
+    static const uint32_t regions[][2] = {
+        { 0, 0 }, { GUARD, 0 }, { GUARD, DISK_SECTORS }, { DISK_SECTORS, 1 },
+        { 0xFFFFFFFFu, 0xFFFFFFFFu },
+    };
+    unsigned failures = 0;
+    for (size_t i = 0; i < sizeof regions / sizeof regions[0]; i++) {
+        const fs_bench_cfg_t cfg = {
+            .access = FS_BENCH_SEQ_WRITE, .file_bytes = 4096u, .buf_bytes = 512u,
+            .cluster_bytes = 4096u, .seed = 1u,
+            .base_lba = regions[i][0], .n_sectors = regions[i][1],
+        };
+        fs_bench_result_t res;
+        if (fs_bench_run(&bench, &cfg, &res) || host.stats.writes != 0) {
+            failures++;
+            fprintf(stderr, "FALHA: região %lu+%lu aceita\n", (unsigned long)regions[i][0],
+                    (unsigned long)regions[i][1]);
+        }
+    }
+    return failures;
+}
+
+int main(int argc, char **argv) {
+    bool quick = false;
+    uint32_t file_kib = 1024u;
+    uint32_t sync_every = 0;
+    FILE *out = stdout;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            quick = true;
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            file_kib = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            sync_every = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out = fopen(argv[++i], "w");
+            if (!out) {
+                perror(argv[i]);
+                return 2;
+            }
+        } else {
+            fprintf(stderr, "uso: %s [-q] [-f kib] [-s n] [-o saida.csv]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (file_kib == 0 || file_kib > DISK_SECTORS / 4u) {
+        fprintf(stderr, "-f: de 1 a %u KiB\n", DISK_SECTORS / 4u);
+        return 2;
+    }
+
+    static const uint32_t spi_full[] = { 12500000u, 25000000u };
+    static const uint32_t buf_full[] = { 100u, 512u, 2048u, 8192u, 32768u };
+    static const uint32_t clust_full[] = { 4096u, 32768u };
+    static const uint32_t spi_quick[] = { 25000000u };
+    static const uint32_t buf_quick[] = { 100u, 4096u };
+    static const uint32_t clust_quick[] = { 32768u };
+
+    const uint32_t *spi = quick ? spi_quick : spi_full;
+    const uint32_t *bufs = quick ? buf_quick : buf_full;
+    const uint32_t *clusts = quick ? clust_quick : clust_full;
+    const size_t n_spi = quick ? 1u : sizeof spi_full / sizeof spi_full[0];
+    const size_t n_buf = quick ? sizeof buf_quick / sizeof buf_quick[0]
+                               : sizeof buf_full / sizeof buf_full[0];
+    const size_t n_clust = quick ? 1u : sizeof clust_full / sizeof clust_full[0];
+
+    memset(disk, GUARD_BYTE, sizeof disk);
+    unsigned runs = 0, failures = check_region_rejects();
+
+    fprintf(out, "spi_hz,cache,%s\n", fs_bench_csv_header());
+
+    for (size_t si = 0; si < n_spi; si++) {
+        for (int cached = 0; cached <= 1; cached++) {
+            for (int access = FS_BENCH_SEQ_WRITE; access <= FS_BENCH_RAND_READ; access++) {
+                const bool writing = access == FS_BENCH_SEQ_WRITE || access == FS_BENCH_RAND_WRITE;
+                for (int prealloc = 0; prealloc <= (writing ? 1 : 0); prealloc++) {
+                    for (size_t ci = 0; ci < n_clust; ci++) {
+                        for (size_t bi = 0; bi < n_buf; bi++) {
+                            /* Disco e cache novos a cada execução */
+                            blockdev_t dev;
+                            blockdev_host_init_ram(&host, disk, DISK_SECTORS);
+                            blockdev_host_latency_t lat = BLOCKDEV_HOST_LATENCY_SD_SPI;
+                            lat.byte_ns = (uint32_t)(8000000000ull / spi[si]);
+                            blockdev_host_set_latency(&host, &lat);
+                            blockdev_host_blockdev(&host, &dev);
+                            if (cached) {
+                                const blockdev_t lower = dev;
+                                sd_cache_init(&cache, &lower, cache_lines, cache_data,
+                                              CACHE_SETS, CACHE_WAYS);
+                                sd_cache_blockdev(&cache, &dev);
+                            }
+                            fs_bench_init(&bench, &dev, virtual_now, &host, io, IO_BYTES,
+                                          samples, MAX_SAMPLES);
+
+                            const fs_bench_cfg_t cfg = {
+                                .access = (fs_bench_access_t)access,
+                                .file_bytes = file_kib * 1024u,
+                                .buf_bytes = bufs[bi],
+                                .cluster_bytes = clusts[ci],
+                                .preallocate = prealloc != 0,
+                                .sync_every = sync_every,
+                                .seed = 1u + (uint32_t)runs,
+                                .base_lba = GUARD,
+                                .n_sectors = DISK_SECTORS - 2u * GUARD,
+                            };
+                            fs_bench_result_t res;
+                            const bool ok = fs_bench_run(&bench, &cfg, &res);
+
+                            char label[32], line[256];
+                            snprintf(label, sizeof label, "%lu,%s", (unsigned long)spi[si],
+                                     cached ? "sd_cache" : "none");
+                            fs_bench_format_csv(line, sizeof line, label, &cfg, &res);
+                            fprintf(out, "%s\n", line);
+
+                            /* Relógio virtual: métricas deterministas para a linha de base */
+                            char metric[64];
+                            const int m = snprintf(metric, sizeof metric, "%lumhz_%s_%s_b%lu_c%luk%s",
+                                                   (unsigned long)(spi[si] / 1000000u),
+                                                   cached ? "cache" : "nocache",
+                                                   fs_bench_access_name(cfg.access),
+                                                   (unsigned long)cfg.buf_bytes,
+                                                   (unsigned long)(cfg.cluster_bytes / 1024u),
+                                                   cfg.preallocate ? "_expand" : "");
+                            snprintf(metric + m, sizeof metric - (size_t)m, "_mb_s");
+                            bench_report("fs_bench_host", metric, res.kb_per_s / 1000.0, "MB/s");
+                            snprintf(metric + m, sizeof metric - (size_t)m, "_p99_us");
+                            bench_report("fs_bench_host", metric, res.p99_ns / 1000.0, "us");
+
+                            runs++;
+                            if (!ok || !res.verified) {
+                                failures++;
+                                fprintf(stderr, "FALHA: %s\n", line);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (!guards_intact()) {
+        failures++;
+        fprintf(stderr, "FALHA: setores fora da região foram gravados\n");
+    }
+    fprintf(stderr, "%u execuções, %u falhas\n", runs, failures);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return failures ? 1 : 0;
+}
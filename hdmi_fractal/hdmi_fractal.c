@@ -0,0 +1,479 @@
+/**
+ * =============================================================================
+ * @file    hdmi_fractal.c
+ * @brief   Iteração em ponto fixo, fila de tiles progressiva e camada HDMI
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details FAIXA DO PONTO FIXO (Q4.28, ±8):
+ *          Enquanto |z| <= 2, x² - y² e 2xy ficam em [-4, 4]; somados a um c
+ *          com |Re c|, |Im c| < 4 o resultado cabe em int32_t. Os quadrados
+ *          são calculados em 64 bits e deslocados antes da soma, de modo que
+ *          o teste de escape também não transborda.
+ *
+ *          SINCRONIZAÇÃO:
+ *          No RP2040 o Cortex-M0+ não tem LDREX/STREX; os contadores da fila
+ *          e das estatísticas são protegidos por um spinlock de hardware. No
+ *          host são usados os builtins __atomic do GCC/Clang.
+ * =============================================================================
+ */
+
+#include "hdmi_fractal.h"
+
+#include <stddef.h>   /* Para size_t */
+#include <string.h>   /* Para memset */
+
+#if HDMI_FRACTAL_USE_MULTICORE
+#include "pico/multicore.h"
+#include "pico/stdlib.h"
+#else
+#include <pthread.h>
+#include <sched.h>    /* Para sched_yield */
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: FUNÇÕES AUXILIARES
+ * =============================================================================
+ */
+
+#define FB          HDMI_FRACTAL_FRAC_BITS
+#define FIX_ONE     ((int64_t)1 << FB)
+
+/** Número de passadas: COARSE, COARSE/2, ..., 1 */
+static uint32_t pass_count(void) {
+    uint32_t n = 1;
+    for (uint32_t s = HDMI_FRACTAL_COARSE; s > 1u; s >>= 1) {
+        n++;
+    }
+    return n;
+}
+
+static uint32_t atomic_add(fractal_t *f, volatile uint32_t *p, uint32_t v) {
+#if HDMI_FRACTAL_USE_MULTICORE
+    const uint32_t save = spin_lock_blocking(f->lock);
+    const uint32_t old = *p;
+    *p = old + v;
+    spin_unlock(f->lock, save);
+    return old;
+#else
+    (void)f;
+    return __atomic_fetch_add(p, v, __ATOMIC_ACQ_REL);
+#endif
+}
+
+/** Primeiro item da passada de `item` (done_items precisa chegar a ele) */
+static inline uint32_t pass_start(const fractal_t *f, uint32_t item) {
+    return (item / f->n_tiles) * f->n_tiles;
+}
+
+/**
+ * @brief Retira o próximo item da fila
+ *
+ * @details Com `open_only`, só retira se a passada do item já puder começar.
+ *          Teste e retirada são uma única operação (spinlock no firmware,
+ *          compare-and-swap no host): testar um valor lido antes e retirar
+ *          outro deixaria passar um item de uma passada ainda fechada.
+ *
+ * @return true e o item em *item; false com a fila vazia ou a passada fechada
+ */
+static bool claim_item(fractal_t *f, bool open_only, uint32_t *item) {
+#if HDMI_FRACTAL_USE_MULTICORE
+    const uint32_t save = spin_lock_blocking(f->lock);
+    const uint32_t cur = f->next_item;
+    const bool ok = cur < f->total_items && (!open_only || f->done_items >= pass_start(f, cur));
+    if (ok) {
+        f->next_item = cur + 1u;
+    }
+    spin_unlock(f->lock, save);
+    *item = cur;
+    return ok;
+#else
+    uint32_t cur = __atomic_load_n(&f->next_item, __ATOMIC_ACQUIRE);
+    do {
+        if (cur >= f->total_items ||
+            (open_only && __atomic_load_n(&f->done_items, __ATOMIC_ACQUIRE) < pass_start(f, cur))) {
+            return false;
+        }
+    } while (!__atomic_compare_exchange_n(&f->next_item, &cur, cur + 1u, true, __ATOMIC_ACQ_REL,
+                                          __ATOMIC_ACQUIRE));
+    *item = cur;
+    return true;
+#endif
+}
+
+static void stats_add(fractal_t *f, const fractal_stats_t *s) {
+#if HDMI_FRACTAL_USE_MULTICORE
+    const uint32_t save = spin_lock_blocking(f->lock);
+    f->stats.iterations += s->iterations;
+    f->stats.pixels += s->pixels;
+    f->stats.interior_skipped += s->interior_skipped;
+    f->stats.periodic_exits += s->periodic_exits;
+    spin_unlock(f->lock, save);
+#else
+    __atomic_fetch_add(&f->stats.iterations, s->iterations, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&f->stats.pixels, s->pixels, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&f->stats.interior_skipped, s->interior_skipped, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&f->stats.periodic_exits, s->periodic_exits, __ATOMIC_RELAXED);
+#endif
+}
+
+/* =============================================================================
+ * SEÇÃO 2: ITERAÇÃO
+ * =============================================================================
+ */
+
+/** true se c está no cardioide principal ou no bulbo de período 2 */
+static bool in_main_bulbs(fractal_fix_t cx, fractal_fix_t cy) {
+    /* Fora desta caixa nenhum dos dois testes é verdadeiro (e evita overflow) */
+    if (cx < -(fractal_fix_t)(FIX_ONE * 5 / 4) || cx > (fractal_fix_t)(FIX_ONE / 2) ||
+        cy < -(fractal_fix_t)FIX_ONE || cy > (fractal_fix_t)FIX_ONE) {
+        return false;
+    }
+    const int64_t y2 = ((int64_t)cy * cy) >> FB;
+
+    /* Cardioide: q (q + (x - 1/4)) <= y² / 4, com q = (x - 1/4)² + y² */
+    const int64_t xq = (int64_t)cx - FIX_ONE / 4;
+    const int64_t q = ((xq * xq) >> FB) + y2;
+    if (((q * (q + xq)) >> FB) <= (y2 >> 2)) {
+        return true;
+    }
+
+    /* Bulbo de período 2: (x + 1)² + y² <= 1/16 */
+    const int64_t x1 = (int64_t)cx + FIX_ONE;
+    return ((x1 * x1) >> FB) + y2 <= FIX_ONE / 16;
+}
+
+/**
+ * @brief Itera z = z² + c em Q4.28
+ *
+ * @return Iterações até o escape, ou max_iter para o interior
+ */
+static uint8_t mandel_point(fractal_fix_t cx, fractal_fix_t cy, uint8_t max_iter,
+                            fractal_stats_t *st) {
+    st->pixels++;
+    if (in_main_bulbs(cx, cy)) {
+        st->interior_skipped++;
+        return max_iter;
+    }
+
+    fractal_fix_t x = 0;
+    fractal_fix_t y = 0;
+    fractal_fix_t px = 0;      /* z salvo para a detecção de periodicidade */
+    fractal_fix_t py = 0;
+    uint32_t period = 8;       /* Intervalo de salvamento, dobra a cada salvamento */
+    uint32_t since = 0;
+
+    for (uint32_t n = 0; n < max_iter; n++) {
+        const int64_t x2 = ((int64_t)x * x) >> FB;
+        const int64_t y2 = ((int64_t)y * y) >> FB;
+        if (x2 + y2 > 4 * FIX_ONE) {
+            st->iterations += n;
+            return (uint8_t)n;
+        }
+        const int64_t xy2 = ((int64_t)x * y) >> (FB - 1);
+        y = (fractal_fix_t)(xy2 + cy);
+        x = (fractal_fix_t)(x2 - y2 + cx);
+
+        if (x == px && y == py) {
+            st->iterations += n + 1u;
+            st->periodic_exits++;
+            return max_iter;
+        }
+        if (++since == period) {
+            since = 0;
+            period <<= 1;
+            px = x;
+            py = y;
+        }
+    }
+    st->iterations += max_iter;
+    return max_iter;
+}
+
+/**
+ * @brief Processa um item (passada, tile) a partir do cursor
+ *
+ * @details Na passada de passo s só são calculados os pontos múltiplos de s
+ *          que não eram múltiplos de 2s; cada um preenche seu bloco s x s.
+ *          O cursor (ox, oy) é a posição dentro do tile do próximo ponto; ao
+ *          esgotar `*budget` pontos calculados a função para e o cursor
+ *          aponta onde retomar.
+ *
+ * @return true se o item terminou
+ */
+static bool render_item(fractal_t *f, uint32_t item, uint16_t *ox, uint16_t *oy,
+                        uint32_t *budget, fractal_stats_t *st) {
+    const uint32_t pass = item / f->n_tiles;
+    const uint32_t tile = item % f->n_tiles;
+    const uint32_t s = (uint32_t)HDMI_FRACTAL_COARSE >> pass;
+
+    const uint32_t tx0 = (tile % f->tiles_x) * HDMI_FRACTAL_TILE;
+    const uint32_t ty0 = (tile / f->tiles_x) * HDMI_FRACTAL_TILE;
+    uint32_t tx1 = tx0 + HDMI_FRACTAL_TILE;
+    uint32_t ty1 = ty0 + HDMI_FRACTAL_TILE;
+    if (tx1 > f->width) {
+        tx1 = f->width;
+    }
+    if (ty1 > f->height) {
+        ty1 = f->height;
+    }
+
+    for (uint32_t y = ty0 + *oy; y < ty1; y += s, *ox = 0) {
+        const fractal_fix_t cy = f->y0 + (fractal_fix_t)y * f->step;
+        const uint32_t bh = (y + s <= ty1) ? s : ty1 - y;
+        for (uint32_t x = tx0 + *ox; x < tx1; x += s) {
+            if (pass != 0 && ((x | y) & s) == 0) {
+                continue;  /* Calculado numa passada anterior */
+            }
+            if (*budget == 0) {
+                *ox = (uint16_t)(x - tx0);
+                *oy = (uint16_t)(y - ty0);
+                return false;
+            }
+            (*budget)--;
+            const uint8_t v = mandel_point(f->x0 + (fractal_fix_t)x * f->step, cy,
+                                           f->max_iter, st);
+            const uint32_t bw = (x + s <= tx1) ? s : tx1 - x;
+            uint8_t *dst = f->iters + (size_t)y * f->width + x;
+            for (uint32_t r = 0; r < bh; r++) {
+                memset(dst, v, bw);
+                dst += f->width;
+            }
+        }
+    }
+    return true;
+}
+
+/** Publica um item concluído: estatísticas e depois done_items */
+static void finish_item(fractal_t *f, const fractal_stats_t *st) {
+    stats_add(f, st);
+    __sync_synchronize();
+    atomic_add(f, &f->done_items, 1);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: API DO MOTOR
+ * =============================================================================
+ */
+
+bool fractal_init(fractal_t *f, uint8_t *iters, uint16_t width, uint16_t height,
+                  uint8_t max_iter) {
+    if (!f || !iters || width == 0 || height == 0 || max_iter < 2) {
+        return false;
+    }
+    memset(f, 0, sizeof *f);
+    f->iters = iters;
+    f->width = width;
+    f->height = height;
+    f->max_iter = max_iter;
+    f->tiles_x = (uint16_t)((width + HDMI_FRACTAL_TILE - 1) / HDMI_FRACTAL_TILE);
+    f->tiles_y = (uint16_t)((height + HDMI_FRACTAL_TILE - 1) / HDMI_FRACTAL_TILE);
+    f->n_tiles = (uint32_t)f->tiles_x * f->tiles_y;
+    f->total_items = f->n_tiles * pass_count();
+    f->next_item = f->total_items;  /* Fila vazia até fractal_begin() */
+    f->done_items = f->total_items;
+    memset(iters, max_iter, (size_t)width * height);
+#if HDMI_FRACTAL_USE_MULTICORE
+    f->lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+#endif
+    fractal_set_view(f, FRACTAL_FIX(-0.75), 0, (fractal_fix_t)(FIX_ONE * 3 / width));
+    return true;
+}
+
+void fractal_set_view(fractal_t *f, fractal_fix_t cx, fractal_fix_t cy, fractal_fix_t step) {
+    if (step < 1) {
+        step = 1;  /* Limite de resolução do Q4.28 */
+    }
+    f->step = step;
+    f->x0 = cx - (fractal_fix_t)(f->width / 2u) * step;
+    f->y0 = cy - (fractal_fix_t)(f->height / 2u) * step;
+}
+
+void fractal_zoom_in(fractal_t *f, uint16_t px, uint16_t py) {
+    const fractal_fix_t cx = f->x0 + (fractal_fix_t)px * f->step;
+    const fractal_fix_t cy = f->y0 + (fractal_fix_t)py * f->step;
+    fractal_set_view(f, cx, cy, f->step / 2);
+}
+
+void fractal_begin(fractal_t *f) {
+    memset(&f->stats, 0, sizeof f->stats);
+    f->part_active = false;
+    f->done_items = 0;
+    __sync_synchronize();
+    f->next_item = 0;
+#if HDMI_FRACTAL_USE_MULTICORE
+    __sev();  /* Acorda o worker do core1 */
+#endif
+}
+
+uint32_t fractal_work(fractal_t *f, uint32_t max_items) {
+    uint32_t processed = 0;
+
+    while (processed < max_items) {
+        /* Quem chama com max_items pequeno (core0 entre linhas HDMI) só
+         * retira itens de passadas abertas e nunca fica preso na barreira
+         * esperando o outro core */
+        const bool bounded = max_items != UINT32_MAX;
+        uint32_t item;
+        if (!claim_item(f, bounded, &item)) {
+            break;
+        }
+
+        /* Barreira entre passadas (só o worker sem limite chega a esperar) */
+        const uint32_t needed = pass_start(f, item);
+        while (f->done_items < needed) {
+#if HDMI_FRACTAL_USE_MULTICORE
+            tight_loop_contents();
+#else
+            sched_yield();
+#endif
+        }
+
+        fractal_stats_t st = { 0, 0, 0, 0 };
+        uint16_t ox = 0;
+        uint16_t oy = 0;
+        uint32_t budget = UINT32_MAX;
+        render_item(f, item, &ox, &oy, &budget, &st);
+        finish_item(f, &st);
+        processed++;
+    }
+    return processed;
+}
+
+uint32_t fractal_work_budget(fractal_t *f, uint32_t max_points) {
+    uint32_t budget = max_points;
+
+    while (budget > 0) {
+        if (!f->part_active) {
+            /* Só passadas abertas: o item nunca espera na barreira */
+            if (!claim_item(f, true, &f->part_item)) {
+                break;
+            }
+            f->part_x = 0;
+            f->part_y = 0;
+            memset(&f->part_stats, 0, sizeof f->part_stats);
+            f->part_active = true;
+        }
+        if (!render_item(f, f->part_item, &f->part_x, &f->part_y, &budget, &f->part_stats)) {
+            break;
+        }
+        finish_item(f, &f->part_stats);
+        f->part_active = false;
+    }
+    return max_points - budget;
+}
+
+bool fractal_done(const fractal_t *f) {
+    return f->done_items >= f->total_items;
+}
+
+void fractal_get_stats(const fractal_t *f, fractal_stats_t *out) {
+    *out = f->stats;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: WORKERS (CORE1 NO RP2040, THREADS NO HOST)
+ * =============================================================================
+ */
+
+#if HDMI_FRACTAL_USE_MULTICORE
+
+/** Instância atendida pelo core1 (multicore_launch_core1 não recebe contexto) */
+static fractal_t *core1_fractal = NULL;
+
+static void fractal_core1_entry(void) {
+    for (;;) {
+        if (fractal_work(core1_fractal, UINT32_MAX) == 0) {
+            __wfe();
+        }
+    }
+}
+
+void fractal_launch_core1(fractal_t *f) {
+    core1_fractal = f;
+    multicore_launch_core1(fractal_core1_entry);
+}
+
+#else
+
+/** Número máximo de threads em fractal_render_threads() */
+#define FRACTAL_MAX_THREADS 32u
+
+static void *fractal_thread_main(void *arg) {
+    fractal_work((fractal_t *)arg, UINT32_MAX);
+    return NULL;
+}
+
+void fractal_render_threads(fractal_t *f, unsigned n_threads) {
+    pthread_t th[FRACTAL_MAX_THREADS];
+    unsigned started = 0;
+
+    if (n_threads > FRACTAL_MAX_THREADS) {
+        n_threads = FRACTAL_MAX_THREADS;
+    }
+    fractal_begin(f);
+    /* A thread chamadora também trabalha */
+    for (unsigned i = 1; i < n_threads; i++) {
+        if (pthread_create(&th[started], NULL, fractal_thread_main, f) == 0) {
+            started++;
+        }
+    }
+    fractal_work(f, UINT32_MAX);
+    for (unsigned i = 0; i < started; i++) {
+        pthread_join(th[i], NULL);
+    }
+}
+
+#endif /* HDMI_FRACTAL_USE_MULTICORE */
+
+/* =============================================================================
+ * SEÇÃO 5: PALETA E CAMADA HDMI
+ * =============================================================================
+ */
+
+/** Cor de um círculo de matizes com 192 posições (6 segmentos de 32) */
+static hdmi_pixel_t hue_color(uint32_t h) {
+    const uint32_t seg = h / 32u;
+    const uint32_t up = (h % 32u) * 8u + 7u;   /* 7 .. 255 */
+    const uint32_t down = 255u - up;
+    switch (seg) {
+    case 0:  return HDMI_RGB565(255u, up, 0u);
+    case 1:  return HDMI_RGB565(down, 255u, 0u);
+    case 2:  return HDMI_RGB565(0u, 255u, up);
+    case 3:  return HDMI_RGB565(0u, down, 255u);
+    case 4:  return HDMI_RGB565(up, 0u, 255u);
+    default: return HDMI_RGB565(255u, 0u, down);
+    }
+}
+
+void fractal_palette_init(hdmi_pixel_t *palette, uint8_t max_iter) {
+    for (uint32_t i = 0; i < max_iter; i++) {
+        palette[i] = hue_color((i * 7u + 128u) % 192u);
+    }
+    palette[max_iter] = HDMI_RGB565(0, 0, 0);
+}
+
+void hdmi_layer_fractal(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width) {
+    const hdmi_fractal_layer_t *fl = (const hdmi_fractal_layer_t *)ctx;
+    const fractal_t *f = fl->f;
+    const uint32_t screen_h = fl->height ? fl->height : 480u;
+
+    uint32_t sy = (uint32_t)y * f->height / screen_h;
+    if (sy >= f->height) {
+        sy = f->height - 1u;
+    }
+    const uint8_t *row = f->iters + (size_t)sy * f->width;
+
+    /* Ampliação horizontal em ponto fixo 16.16 */
+    const uint32_t dx = ((uint32_t)f->width << 16) / width;
+    uint32_t acc = 0;
+    for (uint32_t x = 0; x < width; x++) {
+        line[x] = fl->palette[row[acc >> 16]];
+        acc += dx;
+    }
+}
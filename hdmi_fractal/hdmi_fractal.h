@@ -0,0 +1,260 @@
+/**
+ * =============================================================================
+ * @file    hdmi_fractal.h
+ * @brief   Mandelbrot em ponto fixo, progressivo e dividido entre os dois cores
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Motor para o modo PATTERN_FRACTAL da demo HDMI. O cálculo não usa
+ *          FPU: as coordenadas são Q4.28 em int32_t e os produtos usam 64 bits.
+ *
+ *          BUFFER DE ITERAÇÕES:
+ *          O resultado é um buffer uint8_t de width x height (ex.: 240 x 160
+ *          = 37,5 KiB) com o número de iterações de cada ponto; max_iter
+ *          marca o interior. hdmi_layer_fractal() amplia esse buffer para a
+ *          linha HDMI usando uma paleta RGB565.
+ *
+ *          RENDERIZAÇÃO PROGRESSIVA (coarse-to-fine):
+ *          ┌─────────┬───────────────────────────────────────────────────────┐
+ *          │ Passada │ Pontos calculados             │ Bloco preenchido      │
+ *          ├─────────┼───────────────────────────────┼───────────────────────┤
+ *          │ 0       │ x, y múltiplos de 8           │ 8 x 8                 │
+ *          │ 1       │ múltiplos de 4 (novos)        │ 4 x 4                 │
+ *          │ 2       │ múltiplos de 2 (novos)        │ 2 x 2                 │
+ *          │ 3       │ todos os restantes            │ 1 x 1                 │
+ *          └─────────┴───────────────────────────────┴───────────────────────┘
+ *          A passada 0 custa 1/64 do quadro e já cobre a tela inteira; cada
+ *          passada seguinte só calcula pontos novos.
+ *
+ *          FILA DE TRABALHO:
+ *          Cada item é (passada, tile de 32x32). Os workers (core0 e core1 no
+ *          RP2040, threads no host) retiram itens de um contador atômico. Um
+ *          item da passada p só começa quando todos os da passada p - 1
+ *          terminaram, para que um bloco grosso nunca sobrescreva pontos finos.
+ *
+ *          INTERIOR:
+ *          Pontos no cardioide principal e no bulbo de período 2 são
+ *          classificados sem iterar; nos demais, a detecção de periodicidade
+ *          (z repetido exatamente, o que é confiável em ponto fixo) encerra
+ *          a iteração cedo.
+ * =============================================================================
+ */
+
+#ifndef HDMI_FRACTAL_H
+#define HDMI_FRACTAL_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hdmi_scanline.h"
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/sync.h"
+#define HDMI_FRACTAL_USE_MULTICORE 1
+#else
+#define HDMI_FRACTAL_USE_MULTICORE 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO E PONTO FIXO
+ * =============================================================================
+ */
+
+/** Lado do tile (múltiplo de HDMI_FRACTAL_COARSE) */
+#ifndef HDMI_FRACTAL_TILE
+#define HDMI_FRACTAL_TILE 32
+#endif
+
+/** Passo da primeira passada (potência de 2) */
+#ifndef HDMI_FRACTAL_COARSE
+#define HDMI_FRACTAL_COARSE 8
+#endif
+
+/** Bits fracionários do formato Q4.28 */
+#define HDMI_FRACTAL_FRAC_BITS 28
+
+/** Coordenada em ponto fixo Q4.28 (faixa ±8) */
+typedef int32_t fractal_fix_t;
+
+/** Converte uma constante real em Q4.28 (avaliado em tempo de compilação) */
+#define FRACTAL_FIX(v) ((fractal_fix_t)((v) * (double)(1L << HDMI_FRACTAL_FRAC_BITS)))
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct fractal_stats_t
+ * @brief Contadores acumulados desde fractal_begin()
+ *
+ * @var fractal_stats_t::iterations Iterações de z executadas
+ * @var fractal_stats_t::pixels     Pontos calculados
+ * @var fractal_stats_t::interior_skipped Pontos do cardioide/bulbo (0 iterações)
+ * @var fractal_stats_t::periodic_exits Pontos encerrados pela periodicidade
+ */
+typedef struct {
+    uint64_t iterations;
+    uint32_t pixels;
+    uint32_t interior_skipped;
+    uint32_t periodic_exits;
+} fractal_stats_t;
+
+/**
+ * @struct fractal_t
+ * @brief Estado do motor (instância estática, buffer fornecido pelo usuário)
+ */
+typedef struct {
+    uint8_t *iters;              /**< width * height iterações */
+    uint16_t width;
+    uint16_t height;
+    uint8_t max_iter;            /**< 2 .. 255; valor gravado no interior */
+
+    fractal_fix_t x0;            /**< Coordenada real da coluna 0 */
+    fractal_fix_t y0;            /**< Coordenada imaginária da linha 0 */
+    fractal_fix_t step;          /**< Distância entre pixels */
+
+    uint16_t tiles_x;
+    uint16_t tiles_y;
+    uint32_t n_tiles;
+    uint32_t total_items;        /**< n_tiles * número de passadas */
+    volatile uint32_t next_item; /**< Próximo item a retirar da fila */
+    volatile uint32_t done_items;/**< Itens concluídos */
+
+    fractal_stats_t stats;
+
+    /* Item em curso de fractal_work_budget() (um único chamador) */
+    uint32_t part_item;
+    uint16_t part_x;             /**< Próximo ponto, relativo ao tile */
+    uint16_t part_y;
+    bool part_active;
+    fractal_stats_t part_stats;
+
+#if HDMI_FRACTAL_USE_MULTICORE
+    spin_lock_t *lock;
+#endif
+} fractal_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API DO MOTOR
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o motor
+ *
+ * @param f        Instância
+ * @param iters    Buffer de width * height bytes
+ * @param width    Largura do buffer de iterações
+ * @param height   Altura do buffer de iterações
+ * @param max_iter Limite de iterações (2 .. 255)
+ * @return true se os parâmetros forem válidos
+ */
+bool fractal_init(fractal_t *f, uint8_t *iters, uint16_t width, uint16_t height,
+                  uint8_t max_iter);
+
+/**
+ * @brief Define a vista pelo centro e pela distância entre pixels
+ *
+ * @details Exemplo (conjunto inteiro em 240 colunas):
+ *          fractal_set_view(&f, FRACTAL_FIX(-0.75), 0, FRACTAL_FIX(3.0 / 240));
+ */
+void fractal_set_view(fractal_t *f, fractal_fix_t cx, fractal_fix_t cy, fractal_fix_t step);
+
+/** Centraliza no pixel (px, py) e aproxima 2x */
+void fractal_zoom_in(fractal_t *f, uint16_t px, uint16_t py);
+
+/**
+ * @brief Reinicia a fila de trabalho para a vista atual
+ *
+ * @details Deve ser chamada com os workers ociosos (fractal_done() verdadeiro
+ *          ou fila ainda não iniciada).
+ */
+void fractal_begin(fractal_t *f);
+
+/**
+ * @brief Processa até `max_items` itens da fila
+ *
+ * @details Pode ser chamada de qualquer core/thread ao mesmo tempo. Com
+ *          max_items != UINT32_MAX a função retorna em vez de esperar a
+ *          barreira entre passadas quando o próximo item ainda não pode começar.
+ *          Um item é um tile inteiro (até 32 x 32 pontos, cada um com até
+ *          max_iter iterações): longo demais para caber entre duas linhas
+ *          HDMI; para isso use fractal_work_budget().
+ *
+ * @return Itens processados (0 = fila vazia ou passada anterior em curso)
+ */
+uint32_t fractal_work(fractal_t *f, uint32_t max_items);
+
+/**
+ * @brief Calcula até `max_points` pontos e retoma o mesmo item na próxima chamada
+ *
+ * @details Para intercalar com hdmi_scanline_service() no core0: o custo de
+ *          uma chamada é limitado por max_points * max_iter iterações. Só
+ *          retira itens de passadas abertas, portanto nunca espera a
+ *          barreira. Um único core/thread pode usá-la por instância (o item
+ *          em curso fica em fractal_t); os demais workers usam fractal_work().
+ *
+ * @return Pontos calculados (0 = nada a fazer agora)
+ */
+uint32_t fractal_work_budget(fractal_t *f, uint32_t max_points);
+
+/** true quando todas as passadas terminaram */
+bool fractal_done(const fractal_t *f);
+
+/** Copia os contadores */
+void fractal_get_stats(const fractal_t *f, fractal_stats_t *out);
+
+#if HDMI_FRACTAL_USE_MULTICORE
+/**
+ * @brief Lança no core1 um worker permanente da instância
+ *
+ * @details O core1 dorme em WFE enquanto a fila está vazia; fractal_begin()
+ *          o acorda com SEV.
+ */
+void fractal_launch_core1(fractal_t *f);
+#else
+/**
+ * @brief (Host) Renderiza o quadro inteiro com `n_threads` threads POSIX
+ */
+void fractal_render_threads(fractal_t *f, unsigned n_threads);
+#endif
+
+/* =============================================================================
+ * SEÇÃO 4: CAMADA HDMI
+ * =============================================================================
+ */
+
+/**
+ * @struct hdmi_fractal_layer_t
+ * @brief Contexto de hdmi_layer_fractal()
+ *
+ * @var hdmi_fractal_layer_t::f       Motor cujo buffer será exibido
+ * @var hdmi_fractal_layer_t::palette max_iter + 1 cores (índice max_iter = interior)
+ * @var hdmi_fractal_layer_t::height  Altura da tela (ex.: HDMI_HEIGHT)
+ */
+typedef struct {
+    const fractal_t *f;
+    const hdmi_pixel_t *palette;
+    uint16_t height;
+} hdmi_fractal_layer_t;
+
+/** Preenche uma paleta de max_iter + 1 cores (gradiente cíclico, interior preto) */
+void fractal_palette_init(hdmi_pixel_t *palette, uint8_t max_iter);
+
+/** Amplia o buffer de iterações para a linha y (ctx = hdmi_fractal_layer_t *) */
+void hdmi_layer_fractal(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HDMI_FRACTAL_H */
@@ -0,0 +1,192 @@
+/**
+ * =============================================================================
+ * @file    hdmi_layers.c
+ * @brief   Implementação das camadas de padrão, tiles e texto
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details As camadas escrevem faixas contíguas (fill_run / memcpy) em vez
+ *          de calcular a cor pixel a pixel: uma linha de barras de cor são
+ *          8 preenchimentos, uma linha de tiles são width/8 cópias de 8
+ *          pixels.
+ * =============================================================================
+ */
+
+#include "hdmi_layers.h"
+
+#include <stddef.h>   /* Para size_t */
+#include <string.h>   /* Para memcpy */
+
+/* =============================================================================
+ * SEÇÃO 1: FUNÇÕES AUXILIARES
+ * =============================================================================
+ */
+
+/** Preenche line[x0 .. x1) com uma cor */
+static inline void fill_run(hdmi_pixel_t *line, uint32_t x0, uint32_t x1, hdmi_pixel_t color) {
+    for (uint32_t x = x0; x < x1; x++) {
+        line[x] = color;
+    }
+}
+
+/**
+ * @brief Desenha `count` faixas de larguras proporcionais a `weights`
+ *
+ * @details As bordas são calculadas em ponto fixo (x = soma * width / total),
+ *          de modo que a soma das faixas é sempre exatamente a largura.
+ */
+static void draw_bands(hdmi_pixel_t *line, uint16_t width, const hdmi_pixel_t *colors,
+                       const uint8_t *weights, unsigned count) {
+    uint32_t total = 0;
+    for (unsigned i = 0; i < count; i++) {
+        total += weights[i];
+    }
+    uint32_t acc = 0;
+    uint32_t x0 = 0;
+    for (unsigned i = 0; i < count; i++) {
+        acc += weights[i];
+        const uint32_t x1 = acc * width / total;
+        fill_run(line, x0, x1, colors[i]);
+        x0 = x1;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: PADRÕES DE TESTE
+ * =============================================================================
+ */
+
+void hdmi_layer_color_bars(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width) {
+    static const hdmi_pixel_t colors[8] = {
+        HDMI_RGB565(255, 255, 255), HDMI_RGB565(255, 255, 0),
+        HDMI_RGB565(0, 255, 255),   HDMI_RGB565(0, 255, 0),
+        HDMI_RGB565(255, 0, 255),   HDMI_RGB565(255, 0, 0),
+        HDMI_RGB565(0, 0, 255),     HDMI_RGB565(0, 0, 0),
+    };
+    static const uint8_t weights[8] = { 1, 1, 1, 1, 1, 1, 1, 1 };
+    (void)ctx;
+    (void)y;
+    draw_bands(line, width, colors, weights, 8);
+}
+
+void hdmi_layer_smpte(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width) {
+    /* Barras 75% (faixa superior, 2/3 da altura) */
+    static const hdmi_pixel_t top[7] = {
+        HDMI_RGB565(191, 191, 191), HDMI_RGB565(191, 191, 0),
+        HDMI_RGB565(0, 191, 191),   HDMI_RGB565(0, 191, 0),
+        HDMI_RGB565(191, 0, 191),   HDMI_RGB565(191, 0, 0),
+        HDMI_RGB565(0, 0, 191),
+    };
+    static const uint8_t top_w[7] = { 1, 1, 1, 1, 1, 1, 1 };
+
+    /* Castelação (faixa do meio, 1/12 da altura): barras invertidas */
+    static const hdmi_pixel_t mid[7] = {
+        HDMI_RGB565(0, 0, 191),     HDMI_RGB565(19, 19, 19),
+        HDMI_RGB565(191, 0, 191),   HDMI_RGB565(19, 19, 19),
+        HDMI_RGB565(0, 191, 191),   HDMI_RGB565(19, 19, 19),
+        HDMI_RGB565(191, 191, 191),
+    };
+
+    /* Faixa inferior: -I, branco, +Q, preto, PLUGE (-4%, 0%, +4%), preto */
+    static const hdmi_pixel_t bottom[8] = {
+        HDMI_RGB565(0, 33, 76),     HDMI_RGB565(255, 255, 255),
+        HDMI_RGB565(50, 0, 106),    HDMI_RGB565(19, 19, 19),
+        HDMI_RGB565(9, 9, 9),       HDMI_RGB565(19, 19, 19),
+        HDMI_RGB565(29, 29, 29),    HDMI_RGB565(19, 19, 19),
+    };
+    /* Larguras em 1/28 da tela: -I, branco, +Q e preto com 5; PLUGE com 4 */
+    static const uint8_t bottom_w[8] = { 5, 5, 5, 5, 1, 1, 2, 4 };
+
+    /* ctx opcional: altura da tela (uint16_t *); padrão HDMI_HEIGHT = 480 */
+    const uint32_t height = ctx ? *(const uint16_t *)ctx : 480u;
+    if (y < height * 2u / 3u) {
+        draw_bands(line, width, top, top_w, 7);
+    } else if (y < height * 3u / 4u) {
+        draw_bands(line, width, mid, top_w, 7);
+    } else {
+        draw_bands(line, width, bottom, bottom_w, 8);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: MAPA DE TILES
+ * =============================================================================
+ */
+
+void hdmi_layer_tilemap(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width) {
+    const hdmi_tilemap_t *tm = (const hdmi_tilemap_t *)ctx;
+    const uint32_t map_w = (uint32_t)tm->cols * 8u;
+    const uint32_t map_h = (uint32_t)tm->rows * 8u;
+    const uint32_t ty = ((uint32_t)y + tm->scroll_y) % map_h;
+    const uint8_t *map_row = tm->map + (size_t)(ty >> 3) * tm->cols;
+    const uint32_t py = ty & 7u;
+
+    uint32_t tx = tm->scroll_x % map_w;
+    uint32_t x = 0;
+    while (x < width) {
+        /* Copia o pedaço do tile até a borda do tile ou da tela */
+        const uint32_t px = tx & 7u;
+        uint32_t n = 8u - px;
+        if (n > width - x) {
+            n = width - x;
+        }
+        const hdmi_pixel_t *src = tm->tiles + (size_t)map_row[tx >> 3] * 64u + py * 8u + px;
+        memcpy(line + x, src, n * sizeof *line);
+        x += n;
+        tx += n;
+        if (tx >= map_w) {
+            tx -= map_w;
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: CAMADA DE TEXTO
+ * =============================================================================
+ */
+
+void hdmi_layer_text(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width) {
+    const hdmi_text_layer_t *tl = (const hdmi_text_layer_t *)ctx;
+    const uint32_t scale = tl->scale ? tl->scale : 1u;
+    const uint32_t cell = 8u * scale;
+
+    if (y < tl->y0 || y >= tl->y0 + tl->rows * cell) {
+        return;  /* Linha fora da caixa de texto: nada a sobrepor */
+    }
+
+    const uint32_t gy = (uint32_t)(y - tl->y0) / scale;
+    const char *text_row = tl->text + (size_t)(gy >> 3) * tl->cols;
+    const uint8_t bit = (uint8_t)(1u << (gy & 7u));
+
+    for (uint32_t col = 0; col < tl->cols; col++) {
+        const uint32_t cx = tl->x0 + col * cell;
+        if (cx >= width) {
+            break;
+        }
+        const unsigned code = (unsigned char)text_row[col];
+        const uint8_t *glyph = (code >= tl->first_char && code - tl->first_char < tl->n_chars)
+                                   ? tl->font + (size_t)(code - tl->first_char) * 8u
+                                   : NULL;
+
+        for (uint32_t gx = 0; gx < 8u; gx++) {
+            const bool on = glyph && (glyph[gx] & bit);
+            if (!on && !tl->opaque) {
+                continue;
+            }
+            uint32_t x0 = cx + gx * scale;
+            uint32_t x1 = x0 + scale;
+            if (x0 >= width) {
+                break;
+            }
+            if (x1 > width) {
+                x1 = width;
+            }
+            fill_run(line, x0, x1, on ? tl->fg : tl->bg);
+        }
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * =============================================================================
+ * @file    hdmi_layers.h
+ * @brief   Camadas prontas para o renderizador por linha (padrões, tiles, texto)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada camada é um hdmi_line_fn_t: recebe o número da linha e
+ *          escreve apenas aquela linha. Nada aqui conhece o quadro inteiro.
+ *
+ *          ┌──────────────────────────┬────────────────────────────────────┐
+ *          │ Camada                   │ Uso                                │
+ *          ├──────────────────────────┼────────────────────────────────────┤
+ *          │ hdmi_layer_color_bars    │ equivalente a hdmi_draw_color_bars │
+ *          │ hdmi_layer_smpte         │ equivalente a hdmi_draw_smpte      │
+ *          │ hdmi_layer_tilemap       │ fundo com tiles 8x8 e scroll       │
+ *          │ hdmi_layer_text          │ texto 8x8 (fonte do ssd1306_font.h)│
+ *          └──────────────────────────┴────────────────────────────────────┘
+ * =============================================================================
+ */
+
+#ifndef HDMI_LAYERS_H
+#define HDMI_LAYERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "hdmi_scanline.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: PADRÕES DE TESTE
+ * =============================================================================
+ */
+
+/** Oito barras verticais 100%: branco, amarelo, ciano, verde, magenta, vermelho, azul, preto (ctx ignorado) */
+void hdmi_layer_color_bars(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+/**
+ * @brief Barras SMPTE (75%), faixa de castelação e faixa inferior -I / branco / +Q / PLUGE
+ *
+ * @param ctx Ponteiro opcional para a altura da tela (uint16_t); NULL = 480
+ */
+void hdmi_layer_smpte(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+/* =============================================================================
+ * SEÇÃO 2: MAPA DE TILES
+ * =============================================================================
+ */
+
+/**
+ * @struct hdmi_tilemap_t
+ * @brief Contexto de hdmi_layer_tilemap()
+ *
+ * @var hdmi_tilemap_t::map      cols * rows índices de tile (linha a linha)
+ * @var hdmi_tilemap_t::tiles    Tiles 8x8 RGB565, 64 pixels cada, linha a linha
+ * @var hdmi_tilemap_t::cols     Colunas do mapa (o mapa se repete na horizontal)
+ * @var hdmi_tilemap_t::rows     Linhas do mapa (o mapa se repete na vertical)
+ * @var hdmi_tilemap_t::scroll_x Deslocamento horizontal em pixels
+ * @var hdmi_tilemap_t::scroll_y Deslocamento vertical em pixels
+ */
+typedef struct {
+    const uint8_t *map;
+    const hdmi_pixel_t *tiles;
+    uint16_t cols;
+    uint16_t rows;
+    uint16_t scroll_x;
+    uint16_t scroll_y;
+} hdmi_tilemap_t;
+
+/** Desenha a linha y do mapa de tiles (ctx = hdmi_tilemap_t *) */
+void hdmi_layer_tilemap(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+/* =============================================================================
+ * SEÇÃO 3: CAMADA DE TEXTO
+ * =============================================================================
+ */
+
+/**
+ * @struct hdmi_text_layer_t
+ * @brief Contexto de hdmi_layer_text()
+ *
+ * @details A fonte usa o mesmo formato de `ssd1306_font.h`: 8 bytes por
+ *          glifo, um byte por coluna, bit 0 no topo. Assim o texto do OLED
+ *          e o da tela HDMI compartilham a mesma tabela em flash.
+ *
+ * @var hdmi_text_layer_t::text       cols * rows caracteres (sem '\0' por linha)
+ * @var hdmi_text_layer_t::font       Glifos 8x8 column-major
+ * @var hdmi_text_layer_t::first_char Código do primeiro glifo (32 no ssd1306_font.h)
+ * @var hdmi_text_layer_t::n_chars    Número de glifos na fonte
+ * @var hdmi_text_layer_t::x0         Coluna do canto superior esquerdo
+ * @var hdmi_text_layer_t::y0         Linha do canto superior esquerdo
+ * @var hdmi_text_layer_t::scale      Ampliação inteira (1 = 8x8 pixels)
+ * @var hdmi_text_layer_t::opaque     true pinta `bg` atrás dos glifos
+ */
+typedef struct {
+    const char *text;
+    uint16_t cols;
+    uint16_t rows;
+    const uint8_t *font;
+    uint8_t first_char;
+    uint8_t n_chars;
+    uint16_t x0;
+    uint16_t y0;
+    uint8_t scale;
+    bool opaque;
+    hdmi_pixel_t fg;
+    hdmi_pixel_t bg;
+} hdmi_text_layer_t;
+
+/** Sobrepõe a linha y do texto (ctx = hdmi_text_layer_t *) */
+void hdmi_layer_text(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HDMI_LAYERS_H */
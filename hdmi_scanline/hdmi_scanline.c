@@ -0,0 +1,341 @@
+/**
+ * =============================================================================
+ * @file    hdmi_scanline.c
+ * @brief   Anel de linhas, composição por camadas e alimentação por DMA
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details PROTOCOLO PRODUTOR/CONSUMIDOR (contadores de linha módulo line_mod):
+ *
+ *          ┌─────────────────────────────────────────────────────────────┐
+ *          │ send_n      linha que o DMA está enviando agora             │
+ *          │ send_n + 1  linha já programada no outro canal (armada)     │
+ *          │ fill_n      próxima linha que o produtor vai renderizar     │
+ *          │                                                             │
+ *          │ Produtor: renderiza enquanto fill_n - send_n < ring_len;    │
+ *          │           se fill_n - send_n < 0, pula para send_n.         │
+ *          │ Consumidor (IRQ): send_n++, arma send_n + 1 se pronta,      │
+ *          │           senão arma a linha preta (underrun).              │
+ *          └─────────────────────────────────────────────────────────────┘
+ *
+ *          Com ring_len >= 3 o slot escrito pelo produtor nunca coincide
+ *          com os dois slots que o DMA pode estar lendo.
+ *
+ *          As diferenças são tomadas com sinal, módulo line_mod: a volta do
+ *          contador (a cada ~2^30 linhas, ~10 h a 480 linhas x 60 Hz)
+ *          não interrompe o produtor nem desloca a fase do quadro.
+ * =============================================================================
+ */
+
+#include "hdmi_scanline.h"
+
+#include <stddef.h>   /* Para NULL, size_t */
+#include <string.h>   /* Para memset */
+
+#if HDMI_SCANLINE_USE_DMA
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#else
+#include <stdio.h>    /* Para fopen, fwrite */
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: FUNÇÕES AUXILIARES
+ * =============================================================================
+ */
+
+static inline hdmi_pixel_t *slot_ptr(const hdmi_scanline_t *r, uint32_t n) {
+    return r->ring + (size_t)(n % r->ring_len) * r->width;
+}
+
+/** n + k módulo line_mod (k < line_mod) */
+static inline uint32_t line_add(const hdmi_scanline_t *r, uint32_t n, uint32_t k) {
+    n += k;
+    return (n >= r->line_mod) ? n - r->line_mod : n;
+}
+
+/** a - b com sinal, módulo line_mod, em (-line_mod/2, line_mod/2] */
+static inline int32_t line_diff(const hdmi_scanline_t *r, uint32_t a, uint32_t b) {
+    int32_t d = (int32_t)(a - b);   /* a, b < 2^30: sem estouro */
+    const int32_t half = (int32_t)(r->line_mod / 2u);
+    if (d > half) {
+        d -= (int32_t)r->line_mod;
+    } else if (d <= -half) {
+        d += (int32_t)r->line_mod;
+    }
+    return d;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: COMPOSIÇÃO E ANEL
+ * =============================================================================
+ */
+
+bool hdmi_scanline_init(hdmi_scanline_t *r, hdmi_pixel_t *ring, uint8_t ring_len,
+                        uint16_t width, uint16_t height) {
+    if (!r || !ring || ring_len < 3 || ring_len > HDMI_SCANLINE_MAX_RING ||
+        width == 0 || (width & 1u) || height == 0) {
+        return false;
+    }
+    memset(r, 0, sizeof *r);
+    r->ring = ring;
+    r->ring_len = ring_len;
+    r->width = width;
+    r->height = height;
+    /* Maior múltiplo de height * ring_len até 2^30: a volta preserva y e slot */
+    const uint32_t period = (uint32_t)height * ring_len;
+    r->line_mod = ((1u << 30) / period) * period;
+    r->ready_valid = 0;   /* Nenhuma linha pronta */
+    r->stats.min_lead = ring_len;
+    return true;
+}
+
+bool hdmi_scanline_add_layer(hdmi_scanline_t *r, hdmi_line_fn_t render, void *ctx) {
+    if (!render || r->n_layers >= HDMI_SCANLINE_MAX_LAYERS) {
+        return false;
+    }
+    r->layers[r->n_layers].render = render;
+    r->layers[r->n_layers].ctx = ctx;
+    r->n_layers++;
+    return true;
+}
+
+void hdmi_scanline_clear_layers(hdmi_scanline_t *r) {
+    r->n_layers = 0;
+}
+
+void hdmi_scanline_render_line(const hdmi_scanline_t *r, uint16_t y, hdmi_pixel_t *line) {
+    if (r->n_layers == 0) {
+        memset(line, 0, (size_t)r->width * sizeof *line);
+        return;
+    }
+    for (uint8_t i = 0; i < r->n_layers; i++) {
+        r->layers[i].render(r->layers[i].ctx, y, line, r->width);
+    }
+}
+
+uint32_t hdmi_scanline_service(hdmi_scanline_t *r) {
+    uint32_t rendered = 0;
+
+    for (;;) {
+        const uint32_t send_n = r->send_n;
+
+        /* Com o DMA rodando, send_n (em envio) e send_n + 1 (armada) já foram
+         * entregues, pretas se não estavam prontas: renderizá-las só gastaria
+         * dois tempos de linha justamente quando o produtor está atrasado */
+        const int32_t first = r->streaming ? 2 : 0;
+        const int32_t ahead = line_diff(r, r->fill_n, send_n);
+        if (ahead < first) {
+            r->stats.lines_skipped += (uint32_t)(first - ahead);
+            r->fill_n = line_add(r, send_n, (uint32_t)first);
+        } else if (ahead >= (int32_t)r->ring_len) {
+            break;  /* Anel cheio */
+        }
+
+        const uint32_t n = r->fill_n;
+        const uint32_t slot = n % r->ring_len;
+        hdmi_scanline_render_line(r, (uint16_t)(n % r->height), slot_ptr(r, n));
+
+        /* Publica a linha só depois que todos os pixels foram escritos */
+        __sync_synchronize();
+        r->ready_n[slot] = n;
+        r->ready_valid |= (uint8_t)(1u << slot);
+        r->fill_n = line_add(r, n, 1);
+        rendered++;
+    }
+    return rendered;
+}
+
+const hdmi_pixel_t *hdmi_scanline_next_line(hdmi_scanline_t *r) {
+    /* A linha send_n terminou; o outro canal já está em send_n + 1 */
+    const uint32_t done = r->send_n;
+    r->streaming = true;
+    r->stats.lines_sent++;
+    if (done % r->height == (uint32_t)(r->height - 1)) {
+        r->stats.frames++;
+    }
+
+    const uint32_t send_n = line_add(r, done, 1);
+    const uint32_t queue_n = line_add(r, send_n, 1);
+    r->send_n = send_n;
+
+    /* Folga: linhas prontas à frente da que está sendo armada */
+    const int32_t ahead = line_diff(r, r->fill_n, queue_n);
+    const uint32_t lead = (ahead > 0) ? (uint32_t)ahead : 0u;
+    if (lead < r->stats.min_lead) {
+        r->stats.min_lead = lead;
+    }
+
+    const uint32_t slot = queue_n % r->ring_len;
+    if ((r->ready_valid & (1u << slot)) && r->ready_n[slot] == queue_n) {
+        return slot_ptr(r, queue_n);
+    }
+    r->stats.underruns++;
+    return NULL;  /* Linha preta */
+}
+
+void hdmi_scanline_get_stats(const hdmi_scanline_t *r, hdmi_scanline_stats_t *out) {
+    *out = r->stats;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: ALIMENTAÇÃO DA PIO POR DMA ENCADEADO (RP2040/RP2350)
+ * =============================================================================
+ */
+
+#if HDMI_SCANLINE_USE_DMA
+
+/** Palavra zero lida repetidamente (sem incremento) para linhas pretas */
+static const uint32_t black_word = 0;
+
+/** Instância atendida pelo IRQ (um único fluxo HDMI por sistema) */
+static hdmi_scanline_t *dma_owner = NULL;
+
+/** Valores de CTRL pré-calculados: [canal][0 = linha do anel, 1 = preto] */
+static uint32_t dma_ctrl[2][2];
+
+/**
+ * @brief Reprograma um canal (sem disparar) para enviar uma linha
+ *
+ * @param line Slot do anel, ou NULL para a linha preta
+ */
+static void program_channel(hdmi_scanline_t *r, int idx, const hdmi_pixel_t *line) {
+    dma_channel_hw_t *hw = dma_channel_hw_addr((uint)r->dma_chan[idx]);
+    hw->read_addr = line ? (uintptr_t)line : (uintptr_t)&black_word;
+    hw->transfer_count = r->width / 2u;  /* 2 pixels RGB565 por palavra */
+    hw->al1_ctrl = dma_ctrl[idx][line ? 0 : 1];
+}
+
+static void __isr hdmi_scanline_dma_irq(void) {
+    hdmi_scanline_t *r = dma_owner;
+    if (!r) {
+        return;
+    }
+    /* Pode haver dois fins de transferência pendentes se o IRQ atrasou */
+    while (dma_channel_get_irq0_status((uint)r->dma_chan[r->next_chan])) {
+        const int idx = r->next_chan;
+        dma_channel_acknowledge_irq0((uint)r->dma_chan[idx]);
+        program_channel(r, idx, hdmi_scanline_next_line(r));
+        r->next_chan ^= 1u;
+    }
+}
+
+void hdmi_scanline_start_dma(hdmi_scanline_t *r, PIO pio, uint sm) {
+    r->pio = pio;
+    r->sm = sm;
+    r->dma_chan[0] = dma_claim_unused_channel(true);
+    r->dma_chan[1] = dma_claim_unused_channel(true);
+    r->next_chan = 0;
+
+    for (int i = 0; i < 2; i++) {
+        dma_channel_config c = dma_channel_get_default_config((uint)r->dma_chan[i]);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+        channel_config_set_write_increment(&c, false);
+        channel_config_set_dreq(&c, pio_get_dreq(pio, sm, true));
+        channel_config_set_chain_to(&c, (uint)r->dma_chan[i ^ 1]);
+
+        channel_config_set_read_increment(&c, true);
+        dma_ctrl[i][0] = channel_config_get_ctrl_value(&c);
+        channel_config_set_read_increment(&c, false);
+        dma_ctrl[i][1] = channel_config_get_ctrl_value(&c);
+
+        dma_channel_hw_addr((uint)r->dma_chan[i])->write_addr = (uintptr_t)&pio->txf[sm];
+    }
+
+    /* Pré-preenche o anel: linhas 0 e 1 armadas nos dois canais */
+    r->send_n = 0;
+    r->fill_n = 0;
+    r->ready_valid = 0;
+    r->streaming = false;
+    hdmi_scanline_service(r);
+    program_channel(r, 0, slot_ptr(r, 0));
+    program_channel(r, 1, slot_ptr(r, 1));
+
+    dma_owner = r;
+    dma_channel_set_irq0_enabled((uint)r->dma_chan[0], true);
+    dma_channel_set_irq0_enabled((uint)r->dma_chan[1], true);
+    irq_add_shared_handler(DMA_IRQ_0, hdmi_scanline_dma_irq,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_start((uint)r->dma_chan[0]);
+}
+
+void hdmi_scanline_stop_dma(hdmi_scanline_t *r) {
+    for (int i = 0; i < 2; i++) {
+        dma_channel_set_irq0_enabled((uint)r->dma_chan[i], false);
+        /* Quebra o encadeamento antes de abortar para não religar o par */
+        hw_clear_bits(&dma_channel_hw_addr((uint)r->dma_chan[i])->al1_ctrl,
+                      DMA_CH0_CTRL_TRIG_CHAIN_TO_BITS);
+        hw_set_bits(&dma_channel_hw_addr((uint)r->dma_chan[i])->al1_ctrl,
+                    ((uint)r->dma_chan[i]) << DMA_CH0_CTRL_TRIG_CHAIN_TO_LSB);
+    }
+    dma_channel_abort((uint)r->dma_chan[0]);
+    dma_channel_abort((uint)r->dma_chan[1]);
+    irq_remove_handler(DMA_IRQ_0, hdmi_scanline_dma_irq);
+    dma_owner = NULL;
+    dma_channel_unclaim((uint)r->dma_chan[0]);
+    dma_channel_unclaim((uint)r->dma_chan[1]);
+}
+
+/* =============================================================================
+ * SEÇÃO 3 (HOST): QUADRO EM ARQUIVO PPM
+ * =============================================================================
+ */
+
+#else
+
+/** Uma linha RGB565 como RGB de 8 bits */
+static bool put_ppm_line(FILE *f, const hdmi_pixel_t *line, uint16_t width) {
+    for (uint16_t x = 0; x < width; x++) {
+        const hdmi_pixel_t p = line[x];
+        uint8_t rgb[3];
+        /* Expande 5/6/5 bits para 8 bits replicando os bits altos */
+        rgb[0] = (uint8_t)(((p >> 11) & 0x1Fu) << 3 | ((p >> 13) & 0x07u));
+        rgb[1] = (uint8_t)(((p >> 5) & 0x3Fu) << 2 | ((p >> 9) & 0x03u));
+        rgb[2] = (uint8_t)((p & 0x1Fu) << 3 | ((p >> 2) & 0x07u));
+        if (fwrite(rgb, 1, sizeof rgb, f) != sizeof rgb) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool hdmi_scanline_write_ppm(hdmi_scanline_t *r, const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned)r->width, (unsigned)r->height);
+
+    bool ok = true;
+    for (uint16_t y = 0; y < r->height && ok; y++) {
+        /* O slot 0 do anel serve de rascunho: no host não há DMA lendo */
+        hdmi_pixel_t *line = r->ring;
+        hdmi_scanline_render_line(r, y, line);
+        ok = put_ppm_line(f, line, r->width);
+    }
+    return (fclose(f) == 0) && ok;
+}
+
+bool hdmi_scanline_write_ppm_frame(const hdmi_pixel_t *frame, uint16_t width, uint16_t height,
+                                   const char *path) {
+    FILE *f = fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    fprintf(f, "P6\n%u %u\n255\n", (unsigned)width, (unsigned)height);
+
+    bool ok = true;
+    for (uint16_t y = 0; y < height && ok; y++) {
+        ok = put_ppm_line(f, frame + (size_t)y * width, width);
+    }
+    return (fclose(f) == 0) && ok;
+}
+
+#endif /* HDMI_SCANLINE_USE_DMA */
@@ -0,0 +1,267 @@
+/**
+ * =============================================================================
+ * @file    hdmi_scanline.h
+ * @brief   Renderizador por linha (scanline streaming) para a saída HDMI
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Um framebuffer 720x480 (HDMI_WIDTH x HDMI_HEIGHT) em RGB565 ocupa
+ *          675 KiB e não cabe na RAM do RP2040. hdmi_draw_color_bars() e
+ *          hdmi_draw_smpte() contornam isso empurrando pixels da CPU direto
+ *          para o FIFO da PIO, o que prende a CPU e limita o conteúdo.
+ *
+ *          Este módulo mantém apenas um pequeno anel de linhas:
+ *
+ *          ┌────────────┐  hdmi_scanline_service()  ┌──────────────────┐
+ *          │ camadas    │ ─────────────────────────▶│ anel de N linhas │
+ *          │ (callbacks)│   preenche "just in time" └────────┬─────────┘
+ *          └────────────┘                                    │ DMA
+ *                                          (2 canais encadeados, ping-pong)
+ *                                                            ▼
+ *                                                  ┌──────────────────┐
+ *                                                  │ FIFO TX da PIO   │
+ *                                                  │ (sm_hdmi)        │
+ *                                                  └──────────────────┘
+ *
+ *          NUMERAÇÃO DAS LINHAS:
+ *          O anel é indexado por um contador de linhas n que não reinicia a
+ *          cada quadro: linha da tela y = n % height e slot do anel =
+ *          n % ring_len. O contador volta a zero em line_mod, um múltiplo de
+ *          height * ring_len abaixo de 2^30, para que a fase do quadro e a
+ *          do anel continuem as mesmas na volta (2^32 não é múltiplo de 480);
+ *          as comparações usam a diferença com sinal módulo line_mod. Com o
+ *          DMA rodando, o produtor só escreve linhas n com
+ *          send_n + 1 < n < send_n + ring_len, portanto nunca toca o slot
+ *          que o DMA está lendo nem o que já está armado no outro canal.
+ *
+ *          UNDERRUN:
+ *          Se, na hora de enfileirar a linha n, o slot ainda não contém a
+ *          linha n pronta, o DMA envia uma linha preta e o contador
+ *          `underruns` é incrementado. O produtor então pula as linhas que
+ *          já passaram e as duas já entregues ao DMA (contadas em
+ *          `lines_skipped`), ressincronizando sozinho em send_n + 2.
+ *
+ *          No host (sem Pico SDK) o mesmo pipeline de camadas gera quadros
+ *          em arquivo PPM para verificação visual/automática.
+ * =============================================================================
+ */
+
+#ifndef HDMI_SCANLINE_H
+#define HDMI_SCANLINE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/pio.h"
+#define HDMI_SCANLINE_USE_DMA 1
+#else
+#define HDMI_SCANLINE_USE_DMA 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** Número máximo de slots no anel de linhas */
+#ifndef HDMI_SCANLINE_MAX_RING
+#define HDMI_SCANLINE_MAX_RING 8
+#endif
+
+/** Número máximo de camadas compostas por linha */
+#ifndef HDMI_SCANLINE_MAX_LAYERS
+#define HDMI_SCANLINE_MAX_LAYERS 4
+#endif
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/** Pixel RGB565 (2 pixels por palavra de 32 bits no FIFO da PIO) */
+typedef uint16_t hdmi_pixel_t;
+
+/** Converte componentes de 8 bits em RGB565 */
+#define HDMI_RGB565(r, g, b) \
+    ((hdmi_pixel_t)((((r) & 0xF8u) << 8) | (((g) & 0xFCu) << 3) | ((b) >> 3)))
+
+/**
+ * @brief Callback que desenha (ou sobrepõe) uma linha
+ *
+ * @param ctx   Contexto da camada
+ * @param y     Linha da tela (0 .. height - 1)
+ * @param line  Pixels da linha, já contendo o resultado das camadas anteriores
+ * @param width Largura da linha em pixels
+ */
+typedef void (*hdmi_line_fn_t)(void *ctx, uint16_t y, hdmi_pixel_t *line, uint16_t width);
+
+/**
+ * @struct hdmi_layer_t
+ * @brief Camada da composição (padrão de teste, mapa de tiles, texto, ...)
+ */
+typedef struct {
+    hdmi_line_fn_t render;
+    void *ctx;
+} hdmi_layer_t;
+
+/**
+ * @struct hdmi_scanline_stats_t
+ * @brief Contadores de saúde do pipeline
+ *
+ * @var hdmi_scanline_stats_t::lines_sent  Linhas entregues ao FIFO
+ * @var hdmi_scanline_stats_t::frames      Quadros completos enviados
+ * @var hdmi_scanline_stats_t::underruns   Linhas substituídas por preto
+ * @var hdmi_scanline_stats_t::lines_skipped Linhas que o produtor pulou
+ *      por já terem passado
+ * @var hdmi_scanline_stats_t::min_lead    Menor folga observada (linhas
+ *      prontas à frente do DMA); 0 significa que houve underrun
+ */
+typedef struct {
+    uint32_t lines_sent;
+    uint32_t frames;
+    uint32_t underruns;
+    uint32_t lines_skipped;
+    uint32_t min_lead;
+} hdmi_scanline_stats_t;
+
+/**
+ * @struct hdmi_scanline_t
+ * @brief Estado do renderizador (instância estática, sem malloc)
+ */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint8_t ring_len;
+    hdmi_pixel_t *ring;                              /**< ring_len * width pixels */
+
+    hdmi_layer_t layers[HDMI_SCANLINE_MAX_LAYERS];
+    uint8_t n_layers;
+
+    volatile uint32_t ready_n[HDMI_SCANLINE_MAX_RING]; /**< Linha pronta em cada slot */
+    volatile uint8_t ready_valid;                    /**< Bit i: ready_n[i] já foi escrito */
+    volatile uint32_t send_n;                        /**< Linha em envio */
+    uint32_t fill_n;                                 /**< Próxima linha a renderizar */
+    volatile bool streaming;                         /**< send_n e send_n + 1 já entregues ao DMA */
+    uint32_t line_mod;                               /**< Módulo dos contadores de linha */
+
+    hdmi_scanline_stats_t stats;
+
+#if HDMI_SCANLINE_USE_DMA
+    PIO pio;
+    uint sm;
+    int dma_chan[2];
+    uint8_t next_chan;                               /**< Canal a reprogramar no próximo IRQ */
+#endif
+} hdmi_scanline_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o renderizador
+ *
+ * @param r        Instância
+ * @param ring     Buffer de ring_len * width pixels (alinhado a 4 bytes)
+ * @param ring_len Slots no anel (3 .. HDMI_SCANLINE_MAX_RING)
+ * @param width    Largura (par, ex.: HDMI_WIDTH)
+ * @param height   Altura (ex.: HDMI_HEIGHT)
+ * @return true se os parâmetros forem válidos
+ */
+bool hdmi_scanline_init(hdmi_scanline_t *r, hdmi_pixel_t *ring, uint8_t ring_len,
+                        uint16_t width, uint16_t height);
+
+/**
+ * @brief Acrescenta uma camada ao fim da pilha de composição
+ *
+ * @details A primeira camada deve cobrir a linha inteira (fundo); as demais
+ *          desenham por cima. Trocar de padrão = hdmi_scanline_clear_layers()
+ *          + nova camada, sem parar o DMA.
+ */
+bool hdmi_scanline_add_layer(hdmi_scanline_t *r, hdmi_line_fn_t render, void *ctx);
+
+/** Remove todas as camadas (linhas passam a sair pretas) */
+void hdmi_scanline_clear_layers(hdmi_scanline_t *r);
+
+/**
+ * @brief Renderiza uma linha passando por todas as camadas
+ */
+void hdmi_scanline_render_line(const hdmi_scanline_t *r, uint16_t y, hdmi_pixel_t *line);
+
+/**
+ * @brief Preenche os slots livres do anel com as próximas linhas
+ *
+ * @details Deve ser chamado continuamente (laço do core1 ou do main). Pula
+ *          linhas que o DMA já ultrapassou.
+ *
+ * @return Número de linhas renderizadas nesta chamada
+ */
+uint32_t hdmi_scanline_service(hdmi_scanline_t *r);
+
+/**
+ * @brief Avança o consumidor e devolve a linha a enviar em seguida
+ *
+ * @details Chamado pelo IRQ do DMA (ou pela simulação no host) quando a
+ *          linha send_n termina: send_n passa a ser a linha já armada no
+ *          outro canal e a função devolve a linha send_n + 1 para armar.
+ *
+ * @return Slot da linha, se pronta; NULL (linha preta) em caso de underrun
+ */
+const hdmi_pixel_t *hdmi_scanline_next_line(hdmi_scanline_t *r);
+
+/** Copia os contadores atuais */
+void hdmi_scanline_get_stats(const hdmi_scanline_t *r, hdmi_scanline_stats_t *out);
+
+#if HDMI_SCANLINE_USE_DMA
+/**
+ * @brief Inicia o envio por DMA encadeado para o FIFO TX da state machine
+ *
+ * @details Reivindica dois canais de DMA configurados em ping-pong
+ *          (chain_to mútuo) com DREQ da PIO. O IRQ de fim de transferência
+ *          (DMA_IRQ_0) reprograma o canal ocioso com a linha seguinte.
+ *          O anel é pré-preenchido antes do início.
+ *
+ * @param r   Instância já inicializada e com camadas
+ * @param pio PIO da saída (pio_hdmi)
+ * @param sm  State machine (sm_hdmi)
+ */
+void hdmi_scanline_start_dma(hdmi_scanline_t *r, PIO pio, uint sm);
+
+/** Interrompe o DMA e libera os canais */
+void hdmi_scanline_stop_dma(hdmi_scanline_t *r);
+#else
+/**
+ * @brief (Host) Renderiza um quadro inteiro em um arquivo PPM binário (P6)
+ *
+ * @details Usa o slot 0 do anel como rascunho: não chame enquanto um
+ *          consumidor simulado estiver lendo o anel.
+ *
+ * @return true em caso de sucesso
+ */
+bool hdmi_scanline_write_ppm(hdmi_scanline_t *r, const char *path);
+
+/**
+ * @brief (Host) Grava um quadro já montado (width * height pixels) em PPM
+ *
+ * @details Para gravar as linhas que um consumidor recebeu do anel.
+ */
+bool hdmi_scanline_write_ppm_frame(const hdmi_pixel_t *frame, uint16_t width, uint16_t height,
+                                   const char *path);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HDMI_SCANLINE_H */
@@ -0,0 +1,207 @@
+/**
+ * =============================================================================
+ * @file    hdmi_scanline_sim.c
+ * @brief   (Host) Teste do anel de linhas com um consumidor simulado
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Faz o papel do par de canais de DMA: a cada "tempo de linha" o
+ *          consumidor copia a linha em envio para um quadro, chama
+ *          hdmi_scanline_next_line() e arma o que ela devolver (NULL = linha
+ *          preta). O produtor chama hdmi_scanline_service() conforme um
+ *          roteiro. Cenários:
+ *
+ *          1. Produtor em dia: nenhum underrun nem linha pulada; o quadro
+ *             recebido é igual ao renderizado direto pelas camadas e é
+ *             gravado em PPM (argumento -o).
+ *          2. Produtor parado por STALL linhas: as linhas pretas recebidas
+ *             batem com `underruns`, as puladas com `lines_skipped`, e o
+ *             quadro seguinte volta a sair inteiro.
+ *          3. Contadores começando 2 quadros antes da volta de line_mod:
+ *             a volta não gera underrun nem desloca a fase do quadro.
+ *
+ *          Uso: hdmi_scanline_sim [-o quadro.ppm]
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "hdmi_scanline.h"
+#include "hdmi_layers.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define W      320u
+#define H      240u
+#define RING   4u
+#define STALL  20u
+
+static hdmi_scanline_t video;
+static hdmi_pixel_t ring[RING * W];
+static hdmi_pixel_t frame[H * W];     /* Quadro montado pelo consumidor */
+static hdmi_pixel_t expect[H * W];    /* Quadro renderizado direto */
+static hdmi_pixel_t scratch[W];
+
+/* =============================================================================
+ * SEÇÃO 1: CONSUMIDOR SIMULADO (os dois canais de DMA)
+ * =============================================================================
+ */
+
+typedef struct {
+    const hdmi_pixel_t *cur;     /**< Linha em envio (send_n), NULL = preta */
+    const hdmi_pixel_t *armed;   /**< Linha armada no outro canal */
+    uint32_t black;              /**< Linhas pretas enviadas */
+} consumer_t;
+
+/** Como hdmi_scanline_start_dma(): pré-preenche e arma send_n e send_n + 1 */
+static void consumer_start(consumer_t *c, uint32_t first_line) {
+    video.send_n = first_line;
+    video.fill_n = first_line;
+    video.ready_valid = 0;
+    video.streaming = false;
+    hdmi_scanline_service(&video);
+    c->cur = video.ring + (size_t)(first_line % RING) * W;
+    c->armed = video.ring + (size_t)((first_line + 1u) % RING) * W;
+    c->black = 0;
+}
+
+/** Envia a linha atual para o quadro e avança, como o IRQ de fim de DMA */
+static void consumer_line(consumer_t *c) {
+    const uint16_t y = (uint16_t)(video.send_n % H);
+    if (c->cur) {
+        memcpy(frame + (size_t)y * W, c->cur, W * sizeof *frame);
+    } else {
+        memset(frame + (size_t)y * W, 0, W * sizeof *frame);
+        c->black++;
+    }
+    c->cur = c->armed;
+    c->armed = hdmi_scanline_next_line(&video);
+}
+
+static bool frame_matches(void) {
+    return memcmp(frame, expect, sizeof frame) == 0;
+}
+
+static void reset_stats(void) {
+    memset(&video.stats, 0, sizeof video.stats);
+    video.stats.min_lead = RING;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: CENÁRIOS
+ * =============================================================================
+ */
+
+/** Produtor chamado a cada linha: nada se perde */
+static void scenario_in_time(const char *ppm) {
+    consumer_t c;
+    reset_stats();
+    consumer_start(&c, 0);
+    for (unsigned i = 0; i < 3u * H; i++) {
+        consumer_line(&c);
+        hdmi_scanline_service(&video);
+    }
+    hdmi_scanline_stats_t st;
+    hdmi_scanline_get_stats(&video, &st);
+    CHECK(st.underruns == 0 && st.lines_skipped == 0 && c.black == 0,
+          "em dia: %u underruns, %u puladas, %u pretas", st.underruns, st.lines_skipped, c.black);
+    CHECK(st.frames == 3u && st.lines_sent == 3u * H, "em dia: %u quadros, %u linhas", st.frames,
+          st.lines_sent);
+    CHECK(st.min_lead >= 1u, "em dia: folga mínima %u", st.min_lead);
+    CHECK(frame_matches(), "em dia: quadro recebido difere das camadas");
+    printf("em dia: %u quadros, %u linhas, folga mínima %u\n", st.frames, st.lines_sent,
+           st.min_lead);
+
+    if (ppm) {
+        CHECK(hdmi_scanline_write_ppm_frame(frame, W, H, ppm), "não gravou %s", ppm);
+        printf("quadro recebido: %s\n", ppm);
+    }
+}
+
+/** Produtor para STALL linhas no meio do segundo quadro */
+static void scenario_stall(void) {
+    consumer_t c;
+    reset_stats();
+    consumer_start(&c, 0);
+    const unsigned stall_at = H + H / 2u;
+    for (unsigned i = 0; i < 3u * H; i++) {
+        consumer_line(&c);
+        if (i < stall_at || i >= stall_at + STALL) {
+            hdmi_scanline_service(&video);
+        }
+        if (i == 2u * H - 1u) {
+            /* Fim do 2º quadro: deve ter linhas pretas */
+            CHECK(!frame_matches(), "parada: 2º quadro saiu inteiro");
+        }
+    }
+    hdmi_scanline_stats_t st;
+    hdmi_scanline_get_stats(&video, &st);
+    /* As linhas já prontas cobrem o começo da parada; o consumidor avança
+       mais uma vez antes de o produtor voltar. Na volta, o produtor pula
+       até send_n + 2: send_n e send_n + 1 já estão armadas pretas, então
+       toda linha preta é uma linha pulada e nenhuma é renderizada à toa */
+    const uint32_t lost = STALL + 3u - RING;
+    CHECK(st.underruns == c.black, "parada: %u underruns, %u linhas pretas", st.underruns, c.black);
+    CHECK(st.underruns == lost, "parada: %u underruns, esperado %u", st.underruns, lost);
+    CHECK(st.lines_skipped == lost, "parada: %u puladas, esperado %u", st.lines_skipped, lost);
+    CHECK(st.min_lead == 0u, "parada: folga mínima %u", st.min_lead);
+    CHECK(frame_matches(), "parada: 3º quadro não se recuperou");
+    printf("parada de %u linhas: %u underruns, %u puladas, quadro seguinte inteiro\n", STALL,
+           st.underruns, st.lines_skipped);
+}
+
+/** Contadores atravessando line_mod */
+static void scenario_wrap(void) {
+    consumer_t c;
+    reset_stats();
+    CHECK(video.line_mod % (H * RING) == 0u, "line_mod %u não é múltiplo de altura x anel",
+          video.line_mod);
+    consumer_start(&c, video.line_mod - 2u * H);
+    for (unsigned i = 0; i < 4u * H; i++) {
+        consumer_line(&c);
+        hdmi_scanline_service(&video);
+    }
+    hdmi_scanline_stats_t st;
+    hdmi_scanline_get_stats(&video, &st);
+    CHECK(st.underruns == 0 && st.lines_skipped == 0, "volta: %u underruns, %u puladas",
+          st.underruns, st.lines_skipped);
+    CHECK(st.frames == 4u, "volta: %u quadros, esperado 4", st.frames);
+    CHECK(video.send_n == 2u * H, "volta: send_n %u, esperado %u", video.send_n, 2u * H);
+    CHECK(frame_matches(), "volta: fase do quadro deslocada");
+    printf("volta do contador (line_mod %u): %u quadros sem underrun\n", video.line_mod,
+           st.frames);
+}
+
+int main(int argc, char **argv) {
+    const char *ppm = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            ppm = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [-o quadro.ppm]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    if (!hdmi_scanline_init(&video, ring, RING, W, H) ||
+        !hdmi_scanline_add_layer(&video, hdmi_layer_smpte, NULL)) {
+        printf("FALHA: init\n");
+        return 1;
+    }
+    for (uint16_t y = 0; y < H; y++) {
+        hdmi_scanline_render_line(&video, y, scratch);
+        memcpy(expect + (size_t)y * W, scratch, sizeof scratch);
+    }
+
+    scenario_in_time(ppm);
+    scenario_stall();
+    scenario_wrap();
+
+    return test_check_summary();
+}
@@ -53,6 +53,11 @@
 #include <stdarg.h>   /* Para va_list, va_start, va_end */
 #include <stdint.h>   /* Para uintptr_t */
 
+#include "prof_zone_hooks.h"   /* PROF_ZONE(), vazia sem PROF_ZONE_ENABLE */
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+#include "pico/time.h"   /* Para o intervalo de log_prof_periodic */
+#endif
+
 #ifdef FREERTOS_ENABLED
 #include "FreeRTOS.h"
 #include "semphr.h"
@@ -602,6 +607,9 @@ void log_write(log_level_t level, const char *fmt, ...) {
         return;
     }
 
+    /* Mede formatação e saída; mensagens filtradas não contam */
+    PROF_ZONE("log_write");
+
     /* ========== PASSO 2: SELEÇÃO DE COR VT100 ========== */
     /* Códigos de cor VT100/ANSI para saída colorida no terminal */
     const char *color_reset = "\x1b[0m";  /* Reset para cor padrão */
@@ -705,3 +713,31 @@ void threadSafeInit(void)
     }
 }
 
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+/* =============================================================================
+ * SEÇÃO 6: DESPEJO DAS MÉTRICAS DO PROF_ZONE
+ * =============================================================================
+ */
+
+/** Repassa cada linha da tabela do prof_zone para o log */
+static void prof_emit(void *ctx, const char *line) {
+    (void)ctx;
+    log_write(LOG_LEVEL_INFO, "%s", line);
+}
+
+void log_prof_dump(void) {
+    prof_zone_dump(prof_emit, NULL);
+}
+
+bool log_prof_periodic(uint32_t period_ms) {
+    static uint32_t last_ms = 0;
+    const uint32_t now = to_ms_since_boot(get_absolute_time());
+    if (now - last_ms < period_ms) {
+        return false;
+    }
+    last_ms = now;
+    log_prof_dump();
+    prof_zone_reset();
+    return true;
+}
+#endif /* PROF_ZONE_ENABLED */
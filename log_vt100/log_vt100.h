@@ -169,6 +169,34 @@ void log_set_level(log_level_t level);
  */
 void log_write(log_level_t level, const char *fmt, ...);
 
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+#include <stdbool.h>  /* Para o retorno de log_prof_periodic */
+
+/**
+ * @brief Imprime as métricas do prof_zone em nível INFO
+ * 
+ * @details Uma linha por zona e núcleo com medições: contagem, mínimo,
+ *          média, máximo e p99 em microssegundos. Disponível quando o
+ *          prof_zone faz parte do build com PROF_ZONE_ENABLE=ON.
+ * 
+ * @example [INFO ] zona                 nu        n    min(us)  media(us) ...
+ *          [INFO ] mpu6050_read          1     1000     512.40     518.72 ...
+ */
+void log_prof_dump(void);
+
+/**
+ * @brief Despejo periódico das métricas do prof_zone
+ * 
+ * @details Chame no laço principal ou numa tarefa de baixa prioridade. A
+ *          cada period_ms imprime a tabela com log_prof_dump() e zera as
+ *          métricas: cada tabela cobre apenas a última janela.
+ * 
+ * @param period_ms Intervalo entre os despejos
+ * @return true se a tabela foi impressa nesta chamada
+ */
+bool log_prof_periodic(uint32_t period_ms);
+#endif
+
 /* =============================================================================
  * SEÇÃO 3: CONSTANTES E CONFIGURAÇÕES DE COMPILAÇÃO
  * =============================================================================
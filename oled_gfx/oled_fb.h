@@ -0,0 +1,77 @@
+/**
+ * =============================================================================
+ * @file    oled_fb.h
+ * @brief   Descritor do framebuffer 1-bpp em páginas do SSD1306
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details O SSD1306 organiza a memória de vídeo em "páginas" de 8 linhas.
+ *          Cada byte representa uma coluna de 8 pixels verticais, com o
+ *          bit 0 no topo da página. É o mesmo layout usado pelo buffer
+ *          `ssd` de `ssd1306_i2c.c` (ssd1306_width x ssd1306_n_pages).
+ *
+ *          LAYOUT (128x64 => 8 páginas de 128 bytes):
+ *          ┌──────────────────────────────────────────────────────────┐
+ *          │ índice do byte = (y >> 3) * largura + x                  │
+ *          │ máscara do bit = 1 << (y & 7)                            │
+ *          └──────────────────────────────────────────────────────────┘
+ *
+ *          Todas as rotinas do módulo oled_gfx recebem este descritor em
+ *          vez de usar constantes globais, permitindo desenhar tanto no
+ *          buffer do oled.c quanto em buffers auxiliares (sprites, áreas
+ *          de renderização parciais, testes no host).
+ * =============================================================================
+ */
+
+#ifndef OLED_FB_H
+#define OLED_FB_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct oled_fb_t
+ * @brief Framebuffer monocromático organizado em páginas de 8 pixels
+ *
+ * @var oled_fb_t::buf
+ *      Ponteiro para (height/8) * width bytes
+ * @var oled_fb_t::width
+ *      Largura em pixels (número de colunas por página)
+ * @var oled_fb_t::height
+ *      Altura em pixels (múltiplo de 8)
+ */
+typedef struct {
+    uint8_t *buf;
+    uint16_t width;
+    uint16_t height;
+} oled_fb_t;
+
+/**
+ * @def OLED_FB_INIT(buffer, w, h)
+ * @brief Inicializador estático de oled_fb_t
+ *
+ * @example static uint8_t ssd[ssd1306_buffer_length];
+ *          oled_fb_t fb = OLED_FB_INIT(ssd, ssd1306_width, ssd1306_height);
+ */
+#define OLED_FB_INIT(buffer, w, h) { (buffer), (w), (h) }
+
+/**
+ * @brief Número de páginas (linhas de 8 pixels) do framebuffer
+ */
+static inline uint16_t oled_fb_pages(const oled_fb_t *fb) {
+    return (uint16_t)(fb->height >> 3);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_FB_H */
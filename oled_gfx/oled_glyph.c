@@ -0,0 +1,251 @@
+/**
+ * =============================================================================
+ * @file    oled_glyph.c
+ * @brief   Implementação do blitter de glifos por coluna
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada coluna do glifo (até 4 páginas = 32 pixels) é carregada
+ *          numa palavra de 32 bits. Para um y não alinhado, a palavra e a
+ *          máscara da caixa do glifo são deslocadas de (y & 7) bits; os
+ *          bits que "transbordam" para a página extra vão para uma segunda
+ *          palavra. Cada página de destino recebe então UMA operação de
+ *          byte (OR, XOR ou AND+OR), independentemente de quantos pixels
+ *          estão acesos.
+ *
+ *          CUSTO POR GLIFO 8x8 (aproximado):
+ *          ┌────────────────────────┬───────────────────────────────────┐
+ *          │ Caminho                │ Operações                         │
+ *          ├────────────────────────┼───────────────────────────────────┤
+ *          │ set_pixel por pixel    │ 64 x (índice + máscara + RMW)     │
+ *          │ y alinhado (rápido)    │ 8 bytes (memcpy no modo COPY)     │
+ *          │ y desalinhado          │ 8 colunas x 2 bytes               │
+ *          └────────────────────────┴───────────────────────────────────┘
+ * =============================================================================
+ */
+
+#include "oled_glyph.h"
+
+#include <stddef.h>   /* Para NULL */
+#include <string.h>   /* Para memcpy, memset */
+
+#include "prof_zone_hooks.h"   /* PROF_ZONE(), vazia sem PROF_ZONE_ENABLE */
+
+/* =============================================================================
+ * SEÇÃO 1: FUNÇÕES AUXILIARES
+ * =============================================================================
+ */
+
+/**
+ * @brief Divisão por 8 com arredondamento para baixo (também para y < 0)
+ */
+static inline int floor_div8(int v) {
+    return (v >= 0) ? (v >> 3) : -((7 - v) >> 3);
+}
+
+/**
+ * @brief Carrega as páginas contíguas de uma coluna numa palavra de 32 bits
+ *
+ * @details Montagem byte a byte: o Cortex-M0+ não aceita leituras de 32 bits
+ *          desalinhadas, e o atlas não garante alinhamento por coluna.
+ */
+static inline uint32_t load_column(const uint8_t *col, unsigned pages) {
+    uint32_t w = col[0];
+    if (pages > 1) w |= (uint32_t)col[1] << 8;
+    if (pages > 2) w |= (uint32_t)col[2] << 16;
+    if (pages > 3) w |= (uint32_t)col[3] << 24;
+    return w;
+}
+
+/**
+ * @brief Aplica um byte do glifo sobre um byte do framebuffer
+ *
+ * @param dst  Byte de destino
+ * @param bits Pixels do glifo naquele byte
+ * @param mask Pixels cobertos pela caixa do glifo naquele byte
+ * @param mode Modo de composição
+ */
+static inline void apply_byte(uint8_t *dst, uint8_t bits, uint8_t mask,
+                              oled_glyph_mode_t mode) {
+    switch (mode) {
+        case OLED_GLYPH_COPY:
+            *dst = (uint8_t)((*dst & (uint8_t)~mask) | bits);
+            break;
+        case OLED_GLYPH_XOR:
+            *dst ^= bits;
+            break;
+        case OLED_GLYPH_OR:
+        default:
+            *dst |= bits;
+            break;
+    }
+}
+
+/**
+ * @brief Caminho genérico: y arbitrário e recorte em qualquer borda
+ *
+ * @param glyph Colunas do glifo, ou NULL para uma caixa vazia (modo COPY)
+ */
+static void blit_shifted(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                         const uint8_t *glyph, int x, int y,
+                         oled_glyph_mode_t mode) {
+    const unsigned pages = font->pages;
+    const int fb_pages = (int)oled_fb_pages(fb);
+    const int p0 = floor_div8(y);
+    const unsigned shift = (unsigned)(y - p0 * 8);
+    /* Bytes de destino por coluna: uma página extra quando desalinhado */
+    const unsigned span = pages + (shift ? 1u : 0u);
+
+    /* Máscara da caixa do glifo (pages * 8 bits), deslocada como os pixels */
+    const uint32_t box = (pages >= 4) ? 0xFFFFFFFFu : ((1u << (pages * 8u)) - 1u);
+    const uint32_t box_lo = box << shift;
+    const uint32_t box_hi = shift ? (box >> (32u - shift)) : 0u;
+
+    /* Recorte horizontal: intervalo de colunas visíveis */
+    int c_begin = (x < 0) ? -x : 0;
+    int c_end = font->width;
+    if (x + c_end > (int)fb->width) {
+        c_end = (int)fb->width - x;
+    }
+
+    /* Recorte vertical: intervalo de bytes (páginas) visíveis */
+    int i_begin = (p0 < 0) ? -p0 : 0;
+    int i_end = (int)span;
+    if (p0 + i_end > fb_pages) {
+        i_end = fb_pages - p0;
+    }
+    if (c_begin >= c_end || i_begin >= i_end) {
+        return;
+    }
+
+    for (int c = c_begin; c < c_end; c++) {
+        uint32_t w = glyph ? load_column(glyph + (size_t)c * pages, pages) : 0u;
+        uint32_t lo = w << shift;
+        uint32_t hi = shift ? (w >> (32u - shift)) : 0u;
+        uint8_t *dst = fb->buf + (size_t)(p0 + i_begin) * fb->width + (x + c);
+
+        for (int i = i_begin; i < i_end; i++) {
+            uint8_t bits = (uint8_t)((i < 4) ? (lo >> (8 * i)) : hi);
+            uint8_t mask = (uint8_t)((i < 4) ? (box_lo >> (8 * i)) : box_hi);
+            apply_byte(dst, bits, mask, mode);
+            dst += fb->width;
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: FUNÇÕES PÚBLICAS DA API
+ * =============================================================================
+ */
+
+const uint8_t *oled_glyph_lookup(const oled_glyph_font_t *font, char c) {
+    unsigned code = (unsigned char)c;
+    unsigned index;
+
+    if (font->map) {
+        if (code >= 128u || font->map[code] == OLED_GLYPH_NONE) {
+            return NULL;
+        }
+        index = font->map[code];
+    } else {
+        if (code < font->first || code - font->first >= font->count) {
+            return NULL;
+        }
+        index = code - font->first;
+    }
+    return font->data + (size_t)index * font->width * font->pages;
+}
+
+void oled_glyph_draw_char(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                          int x, int y, char c, oled_glyph_mode_t mode) {
+    const uint8_t *glyph = oled_glyph_lookup(font, c);
+    const unsigned pages = font->pages;
+    const unsigned width = font->width;
+
+    if (!glyph && mode != OLED_GLYPH_COPY) {
+        return;  /* Nada a acender nem a inverter */
+    }
+
+    /* ========== CAMINHO RÁPIDO: página alinhada e sem recorte ========== */
+    if ((y & 7) == 0 && y >= 0 && x >= 0 &&
+        x + (int)width <= (int)fb->width &&
+        (y >> 3) + (int)pages <= (int)oled_fb_pages(fb)) {
+        uint8_t *row = fb->buf + (size_t)(y >> 3) * fb->width + x;
+
+        if (!glyph) {
+            for (unsigned p = 0; p < pages; p++) {
+                memset(row + (size_t)p * fb->width, 0, width);
+            }
+            return;
+        }
+        if (pages == 1 && mode == OLED_GLYPH_COPY) {
+            /* Fonte 8x8: o glifo já é exatamente a sequência de bytes da página */
+            memcpy(row, glyph, width);
+            return;
+        }
+        for (unsigned p = 0; p < pages; p++) {
+            uint8_t *dst = row + (size_t)p * fb->width;
+            const uint8_t *src = glyph + p;
+            for (unsigned col = 0; col < width; col++, src += pages) {
+                apply_byte(&dst[col], *src, 0xFFu, mode);
+            }
+        }
+        return;
+    }
+
+    /* ========== CAMINHO GERAL: deslocamento + recorte ========== */
+    blit_shifted(fb, font, glyph, x, y, mode);
+}
+
+int oled_glyph_draw_string(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                           int x, int y, const char *str, oled_glyph_mode_t mode) {
+    PROF_ZONE("oled_draw_string");
+    if (!str) {
+        return x;
+    }
+    while (*str && x < (int)fb->width) {
+        oled_glyph_draw_char(fb, font, x, y, *str++, mode);
+        x += font->advance;
+    }
+    return x;
+}
+
+void oled_glyph_write_line(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                           unsigned page, int x, const char *str) {
+    PROF_ZONE("oled_write_line");
+    const unsigned pages = font->pages;
+    const unsigned width = font->width;
+
+    if (page + pages > oled_fb_pages(fb)) {
+        return;
+    }
+
+    /* Passo 1: apagar as páginas da linha inteira (fundo do texto) */
+    uint8_t *row = fb->buf + (size_t)page * fb->width;
+    memset(row, 0, (size_t)pages * fb->width);
+
+    /* Passo 2: copiar as colunas dos glifos visíveis, sem máscaras */
+    for (; str && *str && x < (int)fb->width; str++, x += font->advance) {
+        const uint8_t *glyph = oled_glyph_lookup(font, *str);
+        if (!glyph || x + (int)width <= 0) {
+            continue;
+        }
+        unsigned c_begin = (x < 0) ? (unsigned)-x : 0u;
+        unsigned c_end = width;
+        if (x + (int)c_end > (int)fb->width) {
+            c_end = (unsigned)((int)fb->width - x);
+        }
+        for (unsigned p = 0; p < pages; p++) {
+            uint8_t *dst = row + (size_t)p * fb->width + x;
+            const uint8_t *src = glyph + p;
+            for (unsigned col = c_begin; col < c_end; col++) {
+                dst[col] = src[col * pages];
+            }
+        }
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * =============================================================================
+ * @file    oled_glyph.h
+ * @brief   Atlas de glifos pré-renderizado e blitter por coluna para SSD1306
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details oled_draw_char(), oled_draw_big_char() e ssd1306_draw_char()
+ *          desenham cada glifo pixel a pixel, recalculando índice do byte e
+ *          máscara do bit em cada chamada a set_pixel. Este módulo substitui
+ *          esse caminho por um blitter que escreve bytes inteiros por coluna.
+ *
+ *          FORMATO DO ATLAS:
+ *          As fontes `ssd1306_font.h` (8x8) e `big_font.h` (16x32) são
+ *          convertidas em tempo de build (tools/gen_glyph_atlas.py) para um
+ *          atlas "column-major" alinhado a páginas:
+ *
+ *          ┌────────────────────────────────────────────────────────────┐
+ *          │ glifo g, coluna c, página p:                               │
+ *          │   data[(g * width + c) * pages + p]                        │
+ *          │                                                            │
+ *          │ As páginas de uma coluna ficam contíguas, logo a coluna    │
+ *          │ inteira (até 32 pixels) vira uma única palavra de 32 bits. │
+ *          └────────────────────────────────────────────────────────────┘
+ *
+ *          ESTRATÉGIA DO BLITTER:
+ *          - y múltiplo de 8 e glifo inteiro dentro da tela: cópia direta
+ *            dos bytes da coluna para as páginas (caminho rápido usado por
+ *            oled_set_text_line / oled_render_text).
+ *          - y arbitrário: a palavra da coluna é deslocada (y & 7) bits e
+ *            espalhada em (pages + 1) bytes, sem laço por pixel.
+ *          - Recorte (clipping) é feito por coluna e por página, nunca por
+ *            pixel.
+ *
+ * @note    Nenhuma alocação dinâmica; o atlas fica em flash (const).
+ * =============================================================================
+ */
+
+#ifndef OLED_GLYPH_H
+#define OLED_GLYPH_H
+
+#include <stdint.h>
+#include "oled_fb.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @enum oled_glyph_mode_t
+ * @brief Modo de composição do glifo no framebuffer
+ *
+ * @var OLED_GLYPH_OR
+ *      Apenas acende os pixels do glifo (fundo transparente). Equivale ao
+ *      comportamento de oled_draw_char() com set_pixel(..., true).
+ * @var OLED_GLYPH_COPY
+ *      Substitui a caixa do glifo (fundo apagado). Equivale à cópia direta
+ *      feita por ssd1306_draw_char() em linhas alinhadas.
+ * @var OLED_GLYPH_XOR
+ *      Inverte os pixels do glifo (cursor, realce).
+ */
+typedef enum {
+    OLED_GLYPH_OR   = 0,
+    OLED_GLYPH_COPY = 1,
+    OLED_GLYPH_XOR  = 2,
+} oled_glyph_mode_t;
+
+/**
+ * @struct oled_glyph_font_t
+ * @brief Fonte convertida para o formato de atlas column-major
+ *
+ * @var oled_glyph_font_t::width
+ *      Colunas por glifo
+ * @var oled_glyph_font_t::pages
+ *      Páginas de 8 pixels por coluna (1 a 4, altura máxima de 32 px)
+ * @var oled_glyph_font_t::advance
+ *      Avanço horizontal entre glifos em oled_glyph_draw_string()
+ * @var oled_glyph_font_t::first
+ *      Primeiro código ASCII presente quando map == NULL
+ * @var oled_glyph_font_t::count
+ *      Número de glifos no atlas
+ * @var oled_glyph_font_t::map
+ *      Tabela opcional de 128 entradas ASCII -> índice do glifo
+ *      (0xFF = ausente). Usada por fontes esparsas como big_font.h,
+ *      que só contém '0'-'9' e 'A'-'Z'.
+ * @var oled_glyph_font_t::data
+ *      count * width * pages bytes no layout descrito acima
+ */
+typedef struct {
+    uint8_t width;
+    uint8_t pages;
+    uint8_t advance;
+    uint8_t first;
+    uint8_t count;
+    const uint8_t *map;
+    const uint8_t *data;
+} oled_glyph_font_t;
+
+/** Valor de oled_glyph_font_t::map para caracteres sem glifo */
+#define OLED_GLYPH_NONE 0xFFu
+
+/* =============================================================================
+ * SEÇÃO 2: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Retorna o ponteiro para as colunas do glifo de um caractere
+ *
+ * @param font Fonte em formato de atlas
+ * @param c    Caractere ASCII
+ * @return Ponteiro para width * pages bytes, ou NULL se não houver glifo
+ */
+const uint8_t *oled_glyph_lookup(const oled_glyph_font_t *font, char c);
+
+/**
+ * @brief Desenha um glifo na posição (x, y) do framebuffer
+ *
+ * @details x e y podem ser negativos ou ultrapassar a tela; o recorte é
+ *          feito por coluna/página. Caracteres sem glifo não desenham nada
+ *          no modo OR/XOR e limpam a caixa no modo COPY (como um espaço).
+ *
+ * @param fb   Framebuffer de destino
+ * @param font Fonte em formato de atlas
+ * @param x    Coluna do canto superior esquerdo
+ * @param y    Linha do canto superior esquerdo (qualquer valor, não só
+ *             múltiplos de 8)
+ * @param c    Caractere ASCII
+ * @param mode Modo de composição
+ */
+void oled_glyph_draw_char(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                          int x, int y, char c, oled_glyph_mode_t mode);
+
+/**
+ * @brief Desenha uma string a partir de (x, y)
+ *
+ * @details Avança font->advance colunas por caractere. Interrompe o laço
+ *          assim que o próximo glifo começaria fora da borda direita.
+ *
+ * @return Coluna logo após o último glifo desenhado
+ */
+int oled_glyph_draw_string(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                           int x, int y, const char *str, oled_glyph_mode_t mode);
+
+/**
+ * @brief Escreve uma linha de texto inteira alinhada a uma página
+ *
+ * @details Caminho rápido para oled_render_text(): a linha `page` é
+ *          reescrita por completo (glifos copiados byte a byte e o restante
+ *          da página apagado), sem nenhuma operação de máscara.
+ *
+ * @param fb   Framebuffer de destino
+ * @param font Fonte em formato de atlas (normalmente 8x8, pages == 1)
+ * @param page Página inicial (linha de texto 0..7 no display 128x64)
+ * @param x    Coluna inicial do texto (já alinhado pelo chamador)
+ * @param str  Texto a escrever
+ */
+void oled_glyph_write_line(const oled_fb_t *fb, const oled_glyph_font_t *font,
+                           unsigned page, int x, const char *str);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_GLYPH_H */
@@ -0,0 +1,41 @@
+/**
+ * =============================================================================
+ * @file    oled_glyph_atlas.h
+ * @brief   Fontes do driver OLED_SSD1306 convertidas em atlas de glifos
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details As definições são geradas em tempo de build por
+ *          tools/gen_glyph_atlas.py (ver CMakeLists.txt) a partir de
+ *          `ssd1306_font.h` e `big_font.h`. Quando o gerador roda, o CMake
+ *          define OLED_GFX_HAS_FONT_8X8 / OLED_GFX_HAS_FONT_BIG para quem
+ *          linka com oled_gfx.
+ * =============================================================================
+ */
+
+#ifndef OLED_GLYPH_ATLAS_H
+#define OLED_GLYPH_ATLAS_H
+
+#include <stddef.h>
+#include "oled_glyph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Fonte 8x8 de ssd1306_font.h (ASCII 32..126, 1 página por coluna) */
+extern const oled_glyph_font_t oled_glyph_font_8x8;
+
+/** Fonte 16x32 de big_font.h ('0'-'9', 'A'-'Z', 4 páginas por coluna) */
+extern const oled_glyph_font_t oled_glyph_font_big;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_GLYPH_ATLAS_H */
@@ -0,0 +1,278 @@
+/**
+ * =============================================================================
+ * @file    oled_raster.c
+ * @brief   Implementação das primitivas de rasterização em páginas
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Todas as primitivas de preenchimento convergem para page_run():
+ *          dada uma página, uma coluna inicial, um comprimento e uma máscara
+ *          de bits verticais, a máscara é aplicada a n bytes consecutivos.
+ *          O miolo alinhado é processado em palavras de 32 bits com a
+ *          máscara replicada (mask * 0x01010101), ou seja, 4 colunas por
+ *          load/store no Cortex-M0+.
+ *
+ *          ┌──────────── página p ────────────┐
+ *          │ cab. │ palavra │ palavra │ cauda │  cab./cauda: bytes soltos
+ *          └──────────────────────────────────┘  até o alinhamento de 4
+ * =============================================================================
+ */
+
+#include "oled_raster.h"
+
+#include <stddef.h>   /* Para size_t */
+#include <stdint.h>   /* Para uintptr_t */
+#include <stdlib.h>   /* Para abs */
+#include <string.h>   /* Para memcpy */
+
+/**
+ * @typedef oled_word_t
+ * @brief Palavra de 32 bits que pode apelidar (alias) o buffer de bytes
+ *
+ * @details O framebuffer é declarado como uint8_t[]; o atributo may_alias
+ *          mantém o acesso por palavra válido sob strict aliasing.
+ */
+#if defined(__GNUC__)
+typedef uint32_t __attribute__((may_alias)) oled_word_t;
+#else
+typedef uint32_t oled_word_t;
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: NÚCLEO DE PREENCHIMENTO
+ * =============================================================================
+ */
+
+static inline int floor_div8(int v) {
+    return (v >= 0) ? (v >> 3) : -((7 - v) >> 3);
+}
+
+/**
+ * @brief Aplica `mask` a n bytes consecutivos de uma página
+ *
+ * @param p    Primeiro byte (coluna inicial já recortada)
+ * @param n    Número de colunas
+ * @param mask Bits verticais afetados em cada byte
+ * @param op   Operação (apagar, acender, inverter)
+ */
+static void page_run(uint8_t *p, int n, uint8_t mask, oled_raster_op_t op) {
+    const uint32_t mask32 = (uint32_t)mask * 0x01010101u;
+
+    switch (op) {
+        case OLED_RASTER_CLEAR: {
+            const uint8_t keep = (uint8_t)~mask;
+            for (; n > 0 && ((uintptr_t)p & 3u); n--) *p++ &= keep;
+            for (oled_word_t *w = (oled_word_t *)p; n >= 4; n -= 4, p += 4) *w++ &= ~mask32;
+            for (; n > 0; n--) *p++ &= keep;
+            break;
+        }
+        case OLED_RASTER_INVERT:
+            for (; n > 0 && ((uintptr_t)p & 3u); n--) *p++ ^= mask;
+            for (oled_word_t *w = (oled_word_t *)p; n >= 4; n -= 4, p += 4) *w++ ^= mask32;
+            for (; n > 0; n--) *p++ ^= mask;
+            break;
+        case OLED_RASTER_SET:
+        default:
+            for (; n > 0 && ((uintptr_t)p & 3u); n--) *p++ |= mask;
+            for (oled_word_t *w = (oled_word_t *)p; n >= 4; n -= 4, p += 4) *w++ |= mask32;
+            for (; n > 0; n--) *p++ |= mask;
+            break;
+    }
+}
+
+/**
+ * @brief Preenche o retângulo semiaberto [x0, x1) x [y0, y1) com recorte
+ *
+ * @details Para cada página coberta calcula a máscara vertical (parcial na
+ *          primeira e na última página) e delega a page_run().
+ */
+static void fill_span_rect(const oled_fb_t *fb, int x0, int x1, int y0, int y1,
+                           oled_raster_op_t op) {
+    if (x0 < 0) x0 = 0;
+    if (y0 < 0) y0 = 0;
+    if (x1 > (int)fb->width) x1 = (int)fb->width;
+    if (y1 > (int)fb->height) y1 = (int)fb->height;
+    if (x0 >= x1 || y0 >= y1) {
+        return;
+    }
+
+    const int p_first = y0 >> 3;
+    const int p_last = (y1 - 1) >> 3;
+    uint8_t *row = fb->buf + (size_t)p_first * fb->width + x0;
+
+    for (int p = p_first; p <= p_last; p++, row += fb->width) {
+        uint8_t mask = 0xFFu;
+        if (p == p_first) mask &= (uint8_t)(0xFFu << (y0 & 7));
+        if (p == p_last)  mask &= (uint8_t)(0xFFu >> (7 - ((y1 - 1) & 7)));
+        page_run(row, x1 - x0, mask, op);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: SPANS E RETÂNGULOS
+ * =============================================================================
+ */
+
+void oled_raster_hspan(const oled_fb_t *fb, int x0, int x1, int y, oled_raster_op_t op) {
+    if (x0 > x1) {
+        int t = x0; x0 = x1; x1 = t;
+    }
+    fill_span_rect(fb, x0, x1 + 1, y, y + 1, op);
+}
+
+void oled_raster_vspan(const oled_fb_t *fb, int x, int y0, int y1, oled_raster_op_t op) {
+    if (y0 > y1) {
+        int t = y0; y0 = y1; y1 = t;
+    }
+    fill_span_rect(fb, x, x + 1, y0, y1 + 1, op);
+}
+
+void oled_raster_fill_rect(const oled_fb_t *fb, int x, int y, int w, int h,
+                           oled_raster_op_t op) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    fill_span_rect(fb, x, x + w, y, y + h, op);
+}
+
+void oled_raster_rect(const oled_fb_t *fb, int x, int y, int w, int h,
+                      oled_raster_op_t op) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    /* Topo e base ocupam a largura toda; as laterais só o miolo, sem repetir cantos */
+    fill_span_rect(fb, x, x + w, y, y + 1, op);
+    if (h > 1) {
+        fill_span_rect(fb, x, x + w, y + h - 1, y + h, op);
+    }
+    if (h > 2) {
+        fill_span_rect(fb, x, x + 1, y + 1, y + h - 1, op);
+        if (w > 1) {
+            fill_span_rect(fb, x + w - 1, x + w, y + 1, y + h - 1, op);
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: LINHAS (BRESENHAM POR RUNS)
+ * =============================================================================
+ */
+
+void oled_raster_line(const oled_fb_t *fb, int x0, int y0, int x1, int y1,
+                      oled_raster_op_t op) {
+    /* Rejeição trivial: os dois extremos do mesmo lado de fora da tela */
+    if ((x0 < 0 && x1 < 0) || (y0 < 0 && y1 < 0) ||
+        (x0 >= (int)fb->width && x1 >= (int)fb->width) ||
+        (y0 >= (int)fb->height && y1 >= (int)fb->height)) {
+        return;
+    }
+    if (y0 == y1) {
+        oled_raster_hspan(fb, x0, x1, y0, op);
+        return;
+    }
+    if (x0 == x1) {
+        oled_raster_vspan(fb, x0, y0, y1, op);
+        return;
+    }
+
+    const int dx = abs(x1 - x0);
+    const int dy = -abs(y1 - y0);
+    const int sx = (x0 < x1) ? 1 : -1;
+    const int sy = (y0 < y1) ? 1 : -1;
+    const int x_major = (dx >= -dy);
+    int err = dx + dy;
+
+    /* Início do run corrente (pixels consecutivos no eixo dominante) */
+    int rx = x0, ry = y0;
+
+    for (;;) {
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        const int e2 = 2 * err;
+        int step_x = 0, step_y = 0;
+        if (e2 >= dy) { err += dy; step_x = 1; }
+        if (e2 <= dx) { err += dx; step_y = 1; }
+
+        /* O run termina quando o eixo secundário avança */
+        if (x_major ? step_y : step_x) {
+            if (x_major) oled_raster_hspan(fb, rx, x0, y0, op);
+            else         oled_raster_vspan(fb, x0, ry, y0, op);
+            rx = x0 + (step_x ? sx : 0);
+            ry = y0 + (step_y ? sy : 0);
+        }
+        if (step_x) x0 += sx;
+        if (step_y) y0 += sy;
+    }
+
+    /* Último run, que inclui o ponto final */
+    if (x_major) oled_raster_hspan(fb, rx, x0, y0, op);
+    else         oled_raster_vspan(fb, x0, ry, y0, op);
+}
+
+/* =============================================================================
+ * SEÇÃO 4: BLIT DE BITMAP COM RECORTE
+ * =============================================================================
+ */
+
+void oled_raster_blit(const oled_fb_t *fb, int x, int y, const uint8_t *bitmap,
+                      int w, int h, oled_glyph_mode_t mode) {
+    if (!bitmap || w <= 0 || h <= 0) {
+        return;
+    }
+
+    /* Caminho rápido: tela inteira em modo COPY (ssd1306_draw_bitmap) */
+    if (mode == OLED_GLYPH_COPY && x == 0 && y == 0 &&
+        w == (int)fb->width && h == (int)fb->height) {
+        memcpy(fb->buf, bitmap, (size_t)oled_fb_pages(fb) * fb->width);
+        return;
+    }
+
+    const int src_pages = (h + 7) >> 3;
+    const int fb_pages = (int)oled_fb_pages(fb);
+    const int p0 = floor_div8(y);
+    const unsigned shift = (unsigned)(y - p0 * 8);
+    /* Bits válidos da última página do bitmap (h pode não ser múltiplo de 8) */
+    const uint8_t last_mask = (uint8_t)((h & 7) ? ((1u << (h & 7)) - 1u) : 0xFFu);
+
+    int c_begin = (x < 0) ? -x : 0;
+    int c_end = w;
+    if (x + c_end > (int)fb->width) c_end = (int)fb->width - x;
+
+    int i_begin = (p0 < 0) ? -p0 : 0;
+    int i_end = src_pages + (shift ? 1 : 0);
+    if (p0 + i_end > fb_pages) i_end = fb_pages - p0;
+
+    if (c_begin >= c_end || i_begin >= i_end) {
+        return;
+    }
+
+    for (int i = i_begin; i < i_end; i++) {
+        /* Página de destino i recebe bits das páginas de origem i e i-1 */
+        const uint8_t *cur = (i < src_pages) ? bitmap + (size_t)i * w : NULL;
+        const uint8_t *prev = (shift && i > 0) ? bitmap + (size_t)(i - 1) * w : NULL;
+        const uint8_t m_cur = (i < src_pages) ? ((i == src_pages - 1) ? last_mask : 0xFFu) : 0u;
+        const uint8_t m_prev = prev ? ((i - 1 == src_pages - 1) ? last_mask : 0xFFu) : 0u;
+        const uint8_t mask = (uint8_t)((m_cur << shift) | (shift ? (unsigned)(m_prev >> (8u - shift)) : 0u));
+        uint8_t *dst = fb->buf + (size_t)(p0 + i) * fb->width + x;
+
+        for (int c = c_begin; c < c_end; c++) {
+            uint8_t bits = 0;
+            if (cur)  bits |= (uint8_t)(cur[c] << shift);
+            if (prev) bits |= (uint8_t)(prev[c] >> (8u - shift));
+            bits &= mask;
+
+            switch (mode) {
+                case OLED_GLYPH_COPY: dst[c] = (uint8_t)((dst[c] & (uint8_t)~mask) | bits); break;
+                case OLED_GLYPH_XOR:  dst[c] ^= bits; break;
+                case OLED_GLYPH_OR:
+                default:              dst[c] |= bits; break;
+            }
+        }
+    }
+}
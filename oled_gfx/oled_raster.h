@@ -0,0 +1,119 @@
+/**
+ * =============================================================================
+ * @file    oled_raster.h
+ * @brief   Primitivas de rasterização rápidas para o framebuffer do SSD1306
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details oled_draw_line() e ssd1306_draw_line() chamam set_pixel a cada
+ *          passo e o driver não oferece retângulos, spans nem blit com
+ *          recorte. Este módulo trabalha direto sobre o layout em páginas:
+ *
+ *          ┌──────────────────────┬──────────────────────────────────────┐
+ *          │ Primitiva            │ Estratégia                           │
+ *          ├──────────────────────┼──────────────────────────────────────┤
+ *          │ span horizontal      │ máscara de 1 bit replicada em        │
+ *          │                      │ palavras de 32 bits (4 colunas/op)   │
+ *          │ span vertical        │ 1 byte por página (topo/base com     │
+ *          │                      │ máscara parcial, meio com 0xFF)      │
+ *          │ retângulo preenchido │ máscara por página + palavras        │
+ *          │ linha (Bresenham)    │ acumula "runs" e emite spans         │
+ *          │ blit de bitmap       │ deslocamento por página + recorte    │
+ *          └──────────────────────┴──────────────────────────────────────┘
+ *
+ *          Todas as coordenadas são recortadas contra o framebuffer; valores
+ *          negativos ou fora da tela são aceitos.
+ * =============================================================================
+ */
+
+#ifndef OLED_RASTER_H
+#define OLED_RASTER_H
+
+#include <stdint.h>
+#include "oled_fb.h"
+#include "oled_glyph.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @enum oled_raster_op_t
+ * @brief Operação aplicada aos pixels cobertos pela primitiva
+ *
+ * @var OLED_RASTER_CLEAR  Apaga os pixels (equivale a set_pixel(..., false))
+ * @var OLED_RASTER_SET    Acende os pixels (equivale a set_pixel(..., true))
+ * @var OLED_RASTER_INVERT Inverte os pixels
+ */
+typedef enum {
+    OLED_RASTER_CLEAR  = 0,
+    OLED_RASTER_SET    = 1,
+    OLED_RASTER_INVERT = 2,
+} oled_raster_op_t;
+
+/**
+ * @brief Span horizontal de x0 a x1 (inclusive) na linha y
+ */
+void oled_raster_hspan(const oled_fb_t *fb, int x0, int x1, int y, oled_raster_op_t op);
+
+/**
+ * @brief Span vertical de y0 a y1 (inclusive) na coluna x
+ */
+void oled_raster_vspan(const oled_fb_t *fb, int x, int y0, int y1, oled_raster_op_t op);
+
+/**
+ * @brief Retângulo preenchido com canto em (x, y) e tamanho w x h
+ */
+void oled_raster_fill_rect(const oled_fb_t *fb, int x, int y, int w, int h,
+                           oled_raster_op_t op);
+
+/**
+ * @brief Contorno de retângulo com canto em (x, y) e tamanho w x h
+ *
+ * @note  Cada pixel do contorno é tocado uma única vez, de modo que
+ *        OLED_RASTER_INVERT produz um contorno limpo.
+ */
+void oled_raster_rect(const oled_fb_t *fb, int x, int y, int w, int h,
+                      oled_raster_op_t op);
+
+/**
+ * @brief Linha de (x0, y0) a (x1, y1) por Bresenham inteiro
+ *
+ * @details Em vez de um set_pixel por passo, o algoritmo acumula os pixels
+ *          consecutivos no eixo dominante ("run") e os escreve com um único
+ *          span. Linhas horizontais/verticais viram um span direto.
+ *          O conjunto de pixels é o mesmo do Bresenham clássico usado por
+ *          ssd1306_draw_line().
+ */
+void oled_raster_line(const oled_fb_t *fb, int x0, int y0, int x1, int y1,
+                      oled_raster_op_t op);
+
+/**
+ * @brief Copia um bitmap (no layout em páginas) para (x, y) com recorte
+ *
+ * @details Generaliza ssd1306_draw_bitmap(), que só copia a tela inteira:
+ *          o bitmap pode ter qualquer tamanho, ficar parcialmente fora da
+ *          tela e começar em qualquer y. Quando cobre exatamente o
+ *          framebuffer em modo COPY, vira um memcpy único.
+ *
+ * @param fb     Framebuffer de destino
+ * @param x      Coluna de destino do canto superior esquerdo
+ * @param y      Linha de destino do canto superior esquerdo
+ * @param bitmap Bytes em páginas: ceil(h / 8) páginas de w bytes
+ * @param w      Largura do bitmap em pixels
+ * @param h      Altura do bitmap em pixels
+ * @param mode   Mesmos modos de composição dos glifos (OR, COPY, XOR)
+ */
+void oled_raster_blit(const oled_fb_t *fb, int x, int y, const uint8_t *bitmap,
+                      int w, int h, oled_glyph_mode_t mode);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OLED_RASTER_H */
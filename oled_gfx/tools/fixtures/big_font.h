@@ -0,0 +1,33 @@
+/*
+ * Fonte 16x32 mínima no formato de big_font.h (OLED_SSD1306-RP2040-RP2350),
+ * usada pelo oled_glyph_atlas_test: 4 glifos esparsos, cada um com 4 páginas
+ * de 16 bytes (página a página, bit 0 no topo). Os comentários "ASCII: n"
+ * dão o código de cada glifo.
+ */
+
+static const uint8_t big_font[][64] = {
+    { // ASCII: 48 '0'
+      0x2b, 0xd5, 0x51, 0x45, 0x9c, 0xd2, 0xc7, 0x4c, 0x64, 0xc0, 0x07, 0x36, 0xc7, 0x25, 0x1a, 0xb1,
+      0xb4, 0x0d, 0x0d, 0xf3, 0xa7, 0x9b, 0xe6, 0xa6, 0x3e, 0xfe, 0xee, 0x57, 0x4e, 0x69, 0xde, 0xac,
+      0xea, 0x77, 0x23, 0xcc, 0x11, 0x64, 0x58, 0x17, 0x18, 0xe7, 0x60, 0xf7, 0x0a, 0x42, 0x6f, 0x46,
+      0xd2, 0x5f, 0xc7, 0x8b, 0xd9, 0xd4, 0x28, 0xc4, 0x9c, 0x5f, 0xb0, 0x59, 0x86, 0xed, 0xfe, 0xd4,
+    },
+    { // ASCII: 55 '7'
+      0x93, 0xef, 0x5a, 0xa6, 0xf6, 0xe3, 0x3d, 0x8c, 0x30, 0x6d, 0x76, 0x02, 0x2f, 0xe8, 0xa9, 0xd1,
+      0x5d, 0x0d, 0xb4, 0x50, 0xb4, 0x6e, 0x38, 0x8f, 0x6d, 0x96, 0x89, 0x43, 0x33, 0x87, 0x31, 0xdf,
+      0x57, 0x36, 0x1e, 0xb6, 0x5e, 0x36, 0xa0, 0x8d, 0x20, 0x95, 0xa1, 0x52, 0x85, 0x83, 0x20, 0x07,
+      0xd2, 0x83, 0xd4, 0x07, 0x1d, 0x31, 0x78, 0x0b, 0x9e, 0x3e, 0x30, 0xb3, 0xa1, 0xe9, 0x13, 0xce,
+    },
+    { // ASCII: 65 'A'
+      0xa1, 0x6e, 0xec, 0xda, 0x3d, 0xbf, 0x80, 0xc7, 0x95, 0xb6, 0x1d, 0xdf, 0x0c, 0x90, 0xa9, 0x95,
+      0x3e, 0x98, 0xd5, 0xa3, 0x0a, 0xaf, 0x65, 0x1c, 0x39, 0x53, 0x3e, 0x3c, 0x13, 0x40, 0xb5, 0x9a,
+      0x0e, 0xd9, 0x40, 0xb6, 0xd4, 0xc4, 0xc1, 0x7a, 0xd7, 0x70, 0x40, 0x5d, 0x0e, 0xcb, 0x82, 0x4b,
+      0xf4, 0x0b, 0x08, 0x8d, 0xf5, 0xd5, 0x87, 0xa1, 0x46, 0x2d, 0x5b, 0x13, 0x87, 0xae, 0xa2, 0x9c,
+    },
+    { // ASCII: 90 'Z'
+      0x05, 0x7c, 0xf0, 0x1d, 0x71, 0x4d, 0xcc, 0xb8, 0x77, 0x8d, 0xaf, 0x66, 0xbf, 0xb7, 0xeb, 0xeb,
+      0xf2, 0x9f, 0x60, 0x51, 0xd2, 0x4e, 0xf8, 0x02, 0xb5, 0xd1, 0x13, 0x58, 0x2b, 0x99, 0xbe, 0x87,
+      0x46, 0x33, 0x09, 0x6f, 0x9d, 0x16, 0xc9, 0xc2, 0x50, 0x35, 0x2b, 0x48, 0xc7, 0xaa, 0x85, 0x9e,
+      0x95, 0x61, 0x53, 0x95, 0x97, 0x92, 0xb6, 0x44, 0xc6, 0x60, 0x04, 0xf5, 0xd8, 0xb6, 0x57, 0x8f,
+    },
+};
@@ -0,0 +1,25 @@
+/*
+ * Fonte 8x8 mínima no formato de ssd1306_font.h (OLED_SSD1306-RP2040-RP2350),
+ * usada pelo oled_glyph_atlas_test: ASCII 32..47, um byte por coluna com o
+ * bit 0 no topo. Os padrões são arbitrários, mas acendem as quatro bordas da
+ * caixa do glifo.
+ */
+
+static uint8_t font[] = {
+0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // espaço
+0x3d, 0xa3, 0x34, 0x72, 0xd7, 0xfb, 0xe1, 0xfa,  // !
+0x81, 0x29, 0x38, 0x93, 0x32, 0xe6, 0x05, 0xfb,  // "
+0xa1, 0x6b, 0xcb, 0x80, 0xb2, 0xb6, 0xc0, 0x3f,  // #
+0xaf, 0x2d, 0x95, 0x93, 0xea, 0x48, 0x9e, 0x8c,  // $
+0xbd, 0xba, 0xec, 0xd8, 0x2e, 0xcc, 0xff, 0xbb,  // %
+0xd9, 0xfb, 0xcb, 0x84, 0xd7, 0xf5, 0x0c, 0x7a,  // &
+0x43, 0x19, 0x34, 0xdb, 0xf0, 0x48, 0xf6, 0xf5,  // '
+0xbf, 0xe9, 0xf0, 0x80, 0xcd, 0x9d, 0xf5, 0xcd,  // (
+0xdd, 0x67, 0x96, 0x89, 0x04, 0x10, 0x4c, 0xfa,  // )
+0xfb, 0xb8, 0x66, 0x85, 0xf8, 0xee, 0xfe, 0xde,  // *
+0x11, 0x94, 0xa2, 0xea, 0x32, 0xe0, 0x84, 0xe7,  // +
+0xdd, 0xd9, 0xf5, 0x20, 0x88, 0xff, 0xbd, 0x39,  // ,
+0x63, 0xd2, 0x4a, 0xe6, 0x07, 0x2f, 0x00, 0xe7,  // -
+0xab, 0x65, 0x7e, 0x3d, 0x16, 0x89, 0xb6, 0xcf,  // .
+0x03, 0xa0, 0xfb, 0x45, 0x72, 0xf2, 0x43, 0x9c,  // /
+};
@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""
+Gera o atlas de glifos (oled_glyph_atlas.c) a partir das fontes do driver
+OLED_SSD1306: ssd1306_font.h (8x8) e big_font.h (16x32).
+
+Formato de saída (ver oled_glyph.h):
+    data[(glifo * width + coluna) * pages + pagina]
+
+- ssd1306_font.h já é column-major com 1 página: os bytes são copiados.
+- big_font.h guarda cada glifo página a página (4 x 16 bytes); aqui ele é
+  transposto para que as 4 páginas de uma coluna fiquem contíguas.
+
+Uso:
+    gen_glyph_atlas.py --font ssd1306_font.h --big-font big_font.h -o oled_glyph_atlas.c
+"""
+
+import argparse
+import re
+import sys
+
+HEX_RE = re.compile(r"0[xX][0-9a-fA-F]{1,2}")
+ASCII_RE = re.compile(r"ASCII:\s*(\d+)")
+
+
+def strip_comments(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    return re.sub(r"//[^\n]*", "", text)
+
+
+def array_body(text, name):
+    """Retorna o texto entre as chaves do inicializador de `name`."""
+    m = re.search(r"\b" + re.escape(name) + r"\s*\[[^=]*=\s*\{", text)
+    if not m:
+        raise ValueError("array '%s' não encontrado" % name)
+    depth, i = 1, m.end()
+    while depth and i < len(text):
+        if text[i] == "{":
+            depth += 1
+        elif text[i] == "}":
+            depth -= 1
+        i += 1
+    return text[m.end():i - 1]
+
+
+def parse_small_font(path):
+    raw = open(path, encoding="utf-8", errors="replace").read()
+    body = array_body(strip_comments(raw), "font")
+    data = [int(h, 16) for h in HEX_RE.findall(body)]
+    if len(data) % 8:
+        raise ValueError("%s: %d bytes não é múltiplo de 8" % (path, len(data)))
+    return data
+
+
+def parse_big_font(path, width=16, pages=4):
+    raw = open(path, encoding="utf-8", errors="replace").read()
+    glyph_bytes = width * pages
+    codes = [int(c) for c in ASCII_RE.findall(array_body(raw, "big_font"))]
+    body = array_body(strip_comments(raw), "big_font")
+    glyphs = []
+    for group in re.findall(r"\{([^{}]*)\}", body):
+        vals = [int(h, 16) for h in HEX_RE.findall(group)]
+        if len(vals) != glyph_bytes:
+            raise ValueError("%s: glifo com %d bytes (esperado %d)"
+                             % (path, len(vals), glyph_bytes))
+        # página-major (p * width + c) -> coluna-major (c * pages + p)
+        glyphs.append([vals[p * width + c] for c in range(width) for p in range(pages)])
+    if len(codes) != len(glyphs):
+        # Sem comentários "ASCII: n": ordem padrão do big_font.h
+        order = [ord(ch) for ch in "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"]
+        codes = order[:len(glyphs)]
+    return codes, glyphs
+
+
+def emit_bytes(out, data, per_line):
+    for i in range(0, len(data), per_line):
+        out.append("    " + ", ".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    ap.add_argument("--font", help="caminho de ssd1306_font.h")
+    ap.add_argument("--big-font", help="caminho de big_font.h")
+    ap.add_argument("-o", "--output", required=True)
+    args = ap.parse_args()
+
+    out = [
+        "/* Arquivo gerado por tools/gen_glyph_atlas.py - NÃO EDITAR. */",
+        "",
+        '#include "oled_glyph_atlas.h"',
+        "",
+    ]
+
+    if args.font:
+        small = parse_small_font(args.font)
+        count = len(small) // 8
+        out.append("static const uint8_t font_8x8_data[%d] = {" % len(small))
+        emit_bytes(out, small, 8)
+        out += [
+            "};",
+            "",
+            "const oled_glyph_font_t oled_glyph_font_8x8 = {",
+            "    .width = 8, .pages = 1, .advance = 8,",
+            "    .first = 32, .count = %d," % count,
+            "    .map = NULL, .data = font_8x8_data,",
+            "};",
+            "",
+        ]
+
+    if args.big_font:
+        codes, glyphs = parse_big_font(args.big_font)
+        lut = [0xFF] * 128
+        for index, code in enumerate(codes):
+            lut[code] = index
+        flat = [b for g in glyphs for b in g]
+        out.append("static const uint8_t font_big_map[128] = {")
+        emit_bytes(out, lut, 16)
+        out.append("};")
+        out.append("")
+        out.append("static const uint8_t font_big_data[%d] = {" % len(flat))
+        emit_bytes(out, flat, 16)
+        out += [
+            "};",
+            "",
+            "const oled_glyph_font_t oled_glyph_font_big = {",
+            "    .width = 16, .pages = 4, .advance = 16,",
+            "    .first = 0, .count = %d," % len(glyphs),
+            "    .map = font_big_map, .data = font_big_data,",
+            "};",
+            "",
+        ]
+
+    with open(args.output, "w", encoding="utf-8") as f:
+        f.write("\n".join(out))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
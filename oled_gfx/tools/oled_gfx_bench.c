@@ -0,0 +1,379 @@
+/**
+ * =============================================================================
+ * @file    oled_gfx_bench.c
+ * @brief   (Host) Verificação e benchmark das primitivas do oled_gfx
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada primitiva é comparada, em milhares de casos aleatórios com
+ *          recorte em todas as bordas, com uma referência pixel a pixel
+ *          (o set_pixel do driver). Depois mede a vazão da primitiva e da
+ *          referência numa tela 128x64 e imprime o ganho.
+ *
+ *          A verificação e o texto usam uma fonte 8x8 sintética: o atlas
+ *          real só existe quando as fontes do submódulo OLED estão presentes.
+ *          Com Python3, o CMake compila também o atlas gerado das fontes de
+ *          tools/fixtures/ (OLED_GFX_BENCH_ATLAS) e a vazão em glifos/s do
+ *          8x8 e do 16x32 é medida sobre ele.
+ *
+ *          Uso: oled_gfx_bench [-q]   (-q: menos repetições)
+ *          Retorno: 0 se todas as primitivas forem idênticas à referência.
+ * =============================================================================
+ */
+
+#include "oled_glyph.h"
+#include "oled_glyph_atlas.h"
+#include "oled_raster.h"
+#include "bench_report.h"
+#include "test_check.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define W 128
+#define H 64
+#define FB_BYTES (W * H / 8)
+
+static uint8_t buf_fast[FB_BYTES];
+static uint8_t buf_ref[FB_BYTES];
+static const oled_fb_t fb_fast = OLED_FB_INIT(buf_fast, W, H);
+
+static uint32_t rng = 1u;
+
+static int rnd(int lo, int hi) {
+    rng = rng * 1664525u + 1013904223u;
+    return lo + (int)((rng >> 8) % (uint32_t)(hi - lo + 1));
+}
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* =============================================================================
+ * SEÇÃO 1: REFERÊNCIA PIXEL A PIXEL
+ * =============================================================================
+ */
+
+static void ref_pixel(int x, int y, oled_raster_op_t op) {
+    if (x < 0 || y < 0 || x >= W || y >= H) {
+        return;
+    }
+    uint8_t *p = &buf_ref[(y >> 3) * W + x];
+    const uint8_t bit = (uint8_t)(1u << (y & 7));
+    if (op == OLED_RASTER_SET) {
+        *p |= bit;
+    } else if (op == OLED_RASTER_CLEAR) {
+        *p &= (uint8_t)~bit;
+    } else {
+        *p ^= bit;
+    }
+}
+
+static void ref_fill_rect(int x, int y, int w, int h, oled_raster_op_t op) {
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) {
+            ref_pixel(i, j, op);
+        }
+    }
+}
+
+/** Contorno com cada pixel tocado uma vez (importa para INVERT) */
+static void ref_rect(int x, int y, int w, int h, oled_raster_op_t op) {
+    if (w <= 0 || h <= 0) {
+        return;
+    }
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) {
+            if (j == y || j == y + h - 1 || i == x || i == x + w - 1) {
+                ref_pixel(i, j, op);
+            }
+        }
+    }
+}
+
+/** Bresenham de ssd1306_draw_line() */
+static void ref_line(int x0, int y0, int x1, int y1, oled_raster_op_t op) {
+    const int dx = abs(x1 - x0);
+    const int dy = -abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1;
+    const int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+        ref_pixel(x0, y0, op);
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        const int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+}
+
+static void ref_blit(int x, int y, const uint8_t *bitmap, int w, int h, oled_glyph_mode_t mode) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            const bool on = (bitmap[(j >> 3) * w + i] >> (j & 7)) & 1u;
+            if (mode == OLED_GLYPH_COPY) {
+                ref_pixel(x + i, y + j, on ? OLED_RASTER_SET : OLED_RASTER_CLEAR);
+            } else if (on) {
+                ref_pixel(x + i, y + j, mode == OLED_GLYPH_XOR ? OLED_RASTER_INVERT
+                                                                : OLED_RASTER_SET);
+            }
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: FONTE SINTÉTICA
+ * =============================================================================
+ */
+
+#define FONT_FIRST 32
+#define FONT_COUNT 95
+
+static uint8_t font_data[FONT_COUNT * 8];
+static const oled_glyph_font_t font = { 8, 1, 8, FONT_FIRST, FONT_COUNT, NULL, font_data };
+
+static void make_font(void) {
+    for (size_t i = 0; i < sizeof font_data; i++) {
+        font_data[i] = (uint8_t)rnd(0, 255);
+    }
+}
+
+/** Glifo 8x8 de uma página: um byte por coluna, como um bitmap 8x8 */
+static void ref_char(int x, int y, char c, oled_glyph_mode_t mode) {
+    const int idx = (unsigned char)c - FONT_FIRST;
+    static const uint8_t blank[8] = { 0 };
+    const uint8_t *g = (idx >= 0 && idx < FONT_COUNT) ? font_data + idx * 8 : blank;
+    ref_blit(x, y, g, 8, 8, mode);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: VERIFICAÇÃO
+ * =============================================================================
+ */
+
+static void compare(const char *what, unsigned iter) {
+    if (memcmp(buf_fast, buf_ref, FB_BYTES) != 0) {
+        if (failures < 10u) {
+            printf("FALHA %s (caso %u)\n", what, iter);
+        }
+        failures++;
+    }
+}
+
+static void start_case(void) {
+    /* Fundo aleatório: CLEAR e INVERT precisam de pixels acesos */
+    for (size_t i = 0; i < FB_BYTES; i++) {
+        buf_fast[i] = buf_ref[i] = (uint8_t)rnd(0, 255);
+    }
+}
+
+static void verify(unsigned cases) {
+    static uint8_t bitmap[4 * 40];
+    for (unsigned it = 0; it < cases; it++) {
+        const oled_raster_op_t op = (oled_raster_op_t)rnd(0, 2);
+        const int x = rnd(-20, W + 4), y = rnd(-20, H + 4);
+        const int x1 = rnd(-20, W + 20), y1 = rnd(-20, H + 20);
+        const int w = rnd(0, 60), h = rnd(0, 40);
+
+        start_case();
+        oled_raster_hspan(&fb_fast, x, x1, y, op);
+        for (int i = (x < x1 ? x : x1); i <= (x < x1 ? x1 : x); i++) {
+            ref_pixel(i, y, op);
+        }
+        compare("hspan", it);
+
+        start_case();
+        oled_raster_vspan(&fb_fast, x, y, y1, op);
+        for (int j = (y < y1 ? y : y1); j <= (y < y1 ? y1 : y); j++) {
+            ref_pixel(x, j, op);
+        }
+        compare("vspan", it);
+
+        start_case();
+        oled_raster_fill_rect(&fb_fast, x, y, w, h, op);
+        ref_fill_rect(x, y, w, h, op);
+        compare("fill_rect", it);
+
+        start_case();
+        oled_raster_rect(&fb_fast, x, y, w, h, op);
+        ref_rect(x, y, w, h, op);
+        compare("rect", it);
+
+        start_case();
+        oled_raster_line(&fb_fast, x, y, x1, y1, op);
+        ref_line(x, y, x1, y1, op);
+        compare("line", it);
+
+        const int bw = rnd(1, 40), bh = rnd(1, 32);
+        for (int i = 0; i < ((bh + 7) / 8) * bw; i++) {
+            bitmap[i] = (uint8_t)rnd(0, 255);
+        }
+        const oled_glyph_mode_t mode = (oled_glyph_mode_t)rnd(0, 2);
+        start_case();
+        oled_raster_blit(&fb_fast, x, y, bitmap, bw, bh, mode);
+        ref_blit(x, y, bitmap, bw, bh, mode);
+        compare("blit", it);
+
+        const char c = (char)rnd(FONT_FIRST - 2, FONT_FIRST + FONT_COUNT);
+        start_case();
+        oled_glyph_draw_char(&fb_fast, &font, x, y, c, mode);
+        ref_char(x, y, c, mode);
+        compare("draw_char", it);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: BENCHMARK
+ * =============================================================================
+ */
+
+typedef void (*draw_fn_t)(unsigned i);
+
+static void fast_fill(unsigned i) {
+    oled_raster_fill_rect(&fb_fast, (int)(i & 15u), (int)(i & 7u), 100, 40, OLED_RASTER_INVERT);
+}
+static void ref_fill(unsigned i) {
+    ref_fill_rect((int)(i & 15u), (int)(i & 7u), 100, 40, OLED_RASTER_INVERT);
+}
+static void fast_line(unsigned i) {
+    oled_raster_line(&fb_fast, 0, (int)(i & 63u), W - 1, 63 - (int)(i & 63u), OLED_RASTER_INVERT);
+}
+static void ref_line_i(unsigned i) {
+    ref_line(0, (int)(i & 63u), W - 1, 63 - (int)(i & 63u), OLED_RASTER_INVERT);
+}
+static void fast_text(unsigned i) {
+    oled_glyph_draw_string(&fb_fast, &font, 0, (int)(i % 57u), "Temp 23.5C Lux 812", OLED_GLYPH_OR);
+}
+static void ref_text(unsigned i) {
+    const char *s = "Temp 23.5C Lux 812";
+    for (int k = 0; s[k] && k * 8 + 8 <= W; k++) {
+        ref_char(k * 8, (int)(i % 57u), s[k], OLED_GLYPH_OR);
+    }
+}
+
+#if defined(OLED_GFX_BENCH_ATLAS) && OLED_GFX_BENCH_ATLAS
+/* Glifos do atlas gerado da fixture; a referência é o set_pixel por bit do
+ * oled_draw_char(), lendo o mesmo atlas */
+static void ref_atlas_char(const oled_glyph_font_t *f, int x, int y, char c,
+                           oled_glyph_mode_t mode) {
+    const uint8_t *g = oled_glyph_lookup(f, c);
+    for (int col = 0; col < f->width; col++) {
+        for (int p = 0; p < f->pages; p++) {
+            const uint8_t b = g ? g[col * f->pages + p] : 0u;
+            for (int j = 0; j < 8; j++) {
+                const bool on = (b >> j) & 1u;
+                if (mode == OLED_GLYPH_COPY) {
+                    ref_pixel(x + col, y + p * 8 + j, on ? OLED_RASTER_SET : OLED_RASTER_CLEAR);
+                } else if (on) {
+                    ref_pixel(x + col, y + p * 8 + j, OLED_RASTER_SET);
+                }
+            }
+        }
+    }
+}
+
+static void fast_glyph8_aligned(unsigned i) {
+    oled_glyph_draw_char(&fb_fast, &oled_glyph_font_8x8, (int)(i % 15u) * 8,
+                         (int)((i >> 4) & 7u) * 8, (char)(33u + i % 15u), OLED_GLYPH_COPY);
+}
+static void ref_glyph8_aligned(unsigned i) {
+    ref_atlas_char(&oled_glyph_font_8x8, (int)(i % 15u) * 8, (int)((i >> 4) & 7u) * 8,
+                   (char)(33u + i % 15u), OLED_GLYPH_COPY);
+}
+static void fast_glyph8(unsigned i) {
+    oled_glyph_draw_char(&fb_fast, &oled_glyph_font_8x8, (int)(i % 120u), (int)(i % 57u),
+                         (char)(33u + i % 15u), OLED_GLYPH_OR);
+}
+static void ref_glyph8(unsigned i) {
+    ref_atlas_char(&oled_glyph_font_8x8, (int)(i % 120u), (int)(i % 57u),
+                   (char)(33u + i % 15u), OLED_GLYPH_OR);
+}
+static void fast_glyph_big(unsigned i) {
+    oled_glyph_draw_char(&fb_fast, &oled_glyph_font_big, (int)(i % 7u) * 16, (int)(i % 33u),
+                         "07AZ"[i & 3u], OLED_GLYPH_OR);
+}
+static void ref_glyph_big(unsigned i) {
+    ref_atlas_char(&oled_glyph_font_big, (int)(i % 7u) * 16, (int)(i % 33u), "07AZ"[i & 3u],
+                   OLED_GLYPH_OR);
+}
+#endif
+
+/** Operações por segundo num lote de pelo menos 20 ms */
+static double batch(draw_fn_t fn, unsigned reps) {
+    unsigned n = 0;
+    double dt;
+    const double t0 = now_s();
+    do {
+        for (unsigned i = 0; i < reps; i++) {
+            fn(n + i);
+        }
+        n += reps;
+        dt = now_s() - t0;
+    } while (dt < 0.02);
+    return n / dt;
+}
+
+/**
+ * Melhor de 5 lotes de cada implementação, alternados: uma carga externa
+ * longa atinge as duas medições, e o ganho continua estável.
+ */
+static void bench(const char *name, const char *metric, const char *unit, draw_fn_t fast,
+                  draw_fn_t ref, unsigned reps) {
+    double r_fast = 0.0, r_ref = 0.0;
+    for (int k = 0; k < 5; k++) {
+        const double f = batch(fast, reps);
+        const double r = batch(ref, reps / 8u + 1u);
+        r_fast = f > r_fast ? f : r_fast;
+        r_ref = r > r_ref ? r : r_ref;
+    }
+    printf("%-22s %10.0f %-7s  referência %9.0f %-7s  ganho %5.1fx  (sink %02x)\n", name,
+           r_fast, unit, r_ref, unit, r_fast / r_ref,
+           buf_fast[FB_BYTES / 2] ^ buf_ref[FB_BYTES / 3]);
+
+    /* "op/s" -> metrica_op_s, "glyph/s" -> metrica_glyph_s */
+    char m[48];
+    snprintf(m, sizeof m, "%s_%s", metric, unit);
+    *strchr(m, '/') = '_';
+    bench_report("oled_gfx_bench", m, r_fast, unit);
+    snprintf(m, sizeof m, "%s_speedup", metric);
+    bench_report("oled_gfx_bench", m, r_fast / r_ref, "x");
+}
+
+int main(int argc, char **argv) {
+    const bool quick = argc > 1 && strcmp(argv[1], "-q") == 0;
+
+    make_font();
+    verify(quick ? 2000u : 20000u);
+    const int status = test_check_summary();
+
+    const unsigned reps = quick ? 20000u : 200000u;
+    bench("fill_rect 100x40", "fill_rect", "op/s", fast_fill, ref_fill, reps);
+    bench("linha 128 px", "line", "op/s", fast_line, ref_line_i, reps);
+    bench("texto 18 glifos", "text", "op/s", fast_text, ref_text, reps);
+#if defined(OLED_GFX_BENCH_ATLAS) && OLED_GFX_BENCH_ATLAS
+    bench("glifo 8x8 alinhado", "glyph8_aligned", "glyph/s", fast_glyph8_aligned,
+          ref_glyph8_aligned, reps * 4u);
+    bench("glifo 8x8", "glyph8", "glyph/s", fast_glyph8, ref_glyph8, reps * 4u);
+    bench("glifo 16x32", "glyph_big", "glyph/s", fast_glyph_big, ref_glyph_big, reps);
+#endif
+
+    return status;
+}
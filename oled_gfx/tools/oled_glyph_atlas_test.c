@@ -0,0 +1,225 @@
+/**
+ * =============================================================================
+ * @file    oled_glyph_atlas_test.c
+ * @brief   (Host) Confere o atlas gerado contra a fonte de origem, pixel a pixel
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details O CMake roda o tools/gen_glyph_atlas.py sobre as fontes mínimas de
+ *          tools/fixtures/ (mesmo formato de ssd1306_font.h e big_font.h) e
+ *          compila o atlas resultante junto com este teste. Os arrays de
+ *          origem (`font` e `big_font`) são incluídos diretamente e servem de
+ *          referência: cada glifo é desenhado pixel a pixel a partir deles e
+ *          comparado com o blitter do oled_glyph, que só enxerga o atlas.
+ *
+ *          - oled_glyph_draw_char() em OR/COPY/XOR, com y alinhado e
+ *            desalinhado, recorte nas quatro bordas e caracteres sem glifo;
+ *          - fonte 8x8 (1 página, first/count) e 16x32 (4 páginas
+ *            transpostas pelo gerador, mapa ASCII esparso);
+ *          - oled_glyph_draw_string() e oled_glyph_write_line().
+ *
+ *          Uso: oled_glyph_atlas_test
+ *          Retorno: 0 se todos os glifos conferirem, 1 caso contrário.
+ * =============================================================================
+ */
+
+#include "oled_glyph.h"
+#include "oled_glyph_atlas.h"
+#include "test_check.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Fontes de origem, no formato do driver OLED */
+#include "ssd1306_font.h"
+#include "big_font.h"
+
+#define W 128
+#define H 64
+#define FB_BYTES (W * H / 8)
+
+#define SMALL_FIRST 32
+#define SMALL_COUNT ((int)(sizeof font / 8u))
+#define BIG_COUNT   ((int)(sizeof big_font / sizeof big_font[0]))
+
+/** Códigos dos glifos do big_font.h da fixture, na ordem do arquivo */
+static const char big_codes[] = "07AZ";
+
+static unsigned cases;
+
+static uint8_t buf[FB_BYTES];
+static uint8_t ref[FB_BYTES];
+static const oled_fb_t fb = OLED_FB_INIT(buf, W, H);
+
+static uint32_t rng = 7u;
+
+static uint8_t rnd8(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return (uint8_t)(rng >> 24);
+}
+
+/* =============================================================================
+ * SEÇÃO 1: REFERÊNCIA A PARTIR DA FONTE DE ORIGEM
+ * =============================================================================
+ */
+
+static void ref_pixel(int x, int y, bool on, oled_glyph_mode_t mode) {
+    if (x < 0 || y < 0 || x >= W || y >= H) {
+        return;
+    }
+    uint8_t *p = &ref[(y >> 3) * W + x];
+    const uint8_t bit = (uint8_t)(1u << (y & 7));
+    if (mode == OLED_GLYPH_COPY) {
+        *p = on ? (uint8_t)(*p | bit) : (uint8_t)(*p & ~bit);
+    } else if (on) {
+        *p = (mode == OLED_GLYPH_XOR) ? (uint8_t)(*p ^ bit) : (uint8_t)(*p | bit);
+    }
+}
+
+/**
+ * @brief Desenha um glifo da origem pixel a pixel
+ *
+ * @param src   Bytes do glifo no layout página a página da origem
+ *              (src[p * w + c], bit 0 no topo), ou NULL se não houver glifo
+ */
+static void ref_glyph(const uint8_t *src, int w, int pages, int x, int y,
+                      oled_glyph_mode_t mode) {
+    for (int p = 0; p < pages; p++) {
+        for (int c = 0; c < w; c++) {
+            const uint8_t b = src ? src[p * w + c] : 0u;
+            for (int j = 0; j < 8; j++) {
+                ref_pixel(x + c, y + p * 8 + j, (b >> j) & 1u, mode);
+            }
+        }
+    }
+}
+
+/** Glifo de origem da fonte 8x8 (um byte por coluna já é uma página) */
+static const uint8_t *small_src(char c) {
+    const int i = (unsigned char)c - SMALL_FIRST;
+    return (i >= 0 && i < SMALL_COUNT) ? &font[i * 8] : NULL;
+}
+
+static const uint8_t *big_src(char c) {
+    const char *hit = (c != '\0') ? strchr(big_codes, c) : NULL;
+    return hit ? big_font[hit - big_codes] : NULL;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: CASOS
+ * =============================================================================
+ */
+
+static void start(void) {
+    for (size_t i = 0; i < FB_BYTES; i++) {
+        buf[i] = ref[i] = rnd8();
+    }
+}
+
+static void compare(const char *what, char c, int x, int y, int mode) {
+    cases++;
+    if (memcmp(buf, ref, FB_BYTES) != 0) {
+        if (failures < 20u) {
+            printf("FALHA %s '%c' (0x%02x) em (%d, %d), modo %d\n", what,
+                   (c >= 32 && c < 127) ? c : '?', (unsigned char)c, x, y, mode);
+        }
+        failures++;
+    }
+}
+
+/* Posições: alinhadas, desalinhadas e recortadas em cada borda */
+static const int pos[][2] = {
+    { 0, 0 }, { 40, 8 }, { 13, 3 }, { 64, 29 }, { -3, 0 }, { -5, -5 }, { 10, -8 },
+    { 7, -13 }, { W - 5, 16 }, { W - 4, H - 3 }, { 50, H - 7 }, { 50, H - 30 },
+    { -20, 4 }, { W, 4 }, { 4, H }, { 3, -40 },
+};
+
+static void test_font(const char *name, const oled_glyph_font_t *f, const char *chars,
+                      const uint8_t *(*src)(char)) {
+    for (const char *s = chars; *s; s++) {
+        for (size_t i = 0; i < sizeof pos / sizeof pos[0]; i++) {
+            for (int mode = OLED_GLYPH_OR; mode <= OLED_GLYPH_XOR; mode++) {
+                start();
+                oled_glyph_draw_char(&fb, f, pos[i][0], pos[i][1], *s, (oled_glyph_mode_t)mode);
+                ref_glyph(src(*s), f->width, f->pages, pos[i][0], pos[i][1],
+                          (oled_glyph_mode_t)mode);
+                compare(name, *s, pos[i][0], pos[i][1], mode);
+            }
+        }
+    }
+}
+
+static void test_string(void) {
+    static const char *const strs[] = { "!\"#$%&'()*+,-./", "  /.-,!", "#%0A~#" };
+    for (size_t i = 0; i < sizeof strs / sizeof strs[0]; i++) {
+        for (size_t k = 0; k < sizeof pos / sizeof pos[0]; k++) {
+            for (int mode = OLED_GLYPH_OR; mode <= OLED_GLYPH_XOR; mode++) {
+                const int x0 = pos[k][0], y0 = pos[k][1];
+                start();
+                const int end = oled_glyph_draw_string(&fb, &oled_glyph_font_8x8, x0, y0,
+                                                       strs[i], (oled_glyph_mode_t)mode);
+                int x = x0;
+                for (const char *s = strs[i]; *s && x < W; s++, x += 8) {
+                    ref_glyph(small_src(*s), 8, 1, x, y0, (oled_glyph_mode_t)mode);
+                }
+                cases++;
+                if (end != x) {
+                    printf("FALHA draw_string devolveu %d, esperado %d\n", end, x);
+                    failures++;
+                }
+                compare("draw_string", strs[i][0], x0, y0, mode);
+            }
+        }
+
+        /* write_line: a página inteira é reescrita (fundo apagado) */
+        static const int xs[] = { 0, 3, -5, W - 20 };
+        for (size_t k = 0; k < sizeof xs / sizeof xs[0]; k++) {
+            for (unsigned page = 0; page < H / 8; page += 3) {
+                start();
+                oled_glyph_write_line(&fb, &oled_glyph_font_8x8, page, xs[k], strs[i]);
+                memset(&ref[page * W], 0, W);
+                int x = xs[k];
+                for (const char *s = strs[i]; *s && x < W; s++, x += 8) {
+                    ref_glyph(small_src(*s), 8, 1, x, (int)page * 8, OLED_GLYPH_OR);
+                }
+                compare("write_line", strs[i][0], xs[k], (int)page * 8, OLED_GLYPH_COPY);
+            }
+        }
+    }
+}
+
+int main(void) {
+    /* O gerador precisa preservar contagem, primeiro código e mapa */
+    if (oled_glyph_font_8x8.count != SMALL_COUNT || oled_glyph_font_8x8.first != SMALL_FIRST ||
+        oled_glyph_font_big.count != BIG_COUNT || oled_glyph_font_big.pages != 4 ||
+        oled_glyph_font_big.width != 16 || !oled_glyph_font_big.map) {
+        printf("FALHA cabeçalho do atlas: 8x8 %u glifos a partir de %u, grande %u glifos\n",
+               oled_glyph_font_8x8.count, oled_glyph_font_8x8.first, oled_glyph_font_big.count);
+        failures++;
+    }
+
+    /* Todos os glifos das fixtures e vizinhos sem glifo */
+    char small_chars[SMALL_COUNT + 4];
+    int n = 0;
+    small_chars[n++] = SMALL_FIRST - 1;
+    for (int c = SMALL_FIRST; c < SMALL_FIRST + SMALL_COUNT; c++) {
+        small_chars[n++] = (char)c;
+    }
+    small_chars[n++] = (char)(SMALL_FIRST + SMALL_COUNT);
+    small_chars[n++] = (char)0xC3;   /* Fora do ASCII */
+    small_chars[n] = '\0';
+
+    test_font("8x8", &oled_glyph_font_8x8, small_chars, small_src);
+    test_font("16x32", &oled_glyph_font_big, "07AZ1Ba\x7f", big_src);
+    test_string();
+
+    printf("%u casos: %d glifos 8x8 e %d glifos 16x32 da fixture\n", cases, SMALL_COUNT,
+           BIG_COUNT);
+    return test_check_summary();
+}
@@ -0,0 +1,364 @@
+/**
+ * =============================================================================
+ * @file    oled_raster_test.c
+ * @brief   (Host) Testes unitários das primitivas do oled_raster
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Casos escolhidos à mão (o oled_gfx_bench cobre os aleatórios),
+ *          comparados com um modelo de pixels independente do layout em
+ *          páginas:
+ *          - spans e retângulos nas quatro bordas, fora da tela e com
+ *            tamanho zero ou negativo;
+ *          - spans de 1 a 9 colunas começando em cada alinhamento de
+ *            palavra (cabeça, palavra e cauda do page_run) e verticais
+ *            dentro de uma página, numa página exata e cruzando páginas;
+ *          - linhas nos oito octantes, diagonais, e linhas que entram e saem
+ *            da tela; além da referência, conferem pontas, número de pixels
+ *            e conectividade;
+ *          - blit em deslocamentos negativos (x e y, com e sem página
+ *            inteira), altura não múltipla de 8 e os três modos.
+ *
+ *          Cada caso roda com CLEAR/SET/INVERT sobre fundo aleatório, em
+ *          128x64 e 37x24, com o buffer começando em cada alinhamento de
+ *          4 bytes; bytes-sentinela ao redor do buffer acusam escrita fora.
+ *
+ *          Uso: oled_raster_test
+ *          Retorno: 0 se todos os casos conferirem, 1 caso contrário.
+ * =============================================================================
+ */
+
+#include "oled_raster.h"
+#include "test_check.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_W    128
+#define MAX_H    64
+#define GUARD    8
+#define SENTINEL 0xA5u
+
+static unsigned cases;
+
+/* Geometria e alinhamento correntes */
+static int W, H;
+static unsigned align;
+static uint8_t storage[GUARD + 4 + MAX_W * MAX_H / 8 + GUARD];
+static oled_fb_t fb;
+
+/** Modelo: um bool por pixel */
+static bool model[MAX_H][MAX_W];
+
+static uint32_t rng = 12345u;
+
+static uint32_t rnd(void) {
+    rng = rng * 1664525u + 1013904223u;
+    return rng >> 8;
+}
+
+/* =============================================================================
+ * SEÇÃO 1: MODELO E COMPARAÇÃO
+ * =============================================================================
+ */
+
+static bool fb_pixel(int x, int y) {
+    return (fb.buf[(size_t)(y >> 3) * fb.width + x] >> (y & 7)) & 1u;
+}
+
+static void model_pixel(int x, int y, oled_raster_op_t op) {
+    if (x < 0 || y < 0 || x >= W || y >= H) {
+        return;
+    }
+    model[y][x] = (op == OLED_RASTER_SET) ? true
+                : (op == OLED_RASTER_CLEAR) ? false
+                : !model[y][x];
+}
+
+/** Fundo aleatório no buffer e no modelo; sentinelas ao redor */
+static void start(void) {
+    memset(storage, SENTINEL, sizeof storage);
+    fb.buf = storage + GUARD + align;
+    fb.width = (uint16_t)W;
+    fb.height = (uint16_t)H;
+    for (int i = 0; i < W * H / 8; i++) {
+        fb.buf[i] = (uint8_t)rnd();
+    }
+    for (int y = 0; y < H; y++) {
+        for (int x = 0; x < W; x++) {
+            model[y][x] = fb_pixel(x, y);
+        }
+    }
+}
+
+static void check(const char *what, int a, int b, int c, int d, int e) {
+    cases++;
+    const size_t n = (size_t)W * H / 8;
+    bool guard_ok = true;
+    for (size_t i = 0; i < GUARD + align; i++) {
+        guard_ok = guard_ok && storage[i] == SENTINEL;
+    }
+    for (size_t i = GUARD + align + n; i < sizeof storage; i++) {
+        guard_ok = guard_ok && storage[i] == SENTINEL;
+    }
+    int bad_x = -1, bad_y = -1;
+    for (int y = 0; y < H && bad_x < 0; y++) {
+        for (int x = 0; x < W; x++) {
+            if (fb_pixel(x, y) != model[y][x]) {
+                bad_x = x;
+                bad_y = y;
+                break;
+            }
+        }
+    }
+    if (!guard_ok || bad_x >= 0) {
+        if (failures < 20u) {
+            printf("FALHA %s(%d, %d, %d, %d, %d) em %dx%d, alinhamento %u: ", what, a, b, c, d, e,
+                   W, H, align);
+            if (!guard_ok) {
+                printf("escrita fora do buffer\n");
+            } else {
+                printf("pixel (%d, %d)\n", bad_x, bad_y);
+            }
+        }
+        failures++;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: SPANS E RETÂNGULOS
+ * =============================================================================
+ */
+
+static void hspan(int x0, int x1, int y, oled_raster_op_t op) {
+    start();
+    oled_raster_hspan(&fb, x0, x1, y, op);
+    for (int x = (x0 < x1 ? x0 : x1); x <= (x0 < x1 ? x1 : x0); x++) {
+        model_pixel(x, y, op);
+    }
+    check("hspan", x0, x1, y, op, 0);
+}
+
+static void vspan(int x, int y0, int y1, oled_raster_op_t op) {
+    start();
+    oled_raster_vspan(&fb, x, y0, y1, op);
+    for (int y = (y0 < y1 ? y0 : y1); y <= (y0 < y1 ? y1 : y0); y++) {
+        model_pixel(x, y, op);
+    }
+    check("vspan", x, y0, y1, op, 0);
+}
+
+static void fill_rect(int x, int y, int w, int h, oled_raster_op_t op) {
+    start();
+    oled_raster_fill_rect(&fb, x, y, w, h, op);
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) {
+            model_pixel(i, j, op);
+        }
+    }
+    check("fill_rect", x, y, w, h, op);
+}
+
+static void rect(int x, int y, int w, int h, oled_raster_op_t op) {
+    start();
+    oled_raster_rect(&fb, x, y, w, h, op);
+    for (int j = y; j < y + h; j++) {
+        for (int i = x; i < x + w; i++) {
+            if (j == y || j == y + h - 1 || i == x || i == x + w - 1) {
+                model_pixel(i, j, op);
+            }
+        }
+    }
+    check("rect", x, y, w, h, op);
+}
+
+static void test_spans(oled_raster_op_t op) {
+    /* Uma palavra ou menos, em cada alinhamento: cabeça, palavra e cauda */
+    for (int x0 = 0; x0 < 8; x0++) {
+        for (int len = 1; len <= 9; len++) {
+            hspan(x0, x0 + len - 1, 3, op);
+            hspan(x0 + len - 1, x0, H - 1, op);   /* Extremos invertidos */
+        }
+    }
+    /* Bordas */
+    const int edges_x[][2] = { { -5, 3 }, { -1, 0 }, { W - 3, W + 5 }, { W - 1, W },
+                               { -10, W + 10 }, { -9, -1 }, { W, W + 9 }, { 0, W - 1 } };
+    for (size_t i = 0; i < sizeof edges_x / sizeof edges_x[0]; i++) {
+        hspan(edges_x[i][0], edges_x[i][1], 0, op);
+        hspan(edges_x[i][0], edges_x[i][1], H / 2 + 1, op);
+    }
+    hspan(0, W - 1, -1, op);
+    hspan(0, W - 1, H, op);
+
+    /* Verticais: numa página, página exata, cruzando páginas, bordas */
+    const int ys[][2] = { { 0, 0 }, { 1, 6 }, { 3, 4 }, { 7, 7 }, { 8, 15 }, { 7, 8 },
+                          { 5, 18 }, { 0, H - 1 }, { -4, 2 }, { -8, -1 }, { H - 2, H + 6 },
+                          { H, H + 3 }, { -30, H + 30 }, { 15, 9 } };
+    for (size_t i = 0; i < sizeof ys / sizeof ys[0]; i++) {
+        vspan(0, ys[i][0], ys[i][1], op);
+        vspan(W - 1, ys[i][0], ys[i][1], op);
+        vspan(W / 2 + 1, ys[i][0], ys[i][1], op);
+    }
+    vspan(-1, 0, H - 1, op);
+    vspan(W, 0, H - 1, op);
+
+    /* Retângulos: vazios, 1 pixel, finos, cantos parcialmente fora, tela toda */
+    const int rs[][4] = { { 5, 5, 0, 4 }, { 5, 5, 4, 0 }, { 5, 5, -3, 4 }, { 5, 5, 4, -3 },
+                          { 2, 3, 1, 1 }, { 2, 3, 1, 9 }, { 2, 3, 9, 1 }, { 2, 3, 2, 2 },
+                          { 1, 6, 5, 11 }, { -3, -5, 10, 12 }, { W - 4, -2, 10, 7 },
+                          { -6, H - 3, 9, 9 }, { W - 2, H - 2, 5, 5 }, { 0, 0, W, H },
+                          { -1, -1, W + 2, H + 2 }, { -20, 4, 10, 4 }, { W, 0, 4, 4 },
+                          { 3, H, 4, 4 }, { 3, 4, 3, 16 } };
+    for (size_t i = 0; i < sizeof rs / sizeof rs[0]; i++) {
+        fill_rect(rs[i][0], rs[i][1], rs[i][2], rs[i][3], op);
+        rect(rs[i][0], rs[i][1], rs[i][2], rs[i][3], op);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: LINHAS
+ * =============================================================================
+ */
+
+/** Bresenham de ssd1306_draw_line(), pixel a pixel; devolve o número de pixels */
+static int model_line(int x0, int y0, int x1, int y1, oled_raster_op_t op, bool *conn) {
+    const int dx = abs(x1 - x0);
+    const int dy = -abs(y1 - y0);
+    const int sx = x0 < x1 ? 1 : -1;
+    const int sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy, n = 0, px = x0, py = y0;
+    *conn = true;
+    for (;;) {
+        if (n > 0 && (abs(x0 - px) > 1 || abs(y0 - py) > 1 || (x0 == px && y0 == py))) {
+            *conn = false;
+        }
+        model_pixel(x0, y0, op);
+        px = x0;
+        py = y0;
+        n++;
+        if (x0 == x1 && y0 == y1) {
+            break;
+        }
+        const int e2 = 2 * err;
+        if (e2 >= dy) {
+            err += dy;
+            x0 += sx;
+        }
+        if (e2 <= dx) {
+            err += dx;
+            y0 += sy;
+        }
+    }
+    return n;
+}
+
+static void line(int x0, int y0, int x1, int y1, oled_raster_op_t op) {
+    start();
+    oled_raster_line(&fb, x0, y0, x1, y1, op);
+    bool conn;
+    const int n = model_line(x0, y0, x1, y1, op, &conn);
+    const int dx = abs(x1 - x0), dy = abs(y1 - y0);
+    if (n != (dx > dy ? dx : dy) + 1 || !conn) {
+        printf("FALHA modelo da linha (%d, %d)-(%d, %d): %d pixels\n", x0, y0, x1, y1, n);
+        failures++;
+    }
+    check("line", x0, y0, x1, y1, op);
+}
+
+static void test_lines(oled_raster_op_t op) {
+    const int cx = W / 2, cy = H / 2;
+    /* Oito octantes com inclinações rasas, íngremes e diagonais exatas */
+    const int d[][2] = { { 11, 3 }, { 3, 11 }, { -3, 11 }, { -11, 3 }, { -11, -3 },
+                         { -3, -11 }, { 3, -11 }, { 11, -3 }, { 9, 9 }, { -9, 9 },
+                         { -9, -9 }, { 9, -9 }, { 20, 1 }, { 1, 20 }, { 17, 16 },
+                         { 16, 17 }, { 0, 7 }, { 7, 0 }, { 0, 0 } };
+    for (size_t i = 0; i < sizeof d / sizeof d[0]; i++) {
+        line(cx, cy, cx + d[i][0], cy + d[i][1], op);
+        line(cx + d[i][0], cy + d[i][1], cx, cy, op);   /* Sentido inverso */
+    }
+    /* Entrando e saindo da tela, cantos e rejeição trivial */
+    line(-10, -7, W + 10, H + 5, op);
+    line(W + 10, -7, -10, H + 5, op);
+    line(-30, 5, 5, -30, op);
+    line(-3, H / 2, W + 3, H / 2 - 1, op);
+    line(W / 3, -20, W / 3 + 2, H + 20, op);
+    line(0, 0, W - 1, H - 1, op);
+    line(W - 1, 0, 0, H - 1, op);
+    line(-5, -5, -1, -20, op);
+    line(W, 3, W + 9, 40, op);
+    line(2, H, 30, H + 4, op);
+}
+
+/* =============================================================================
+ * SEÇÃO 4: BLIT
+ * =============================================================================
+ */
+
+static uint8_t bitmap[MAX_W * (MAX_H + 8) / 8];
+
+static void blit(int x, int y, int w, int h, oled_glyph_mode_t mode) {
+    for (int i = 0; i < ((h + 7) / 8) * w; i++) {
+        bitmap[i] = (uint8_t)rnd();
+    }
+    start();
+    oled_raster_blit(&fb, x, y, bitmap, w, h, mode);
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            const bool on = (bitmap[(j >> 3) * w + i] >> (j & 7)) & 1u;
+            if (mode == OLED_GLYPH_COPY) {
+                model_pixel(x + i, y + j, on ? OLED_RASTER_SET : OLED_RASTER_CLEAR);
+            } else if (on) {
+                model_pixel(x + i, y + j, mode == OLED_GLYPH_XOR ? OLED_RASTER_INVERT
+                                                                 : OLED_RASTER_SET);
+            }
+        }
+    }
+    check("blit", x, y, w, h, mode);
+}
+
+static void test_blit(oled_glyph_mode_t mode) {
+    /* Deslocamentos negativos: y com e sem múltiplo de 8, x parcial */
+    const int off[][2] = { { -3, -5 }, { -1, -1 }, { 0, -8 }, { -7, -13 }, { 2, -16 },
+                           { -9, 0 }, { -9, 3 }, { -15, -7 }, { -20, -20 }, { -12, -3 } };
+    const int size[][2] = { { 12, 13 }, { 8, 8 }, { 5, 3 }, { 16, 17 }, { 1, 1 }, { 20, 24 } };
+    for (size_t i = 0; i < sizeof off / sizeof off[0]; i++) {
+        for (size_t s = 0; s < sizeof size / sizeof size[0]; s++) {
+            blit(off[i][0], off[i][1], size[s][0], size[s][1], mode);
+        }
+    }
+    /* Bordas positivas e totalmente fora */
+    blit(W - 5, H - 6, 12, 13, mode);
+    blit(W - 1, 3, 4, 9, mode);
+    blit(3, H - 1, 4, 9, mode);
+    blit(W, 0, 4, 8, mode);
+    blit(0, H, 4, 8, mode);
+    blit(5, 11, 0, 8, mode);
+    /* Tela inteira (caminho do memcpy em COPY) e deslocada um pixel */
+    blit(0, 0, W, H, mode);
+    blit(0, 1, W, H, mode);
+    blit(-1, 0, W, H, mode);
+}
+
+int main(void) {
+    static const int geom[][2] = { { 128, 64 }, { 37, 24 } };
+    for (size_t g = 0; g < sizeof geom / sizeof geom[0]; g++) {
+        W = geom[g][0];
+        H = geom[g][1];
+        for (align = 0; align < 4; align++) {
+            for (int op = OLED_RASTER_CLEAR; op <= OLED_RASTER_INVERT; op++) {
+                test_spans((oled_raster_op_t)op);
+                test_lines((oled_raster_op_t)op);
+                test_blit((oled_glyph_mode_t)op);
+            }
+        }
+    }
+    printf("%u casos em 128x64 e 37x24, 4 alinhamentos\n", cases);
+    return test_check_summary();
+}
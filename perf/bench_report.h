@@ -0,0 +1,71 @@
+/**
+ * =============================================================================
+ * @file    bench_report.h
+ * @brief   (Host) Resultados de benchmark em formato legível por máquina
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os benchmarks continuam imprimindo suas tabelas para leitura
+ *          humana; cada métrica acompanhada também é registrada aqui. Se a
+ *          variável de ambiente BENCH_RESULTS apontar para um arquivo, uma
+ *          linha CSV é acrescentada por métrica:
+ *
+ *              bench,metrica,valor,unidade
+ *              tmds_bench,bars_table,412.5,Mpixel/s
+ *
+ *          Sem a variável nada é gravado. O arquivo é aberto em modo append
+ *          a cada métrica, então vários benchmarks (um processo por teste do
+ *          ctest) gravam no mesmo arquivo, que depois é comparado com a
+ *          linha de base pelo bench_compare.
+ *
+ *          Apenas cabeçalho: as ferramentas de host incluem este diretório
+ *          sem depender de uma biblioteca a mais.
+ * =============================================================================
+ */
+
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+#include <stdio.h>
+#include <stdlib.h>   /* Para getenv */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Variável de ambiente com o caminho do CSV de resultados */
+#define BENCH_REPORT_ENV "BENCH_RESULTS"
+
+/**
+ * @brief Registra uma métrica
+ *
+ * @param bench  Nome do benchmark (normalmente o do executável)
+ * @param metric Nome da métrica, sem vírgulas nem espaços
+ * @param value  Valor
+ * @param unit   Unidade ("MB/s", "x", "ns", ...)
+ */
+static inline void bench_report(const char *bench, const char *metric, double value,
+                                const char *unit) {
+    const char *path = getenv(BENCH_REPORT_ENV);
+    if (!path || !*path) {
+        return;
+    }
+    FILE *f = fopen(path, "a");
+    if (!f) {
+        perror(path);
+        return;
+    }
+    fprintf(f, "%s,%s,%.6g,%s\n", bench, metric, value, unit);
+    fclose(f);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BENCH_REPORT_H */
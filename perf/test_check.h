@@ -0,0 +1,65 @@
+/**
+ * =============================================================================
+ * @file    test_check.h
+ * @brief   (Host) Verificações das ferramentas de teste: CHECK() e resumo
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada ferramenta é um único arquivo-fonte que conta as próprias
+ *          falhas e termina com o mesmo resumo, que o ctest lê pelo código
+ *          de retorno:
+ *
+ *              CHECK(n == 3u, "lidos %u, esperado 3", n);
+ *              ...
+ *              return test_check_summary();
+ *
+ *          `failures` fica visível para quem quiser saber se um trecho
+ *          falhou (guardar o valor antes e comparar depois). Definir
+ *          TEST_CHECK_MAX_REPORTS antes do include limita quantas falhas são
+ *          impressas, para laços que podem falhar milhares de vezes; todas
+ *          continuam contadas.
+ *
+ *          Apenas cabeçalho, como o bench_report.h.
+ * =============================================================================
+ */
+
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+#include <stdio.h>
+
+#ifndef TEST_CHECK_MAX_REPORTS
+#define TEST_CHECK_MAX_REPORTS 0xFFFFFFFFu   /**< Falhas impressas (as demais só contam) */
+#endif
+
+/** Falhas registradas por CHECK() (e por quem mais incrementar) */
+static unsigned failures = 0;
+
+/** Conta uma falha e imprime a mensagem printf quando `cond` for falsa */
+#define CHECK(cond, ...)                                  \
+    do {                                                  \
+        if (!(cond)) {                                    \
+            if (failures++ < TEST_CHECK_MAX_REPORTS) {    \
+                printf("FALHA: ");                        \
+                printf(__VA_ARGS__);                      \
+                printf("\n");                             \
+            }                                             \
+        }                                                 \
+    } while (0)
+
+/**
+ * @brief Imprime o resumo final
+ *
+ * @return Código de saída do processo: 0 sem falhas, 1 com alguma
+ */
+static inline int test_check_summary(void) {
+    printf("verificação: %s (%u falhas)\n", failures ? "FALHA" : "ok", failures);
+    return failures ? 1 : 0;
+}
+
+#endif /* TEST_CHECK_H */
@@ -0,0 +1,267 @@
+/**
+ * =============================================================================
+ * @file    bench_compare.c
+ * @brief   (Host) Compara os resultados dos benchmarks com a linha de base
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details LINHA DE BASE (CSV, '#' inicia comentário):
+ *
+ *              bench,metrica,valor,unidade,melhor,tolerancia_pct
+ *              sensor_pack_bench,mpu6050_packed_ratio,2.21,x,higher,1
+ *
+ *          `melhor` é "higher" (razão, quadros) ou "lower" (latência,
+ *          contagem), e a métrica regride quando piora mais que a tolerância.
+ *          Métricas deterministas (relógio virtual, razão de compressão) usam
+ *          tolerâncias pequenas. Ganhos sobre uma referência medida no mesmo
+ *          processo usam tolerâncias médias. "info" marca vazões absolutas,
+ *          que dependem da máquina: são impressas e nunca falham.
+ *
+ *          RESULTADOS: o CSV gravado pelo bench_report (vale a última linha
+ *          de cada métrica). Uma métrica acompanhada (higher/lower) sem
+ *          resultado é falha: o benchmark deixou de rodar ou de reportá-la.
+ *
+ *          Uso: bench_compare [-w] [-p] linha_de_base.csv resultados.csv
+ *            -w  regrava a linha de base com os valores medidos (mantém
+ *                comentários, direção e tolerância)
+ *            -p  execução parcial: métricas não medidas só geram aviso
+ *                (o mesmo que BENCH_PARTIAL=1 no ambiente, para ctest -R)
+ *          Retorno: 0 sem regressão, 1 com regressão ou métrica não medida,
+ *          2 erro.
+ * =============================================================================
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_ROWS  512u
+#define MAX_LINE  256u
+#define MAX_NAME  64u
+
+typedef struct {
+    char bench[MAX_NAME];
+    char metric[MAX_NAME];
+    char unit[16];
+    double value;
+    int dir;               /**< DIR_HIGHER, DIR_LOWER ou DIR_INFO */
+    double tol_pct;
+    char raw[MAX_LINE];    /**< Linha original (comentários e linhas em branco) */
+    int is_row;
+} row_t;
+
+enum { DIR_LOWER = 0, DIR_HIGHER = 1, DIR_INFO = 2 };
+
+static const char *const dir_name[] = { "lower", "higher", "info" };
+
+static row_t base[MAX_ROWS];
+static row_t res[MAX_ROWS];
+
+/** Separa `line` em até `max` campos por vírgula; retorna o número de campos */
+static unsigned split_csv(char *line, char **fields, unsigned max) {
+    unsigned n = 0;
+    char *p = line;
+    while (n < max) {
+        fields[n++] = p;
+        char *comma = strchr(p, ',');
+        if (!comma) {
+            break;
+        }
+        *comma = '\0';
+        p = comma + 1;
+    }
+    return n;
+}
+
+static void chomp(char *s) {
+    size_t n = strlen(s);
+    while (n && (s[n - 1] == '\n' || s[n - 1] == '\r' || s[n - 1] == ' ')) {
+        s[--n] = '\0';
+    }
+}
+
+static void copy_name(char *dst, size_t size, const char *src) {
+    snprintf(dst, size, "%s", src);
+}
+
+/**
+ * @brief Lê um CSV
+ *
+ * @param baseline true para o formato da linha de base (6 campos)
+ * @return Número de linhas, ou -1 em erro
+ */
+static int load(const char *path, row_t *rows, int baseline) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        perror(path);
+        return -1;
+    }
+    char line[MAX_LINE];
+    unsigned n = 0, lineno = 0;
+    while (fgets(line, sizeof line, f)) {
+        lineno++;
+        if (n >= MAX_ROWS) {
+            fprintf(stderr, "%s: mais de %u linhas\n", path, MAX_ROWS);
+            fclose(f);
+            return -1;
+        }
+        chomp(line);
+        row_t *r = &rows[n];
+        memset(r, 0, sizeof *r);
+        copy_name(r->raw, sizeof r->raw, line);
+        if (line[0] == '\0' || line[0] == '#') {
+            if (baseline) {
+                n++;   /* Preservado por -w */
+            }
+            continue;
+        }
+        char *fld[6];
+        const unsigned nf = split_csv(line, fld, 6);
+        if (nf < (baseline ? 6u : 4u)) {
+            fprintf(stderr, "%s:%u: campos insuficientes\n", path, lineno);
+            fclose(f);
+            return -1;
+        }
+        copy_name(r->bench, sizeof r->bench, fld[0]);
+        copy_name(r->metric, sizeof r->metric, fld[1]);
+        r->value = strtod(fld[2], NULL);
+        copy_name(r->unit, sizeof r->unit, fld[3]);
+        if (baseline) {
+            r->dir = -1;
+            for (int d = DIR_LOWER; d <= DIR_INFO; d++) {
+                if (strcmp(fld[4], dir_name[d]) == 0) {
+                    r->dir = d;
+                }
+            }
+            if (r->dir < 0) {
+                fprintf(stderr, "%s:%u: direção deve ser higher, lower ou info\n", path, lineno);
+                fclose(f);
+                return -1;
+            }
+            r->tol_pct = strtod(fld[5], NULL);
+        }
+        r->is_row = 1;
+        n++;
+    }
+    fclose(f);
+    return (int)n;
+}
+
+/** Última medição de bench/metric, ou NULL */
+static const row_t *find(const row_t *rows, int n, const row_t *key) {
+    for (int i = n - 1; i >= 0; i--) {
+        if (rows[i].is_row && strcmp(rows[i].bench, key->bench) == 0 &&
+            strcmp(rows[i].metric, key->metric) == 0) {
+            return &rows[i];
+        }
+    }
+    return NULL;
+}
+
+static int rewrite(const char *path, const row_t *rows, int n, const row_t *results, int nr) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        perror(path);
+        return 2;
+    }
+    for (int i = 0; i < n; i++) {
+        const row_t *b = &rows[i];
+        if (!b->is_row) {
+            fprintf(f, "%s\n", b->raw);
+            continue;
+        }
+        const row_t *m = find(results, nr, b);
+        fprintf(f, "%s,%s,%.6g,%s,%s,%g\n", b->bench, b->metric, m ? m->value : b->value,
+                b->unit, dir_name[b->dir], b->tol_pct);
+    }
+    fclose(f);
+    printf("linha de base regravada: %s\n", path);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int write = 0, partial = 0;
+    int arg = 1;
+    for (; arg < argc && argv[arg][0] == '-'; arg++) {
+        if (strcmp(argv[arg], "-w") == 0) {
+            write = 1;
+        } else if (strcmp(argv[arg], "-p") == 0) {
+            partial = 1;
+        } else {
+            break;
+        }
+    }
+    const char *env = getenv("BENCH_PARTIAL");
+    if (env && env[0] && strcmp(env, "0") != 0) {
+        partial = 1;
+    }
+    if (argc - arg != 2) {
+        fprintf(stderr, "uso: %s [-w] [-p] linha_de_base.csv resultados.csv\n", argv[0]);
+        return 2;
+    }
+    const int nb = load(argv[arg], base, 1);
+    const int nr = load(argv[arg + 1], res, 0);
+    if (nb < 0 || nr < 0) {
+        return 2;
+    }
+    if (write) {
+        return rewrite(argv[arg], base, nb, res, nr);
+    }
+
+    unsigned regressions = 0, missing = 0, improved = 0, tracked = 0, info = 0;
+    printf("%-20s %-30s %12s %12s %8s  %s\n", "bench", "métrica", "base", "atual", "delta",
+           "situação");
+    for (int i = 0; i < nb; i++) {
+        const row_t *b = &base[i];
+        if (!b->is_row) {
+            continue;
+        }
+        const row_t *m = find(res, nr, b);
+        if (b->dir == DIR_INFO) {
+            info++;
+            if (m) {
+                printf("%-20s %-30s %12.6g %12.6g %+7.1f%%  informativo\n", b->bench, b->metric,
+                       b->value, m->value,
+                       (m->value - b->value) / (fabs(b->value) > 1e-12 ? fabs(b->value) : 1.0) *
+                           100.0);
+            }
+            continue;
+        }
+        tracked++;
+        if (!m) {
+            missing++;
+            printf("%-20s %-30s %12.6g %12s %8s  %s\n", b->bench, b->metric, b->value, "-", "-",
+                   partial ? "não medido" : "NÃO MEDIDO");
+            continue;
+        }
+        /* Variação no sentido "melhor": positiva = melhorou */
+        const double denom = fabs(b->value) > 1e-12 ? fabs(b->value) : 1.0;
+        double gain = (m->value - b->value) / denom * 100.0;
+        if (b->dir == DIR_LOWER) {
+            gain = -gain;
+        }
+        const char *status = "ok";
+        if (gain < -b->tol_pct) {
+            status = "REGRESSÃO";
+            regressions++;
+        } else if (gain > b->tol_pct) {
+            status = "melhorou (atualize a linha de base)";
+            improved++;
+        }
+        printf("%-20s %-30s %12.6g %12.6g %+7.1f%%  %s\n", b->bench, b->metric, b->value,
+               m->value, gain, status);
+    }
+    printf("%u métricas, %u regressões, %u melhoras, %u não medidas (%u informativas)\n",
+           tracked, regressions, improved, missing, info);
+    if (missing) {
+        fprintf(stderr, "%s: %u métricas da linha de base não foram medidas\n",
+                partial ? "aviso" : "FALHA", missing);
+    }
+    return (regressions || (missing && !partial)) ? 1 : 0;
+}
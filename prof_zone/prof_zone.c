@@ -0,0 +1,481 @@
+/**
+ * =============================================================================
+ * @file    prof_zone.c
+ * @brief   Zonas de profiling com precisão de ciclo, por núcleo
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details A duração de uma zona vem de dois contadores lidos juntos: o de
+ *          ciclos (SysTick, que dá a volta a cada 2^24 ciclos ou a cada tick
+ *          do FreeRTOS) e o de microssegundos. A diferença dos ciclos é
+ *          exata módulo o período do SysTick; a dos microssegundos diz
+ *          quantas voltas inteiras couberam no meio.
+ * =============================================================================
+ */
+
+#include "prof_zone.h"
+
+#include <stdio.h>    /* Para snprintf */
+#include <string.h>   /* Para memset, memcpy e strncmp */
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/clocks.h"
+#include "hardware/structs/systick.h"
+#include "hardware/sync.h"
+#include "pico/platform.h"
+#include "pico/time.h"
+#define PROF_ZONE_ON_DEVICE 1
+#else
+#include <pthread.h>
+#include <time.h>     /* Para clock_gettime */
+#define PROF_ZONE_ON_DEVICE 0
+#endif
+
+#if (PROF_ZONE_RING_EVENTS & (PROF_ZONE_RING_EVENTS - 1u)) != 0
+#error "PROF_ZONE_RING_EVENTS deve ser potência de 2"
+#endif
+
+#define LOAD_ACQ(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+
+#define EXPORT_VERSION   1u
+#define EXPORT_HDR       16u
+#define EXPORT_CORE_HDR  16u
+#define EXPORT_EVENT     12u
+
+/* =============================================================================
+ * SEÇÃO 1: ESTADO
+ * =============================================================================
+ */
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint16_t hist[PROF_ZONE_HIST_BUCKETS];
+} zone_acc_t;
+
+/** Estado de um núcleo: só ele escreve aqui */
+typedef struct {
+    zone_acc_t acc[PROF_ZONE_MAX_ZONES];
+    prof_zone_event_t ring[PROF_ZONE_RING_EVENTS];
+    uint32_t head;            /**< Livre: eventos já gravados */
+    uint32_t epoch;           /**< Última reinicialização aplicada */
+    uint32_t tick_hz;
+    uint32_t ticks_per_us;
+    bool ready;
+} core_state_t;
+
+static core_state_t cores[PROF_ZONE_MAX_CORES];
+static char names[PROF_ZONE_MAX_ZONES][PROF_ZONE_NAME_LEN];
+static uint16_t n_zones;
+static uint32_t reset_epoch;
+static volatile bool capture = true;
+
+#if PROF_ZONE_ON_DEVICE
+static spin_lock_t *reg_lock;
+#else
+static pthread_mutex_t reg_lock = PTHREAD_MUTEX_INITIALIZER;
+static uint32_t next_core;
+static __thread int tls_core = -1;
+#endif
+
+/* =============================================================================
+ * SEÇÃO 2: RELÓGIO E NÚCLEO
+ * =============================================================================
+ */
+
+static inline uint32_t this_core(void) {
+#if PROF_ZONE_ON_DEVICE
+    return get_core_num();
+#else
+    return tls_core < 0 ? 0u : (uint32_t)tls_core;
+#endif
+}
+
+/** Lê os dois contadores; `cyc` é crescente */
+static inline void read_clock(uint32_t *us, uint32_t *cyc) {
+#if PROF_ZONE_ON_DEVICE
+    *cyc = systick_hw->rvr - systick_hw->cvr;   /* SysTick conta para baixo */
+    *us = time_us_32();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    const uint64_t ns = (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+    *cyc = (uint32_t)ns;
+    *us = (uint32_t)(ns / 1000u);
+#endif
+}
+
+/** Período do contador de ciclos, em ticks */
+static inline uint64_t cyc_period(void) {
+#if PROF_ZONE_ON_DEVICE
+    /* Relido a cada zona: o FreeRTOS reprograma o SysTick ao iniciar */
+    return (uint64_t)systick_hw->rvr + 1u;
+#else
+    return (uint64_t)1u << 32;
+#endif
+}
+
+/**
+ * @brief Duração em ticks
+ *
+ * @details `part` é exato módulo o período; a estimativa pelos
+ *          microssegundos (erro de ±1 us) escolhe o número de voltas.
+ */
+static uint32_t elapsed_ticks(const core_state_t *c, const prof_zone_scope_t *s, uint32_t us,
+                              uint32_t cyc) {
+    const uint64_t period = cyc_period();
+    const uint64_t part = cyc >= s->cyc ? (uint64_t)(cyc - s->cyc)
+                                        : (uint64_t)cyc + period - s->cyc;
+    const uint64_t est = (uint64_t)(us - s->t_us) * c->ticks_per_us;
+    if (est <= part + period / 2u) {
+        return (uint32_t)part;
+    }
+    const uint64_t t = part + (est - part + period / 2u) / period * period;
+    return t > UINT32_MAX ? UINT32_MAX : (uint32_t)t;
+}
+
+void prof_zone_init_core(void) {
+#if PROF_ZONE_ON_DEVICE
+    core_state_t *c = &cores[this_core()];
+    /* CSR: bit 0 ENABLE, bit 2 CLKSOURCE (1 = clk_sys) */
+    if (!(systick_hw->csr & 1u)) {
+        systick_hw->rvr = 0x00FFFFFFu;
+        systick_hw->cvr = 0u;
+        systick_hw->csr = 0x5u;   /* Sem TICKINT: só contagem */
+    }
+    c->tick_hz = (systick_hw->csr & 0x4u) ? clock_get_hz(clk_sys) : 1000000u;
+#else
+    const uint32_t core = __atomic_fetch_add(&next_core, 1u, __ATOMIC_RELAXED);
+    tls_core = (int)(core < PROF_ZONE_MAX_CORES ? core : PROF_ZONE_MAX_CORES - 1u);
+    core_state_t *c = &cores[tls_core];
+    c->tick_hz = 1000000000u;
+#endif
+    c->ticks_per_us = c->tick_hz / 1000000u;
+    STORE_REL(&c->ready, true);
+}
+
+void prof_zone_init(void) {
+    memset(cores, 0, sizeof cores);
+    memset(names, 0, sizeof names);
+    n_zones = 0;
+    reset_epoch = 0;
+    capture = true;
+#if PROF_ZONE_ON_DEVICE
+    if (!reg_lock) {
+        reg_lock = spin_lock_instance((uint)spin_lock_claim_unused(true));
+    }
+#else
+    next_core = 0;
+#endif
+    prof_zone_init_core();
+}
+
+/* =============================================================================
+ * SEÇÃO 3: REGISTRO
+ * =============================================================================
+ */
+
+uint16_t prof_zone_register(const char *name) {
+#if PROF_ZONE_ON_DEVICE
+    /* Antes de prof_zone_init() só há um núcleo: sem trava */
+    const uint32_t save = reg_lock ? spin_lock_blocking(reg_lock) : 0u;
+#else
+    pthread_mutex_lock(&reg_lock);
+#endif
+    uint16_t id = PROF_ZONE_INVALID;
+    for (uint16_t i = 0; i < n_zones; i++) {
+        if (strncmp(names[i], name, PROF_ZONE_NAME_LEN - 1u) == 0) {
+            id = i;
+            break;
+        }
+    }
+    if (id == PROF_ZONE_INVALID && n_zones < PROF_ZONE_MAX_ZONES) {
+        id = n_zones;
+        strncpy(names[id], name, PROF_ZONE_NAME_LEN - 1u);
+        STORE_REL(&n_zones, (uint16_t)(id + 1u));
+    }
+#if PROF_ZONE_ON_DEVICE
+    if (reg_lock) {
+        spin_unlock(reg_lock, save);
+    }
+#else
+    pthread_mutex_unlock(&reg_lock);
+#endif
+    return id;
+}
+
+uint16_t prof_zone_count(void) {
+    return LOAD_ACQ(&n_zones);
+}
+
+const char *prof_zone_name(uint16_t zone) {
+    return zone < prof_zone_count() ? names[zone] : NULL;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: MEDIÇÃO
+ * =============================================================================
+ */
+
+/** Faixa 0: < 2^MIN_LOG2; depois 4 faixas por oitava */
+static uint32_t bucket_of(uint32_t t) {
+    if (t < (1u << PROF_ZONE_HIST_MIN_LOG2)) {
+        return 0u;
+    }
+    const uint32_t e = 31u - (uint32_t)__builtin_clz(t);
+    const uint32_t b = 1u + (e - PROF_ZONE_HIST_MIN_LOG2) * 4u + ((t >> (e - 2u)) & 3u);
+    return b < PROF_ZONE_HIST_BUCKETS ? b : PROF_ZONE_HIST_BUCKETS - 1u;
+}
+
+/** Maior duração que cai na faixa `b` */
+static uint32_t bucket_upper(uint32_t b) {
+    if (b == 0u) {
+        return (1u << PROF_ZONE_HIST_MIN_LOG2) - 1u;
+    }
+    const uint32_t e = PROF_ZONE_HIST_MIN_LOG2 + (b - 1u) / 4u;
+    const uint64_t up = ((uint64_t)(5u + (b - 1u) % 4u) << (e - 2u)) - 1u;
+    return up > UINT32_MAX ? UINT32_MAX : (uint32_t)up;
+}
+
+prof_zone_scope_t prof_zone_begin_id(uint16_t zone) {
+    prof_zone_scope_t s;
+    s.zone = zone;
+    read_clock(&s.t_us, &s.cyc);
+    return s;
+}
+
+prof_zone_scope_t prof_zone_begin(prof_zone_site_t *site) {
+    if (!LOAD_ACQ(&site->registered)) {
+        site->id = prof_zone_register(site->name);
+        STORE_REL(&site->registered, true);
+    }
+    return prof_zone_begin_id(site->id);
+}
+
+void prof_zone_end(prof_zone_scope_t *s) {
+    uint32_t us, cyc;
+    read_clock(&us, &cyc);
+
+    const uint32_t core = this_core();
+    if (core >= PROF_ZONE_MAX_CORES || s->zone >= PROF_ZONE_MAX_ZONES) {
+        return;
+    }
+    core_state_t *c = &cores[core];
+    if (!c->ready) {
+        return;
+    }
+    const uint32_t epoch = LOAD_ACQ(&reset_epoch);
+    if (c->epoch != epoch) {
+        memset(c->acc, 0, sizeof c->acc);
+        STORE_REL(&c->head, 0u);
+        c->epoch = epoch;
+    }
+
+    const uint32_t t = elapsed_ticks(c, s, us, cyc);
+    zone_acc_t *a = &c->acc[s->zone];
+    if (a->count == 0u || t < a->min) {
+        a->min = t;
+    }
+    if (t > a->max) {
+        a->max = t;
+    }
+    a->count++;
+    a->sum += t;
+    const uint32_t b = bucket_of(t);
+    if (++a->hist[b] == UINT16_MAX) {
+        /* Metade de tudo: a forma da distribuição (e o p99) se mantém */
+        for (uint32_t i = 0; i < PROF_ZONE_HIST_BUCKETS; i++) {
+            a->hist[i] >>= 1;
+        }
+    }
+
+    if (capture) {
+        const uint32_t head = c->head;
+        prof_zone_event_t *e = &c->ring[head & (PROF_ZONE_RING_EVENTS - 1u)];
+        e->t_us = s->t_us;
+        e->ticks = t;
+        e->zone = s->zone;
+        e->reserved = 0u;
+        STORE_REL(&c->head, head + 1u);
+    }
+}
+
+void prof_zone_set_capture(bool on) {
+    capture = on;
+}
+
+void prof_zone_reset(void) {
+    /* Sem read-modify-write atômico: no M0+ (sem LDREX/STREX) ele viraria uma
+     * chamada a __atomic_fetch_add_4; a trava do registro serializa os núcleos */
+#if PROF_ZONE_ON_DEVICE
+    const uint32_t save = reg_lock ? spin_lock_blocking(reg_lock) : 0u;
+#else
+    pthread_mutex_lock(&reg_lock);
+#endif
+    STORE_REL(&reset_epoch, reset_epoch + 1u);
+#if PROF_ZONE_ON_DEVICE
+    if (reg_lock) {
+        spin_unlock(reg_lock, save);
+    }
+#else
+    pthread_mutex_unlock(&reg_lock);
+#endif
+}
+
+/* =============================================================================
+ * SEÇÃO 5: MÉTRICAS
+ * =============================================================================
+ */
+
+bool prof_zone_get_stats(uint16_t zone, uint8_t core, prof_zone_stats_t *out) {
+    memset(out, 0, sizeof *out);
+    if (zone >= prof_zone_count() || core >= PROF_ZONE_MAX_CORES) {
+        return false;
+    }
+    const core_state_t *c = &cores[core];
+    out->tick_hz = c->tick_hz;
+    if (!LOAD_ACQ(&c->ready) || c->epoch != LOAD_ACQ(&reset_epoch)) {
+        return true;   /* Reinicialização ainda não aplicada: sem medições */
+    }
+    const zone_acc_t *a = &c->acc[zone];
+    out->count = a->count;
+    out->min_ticks = a->min;
+    out->max_ticks = a->max;
+    out->sum_ticks = a->sum;
+    if (out->count == 0u) {
+        return true;
+    }
+
+    uint32_t total = 0;
+    for (uint32_t i = 0; i < PROF_ZONE_HIST_BUCKETS; i++) {
+        total += a->hist[i];
+    }
+    const uint32_t need = (uint32_t)(((uint64_t)total * 99u + 99u) / 100u);
+    uint32_t cum = 0;
+    out->p99_ticks = out->max_ticks;
+    for (uint32_t i = 0; i < PROF_ZONE_HIST_BUCKETS; i++) {
+        cum += a->hist[i];
+        if (cum >= need) {
+            const uint32_t up = bucket_upper(i);
+            out->p99_ticks = up < out->min_ticks ? out->min_ticks
+                             : up > out->max_ticks ? out->max_ticks
+                                                   : up;
+            break;
+        }
+    }
+    return true;
+}
+
+/** Ticks em "us.cc" (sem ponto flutuante: o M0+ não tem FPU) */
+static void fmt_us(char *dst, size_t size, uint64_t ticks, uint32_t tick_hz) {
+    const uint64_t ns = tick_hz ? ticks * 1000000000u / tick_hz : 0u;
+    snprintf(dst, size, "%lu.%02lu", (unsigned long)(ns / 1000u),
+             (unsigned long)(ns % 1000u / 10u));
+}
+
+void prof_zone_dump(prof_zone_emit_fn_t emit, void *ctx) {
+    char line[144];
+    snprintf(line, sizeof line, "%-20s %2s %8s %10s %10s %10s %10s", "zona", "nu", "n",
+             "min(us)", "media(us)", "max(us)", "p99(us)");
+    emit(ctx, line);
+
+    const uint16_t n = prof_zone_count();
+    for (uint16_t z = 0; z < n; z++) {
+        for (uint8_t core = 0; core < PROF_ZONE_MAX_CORES; core++) {
+            prof_zone_stats_t st;
+            if (!prof_zone_get_stats(z, core, &st) || st.count == 0u) {
+                continue;
+            }
+            char mn[24], mean[24], mx[24], p99[24];
+            fmt_us(mn, sizeof mn, st.min_ticks, st.tick_hz);
+            fmt_us(mean, sizeof mean, st.sum_ticks / st.count, st.tick_hz);
+            fmt_us(mx, sizeof mx, st.max_ticks, st.tick_hz);
+            fmt_us(p99, sizeof p99, st.p99_ticks, st.tick_hz);
+            snprintf(line, sizeof line, "%-20.23s %2u %8lu %10s %10s %10s %10s", names[z],
+                     (unsigned)core, (unsigned long)st.count, mn, mean, mx, p99);
+            emit(ctx, line);
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 6: EXPORTAÇÃO
+ * =============================================================================
+ */
+
+static inline void put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put32(uint8_t *p, uint32_t v) {
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static bool export_core(const core_state_t *c, prof_zone_write_fn_t write, void *ctx) {
+    const bool valid = LOAD_ACQ(&c->ready) && c->epoch == LOAD_ACQ(&reset_epoch);
+    const uint32_t head = valid ? LOAD_ACQ(&c->head) : 0u;
+    const uint32_t n = head < PROF_ZONE_RING_EVENTS ? head : PROF_ZONE_RING_EVENTS;
+
+    uint8_t buf[16u * EXPORT_EVENT];
+    memset(buf, 0, EXPORT_CORE_HDR);
+    put32(buf, c->tick_hz);
+    put32(buf + 4, n);
+    put32(buf + 8, head - n);
+    if (!write(ctx, buf, EXPORT_CORE_HDR)) {
+        return false;
+    }
+
+    uint32_t fill = 0;
+    for (uint32_t i = head - n; i != head; i++) {
+        const prof_zone_event_t *e = &c->ring[i & (PROF_ZONE_RING_EVENTS - 1u)];
+        uint8_t *p = buf + fill;
+        put32(p, e->t_us);
+        put32(p + 4, e->ticks);
+        put16(p + 8, e->zone);
+        put16(p + 10, 0u);
+        fill += EXPORT_EVENT;
+        if (fill == sizeof buf) {
+            if (!write(ctx, buf, fill)) {
+                return false;
+            }
+            fill = 0;
+        }
+    }
+    return fill == 0u || write(ctx, buf, fill);
+}
+
+bool prof_zone_export(prof_zone_write_fn_t write, void *ctx) {
+    const bool was = capture;
+    capture = false;
+
+    const uint16_t n = prof_zone_count();
+    uint8_t hdr[EXPORT_HDR];
+    memset(hdr, 0, sizeof hdr);
+    memcpy(hdr, "PZTR", 4);
+    put16(hdr + 4, EXPORT_VERSION);
+    put16(hdr + 6, n);
+    hdr[8] = (uint8_t)PROF_ZONE_MAX_CORES;
+    hdr[9] = (uint8_t)PROF_ZONE_NAME_LEN;
+    put16(hdr + 10, EXPORT_EVENT);
+
+    bool ok = write(ctx, hdr, sizeof hdr);
+    for (uint16_t z = 0; ok && z < n; z++) {
+        ok = write(ctx, names[z], PROF_ZONE_NAME_LEN);
+    }
+    for (uint32_t core = 0; ok && core < PROF_ZONE_MAX_CORES; core++) {
+        ok = export_core(&cores[core], write, ctx);
+    }
+
+    capture = was;
+    return ok;
+}
@@ -0,0 +1,271 @@
+/**
+ * =============================================================================
+ * @file    prof_zone.h
+ * @brief   Zonas de profiling com precisão de ciclo, por núcleo
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Mede no campo quanto tempo levam os caminhos quentes (leitura
+ *          dos sensores, renderização do OLED, log_write):
+ *
+ *              void mpu_ler(...) {
+ *                  PROF_ZONE("mpu6050_read");   // fecha ao sair do bloco
+ *                  ...
+ *              }
+ *
+ *          Sem PROF_ZONE_ENABLED as macros viram ((void)0): nenhum código,
+ *          nenhuma variável. Com a opção, cada zona custa duas leituras de
+ *          relógio e uma atualização das métricas na saída.
+ *
+ *          RELÓGIO:
+ *          - Firmware: SysTick do núcleo (24 bits, clk_sys) para a resolução
+ *            de ciclo e time_us_32() para resolver as voltas do SysTick. Se
+ *            o SysTick já estiver em uso (tick do FreeRTOS), o recarregamento
+ *            dele é respeitado.
+ *          - Host: CLOCK_MONOTONIC em nanossegundos.
+ *
+ *          POR NÚCLEO (sem trava; cada núcleo só escreve no próprio estado):
+ *          ┌──────────────────────┬───────────────────────────────────────────┐
+ *          │ Métricas por zona    │ n, mín, soma, máx e histograma log-linear │
+ *          │                      │ (4 faixas por oitava) para o p99          │
+ *          │ Anel de eventos      │ últimas PROF_ZONE_RING_EVENTS zonas       │
+ *          │                      │ fechadas (início em us, duração em ticks) │
+ *          └──────────────────────┴───────────────────────────────────────────┘
+ *
+ *          As métricas saem em texto por prof_zone_dump() (o log_vt100 tem
+ *          log_prof_periodic()) e o anel em binário por prof_zone_export();
+ *          tools/prof_trace.c converte o binário para o JSON de trace do
+ *          Chrome (chrome://tracing, Perfetto).
+ *
+ *          Zonas em rotinas de interrupção não são protegidas contra a zona
+ *          interrompida no mesmo núcleo: meça a IRQ inteira ou nada dela.
+ * =============================================================================
+ */
+
+#ifndef PROF_ZONE_H
+#define PROF_ZONE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** Zonas distintas (nomes) */
+#ifndef PROF_ZONE_MAX_ZONES
+#define PROF_ZONE_MAX_ZONES 16u
+#endif
+
+/** Núcleos (no host, threads registradas com prof_zone_init_core) */
+#ifndef PROF_ZONE_MAX_CORES
+#define PROF_ZONE_MAX_CORES 2u
+#endif
+
+/** Eventos no anel de cada núcleo (potência de 2; 12 bytes cada) */
+#ifndef PROF_ZONE_RING_EVENTS
+#define PROF_ZONE_RING_EVENTS 256u
+#endif
+
+/** Bytes do nome de uma zona, com o terminador */
+#define PROF_ZONE_NAME_LEN 24u
+
+/**
+ * Histograma: faixa 0 para durações < 2^PROF_ZONE_HIST_MIN_LOG2 ticks e
+ * 4 faixas por oitava até 2^(MIN_LOG2 + OCTAVES); acima disso, a última.
+ */
+#define PROF_ZONE_HIST_MIN_LOG2 4u
+#define PROF_ZONE_HIST_OCTAVES  24u
+#define PROF_ZONE_HIST_BUCKETS  (1u + PROF_ZONE_HIST_OCTAVES * 4u)
+
+/** Zona inválida (tabela cheia): medida e descartada */
+#define PROF_ZONE_INVALID 0xFFFFu
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/** Local de uma zona no código; registrado na primeira passagem */
+typedef struct {
+    const char *name;
+    uint16_t id;
+    bool registered;
+} prof_zone_site_t;
+
+/** Zona aberta (vive na pilha de quem mede) */
+typedef struct {
+    uint32_t t_us;
+    uint32_t cyc;
+    uint16_t zone;
+} prof_zone_scope_t;
+
+/**
+ * @struct prof_zone_event_t
+ * @brief Uma zona fechada, no anel do núcleo (12 bytes)
+ */
+typedef struct {
+    uint32_t t_us;       /**< Início, time_us_32() */
+    uint32_t ticks;      /**< Duração em ticks do núcleo */
+    uint16_t zone;
+    uint16_t reserved;
+} prof_zone_event_t;
+
+/**
+ * @struct prof_zone_stats_t
+ * @brief Métricas de uma zona num núcleo, em ticks (tick_hz por segundo)
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t min_ticks;
+    uint32_t max_ticks;
+    uint32_t p99_ticks;   /**< Limite superior da faixa do histograma (~19%) */
+    uint64_t sum_ticks;
+    uint32_t tick_hz;
+} prof_zone_stats_t;
+
+/** Recebe os bytes de prof_zone_export(); false interrompe a exportação */
+typedef bool (*prof_zone_write_fn_t)(void *ctx, const void *data, size_t len);
+
+/** Recebe uma linha (sem '\n') de prof_zone_dump() */
+typedef void (*prof_zone_emit_fn_t)(void *ctx, const char *line);
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Zera tudo e prepara o núcleo que chama (como prof_zone_init_core)
+ *
+ * @details Chame uma vez, antes de qualquer zona e antes de iniciar o core1.
+ */
+void prof_zone_init(void);
+
+/**
+ * @brief Prepara o núcleo que chama
+ *
+ * @details Firmware: liga o SysTick do núcleo, se estiver desligado; chame
+ *          também no início do core1. Host: associa a thread que chama ao
+ *          próximo índice de núcleo livre.
+ */
+void prof_zone_init_core(void);
+
+/**
+ * @brief Registra (ou encontra) uma zona pelo nome
+ *
+ * @return Índice da zona, ou PROF_ZONE_INVALID se a tabela estiver cheia
+ */
+uint16_t prof_zone_register(const char *name);
+
+/** Abre uma zona já registrada */
+prof_zone_scope_t prof_zone_begin_id(uint16_t zone);
+
+/** Abre a zona de um local, registrando-a na primeira vez */
+prof_zone_scope_t prof_zone_begin(prof_zone_site_t *site);
+
+/** Fecha a zona: atualiza as métricas do núcleo e grava o evento no anel */
+void prof_zone_end(prof_zone_scope_t *scope);
+
+/** Liga/desliga a gravação no anel (as métricas continuam) */
+void prof_zone_set_capture(bool on);
+
+/** Zonas registradas */
+uint16_t prof_zone_count(void);
+
+/** Nome de uma zona, ou NULL */
+const char *prof_zone_name(uint16_t zone);
+
+/**
+ * @brief Métricas de uma zona num núcleo
+ *
+ * @details Leitura sem trava: se o núcleo estiver medindo, os campos podem
+ *          vir de atualizações diferentes (é um instantâneo).
+ *
+ * @return false se a zona ou o núcleo forem inválidos
+ */
+bool prof_zone_get_stats(uint16_t zone, uint8_t core, prof_zone_stats_t *out);
+
+/** Zera métricas e anéis; cada núcleo aplica na sua próxima zona */
+void prof_zone_reset(void);
+
+/**
+ * @brief Tabela de texto: uma linha por zona e núcleo com medições
+ *
+ * @details Colunas: zona, núcleo, n, mín, média, máx e p99 em us.
+ */
+void prof_zone_dump(prof_zone_emit_fn_t emit, void *ctx);
+
+/**
+ * @brief Exporta os anéis de todos os núcleos em binário
+ *
+ * @details A gravação nos anéis é suspensa durante a exportação. Formato
+ *          (little-endian):
+ *
+ *          ┌──────────────────────────┬─────────────────────────────────────┐
+ *          │ Cabeçalho (16 bytes)     │ "PZTR", u16 versão, u16 zonas,      │
+ *          │                          │ u8 núcleos, u8 bytes do nome,       │
+ *          │                          │ u16 bytes do evento, u32 reservado  │
+ *          │ Nomes                    │ zonas x PROF_ZONE_NAME_LEN bytes    │
+ *          │ Por núcleo (16 bytes)    │ u32 tick_hz, u32 eventos, u32       │
+ *          │                          │ sobrescritos, u32 reservado         │
+ *          │   eventos                │ prof_zone_event_t, do mais antigo   │
+ *          └──────────────────────────┴─────────────────────────────────────┘
+ *
+ * @return false se `write` falhar
+ */
+bool prof_zone_export(prof_zone_write_fn_t write, void *ctx);
+
+/* =============================================================================
+ * SEÇÃO 4: MACROS
+ * =============================================================================
+ */
+
+#define PROF_ZONE_CAT_(a, b) a##b
+#define PROF_ZONE_CAT(a, b)  PROF_ZONE_CAT_(a, b)
+
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+
+/** Zona até o fim do bloco (atributo cleanup do GCC/Clang) */
+#define PROF_ZONE(name)                                                              \
+    static prof_zone_site_t PROF_ZONE_CAT(prof_site_, __LINE__) = { (name), 0u, false }; \
+    prof_zone_scope_t PROF_ZONE_CAT(prof_scope_, __LINE__)                           \
+        __attribute__((cleanup(prof_zone_end))) =                                    \
+            prof_zone_begin(&PROF_ZONE_CAT(prof_site_, __LINE__))
+
+/** Zona até o fim do bloco, com índice de prof_zone_register() */
+#define PROF_ZONE_ID(id)                                                             \
+    prof_zone_scope_t PROF_ZONE_CAT(prof_scope_, __LINE__)                           \
+        __attribute__((cleanup(prof_zone_end))) = prof_zone_begin_id(id)
+
+/** Zona explícita, para trechos que não formam um bloco */
+#define PROF_ZONE_BEGIN(var, name)                                                   \
+    static prof_zone_site_t var##_site = { (name), 0u, false };                      \
+    prof_zone_scope_t var = prof_zone_begin(&var##_site)
+#define PROF_ZONE_END(var) prof_zone_end(&(var))
+
+#else
+
+#define PROF_ZONE(name)            ((void)0)
+#define PROF_ZONE_ID(id)           ((void)0)
+#define PROF_ZONE_BEGIN(var, name) ((void)0)
+#define PROF_ZONE_END(var)         ((void)0)
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROF_ZONE_H */
@@ -0,0 +1,33 @@
+/**
+ * =============================================================================
+ * @file    prof_zone_hooks.h
+ * @brief   Macros PROF_ZONE() para módulos que linkam o prof_zone opcionalmente
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os módulos instrumentados (sensor_acq, oled_gfx, log_vt100) só
+ *          linkam o prof_zone quando ele faz parte do build. Este cabeçalho
+ *          não depende da biblioteca: com PROF_ZONE_ENABLED inclui
+ *          prof_zone.h; sem ela, define as mesmas macros como ((void)0).
+ *          Basta pôr este diretório no caminho de include do módulo.
+ * =============================================================================
+ */
+
+#ifndef PROF_ZONE_HOOKS_H
+#define PROF_ZONE_HOOKS_H
+
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+#include "prof_zone.h"
+#else
+#define PROF_ZONE(name)            ((void)0)
+#define PROF_ZONE_ID(id)           ((void)0)
+#define PROF_ZONE_BEGIN(var, name) ((void)0)
+#define PROF_ZONE_END(var)         ((void)0)
+#endif
+
+#endif /* PROF_ZONE_HOOKS_H */
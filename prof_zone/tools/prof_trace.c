@@ -0,0 +1,189 @@
+/**
+ * =============================================================================
+ * @file    prof_trace.c
+ * @brief   (Host) Converte a exportação do prof_zone para trace JSON do Chrome
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada zona vira um evento completo ("ph":"X") na linha do tempo do
+ *          seu núcleo; o aninhamento aparece pela sobreposição dos tempos.
+ *          O início vem em microssegundos (time_us_32) e a duração em ticks
+ *          do núcleo, convertida com o tick_hz gravado no arquivo. Os tempos
+ *          começam em zero no evento mais antigo.
+ *
+ *          Abra o JSON em chrome://tracing ou em https://ui.perfetto.dev.
+ *
+ *          Uso: prof_trace entrada.pzt [saida.json]
+ *          Retorno: 0 em sucesso, 2 em erro de leitura ou formato.
+ * =============================================================================
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_ZONES   256u
+#define MAX_CORES   8u
+#define MAX_EVENTS  65536u
+#define NAME_LEN    64u
+
+typedef struct {
+    uint32_t t_us;
+    uint32_t ticks;
+    uint16_t zone;
+    uint8_t core;
+} event_t;
+
+static char names[MAX_ZONES][NAME_LEN];
+static event_t events[MAX_EVENTS];
+static uint32_t tick_hz[MAX_CORES];
+
+static inline uint16_t get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t get32(const uint8_t *p) {
+    return (uint32_t)get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+static bool read_exact(FILE *f, void *dst, size_t n) {
+    return fread(dst, 1, n, f) == n;
+}
+
+/** Nome como string JSON (aspas, barra e controle escapados) */
+static void put_json_str(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        const unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fprintf(out, "\\%c", c);
+        } else if (c < 0x20u) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+int main(int argc, char **argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "uso: %s entrada.pzt [saida.json]\n", argv[0]);
+        return 2;
+    }
+    FILE *in = fopen(argv[1], "rb");
+    if (!in) {
+        perror(argv[1]);
+        return 2;
+    }
+
+    uint8_t hdr[16];
+    if (!read_exact(in, hdr, sizeof hdr) || memcmp(hdr, "PZTR", 4) != 0 || get16(hdr + 4) != 1u) {
+        fprintf(stderr, "%s: não é uma exportação do prof_zone (versão 1)\n", argv[1]);
+        fclose(in);
+        return 2;
+    }
+    const uint16_t n_zones = get16(hdr + 6);
+    const uint8_t n_cores = hdr[8];
+    const uint8_t name_len = hdr[9];
+    const uint16_t event_len = get16(hdr + 10);
+    if (n_zones > MAX_ZONES || n_cores > MAX_CORES || name_len == 0u || name_len > NAME_LEN ||
+        event_len < 12u || event_len > 64u) {
+        fprintf(stderr, "%s: cabeçalho fora dos limites\n", argv[1]);
+        fclose(in);
+        return 2;
+    }
+
+    for (uint16_t z = 0; z < n_zones; z++) {
+        if (!read_exact(in, names[z], name_len)) {
+            fprintf(stderr, "%s: tabela de nomes truncada\n", argv[1]);
+            fclose(in);
+            return 2;
+        }
+        names[z][name_len - 1u] = '\0';
+    }
+
+    uint32_t n_events = 0;
+    for (uint8_t core = 0; core < n_cores; core++) {
+        uint8_t ch[16];
+        if (!read_exact(in, ch, sizeof ch)) {
+            fprintf(stderr, "%s: núcleo %u truncado\n", argv[1], core);
+            fclose(in);
+            return 2;
+        }
+        tick_hz[core] = get32(ch);
+        const uint32_t count = get32(ch + 4);
+        fprintf(stderr, "núcleo %u: %lu eventos, %lu sobrescritos, %lu ticks/s\n", core,
+                (unsigned long)count, (unsigned long)get32(ch + 8), (unsigned long)tick_hz[core]);
+        for (uint32_t i = 0; i < count; i++) {
+            uint8_t e[64];
+            if (!read_exact(in, e, event_len)) {
+                fprintf(stderr, "%s: eventos do núcleo %u truncados\n", argv[1], core);
+                fclose(in);
+                return 2;
+            }
+            if (n_events == MAX_EVENTS) {
+                continue;
+            }
+            event_t *ev = &events[n_events++];
+            ev->t_us = get32(e);
+            ev->ticks = get32(e + 4);
+            ev->zone = get16(e + 8);
+            ev->core = core;
+        }
+    }
+    fclose(in);
+
+    FILE *out = stdout;
+    if (argc == 3) {
+        out = fopen(argv[2], "w");
+        if (!out) {
+            perror(argv[2]);
+            return 2;
+        }
+    }
+
+    /* time_us_32 dá a volta a cada ~71 min: diferenças com sinal ao 1º evento */
+    int64_t base = 0;
+    for (uint32_t i = 0; i < n_events; i++) {
+        const int64_t rel = (int32_t)(events[i].t_us - events[0].t_us);
+        if (rel < base) {
+            base = rel;
+        }
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (uint8_t core = 0; core < n_cores; core++) {
+        fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                     "\"args\":{\"name\":\"core%u\"}},\n", core, core);
+    }
+    for (uint32_t i = 0; i < n_events; i++) {
+        const event_t *ev = &events[i];
+        const int64_t ts = (int32_t)(ev->t_us - events[0].t_us) - base;
+        const double dur = tick_hz[ev->core] ? (double)ev->ticks * 1e6 / tick_hz[ev->core] : 0.0;
+        fprintf(out, "{\"name\":");
+        if (ev->zone < n_zones) {
+            put_json_str(out, names[ev->zone]);
+        } else {
+            fprintf(out, "\"zona_%u\"", ev->zone);
+        }
+        fprintf(out, ",\"cat\":\"prof_zone\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+                     "\"ts\":%lld,\"dur\":%.3f},\n", ev->core, (long long)ts, dur);
+    }
+    /* Evento vazio no fim: o JSON não aceita vírgula sobrando */
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+                 "\"args\":{\"name\":\"prof_zone\"}}\n]}\n");
+
+    if (out != stdout) {
+        fclose(out);
+    }
+    fprintf(stderr, "%lu zonas no trace%s\n", (unsigned long)n_events,
+            n_events == MAX_EVENTS ? " (limite do conversor atingido)" : "");
+    return 0;
+}
@@ -0,0 +1,204 @@
+/**
+ * =============================================================================
+ * @file    prof_zone_demo.c
+ * @brief   (Host) Demonstração e verificação do prof_zone com dois "núcleos"
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Duas threads fazem o papel do core0 e do core1. O core0 mede um
+ *          "quadro" com zonas aninhadas (CRC16 de setores do sd_crc e uma
+ *          espera de 100 us); o core1, CRCs e esperas de 250 us. Confere as
+ *          contagens por núcleo, a ordem mín <= média <= p99 <= máx, que as
+ *          esperas não saem mais curtas que o pedido e que a exportação tem
+ *          o tamanho esperado. Depois mede o custo de uma zona vazia.
+ *
+ *          Uso: prof_zone_demo [-q] [-o saida.pzt]
+ *            -q  menos repetições
+ *            -o  grava a exportação binária (converta com prof_trace)
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "prof_zone.h"
+#include "sd_crc.h"
+#include "bench_report.h"
+#include "test_check.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+static uint8_t sector[4][512];
+static volatile uint16_t sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+static void spin_us(unsigned us) {
+    const uint64_t end = now_ns() + (uint64_t)us * 1000u;
+    while (now_ns() < end) {
+    }
+}
+
+static void crc_sector(unsigned i) {
+    PROF_ZONE("crc_setor");
+    sink ^= sd_crc16(sector[i & 3u], sizeof sector[0]);
+}
+
+/* =============================================================================
+ * SEÇÃO 1: CARGA DOS DOIS NÚCLEOS
+ * =============================================================================
+ */
+
+static unsigned frames, core1_iters;
+
+static void *core1_main(void *arg) {
+    (void)arg;
+    prof_zone_init_core();
+    for (unsigned i = 0; i < core1_iters; i++) {
+        crc_sector(i);
+        PROF_ZONE_BEGIN(wait, "espera_250us");
+        spin_us(250u);
+        PROF_ZONE_END(wait);
+    }
+    return NULL;
+}
+
+static void core0_frame(unsigned f) {
+    PROF_ZONE("quadro");
+    for (unsigned i = 0; i < 4u; i++) {
+        crc_sector(f + i);
+    }
+    {
+        PROF_ZONE("espera_100us");
+        spin_us(100u);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: VERIFICAÇÃO
+ * =============================================================================
+ */
+
+static bool stats_of(const char *name, uint8_t core, prof_zone_stats_t *st) {
+    for (uint16_t z = 0; z < prof_zone_count(); z++) {
+        if (strcmp(prof_zone_name(z), name) == 0) {
+            return prof_zone_get_stats(z, core, st);
+        }
+    }
+    memset(st, 0, sizeof *st);
+    return false;
+}
+
+static void check_zone(const char *name, uint8_t core, uint32_t count, uint32_t min_us) {
+    prof_zone_stats_t st;
+    CHECK(stats_of(name, core, &st), "zona %s não registrada", name);
+    CHECK(st.count == count, "%s/núcleo %u: %lu medições, esperado %lu", name, core,
+          (unsigned long)st.count, (unsigned long)count);
+    if (st.count == 0u) {
+        return;
+    }
+    const uint64_t mean = st.sum_ticks / st.count;
+    CHECK(st.min_ticks <= mean && mean <= st.max_ticks, "%s: média fora de [mín, máx]", name);
+    CHECK(st.min_ticks <= st.p99_ticks && st.p99_ticks <= st.max_ticks,
+          "%s: p99 fora de [mín, máx]", name);
+    CHECK((uint64_t)st.min_ticks * 1000000u >= (uint64_t)min_us * st.tick_hz,
+          "%s: mínimo de %lu ticks menor que %u us", name, (unsigned long)st.min_ticks, min_us);
+}
+
+static void print_line(void *ctx, const char *line) {
+    (void)ctx;
+    printf("%s\n", line);
+}
+
+typedef struct {
+    FILE *f;
+    size_t bytes;
+} sink_t;
+
+static bool write_out(void *ctx, const void *data, size_t len) {
+    sink_t *s = ctx;
+    s->bytes += len;
+    return !s->f || fwrite(data, 1, len, s->f) == len;
+}
+
+int main(int argc, char **argv) {
+    bool quick = false;
+    const char *out_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            quick = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            out_path = argv[++i];
+        } else {
+            fprintf(stderr, "uso: %s [-q] [-o saida.pzt]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    sd_crc_init();
+    for (unsigned i = 0; i < sizeof sector; i++) {
+        sector[i / 512u][i % 512u] = (uint8_t)(i * 37u + 11u);
+    }
+    frames = quick ? 200u : 2000u;
+    core1_iters = quick ? 100u : 1000u;
+
+    prof_zone_init();
+    pthread_t th;
+    pthread_create(&th, NULL, core1_main, NULL);
+    for (unsigned f = 0; f < frames; f++) {
+        core0_frame(f);
+    }
+    pthread_join(th, NULL);
+
+    prof_zone_dump(print_line, NULL);
+
+    check_zone("quadro", 0, frames, 100u);
+    check_zone("crc_setor", 0, frames * 4u, 0u);
+    check_zone("espera_100us", 0, frames, 100u);
+    check_zone("crc_setor", 1, core1_iters, 0u);
+    check_zone("espera_250us", 1, core1_iters, 250u);
+    check_zone("espera_250us", 0, 0u, 0u);
+
+    /* Exportação: cabeçalho, nomes e, por núcleo, os últimos eventos do anel */
+    sink_t s = { NULL, 0 };
+    if (out_path) {
+        s.f = fopen(out_path, "wb");
+        if (!s.f) {
+            perror(out_path);
+            return 2;
+        }
+    }
+    CHECK(prof_zone_export(write_out, &s), "exportação falhou");
+    if (s.f) {
+        fclose(s.f);
+        printf("exportação: %s (%zu bytes)\n", out_path, s.bytes);
+    }
+    const uint32_t ev0 = frames * 6u, ev1 = core1_iters * 2u;
+    const size_t expect = 16u + prof_zone_count() * (size_t)PROF_ZONE_NAME_LEN + 2u * 16u +
+                          12u * ((ev0 < PROF_ZONE_RING_EVENTS ? ev0 : PROF_ZONE_RING_EVENTS) +
+                                 (ev1 < PROF_ZONE_RING_EVENTS ? ev1 : PROF_ZONE_RING_EVENTS));
+    CHECK(s.bytes == expect, "exportação com %zu bytes, esperado %zu", s.bytes, expect);
+
+    /* Custo de uma zona vazia (duas leituras de relógio e as métricas) */
+    prof_zone_reset();
+    const unsigned reps = quick ? 200000u : 2000000u;
+    const uint64_t t0 = now_ns();
+    for (unsigned i = 0; i < reps; i++) {
+        PROF_ZONE("vazia");
+    }
+    const double zone_ns = (double)(now_ns() - t0) / reps;
+    printf("custo de uma zona vazia: %.1f ns\n", zone_ns);
+    bench_report("prof_zone_demo", "zone_overhead_ns", zone_ns, "ns");
+
+    return test_check_summary();
+}
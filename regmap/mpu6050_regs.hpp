@@ -0,0 +1,130 @@
+/**
+ * =============================================================================
+ * @file    mpu6050_regs.hpp
+ * @brief   Mapa tipado dos registradores do MPU6050
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os mesmos registradores que a classe MPU6050 usa (endereço 0x68),
+ *          com os campos de configuração. As saídas são int16_t big-endian
+ *          de 0x3B a 0x48: ler as sete em sequência é uma rajada de 14
+ *          bytes, a mesma de MPU6050::readRaw().
+ *
+ *              regmap::WireBus<I2C> bus{ wire, mpu6050::I2C_ADDR };
+ *              regmap::modify(bus, mpu6050::GYRO_FS_SEL::set(mpu6050::GyroRange::Dps500));
+ *              regmap::read_regs<mpu6050::ACCEL_XOUT, ..., mpu6050::GYRO_ZOUT>(bus, ...);
+ * =============================================================================
+ */
+
+#ifndef MPU6050_REGS_HPP
+#define MPU6050_REGS_HPP
+
+#include "regmap.hpp"
+
+namespace mpu6050 {
+
+using regmap::Access;
+using regmap::Endian;
+using regmap::Field;
+using regmap::Reg;
+using regmap::Status;
+
+static constexpr uint8_t I2C_ADDR = 0x68;   /**< AD0 em 0 */
+static constexpr uint8_t ID = 0x68;         /**< Valor de WHO_AM_I */
+
+/* =============================================================================
+ * SEÇÃO 1: VALORES DOS CAMPOS
+ * =============================================================================
+ */
+
+enum class ClockSource : uint8_t {
+    Internal8MHz = 0,
+    PllGyroX = 1,
+    PllGyroY = 2,
+    PllGyroZ = 3,
+    Stop = 7,
+};
+
+enum class GyroRange : uint8_t { Dps250 = 0, Dps500 = 1, Dps1000 = 2, Dps2000 = 3 };
+
+enum class AccelRange : uint8_t { G2 = 0, G4 = 1, G8 = 2, G16 = 3 };
+
+/** Filtro passa-baixas (banda do acelerômetro / giroscópio) */
+enum class Dlpf : uint8_t {
+    Hz260 = 0,
+    Hz184 = 1,
+    Hz94 = 2,
+    Hz44 = 3,
+    Hz21 = 4,
+    Hz10 = 5,
+    Hz5 = 6,
+};
+
+/* =============================================================================
+ * SEÇÃO 2: REGISTRADORES
+ * =============================================================================
+ */
+
+using SMPLRT_DIV = Reg<0x19>;     /**< Taxa = 8 ou 1 kHz / (1 + SMPLRT_DIV) */
+using CONFIG = Reg<0x1A>;
+using GYRO_CONFIG = Reg<0x1B>;
+using ACCEL_CONFIG = Reg<0x1C>;
+
+/** Saídas (0x3B..0x48, contíguas) */
+using ACCEL_XOUT = Status<0x3B, int16_t>;   /**< ACCEL_OUT da classe MPU6050 */
+using ACCEL_YOUT = Status<0x3D, int16_t>;
+using ACCEL_ZOUT = Status<0x3F, int16_t>;
+using TEMP_OUT = Status<0x41, int16_t>;     /**< °C = TEMP_OUT / 340 + 36.53 */
+using GYRO_XOUT = Status<0x43, int16_t>;    /**< GYRO_OUT da classe MPU6050 */
+using GYRO_YOUT = Status<0x45, int16_t>;
+using GYRO_ZOUT = Status<0x47, int16_t>;
+
+/** Bits que se limpam sozinhos */
+using SIGNAL_PATH_RESET = Reg<0x68, uint8_t, Endian::Big, Access::WO, true>;
+/** DEVICE_RESET se limpa sozinho */
+using PWR_MGMT_1 = Reg<0x6B, uint8_t, Endian::Big, Access::RW, true>;
+using PWR_MGMT_2 = Reg<0x6C>;
+using WHO_AM_I = Reg<0x75, uint8_t, Endian::Big, Access::RO>;
+
+/* =============================================================================
+ * SEÇÃO 3: CAMPOS
+ * =============================================================================
+ */
+
+using DLPF_CFG = Field<CONFIG, 0, 3, Dlpf>;
+using EXT_SYNC_SET = Field<CONFIG, 3, 3>;
+
+using GYRO_FS_SEL = Field<GYRO_CONFIG, 3, 2, GyroRange>;
+using GYRO_SELF_TEST = Field<GYRO_CONFIG, 5, 3>;      /**< ZG_ST, YG_ST, XG_ST */
+
+using ACCEL_AFS_SEL = Field<ACCEL_CONFIG, 3, 2, AccelRange>;
+using ACCEL_SELF_TEST = Field<ACCEL_CONFIG, 5, 3>;    /**< ZA_ST, YA_ST, XA_ST */
+
+using TEMP_RESET = Field<SIGNAL_PATH_RESET, 0, 1, bool>;
+using ACCEL_RESET = Field<SIGNAL_PATH_RESET, 1, 1, bool>;
+using GYRO_RESET = Field<SIGNAL_PATH_RESET, 2, 1, bool>;
+
+using CLKSEL = Field<PWR_MGMT_1, 0, 3, ClockSource>;
+using TEMP_DIS = Field<PWR_MGMT_1, 3, 1, bool>;
+using CYCLE = Field<PWR_MGMT_1, 5, 1, bool>;
+using SLEEP = Field<PWR_MGMT_1, 6, 1, bool>;
+using DEVICE_RESET = Field<PWR_MGMT_1, 7, 1, bool>;
+
+using STBY_GYRO = Field<PWR_MGMT_2, 0, 3>;            /**< ZG, YG, XG */
+using STBY_ACCEL = Field<PWR_MGMT_2, 3, 3>;           /**< ZA, YA, XA */
+using LP_WAKE_CTRL = Field<PWR_MGMT_2, 6, 2>;
+
+using WHO_AM_I_ID = Field<WHO_AM_I, 1, 6>;            /**< 0x34 (= 0x68 >> 1) */
+
+static_assert(regmap::transactions<ACCEL_XOUT, ACCEL_YOUT, ACCEL_ZOUT, TEMP_OUT, GYRO_XOUT,
+                                   GYRO_YOUT, GYRO_ZOUT> == 1,
+              "saídas do MPU6050 devem sair numa rajada");
+
+}  // namespace mpu6050
+
+#endif /* MPU6050_REGS_HPP */
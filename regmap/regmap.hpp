@@ -0,0 +1,474 @@
+/**
+ * =============================================================================
+ * @file    regmap.hpp
+ * @brief   Mapas de registradores tipados em tempo de compilação (C++17)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os drivers do kit acessam os registradores por funções sem tipo
+ *          (readReg, readReg16Bit, read8...) e cada chamada repete
+ *          deslocamentos e máscaras. Aqui cada registrador é um tipo que
+ *          carrega, em constexpr, tudo o que a chamada precisa saber:
+ *
+ *          ┌──────────────┬──────────────────────────────────────────────────┐
+ *          │ Reg<...>     │ endereço, tipo do valor (largura e sinal),       │
+ *          │              │ ordem dos bytes, acesso (RW/RO/WO), volátil      │
+ *          │ Field<...>   │ registrador, bit menos significativo, largura e  │
+ *          │              │ tipo (ex.: enum class com as faixas do sensor)   │
+ *          └──────────────┴──────────────────────────────────────────────────┘
+ *
+ *          ACESSOS (todos resolvidos na compilação):
+ *          - read<R>/write<R>: uma transação com R::bytes bytes.
+ *          - read<F>: lê o registrador e extrai o campo.
+ *          - modify(bus, F1::set(a), F2::set(b)...): os campos de um mesmo
+ *            registrador viram um único read-modify-write; se cobrirem todos
+ *            os bits, só a escrita.
+ *          - read_regs<R1, R2...>/write_regs: registradores de endereços
+ *            contíguos saem numa única rajada (auto-incremento do I2C);
+ *            cada trecho contíguo vira uma transação.
+ *          - Escrever num RO, ler de um WO, sobrepor campos no mesmo
+ *            modify ou guardar cópia (Shadow) de um registrador volátil são
+ *            erros de compilação.
+ *
+ *          BARRAMENTO: qualquer tipo com
+ *              bool read(uint8_t reg, uint8_t *dst, size_t n);
+ *              bool write(uint8_t reg, const uint8_t *src, size_t n);
+ *          WireBus adapta a classe I2C dos drivers (estilo Arduino) e, no
+ *          firmware, PicoI2cBus usa o hardware/i2c do Pico SDK.
+ * =============================================================================
+ */
+
+#ifndef REGMAP_HPP
+#define REGMAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/i2c.h"
+#endif
+
+namespace regmap {
+
+/* =============================================================================
+ * SEÇÃO 1: REGISTRADOR
+ * =============================================================================
+ */
+
+enum class Endian : uint8_t { Big, Little };
+enum class Access : uint8_t { RW, RO, WO };
+
+/**
+ * @brief Um registrador
+ *
+ * @tparam Addr     Endereço do primeiro byte
+ * @tparam T        Tipo do valor: largura (1 a 4 bytes) e sinal
+ * @tparam E        Ordem dos bytes no barramento
+ * @tparam A        Acesso permitido
+ * @tparam Volatile O dispositivo muda o valor sozinho (status, medições,
+ *                  bits que se limpam): nunca pode ser servido de cópia
+ */
+template <uint8_t Addr, typename T = uint8_t, Endian E = Endian::Big, Access A = Access::RW,
+          bool Volatile = false>
+struct Reg {
+    static_assert(std::is_integral<T>::value && sizeof(T) <= 4, "registrador de 1 a 4 bytes");
+
+    using value_type = T;
+    using raw_type = typename std::make_unsigned<T>::type;
+
+    static constexpr uint8_t addr = Addr;
+    static constexpr size_t bytes = sizeof(T);
+    static constexpr Endian endian = E;
+    static constexpr Access access = A;
+    static constexpr bool is_volatile = Volatile;
+    static constexpr raw_type all_bits = static_cast<raw_type>(~raw_type(0));
+
+    /** Bytes do barramento -> valor bruto */
+    static constexpr raw_type decode(const uint8_t *p) {
+        /* 1 e 2 bytes com a mesma expressão do código à mão (o compilador
+           reconhece a troca de bytes); acima disso, o laço */
+        if constexpr (bytes == 1) {
+            return p[0];
+        } else if constexpr (bytes == 2) {
+            return static_cast<raw_type>(E == Endian::Big ? (p[0] << 8 | p[1]) : (p[1] << 8 | p[0]));
+        }
+        uint32_t v = 0;
+        for (size_t i = 0; i < bytes; i++) {
+            v |= static_cast<uint32_t>(p[i]) << (8u * (E == Endian::Big ? bytes - 1u - i : i));
+        }
+        return static_cast<raw_type>(v);
+    }
+
+    /** Valor bruto -> bytes do barramento */
+    static constexpr void encode(raw_type v, uint8_t *p) {
+        for (size_t i = 0; i < bytes; i++) {
+            p[i] = static_cast<uint8_t>(v >> (8u * (E == Endian::Big ? bytes - 1u - i : i)));
+        }
+    }
+};
+
+/** Registrador só de leitura e volátil (status, resultados) */
+template <uint8_t Addr, typename T = uint8_t, Endian E = Endian::Big>
+using Status = Reg<Addr, T, E, Access::RO, true>;
+
+/* =============================================================================
+ * SEÇÃO 2: CAMPO
+ * =============================================================================
+ */
+
+/** Valor de campos de R já deslocado; Mask diz quais bits ele define */
+template <class R, typename R::raw_type Mask>
+struct Update {
+    using reg = R;
+    static constexpr typename R::raw_type mask = Mask;
+    typename R::raw_type bits;
+};
+
+/**
+ * @brief Um campo de bits de um registrador
+ *
+ * @tparam T Tipo do campo: inteiro, bool ou enum class
+ */
+template <class R, unsigned Lsb, unsigned Width, typename T = typename R::raw_type>
+struct Field {
+    using reg = R;
+    using value_type = T;
+    using raw_type = typename R::raw_type;
+
+    static_assert(Width > 0 && Lsb + Width <= 8u * sizeof(raw_type), "campo fora do registrador");
+
+    static constexpr unsigned lsb = Lsb;
+    static constexpr unsigned width = Width;
+    static constexpr raw_type mask = static_cast<raw_type>(
+        (Width == 8u * sizeof(raw_type) ? R::all_bits
+                                        : static_cast<raw_type>((1ull << Width) - 1u))
+        << Lsb);
+
+    static constexpr T get(raw_type r) {
+        return static_cast<T>((r & mask) >> Lsb);
+    }
+
+    static constexpr Update<R, mask> set(T v) {
+        return Update<R, mask>{ static_cast<raw_type>((static_cast<raw_type>(v) << Lsb) & mask) };
+    }
+};
+
+/** F é um Field (tem F::reg)? */
+template <class X, class = void>
+struct is_field : std::false_type {};
+template <class X>
+struct is_field<X, std::void_t<typename X::reg, decltype(X::lsb)>> : std::true_type {};
+
+namespace detail {
+
+constexpr unsigned popcount(uint32_t v) {
+    unsigned n = 0;
+    for (; v; v &= v - 1u) {
+        n++;
+    }
+    return n;
+}
+
+template <class R>
+constexpr bool readable = R::access != Access::WO;
+template <class R>
+constexpr bool writable = R::access != Access::RO;
+
+/**
+ * Trechos contíguos de uma lista de registradores: para cada registrador,
+ * onde ele fica no buffer e quantos bytes a rajada que começa nele
+ * transfere (0 se ele continua a anterior).
+ */
+template <size_t N>
+struct Runs {
+    uint8_t addr[N];
+    size_t off[N];
+    size_t len[N];
+};
+
+template <class... Rs>
+constexpr Runs<sizeof...(Rs)> runs_of() {
+    constexpr uint8_t addrs[] = { Rs::addr... };
+    constexpr size_t sizes[] = { Rs::bytes... };
+    Runs<sizeof...(Rs)> r{};
+    size_t start = 0, off = 0;
+    for (size_t i = 0; i < sizeof...(Rs); i++) {
+        r.addr[i] = addrs[i];
+        r.off[i] = off;
+        r.len[i] = 0;
+        if (i > 0 && addrs[i] == static_cast<size_t>(addrs[i - 1]) + sizes[i - 1]) {
+            r.len[start] += sizes[i];
+        } else {
+            start = i;
+            r.len[i] = sizes[i];
+        }
+        off += sizes[i];
+    }
+    return r;
+}
+
+template <class... Rs>
+constexpr size_t transactions_of() {
+    constexpr Runs<sizeof...(Rs)> r = runs_of<Rs...>();
+    size_t n = 0;
+    for (size_t i = 0; i < sizeof...(Rs); i++) {
+        n += r.len[i] != 0u;
+    }
+    return n;
+}
+
+/**
+ * Uma chamada ao barramento por trecho, com endereço e tamanho constantes:
+ * o laço sobre os trechos é expandido na compilação (um laço em tempo de
+ * execução deixaria o memcpy/DMA do barramento com tamanho variável).
+ */
+template <class... Rs>
+struct Burst {
+    static constexpr Runs<sizeof...(Rs)> runs = runs_of<Rs...>();
+
+    template <size_t I, class Bus>
+    static bool read_run(Bus &bus, uint8_t *buf) {
+        if constexpr (runs.len[I] == 0u) {
+            return true;
+        } else {
+            return bus.read(runs.addr[I], buf + runs.off[I], runs.len[I]);
+        }
+    }
+
+    template <size_t I, class Bus>
+    static bool write_run(Bus &bus, const uint8_t *buf) {
+        if constexpr (runs.len[I] == 0u) {
+            return true;
+        } else {
+            return bus.write(runs.addr[I], buf + runs.off[I], runs.len[I]);
+        }
+    }
+
+    template <class Bus, size_t... I>
+    static bool read(Bus &bus, uint8_t *buf, std::index_sequence<I...>) {
+        return (read_run<I>(bus, buf) && ...);
+    }
+
+    template <class Bus, size_t... I>
+    static bool write(Bus &bus, const uint8_t *buf, std::index_sequence<I...>) {
+        return (write_run<I>(bus, buf) && ...);
+    }
+};
+
+}  // namespace detail
+
+/** Transações que read_regs/write_regs<Rs...> fazem (para static_assert) */
+template <class... Rs>
+constexpr size_t transactions = detail::transactions_of<Rs...>();
+
+/* =============================================================================
+ * SEÇÃO 3: ACESSOS
+ * =============================================================================
+ */
+
+/** Lê um registrador inteiro, ou um campo */
+template <class X, class Bus>
+bool read(Bus &bus, typename X::value_type &out) {
+    if constexpr (is_field<X>::value) {
+        using R = typename X::reg;
+        static_assert(detail::readable<R>, "registrador só de escrita");
+        uint8_t buf[R::bytes];
+        if (!bus.read(R::addr, buf, R::bytes)) {
+            return false;
+        }
+        out = X::get(R::decode(buf));
+    } else {
+        static_assert(detail::readable<X>, "registrador só de escrita");
+        uint8_t buf[X::bytes];
+        if (!bus.read(X::addr, buf, X::bytes)) {
+            return false;
+        }
+        out = static_cast<typename X::value_type>(X::decode(buf));
+    }
+    return true;
+}
+
+/** Escreve um registrador inteiro (para campos, use modify) */
+template <class R, class Bus>
+bool write(Bus &bus, typename R::value_type v) {
+    static_assert(!is_field<R>::value, "campo: use modify(bus, Campo::set(v))");
+    static_assert(detail::writable<R>, "registrador só de leitura");
+    uint8_t buf[R::bytes];
+    R::encode(static_cast<typename R::raw_type>(v), buf);
+    return bus.write(R::addr, buf, R::bytes);
+}
+
+/**
+ * @brief Atualiza campos de um registrador numa única transação
+ *
+ * @details Se os campos cobrem todos os bits, escreve sem ler; senão, um
+ *          read-modify-write (uma leitura e uma escrita para N campos).
+ */
+template <class Bus, class U0, class... Us>
+bool modify(Bus &bus, U0 u0, Us... us) {
+    using R = typename U0::reg;
+    using raw_type = typename R::raw_type;
+    static_assert((std::is_same<R, typename Us::reg>::value && ...),
+                  "modify: todos os campos devem ser do mesmo registrador");
+    static_assert(detail::writable<R>, "registrador só de leitura");
+
+    constexpr raw_type mask = static_cast<raw_type>((U0::mask | ... | Us::mask));
+    static_assert(detail::popcount(mask) ==
+                      (detail::popcount(U0::mask) + ... + detail::popcount(Us::mask)),
+                  "modify: campos sobrepostos");
+    const raw_type bits = static_cast<raw_type>((u0.bits | ... | us.bits));
+
+    uint8_t buf[R::bytes];
+    raw_type v = bits;
+    if constexpr (mask != R::all_bits) {
+        static_assert(detail::readable<R>, "read-modify-write num registrador só de escrita");
+        if (!bus.read(R::addr, buf, R::bytes)) {
+            return false;
+        }
+        v = static_cast<raw_type>((R::decode(buf) & static_cast<raw_type>(~mask)) | bits);
+    }
+    R::encode(v, buf);
+    return bus.write(R::addr, buf, R::bytes);
+}
+
+/**
+ * @brief Cópia em RAM de um registrador não volátil
+ *
+ * @details Com a cópia válida, modify_cached() escreve sem ler. Só faz
+ *          sentido para registradores que o dispositivo não muda sozinho.
+ */
+template <class R>
+struct Shadow {
+    static_assert(!R::is_volatile, "registrador volátil não pode ter cópia");
+    typename R::raw_type value;
+    bool valid;
+};
+
+template <class Bus, class R, class U0, class... Us>
+bool modify_cached(Bus &bus, Shadow<R> &shadow, U0 u0, Us... us) {
+    using raw_type = typename R::raw_type;
+    static_assert(std::is_same<R, typename U0::reg>::value &&
+                      (std::is_same<R, typename Us::reg>::value && ...),
+                  "modify_cached: campos de outro registrador");
+    constexpr raw_type mask = static_cast<raw_type>((U0::mask | ... | Us::mask));
+    uint8_t buf[R::bytes];
+    if (!shadow.valid && mask != R::all_bits) {
+        if (!bus.read(R::addr, buf, R::bytes)) {
+            return false;
+        }
+        shadow.value = R::decode(buf);
+    }
+    const raw_type v = static_cast<raw_type>((shadow.value & static_cast<raw_type>(~mask)) |
+                                             (u0.bits | ... | us.bits));
+    R::encode(v, buf);
+    if (!bus.write(R::addr, buf, R::bytes)) {
+        shadow.valid = false;
+        return false;
+    }
+    shadow.value = v;
+    shadow.valid = true;
+    return true;
+}
+
+/**
+ * @brief Lê vários registradores; os contíguos saem numa rajada só
+ *
+ * @details read_regs<ACCEL_XOUT, ACCEL_YOUT, ACCEL_ZOUT>(bus, ax, ay, az)
+ *          faz uma leitura de 6 bytes.
+ */
+template <class... Rs, class Bus>
+bool read_regs(Bus &bus, typename Rs::value_type &... out) {
+    static_assert((detail::readable<Rs> && ...), "registrador só de escrita");
+    uint8_t buf[(Rs::bytes + ...)];
+    if (!detail::Burst<Rs...>::read(bus, buf, std::index_sequence_for<Rs...>{})) {
+        return false;
+    }
+    size_t off = 0;
+    ((out = static_cast<typename Rs::value_type>(Rs::decode(buf + off)), off += Rs::bytes), ...);
+    return true;
+}
+
+/** Escreve vários registradores; os contíguos saem numa rajada só */
+template <class... Rs, class Bus>
+bool write_regs(Bus &bus, typename Rs::value_type... v) {
+    static_assert((detail::writable<Rs> && ...), "registrador só de leitura");
+    uint8_t buf[(Rs::bytes + ...)];
+    size_t off = 0;
+    ((Rs::encode(static_cast<typename Rs::raw_type>(v), buf + off), off += Rs::bytes), ...);
+    return detail::Burst<Rs...>::write(bus, buf, std::index_sequence_for<Rs...>{});
+}
+
+/* =============================================================================
+ * SEÇÃO 4: BARRAMENTOS
+ * =============================================================================
+ */
+
+/**
+ * @brief Adapta a classe I2C dos drivers (beginTransmission/requestFrom)
+ *
+ * @details O buffer de recepção da classe I2C tem 32 bytes: rajadas
+ *          maiores que isso precisam ser divididas por quem chama.
+ */
+template <class Wire>
+struct WireBus {
+    Wire &wire;
+    uint8_t address;
+
+    bool read(uint8_t reg, uint8_t *dst, size_t n) {
+        wire.beginTransmission(address);
+        wire.write(reg);
+        if (wire.endTransmission() != 0) {
+            return false;
+        }
+        if (wire.requestFrom(address, n) != n) {
+            return false;
+        }
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = static_cast<uint8_t>(wire.read());
+        }
+        return true;
+    }
+
+    bool write(uint8_t reg, const uint8_t *src, size_t n) {
+        wire.beginTransmission(address);
+        wire.write(reg);
+        wire.write(src, n);
+        return wire.endTransmission() == 0;
+    }
+};
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+/** I2C do Pico SDK: endereço do registrador sem STOP, depois os dados */
+struct PicoI2cBus {
+    i2c_inst_t *i2c;
+    uint8_t address;
+
+    bool read(uint8_t reg, uint8_t *dst, size_t n) {
+        return i2c_write_blocking(i2c, address, &reg, 1, true) == 1 &&
+               i2c_read_blocking(i2c, address, dst, n, false) == static_cast<int>(n);
+    }
+
+    bool write(uint8_t reg, const uint8_t *src, size_t n) {
+        uint8_t buf[1 + 32];
+        if (n > sizeof buf - 1u) {
+            return false;   /* Mesmo limite do buffer da classe I2C */
+        }
+        buf[0] = reg;
+        for (size_t i = 0; i < n; i++) {
+            buf[1 + i] = src[i];
+        }
+        return i2c_write_blocking(i2c, address, buf, n + 1u, false) == static_cast<int>(n + 1u);
+    }
+};
+#endif
+
+}  // namespace regmap
+
+#endif /* REGMAP_HPP */
@@ -0,0 +1,428 @@
+/**
+ * =============================================================================
+ * @file    regmap_demo.cpp
+ * @brief   (Host) Mapas tipados vs. acesso escrito à mão: transações e tempo
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Um barramento simulado (banco de 256 registradores com
+ *          auto-incremento) grava cada transação. Cada operação dos drivers
+ *          é feita duas vezes, à mão (como nas classes MPU6050 e VL53L0X) e
+ *          com os mapas tipados, e o demo confere:
+ *
+ *          - leitura dos 14 bytes do MPU6050, configuração (PWR_MGMT_1 com
+ *            dois campos, SMPLRT_DIV, CONFIG, GYRO_CONFIG, ACCEL_CONFIG) e
+ *            leitura de distância do VL53L0X: mesmas transações, mesmos
+ *            bytes e mesmos valores;
+ *          - campos de PWR_MGMT_1 um a um custam 4 transações, o modify
+ *            com os dois custa 2;
+ *          - VCSEL_PERIOD + TIMEOUT do pré-range: o driver faz 2 leituras,
+ *            read_regs faz uma rajada de 3 bytes;
+ *          - Shadow: o segundo modify_cached não lê.
+ *
+ *          Depois mede as duas versões num barramento sem registro de
+ *          transações, para mostrar que a camada tipada não custa tempo.
+ *
+ *          Uso: regmap_demo [-q]
+ *            -q  menos repetições
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "mpu6050_regs.hpp"
+#include "vl53l0x_regs.hpp"
+#include "bench_report.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+static volatile uint32_t sink;
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+/* Codificação verificada na compilação */
+static_assert(mpu6050::GYRO_FS_SEL::set(mpu6050::GyroRange::Dps500).bits == 0x08, "");
+static_assert(mpu6050::GYRO_FS_SEL::mask == 0x18, "");
+static_assert(mpu6050::CLKSEL::mask == 0x07 && mpu6050::SLEEP::mask == 0x40, "");
+static_assert(vl53l0x::encode_vcsel_period(14) == 6 && vl53l0x::decode_vcsel_period(6) == 14, "");
+static_assert(regmap::is_field<vl53l0x::INTERRUPT_GPIO_STATUS>::value, "");
+static_assert(!regmap::is_field<vl53l0x::RESULT_RANGE_MM>::value, "");
+
+/* =============================================================================
+ * SEÇÃO 1: BARRAMENTOS SIMULADOS
+ * =============================================================================
+ */
+
+typedef struct {
+    bool write;
+    uint8_t reg;
+    uint8_t n;
+    uint8_t data[16];
+} txn_t;
+
+/** Grava cada transação com os bytes que passaram */
+struct LogBus {
+    uint8_t regs[256];
+    txn_t log[32];
+    unsigned count;
+
+    void record(bool w, uint8_t reg, const uint8_t *data, size_t n) {
+        if (count < 32u) {
+            txn_t &t = log[count];
+            memset(&t, 0, sizeof t);
+            t.write = w;
+            t.reg = reg;
+            t.n = (uint8_t)n;
+            memcpy(t.data, data, n < 16u ? n : 16u);
+        }
+        count++;
+    }
+
+    bool read(uint8_t reg, uint8_t *dst, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            dst[i] = regs[(uint8_t)(reg + i)];
+        }
+        record(false, reg, dst, n);
+        return true;
+    }
+
+    bool write(uint8_t reg, const uint8_t *src, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            regs[(uint8_t)(reg + i)] = src[i];
+        }
+        record(true, reg, src, n);
+        return true;
+    }
+};
+
+/** Só copia bytes: mede a camada, não o registro */
+struct FastBus {
+    uint8_t regs[256 + 16];
+    uint32_t txns;
+
+    bool read(uint8_t reg, uint8_t *dst, size_t n) {
+        memcpy(dst, regs + reg, n);
+        txns++;
+        return true;
+    }
+
+    bool write(uint8_t reg, const uint8_t *src, size_t n) {
+        memcpy(regs + reg, src, n);
+        txns++;
+        return true;
+    }
+};
+
+/** Banco de registradores com saídas, status e configurações não nulas */
+static void fill_regs(uint8_t *regs) {
+    for (unsigned i = 0; i < 256u; i++) {
+        regs[i] = (uint8_t)(i * 29u + 7u);
+    }
+    regs[vl53l0x::RESULT_INTERRUPT_STATUS::addr] = 0x44;   /* GPIO: nova amostra */
+}
+
+static bool same_log(const LogBus &a, const LogBus &b) {
+    return a.count == b.count && a.count <= 32u &&
+           memcmp(a.log, b.log, a.count * sizeof a.log[0]) == 0 &&
+           memcmp(a.regs, b.regs, sizeof a.regs) == 0;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: OPERAÇÕES À MÃO (como nos drivers)
+ * =============================================================================
+ */
+
+template <class Bus>
+static bool read8(Bus &bus, uint8_t reg, uint8_t *v) {
+    return bus.read(reg, v, 1);
+}
+
+template <class Bus>
+static bool write8(Bus &bus, uint8_t reg, uint8_t v) {
+    return bus.write(reg, &v, 1);
+}
+
+/** MPU6050::readRaw(): 14 bytes a partir de ACCEL_OUT */
+template <class Bus>
+static bool hand_mpu_read_raw(Bus &bus, int16_t raw[7]) {
+    uint8_t buf[14];
+    if (!bus.read(0x3B, buf, sizeof buf)) {
+        return false;
+    }
+    for (unsigned i = 0; i < 7u; i++) {
+        raw[i] = (int16_t)(buf[2u * i] << 8 | buf[2u * i + 1u]);
+    }
+    return true;
+}
+
+template <class Bus>
+static bool hand_mpu_configure(Bus &bus) {
+    uint8_t v;
+    if (!read8(bus, 0x6B, &v) || !write8(bus, 0x6B, (uint8_t)((v & ~0x47u) | 0x01u))) {
+        return false;   /* CLKSEL = PLL do giro X, SLEEP = 0 */
+    }
+    if (!write8(bus, 0x19, 7)) {
+        return false;
+    }
+    if (!read8(bus, 0x1A, &v) || !write8(bus, 0x1A, (uint8_t)((v & ~0x07u) | 3u))) {
+        return false;
+    }
+    if (!read8(bus, 0x1B, &v) || !write8(bus, 0x1B, (uint8_t)((v & ~0x18u) | 1u << 3))) {
+        return false;
+    }
+    return read8(bus, 0x1C, &v) && write8(bus, 0x1C, (uint8_t)((v & ~0x18u) | 1u << 3));
+}
+
+/** VL53L0X::readRangeContinuousMillimeters(), sem a espera */
+template <class Bus>
+static bool hand_vl53_read_range(Bus &bus, uint16_t *mm) {
+    uint8_t st, b[2];
+    if (!read8(bus, 0x13, &st) || (st & 0x07u) == 0u) {
+        return false;
+    }
+    if (!bus.read(0x14 + 10, b, 2)) {
+        return false;
+    }
+    *mm = (uint16_t)(b[0] << 8 | b[1]);
+    return write8(bus, 0x0B, 0x01);
+}
+
+/** Como getSequenceStepTimeouts(): período e timeout em duas leituras */
+template <class Bus>
+static bool hand_vl53_pre_range(Bus &bus, uint8_t *period, uint16_t *timeout) {
+    uint8_t b[2];
+    if (!read8(bus, 0x50, period) || !bus.read(0x51, b, 2)) {
+        return false;
+    }
+    *timeout = (uint16_t)(b[0] << 8 | b[1]);
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: AS MESMAS OPERAÇÕES COM OS MAPAS TIPADOS
+ * =============================================================================
+ */
+
+template <class Bus>
+static bool typed_mpu_read_raw(Bus &bus, int16_t raw[7]) {
+    using namespace mpu6050;
+    return regmap::read_regs<ACCEL_XOUT, ACCEL_YOUT, ACCEL_ZOUT, TEMP_OUT, GYRO_XOUT, GYRO_YOUT,
+                             GYRO_ZOUT>(bus, raw[0], raw[1], raw[2], raw[3], raw[4], raw[5],
+                                        raw[6]);
+}
+
+template <class Bus>
+static bool typed_mpu_configure(Bus &bus) {
+    using namespace mpu6050;
+    return regmap::modify(bus, CLKSEL::set(ClockSource::PllGyroX), SLEEP::set(false)) &&
+           regmap::write<SMPLRT_DIV>(bus, 7) &&
+           regmap::modify(bus, DLPF_CFG::set(Dlpf::Hz44)) &&
+           regmap::modify(bus, GYRO_FS_SEL::set(GyroRange::Dps500)) &&
+           regmap::modify(bus, ACCEL_AFS_SEL::set(AccelRange::G4));
+}
+
+/** Um campo por chamada: o que o modify com vários campos evita */
+template <class Bus>
+static bool typed_mpu_wake_naive(Bus &bus) {
+    using namespace mpu6050;
+    return regmap::modify(bus, CLKSEL::set(ClockSource::PllGyroX)) &&
+           regmap::modify(bus, SLEEP::set(false));
+}
+
+template <class Bus>
+static bool typed_vl53_read_range(Bus &bus, uint16_t *mm) {
+    using namespace vl53l0x;
+    uint8_t st;
+    if (!regmap::read<INTERRUPT_GPIO_STATUS>(bus, st) || st == 0u) {
+        return false;
+    }
+    return regmap::read<RESULT_RANGE_MM>(bus, *mm) &&
+           regmap::write<SYSTEM_INTERRUPT_CLEAR>(bus, 0x01);
+}
+
+template <class Bus>
+static bool typed_vl53_pre_range(Bus &bus, uint8_t *period, uint16_t *timeout) {
+    using namespace vl53l0x;
+    return regmap::read_regs<PRE_RANGE_CONFIG_VCSEL_PERIOD, PRE_RANGE_CONFIG_TIMEOUT_MACROP_HI>(
+        bus, *period, *timeout);
+}
+
+/* =============================================================================
+ * SEÇÃO 4: VERIFICAÇÃO
+ * =============================================================================
+ */
+
+static void check_equivalence(void) {
+    static LogBus hand, typed;
+
+    /* Leitura dos 14 bytes do MPU6050 */
+    fill_regs(hand.regs);
+    fill_regs(typed.regs);
+    hand.count = typed.count = 0;
+    int16_t rh[7], rt[7];
+    CHECK(hand_mpu_read_raw(hand, rh) && typed_mpu_read_raw(typed, rt), "mpu: leitura falhou");
+    CHECK(memcmp(rh, rt, sizeof rh) == 0, "mpu: valores diferentes");
+    CHECK(same_log(hand, typed), "mpu: transações diferentes");
+    CHECK(typed.count == 1u, "mpu: %u transações na leitura, esperado 1", typed.count);
+    bench_report("regmap_demo", "mpu_read_raw_transactions", typed.count, "txn");
+
+    /* Configuração */
+    hand.count = typed.count = 0;
+    CHECK(hand_mpu_configure(hand) && typed_mpu_configure(typed), "mpu: configuração falhou");
+    CHECK(same_log(hand, typed), "mpu: configuração com transações diferentes");
+    CHECK(typed.count == 9u, "mpu: %u transações na configuração, esperado 9", typed.count);
+    printf("MPU6050 leitura: 1 rajada de 14 bytes; configuração: %u transações (igual à mão)\n",
+           typed.count);
+    bench_report("regmap_demo", "mpu_config_transactions", typed.count, "txn");
+
+    /* PWR_MGMT_1: dois campos num read-modify-write */
+    fill_regs(typed.regs);
+    typed.count = 0;
+    CHECK(typed_mpu_wake_naive(typed), "mpu: wake falhou");
+    const unsigned naive = typed.count;
+    const uint8_t naive_val = typed.regs[mpu6050::PWR_MGMT_1::addr];
+    fill_regs(typed.regs);
+    typed.count = 0;
+    CHECK(regmap::modify(typed, mpu6050::CLKSEL::set(mpu6050::ClockSource::PllGyroX),
+                         mpu6050::SLEEP::set(false)),
+          "mpu: modify falhou");
+    CHECK(typed.count == 2u && naive == 4u, "mpu: campos juntos %u, um a um %u transações",
+          typed.count, naive);
+    CHECK(typed.regs[mpu6050::PWR_MGMT_1::addr] == naive_val, "mpu: PWR_MGMT_1 diferente");
+    printf("PWR_MGMT_1 (CLKSEL + SLEEP): %u transações juntos, %u um a um\n", typed.count, naive);
+
+    /* Distância do VL53L0X */
+    fill_regs(hand.regs);
+    fill_regs(typed.regs);
+    hand.count = typed.count = 0;
+    uint16_t mh = 0, mt = 1;
+    CHECK(hand_vl53_read_range(hand, &mh) && typed_vl53_read_range(typed, &mt),
+          "vl53: leitura falhou");
+    CHECK(mh == mt, "vl53: %u mm à mão, %u tipado", mh, mt);
+    CHECK(same_log(hand, typed), "vl53: transações diferentes");
+
+    /* Período + timeout do pré-range: uma rajada em vez de duas leituras */
+    hand.count = typed.count = 0;
+    uint8_t ph = 0, pt = 1;
+    uint16_t th = 0, tt = 1;
+    CHECK(hand_vl53_pre_range(hand, &ph, &th) && typed_vl53_pre_range(typed, &pt, &tt),
+          "vl53: pré-range falhou");
+    CHECK(ph == pt && th == tt, "vl53: pré-range com valores diferentes");
+    CHECK(hand.count == 2u && typed.count == 1u && typed.log[0].n == 3u,
+          "vl53: pré-range com %u/%u transações, esperado 2/1", hand.count, typed.count);
+    printf("VL53L0X pré-range: %u leituras à mão, %u rajada de %u bytes tipado\n", hand.count,
+           typed.count, typed.log[0].n);
+    bench_report("regmap_demo", "vl53_pre_range_transactions", typed.count, "txn");
+
+    /* Mapa de SPADs: seis registradores contíguos numa escrita */
+    typed.count = 0;
+    {
+        using namespace vl53l0x;
+        CHECK((regmap::write_regs<GLOBAL_CONFIG_SPAD_ENABLES_REF_0, GLOBAL_CONFIG_SPAD_ENABLES_REF_1,
+                                  GLOBAL_CONFIG_SPAD_ENABLES_REF_2, GLOBAL_CONFIG_SPAD_ENABLES_REF_3,
+                                  GLOBAL_CONFIG_SPAD_ENABLES_REF_4, GLOBAL_CONFIG_SPAD_ENABLES_REF_5>(
+                  typed, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06)),
+              "vl53: SPADs falharam");
+    }
+    CHECK(typed.count == 1u && typed.log[0].n == 6u &&
+              memcmp(typed.log[0].data, "\x01\x02\x03\x04\x05\x06", 6) == 0,
+          "vl53: SPADs em %u transações", typed.count);
+
+    /* Cópia em RAM: só o primeiro modify_cached lê */
+    typed.count = 0;
+    regmap::Shadow<mpu6050::GYRO_CONFIG> gyro = { 0, false };
+    CHECK(regmap::modify_cached(typed, gyro, mpu6050::GYRO_FS_SEL::set(mpu6050::GyroRange::Dps250)) &&
+              regmap::modify_cached(typed, gyro,
+                                    mpu6050::GYRO_FS_SEL::set(mpu6050::GyroRange::Dps2000)),
+          "shadow: modify falhou");
+    uint8_t fs = 0xFF;
+    CHECK(regmap::read<mpu6050::GYRO_CONFIG>(typed, fs) && fs == gyro.value &&
+              mpu6050::GYRO_FS_SEL::get(fs) == mpu6050::GyroRange::Dps2000,
+          "shadow: GYRO_CONFIG fora de sincronia");
+    CHECK(typed.count == 4u, "shadow: %u transações, esperado 4 (1 leitura, 2 escritas, 1 conferência)",
+          typed.count);
+}
+
+/* =============================================================================
+ * SEÇÃO 5: TEMPO
+ * =============================================================================
+ */
+
+static FastBus fast;
+
+/* Cada versão vira uma função de verdade: sem isso o compilador levaria a
+   leitura para fora do laço de medida e compararia laços, não acessos */
+__attribute__((noinline)) static bool hand_raw_fn(int16_t *raw) {
+    return hand_mpu_read_raw(fast, raw);
+}
+__attribute__((noinline)) static bool typed_raw_fn(int16_t *raw) {
+    return typed_mpu_read_raw(fast, raw);
+}
+__attribute__((noinline)) static bool hand_range_fn(uint16_t *mm) {
+    return hand_vl53_read_range(fast, mm);
+}
+__attribute__((noinline)) static bool typed_range_fn(uint16_t *mm) {
+    return typed_vl53_read_range(fast, mm);
+}
+
+static void run(bool (*raw_fn)(int16_t *), bool (*range_fn)(uint16_t *), unsigned reps) {
+    int16_t raw[7];
+    uint16_t mm = 0;
+    for (unsigned i = 0; i < reps; i++) {
+        raw_fn(raw);
+        range_fn(&mm);
+        sink += (uint32_t)raw[i % 7u] + mm;
+    }
+}
+
+/** Melhor de 5 rodadas, alternando as versões */
+static void time_both(unsigned reps, double *hand_ns, double *typed_ns) {
+    *hand_ns = *typed_ns = 1e30;
+    for (unsigned round = 0; round < 5u; round++) {
+        uint64_t t0 = now_ns();
+        run(hand_raw_fn, hand_range_fn, reps);
+        const double h = (double)(now_ns() - t0) / reps;
+        t0 = now_ns();
+        run(typed_raw_fn, typed_range_fn, reps);
+        const double t = (double)(now_ns() - t0) / reps;
+        *hand_ns = h < *hand_ns ? h : *hand_ns;
+        *typed_ns = t < *typed_ns ? t : *typed_ns;
+    }
+}
+
+int main(int argc, char **argv) {
+    bool quick = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            quick = true;
+        } else {
+            fprintf(stderr, "uso: %s [-q]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    check_equivalence();
+
+    fill_regs(fast.regs);
+    double hand_ns, typed_ns;
+    time_both(quick ? 200000u : 2000000u, &hand_ns, &typed_ns);
+    const uint32_t txns = fast.txns;
+    CHECK(txns > 0u, "barramento rápido sem transações");
+    const double ratio = typed_ns / hand_ns;
+    printf("leitura MPU6050 + distância VL53L0X: %.2f ns à mão, %.2f ns tipado (razão %.3f)\n",
+           hand_ns, typed_ns, ratio);
+    bench_report("regmap_demo", "typed_vs_hand_time_ratio", ratio, "x");
+
+    return test_check_summary();
+}
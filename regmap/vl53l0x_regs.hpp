@@ -0,0 +1,202 @@
+/**
+ * =============================================================================
+ * @file    vl53l0x_regs.hpp
+ * @brief   Mapa tipado dos registradores do VL53L0X
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os nomes e endereços do enum regAddr da classe VL53L0X, com a
+ *          largura com que o driver acessa cada um (readReg, readReg16Bit,
+ *          readReg32Bit). Os registradores de vários bytes do VL53L0X são
+ *          big-endian.
+ *
+ *          Onde o driver usa o par _HI/_LO como um valor de 16 bits (os
+ *          timeouts, os limites de sigma), o registrador _HI é declarado
+ *          com uint16_t. RESULT_RANGE_MM é o RESULT_RANGE_STATUS + 10 que
+ *          readRangeContinuousMillimeters() lê.
+ *
+ *          Registradores contíguos lidos juntos (VCSEL_PERIOD + TIMEOUT do
+ *          pré-range, as seis GLOBAL_CONFIG_SPAD_ENABLES_REF) saem numa
+ *          rajada com read_regs/write_regs.
+ * =============================================================================
+ */
+
+#ifndef VL53L0X_REGS_HPP
+#define VL53L0X_REGS_HPP
+
+#include "regmap.hpp"
+
+namespace vl53l0x {
+
+using regmap::Access;
+using regmap::Endian;
+using regmap::Field;
+using regmap::Reg;
+using regmap::Status;
+
+static constexpr uint8_t I2C_ADDR = 0x29;
+static constexpr uint8_t MODEL_ID = 0xEE;   /**< Valor de IDENTIFICATION_MODEL_ID */
+
+/** Período do VCSEL gravado como (pclks / 2) - 1 */
+constexpr uint8_t encode_vcsel_period(uint8_t pclks) {
+    return static_cast<uint8_t>((pclks >> 1) - 1u);
+}
+constexpr uint8_t decode_vcsel_period(uint8_t reg) {
+    return static_cast<uint8_t>((reg + 1u) << 1);
+}
+
+/* =============================================================================
+ * SEÇÃO 1: CONTROLE E INTERRUPÇÃO
+ * =============================================================================
+ */
+
+/** bit 0 se limpa ao fim de uma medida única */
+using SYSRANGE_START = Reg<0x00, uint8_t, Endian::Big, Access::RW, true>;
+
+using SYSTEM_THRESH_HIGH = Reg<0x0C, uint16_t>;
+using SYSTEM_THRESH_LOW = Reg<0x0E, uint16_t>;
+
+using SYSTEM_SEQUENCE_CONFIG = Reg<0x01>;
+using SYSTEM_RANGE_CONFIG = Reg<0x09>;
+using SYSTEM_INTERMEASUREMENT_PERIOD = Reg<0x04, uint32_t>;
+
+using SYSTEM_INTERRUPT_CONFIG_GPIO = Reg<0x0A>;
+using GPIO_HV_MUX_ACTIVE_HIGH = Reg<0x84>;
+using SYSTEM_INTERRUPT_CLEAR = Reg<0x0B, uint8_t, Endian::Big, Access::RW, true>;
+
+/* =============================================================================
+ * SEÇÃO 2: RESULTADOS
+ * =============================================================================
+ */
+
+using RESULT_INTERRUPT_STATUS = Status<0x13>;
+using RESULT_RANGE_STATUS = Status<0x14>;
+using RESULT_RANGE_MM = Status<0x14 + 10, uint16_t>;
+
+using RESULT_CORE_AMBIENT_WINDOW_EVENTS_RTN = Status<0xBC, uint32_t>;
+using RESULT_CORE_RANGING_TOTAL_EVENTS_RTN = Status<0xC0, uint32_t>;
+using RESULT_CORE_AMBIENT_WINDOW_EVENTS_REF = Status<0xD0, uint32_t>;
+using RESULT_CORE_RANGING_TOTAL_EVENTS_REF = Status<0xD4, uint32_t>;
+using RESULT_PEAK_SIGNAL_RATE_REF = Status<0xB6, uint16_t>;
+
+/* =============================================================================
+ * SEÇÃO 3: CONFIGURAÇÃO DE MEDIDA
+ * =============================================================================
+ */
+
+using ALGO_PART_TO_PART_RANGE_OFFSET_MM = Reg<0x28, int16_t>;
+
+using I2C_SLAVE_DEVICE_ADDRESS = Reg<0x8A>;
+
+using MSRC_CONFIG_CONTROL = Reg<0x60>;
+
+using PRE_RANGE_CONFIG_MIN_SNR = Reg<0x27>;
+using PRE_RANGE_CONFIG_VALID_PHASE_LOW = Reg<0x56>;
+using PRE_RANGE_CONFIG_VALID_PHASE_HIGH = Reg<0x57>;
+using PRE_RANGE_MIN_COUNT_RATE_RTN_LIMIT = Reg<0x64, uint16_t>;
+
+using FINAL_RANGE_CONFIG_MIN_SNR = Reg<0x67>;
+using FINAL_RANGE_CONFIG_VALID_PHASE_LOW = Reg<0x47>;
+using FINAL_RANGE_CONFIG_VALID_PHASE_HIGH = Reg<0x48>;
+/** Limite de taxa de sinal, MCPS em ponto fixo Q9.7 */
+using FINAL_RANGE_CONFIG_MIN_COUNT_RATE_RTN_LIMIT = Reg<0x44, uint16_t>;
+
+using PRE_RANGE_CONFIG_SIGMA_THRESH_HI = Reg<0x61, uint16_t>;   /**< HI:LO */
+using PRE_RANGE_CONFIG_SIGMA_THRESH_LO = Reg<0x62>;
+
+using PRE_RANGE_CONFIG_VCSEL_PERIOD = Reg<0x50>;
+using PRE_RANGE_CONFIG_TIMEOUT_MACROP_HI = Reg<0x51, uint16_t>; /**< HI:LO */
+using PRE_RANGE_CONFIG_TIMEOUT_MACROP_LO = Reg<0x52>;
+
+using SYSTEM_HISTOGRAM_BIN = Reg<0x81>;
+using HISTOGRAM_CONFIG_INITIAL_PHASE_SELECT = Reg<0x33>;
+using HISTOGRAM_CONFIG_READOUT_CTRL = Reg<0x55>;
+
+using FINAL_RANGE_CONFIG_VCSEL_PERIOD = Reg<0x70>;
+using FINAL_RANGE_CONFIG_TIMEOUT_MACROP_HI = Reg<0x71, uint16_t>;   /**< HI:LO */
+using FINAL_RANGE_CONFIG_TIMEOUT_MACROP_LO = Reg<0x72>;
+using CROSSTALK_COMPENSATION_PEAK_RATE_MCPS = Reg<0x20, uint16_t>;
+
+using MSRC_CONFIG_TIMEOUT_MACROP = Reg<0x46>;
+
+using SOFT_RESET_GO2_SOFT_RESET_N = Reg<0xBF>;
+using IDENTIFICATION_MODEL_ID = Reg<0xC0, uint8_t, Endian::Big, Access::RO>;
+using IDENTIFICATION_REVISION_ID = Reg<0xC2, uint8_t, Endian::Big, Access::RO>;
+
+using OSC_CALIBRATE_VAL = Reg<0xF8, uint16_t>;
+
+using GLOBAL_CONFIG_VCSEL_WIDTH = Reg<0x32>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_0 = Reg<0xB0>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_1 = Reg<0xB1>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_2 = Reg<0xB2>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_3 = Reg<0xB3>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_4 = Reg<0xB4>;
+using GLOBAL_CONFIG_SPAD_ENABLES_REF_5 = Reg<0xB5>;
+
+using GLOBAL_CONFIG_REF_EN_START_SELECT = Reg<0xB6>;
+using DYNAMIC_SPAD_NUM_REQUESTED_REF_SPAD = Reg<0x4E>;
+using DYNAMIC_SPAD_REF_EN_START_OFFSET = Reg<0x4F>;
+using POWER_MANAGEMENT_GO1_POWER_FORCE = Reg<0x80>;
+
+using VHV_CONFIG_PAD_SCL_SDA__EXTSUP_HV = Reg<0x89>;
+
+using ALGO_PHASECAL_LIM = Reg<0x30>;
+using ALGO_PHASECAL_CONFIG_TIMEOUT = Reg<0x30>;
+
+/* =============================================================================
+ * SEÇÃO 4: CAMPOS
+ * =============================================================================
+ */
+
+enum class GpioMode : uint8_t {
+    Disabled = 0,
+    LevelLow = 1,
+    LevelHigh = 2,
+    OutOfWindow = 3,
+    NewSampleReady = 4,
+};
+
+using SYSRANGE_MODE_START_STOP = Field<SYSRANGE_START, 0, 1, bool>;
+using SYSRANGE_MODE_BACKTOBACK = Field<SYSRANGE_START, 1, 1, bool>;
+
+using SEQUENCE_MSRC = Field<SYSTEM_SEQUENCE_CONFIG, 2, 1, bool>;
+using SEQUENCE_DSS = Field<SYSTEM_SEQUENCE_CONFIG, 3, 1, bool>;
+using SEQUENCE_TCC = Field<SYSTEM_SEQUENCE_CONFIG, 4, 1, bool>;
+using SEQUENCE_PRE_RANGE = Field<SYSTEM_SEQUENCE_CONFIG, 6, 1, bool>;
+using SEQUENCE_FINAL_RANGE = Field<SYSTEM_SEQUENCE_CONFIG, 7, 1, bool>;
+
+using GPIO_MODE = Field<SYSTEM_INTERRUPT_CONFIG_GPIO, 0, 3, GpioMode>;
+/** 0: interrupção ativa em nível baixo (o driver limpa este bit) */
+using GPIO_ACTIVE_HIGH = Field<GPIO_HV_MUX_ACTIVE_HIGH, 4, 1, bool>;
+
+using INTERRUPT_GPIO_STATUS = Field<RESULT_INTERRUPT_STATUS, 0, 3>;   /**< != 0: pronta */
+using RANGE_STATUS_CODE = Field<RESULT_RANGE_STATUS, 3, 4>;
+
+/** Desligam os limites SIGNAL_RATE_MSRC e SIGNAL_RATE_PRE_RANGE (0x12) */
+using MSRC_DISABLE_SIGNAL_RATE_MSRC = Field<MSRC_CONFIG_CONTROL, 1, 1, bool>;
+using MSRC_DISABLE_SIGNAL_RATE_PRE_RANGE = Field<MSRC_CONFIG_CONTROL, 4, 1, bool>;
+
+using I2C_ADDRESS_7BIT = Field<I2C_SLAVE_DEVICE_ADDRESS, 0, 7>;
+
+/** 1: I/O em 2V8 */
+using VHV_IO_2V8 = Field<VHV_CONFIG_PAD_SCL_SDA__EXTSUP_HV, 0, 1, bool>;
+
+static_assert(regmap::transactions<PRE_RANGE_CONFIG_VCSEL_PERIOD,
+                                   PRE_RANGE_CONFIG_TIMEOUT_MACROP_HI> == 1,
+              "período e timeout do pré-range devem sair numa rajada");
+static_assert(regmap::transactions<GLOBAL_CONFIG_SPAD_ENABLES_REF_0,
+                                   GLOBAL_CONFIG_SPAD_ENABLES_REF_1,
+                                   GLOBAL_CONFIG_SPAD_ENABLES_REF_2,
+                                   GLOBAL_CONFIG_SPAD_ENABLES_REF_3,
+                                   GLOBAL_CONFIG_SPAD_ENABLES_REF_4,
+                                   GLOBAL_CONFIG_SPAD_ENABLES_REF_5> == 1,
+              "mapa de SPADs deve sair numa rajada");
+
+}  // namespace vl53l0x
+
+#endif /* VL53L0X_REGS_HPP */
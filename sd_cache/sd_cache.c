@@ -0,0 +1,448 @@
+/**
+ * =============================================================================
+ * @file    sd_cache.c
+ * @brief   Implementação do cache de setores (LRU, write-back, read-ahead)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Invariante de coerência: uma linha válida e limpa é idêntica ao
+ *          setor no dispositivo; uma linha suja é a versão mais nova. Por
+ *          isso o bypass de leitura só precisa sobrepor as linhas sujas, e o
+ *          bypass de escrita atualiza as linhas presentes e as marca limpas.
+ * =============================================================================
+ */
+
+#include "sd_cache.h"
+
+#include <stddef.h>   /* Para size_t */
+#include <string.h>   /* Para memcpy, memset */
+
+/* =============================================================================
+ * SEÇÃO 1: FUNÇÕES AUXILIARES
+ * =============================================================================
+ */
+
+#define LINE_VALID      0x01u
+#define LINE_DIRTY      0x02u
+#define LINE_PREFETCHED 0x04u  /* Trazida por read-ahead e ainda não lida */
+
+#define SECTOR BLOCKDEV_SECTOR_SIZE
+
+static inline uint8_t *line_data(const sd_cache_t *c, uint32_t idx) {
+    return c->data + (size_t)idx * SECTOR;
+}
+
+static inline uint32_t set_base(const sd_cache_t *c, uint32_t lba) {
+    return (lba & (uint32_t)(c->n_sets - 1u)) * c->n_ways;
+}
+
+static inline void touch(sd_cache_t *c, sd_cache_line_t *l) {
+    l->stamp = ++c->tick;
+}
+
+/** Índice da linha que contém `lba`, ou -1 */
+static int32_t find_line(const sd_cache_t *c, uint32_t lba) {
+    const uint32_t base = set_base(c, lba);
+    for (uint32_t w = 0; w < c->n_ways; w++) {
+        const sd_cache_line_t *l = &c->lines[base + w];
+        if ((l->flags & LINE_VALID) && l->lba == lba) {
+            return (int32_t)(base + w);
+        }
+    }
+    return -1;
+}
+
+static bool is_pinned(const sd_cache_t *c, uint32_t lba) {
+    for (uint8_t i = 0; i < c->n_pins; i++) {
+        if (lba - c->pin_lba[i] < c->pin_count[i]) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Escolhe a linha a substituir no conjunto de `lba`
+ *
+ * @details Ordem de preferência: linha inválida; LRU entre as não fixadas;
+ *          LRU entre as fixadas, só numa falta de verdade (demand). O
+ *          read-ahead especulativo (demand falso) nunca escolhe linhas sujas
+ *          nem fixadas: não deve forçar gravações nem tirar a FAT do cache
+ *          por um setor que talvez nem seja lido.
+ *
+ * @return Índice da linha, ou -1 se nenhuma servir
+ */
+static int32_t pick_victim(const sd_cache_t *c, uint32_t lba, bool demand) {
+    const uint32_t base = set_base(c, lba);
+    int32_t best = -1;
+    int32_t best_pinned = -1;
+
+    for (uint32_t w = 0; w < c->n_ways; w++) {
+        const sd_cache_line_t *l = &c->lines[base + w];
+        if (!(l->flags & LINE_VALID)) {
+            return (int32_t)(base + w);
+        }
+        if (!demand && (l->flags & LINE_DIRTY)) {
+            continue;
+        }
+        int32_t *slot = is_pinned(c, l->lba) ? &best_pinned : &best;
+        if (*slot < 0 || l->stamp < c->lines[*slot].stamp) {
+            *slot = (int32_t)(base + w);
+        }
+    }
+    return (best >= 0 || !demand) ? best : best_pinned;
+}
+
+static blockdev_result_t write_back(sd_cache_t *c, uint32_t idx) {
+    sd_cache_line_t *l = &c->lines[idx];
+    const blockdev_result_t r = blockdev_write(&c->lower, line_data(c, idx), l->lba, 1);
+    if (r == BLOCKDEV_OK) {
+        l->flags &= (uint8_t)~LINE_DIRTY;
+        c->stats.writebacks++;
+    }
+    return r;
+}
+
+/** Aloca uma linha para `lba` (gravando a vítima se estiver suja) */
+static blockdev_result_t alloc_line(sd_cache_t *c, uint32_t lba, uint32_t *out) {
+    const int32_t v = pick_victim(c, lba, true);
+    sd_cache_line_t *l = &c->lines[v];
+    if (l->flags & LINE_VALID) {
+        if (l->flags & LINE_DIRTY) {
+            const blockdev_result_t r = write_back(c, (uint32_t)v);
+            if (r != BLOCKDEV_OK) {
+                return r;
+            }
+        }
+        c->stats.evictions++;
+    }
+    l->lba = lba;
+    l->flags = LINE_VALID;
+    touch(c, l);
+    *out = (uint32_t)v;
+    return BLOCKDEV_OK;
+}
+
+/** Traz até c->readahead setores a partir de `lba` sem despejar sujas nem fixadas */
+static void read_ahead(sd_cache_t *c, uint32_t lba) {
+    uint32_t sectors = 0;
+    if (blockdev_ioctl(&c->lower, BLOCKDEV_GET_SECTOR_COUNT, &sectors) != BLOCKDEV_OK) {
+        sectors = 0;  /* Desconhecido: confia no erro de leitura para parar */
+    }
+    for (uint32_t k = 0; k < c->readahead; k++) {
+        const uint32_t s = lba + k;
+        if (sectors && s >= sectors) {
+            break;
+        }
+        if (find_line(c, s) >= 0) {
+            continue;
+        }
+        const int32_t v = pick_victim(c, s, false);
+        if (v < 0) {
+            continue;
+        }
+        sd_cache_line_t *l = &c->lines[v];
+        if (l->flags & LINE_VALID) {
+            c->stats.evictions++;
+        }
+        l->flags = 0;
+        if (blockdev_read(&c->lower, line_data(c, (uint32_t)v), s, 1) != BLOCKDEV_OK) {
+            break;
+        }
+        l->lba = s;
+        l->flags = LINE_VALID | LINE_PREFETCHED;
+        touch(c, l);
+        c->stats.readahead++;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+bool sd_cache_init(sd_cache_t *c, const blockdev_t *lower, sd_cache_line_t *lines,
+                   uint8_t *data, uint16_t n_sets, uint8_t n_ways) {
+    if (!c || !lower || !lines || !data || n_sets == 0 || (n_sets & (n_sets - 1u)) ||
+        n_ways == 0) {
+        return false;
+    }
+    memset(c, 0, sizeof *c);
+    c->lower = *lower;
+    c->lines = lines;
+    c->data = data;
+    c->n_sets = n_sets;
+    c->n_ways = n_ways;
+    c->readahead = SD_CACHE_DEFAULT_READAHEAD;
+    c->bypass = SD_CACHE_DEFAULT_BYPASS;
+    c->last_read_end = UINT32_MAX;
+    memset(lines, 0, (size_t)n_sets * n_ways * sizeof *lines);
+    return true;
+}
+
+void sd_cache_set_readahead(sd_cache_t *c, uint8_t sectors) {
+    c->readahead = sectors;
+}
+
+void sd_cache_set_bypass(sd_cache_t *c, uint16_t sectors) {
+    c->bypass = sectors;
+}
+
+bool sd_cache_pin(sd_cache_t *c, uint32_t lba, uint32_t count) {
+    if (c->n_pins >= SD_CACHE_MAX_PINS || count == 0) {
+        return false;
+    }
+    c->pin_lba[c->n_pins] = lba;
+    c->pin_count[c->n_pins] = count;
+    c->n_pins++;
+    return true;
+}
+
+bool sd_cache_pin_fat(sd_cache_t *c, const uint8_t *vbr, uint32_t vbr_lba) {
+    if (vbr[510] != 0x55u || vbr[511] != 0xAAu) {
+        return false;
+    }
+    const uint32_t bytes_per_sec = (uint32_t)vbr[11] | (uint32_t)vbr[12] << 8;
+    const uint32_t reserved = (uint32_t)vbr[14] | (uint32_t)vbr[15] << 8;
+    const uint32_t n_fats = vbr[16];
+    const uint32_t fat_sz16 = (uint32_t)vbr[22] | (uint32_t)vbr[23] << 8;
+    const uint32_t fat_sz32 = (uint32_t)vbr[36] | (uint32_t)vbr[37] << 8 |
+                              (uint32_t)vbr[38] << 16 | (uint32_t)vbr[39] << 24;
+    const uint32_t fat_sz = fat_sz16 ? fat_sz16 : fat_sz32;
+
+    if (bytes_per_sec != SECTOR || reserved == 0 || n_fats == 0 || n_fats > 2 || fat_sz == 0) {
+        return false;
+    }
+    return sd_cache_pin(c, vbr_lba + reserved, fat_sz * n_fats);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: LEITURA E ESCRITA
+ * =============================================================================
+ */
+
+blockdev_result_t sd_cache_read(sd_cache_t *c, uint8_t *buf, uint32_t lba, uint32_t count) {
+    if (!buf || count == 0) {
+        return BLOCKDEV_PARERR;
+    }
+
+    if (c->bypass && count >= c->bypass) {
+        const blockdev_result_t r = blockdev_read(&c->lower, buf, lba, count);
+        if (r != BLOCKDEV_OK) {
+            return r;
+        }
+        /* As linhas sujas são mais novas que o dispositivo */
+        for (uint32_t i = 0; i < count; i++) {
+            const int32_t idx = find_line(c, lba + i);
+            if (idx >= 0 && (c->lines[idx].flags & LINE_DIRTY)) {
+                memcpy(buf + (size_t)i * SECTOR, line_data(c, (uint32_t)idx), SECTOR);
+            }
+        }
+        c->stats.bypass_sectors += count;
+        c->last_read_end = lba + count;
+        return BLOCKDEV_OK;
+    }
+
+    const bool sequential = (lba == c->last_read_end);
+    bool trigger = false;
+    uint32_t i = 0;
+
+    while (i < count) {
+        const int32_t idx = find_line(c, lba + i);
+        if (idx >= 0) {
+            sd_cache_line_t *l = &c->lines[idx];
+            memcpy(buf + (size_t)i * SECTOR, line_data(c, (uint32_t)idx), SECTOR);
+            if (l->flags & LINE_PREFETCHED) {
+                l->flags &= (uint8_t)~LINE_PREFETCHED;
+                c->stats.readahead_hits++;
+                trigger = true;  /* O fluxo sequencial alcançou o read-ahead */
+            }
+            touch(c, l);
+            c->stats.read_hits++;
+            i++;
+            continue;
+        }
+
+        /* Falta: lê de uma vez o trecho contíguo ausente, direto no buffer */
+        uint32_t j = i + 1;
+        while (j < count && find_line(c, lba + j) < 0) {
+            j++;
+        }
+        blockdev_result_t r = blockdev_read(&c->lower, buf + (size_t)i * SECTOR, lba + i, j - i);
+        if (r != BLOCKDEV_OK) {
+            return r;
+        }
+        for (uint32_t k = i; k < j; k++) {
+            uint32_t line;
+            r = alloc_line(c, lba + k, &line);
+            if (r != BLOCKDEV_OK) {
+                return r;
+            }
+            memcpy(line_data(c, line), buf + (size_t)k * SECTOR, SECTOR);
+        }
+        c->stats.read_misses += j - i;
+        trigger = true;
+        i = j;
+    }
+
+    c->last_read_end = lba + count;
+    if (c->readahead && sequential && trigger) {
+        read_ahead(c, lba + count);
+    }
+    return BLOCKDEV_OK;
+}
+
+blockdev_result_t sd_cache_write(sd_cache_t *c, const uint8_t *buf, uint32_t lba,
+                                 uint32_t count) {
+    if (!buf || count == 0) {
+        return BLOCKDEV_PARERR;
+    }
+
+    if (c->bypass && count >= c->bypass) {
+        const blockdev_result_t r = blockdev_write(&c->lower, buf, lba, count);
+        if (r != BLOCKDEV_OK) {
+            return r;
+        }
+        /* Linhas presentes passam a refletir o que acabou de ser gravado */
+        for (uint32_t i = 0; i < count; i++) {
+            const int32_t idx = find_line(c, lba + i);
+            if (idx >= 0) {
+                memcpy(line_data(c, (uint32_t)idx), buf + (size_t)i * SECTOR, SECTOR);
+                c->lines[idx].flags = LINE_VALID;
+            }
+        }
+        c->stats.bypass_sectors += count;
+        return BLOCKDEV_OK;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        int32_t idx = find_line(c, lba + i);
+        if (idx >= 0) {
+            c->stats.write_hits++;
+            touch(c, &c->lines[idx]);
+        } else {
+            uint32_t line;
+            const blockdev_result_t r = alloc_line(c, lba + i, &line);
+            if (r != BLOCKDEV_OK) {
+                return r;
+            }
+            idx = (int32_t)line;
+            c->stats.write_misses++;
+        }
+        memcpy(line_data(c, (uint32_t)idx), buf + (size_t)i * SECTOR, SECTOR);
+        c->lines[idx].flags = LINE_VALID | LINE_DIRTY;
+    }
+    return BLOCKDEV_OK;
+}
+
+blockdev_result_t sd_cache_flush(sd_cache_t *c) {
+    const uint32_t n_lines = (uint32_t)c->n_sets * c->n_ways;
+    uint32_t from = 0;
+
+    /* Seleciona a linha suja de menor LBA >= from: gravações em ordem
+     * crescente, que o driver abaixo pode coalescer num único fluxo */
+    for (;;) {
+        int32_t next = -1;
+        for (uint32_t i = 0; i < n_lines; i++) {
+            const sd_cache_line_t *l = &c->lines[i];
+            if ((l->flags & LINE_DIRTY) && l->lba >= from &&
+                (next < 0 || l->lba < c->lines[next].lba)) {
+                next = (int32_t)i;
+            }
+        }
+        if (next < 0) {
+            return BLOCKDEV_OK;
+        }
+        const blockdev_result_t r = write_back(c, (uint32_t)next);
+        if (r != BLOCKDEV_OK) {
+            return r;
+        }
+        if (c->lines[next].lba == UINT32_MAX) {
+            return BLOCKDEV_OK;
+        }
+        from = c->lines[next].lba + 1u;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: IOCTL E ADAPTADOR
+ * =============================================================================
+ */
+
+blockdev_result_t sd_cache_ioctl(sd_cache_t *c, uint8_t cmd, void *buff) {
+    const uint32_t n_lines = (uint32_t)c->n_sets * c->n_ways;
+    blockdev_result_t r;
+
+    switch (cmd) {
+    case BLOCKDEV_CTRL_SYNC:
+        r = sd_cache_flush(c);
+        return (r == BLOCKDEV_OK) ? blockdev_sync(&c->lower) : r;
+
+    case BLOCKDEV_CTRL_TRIM: {
+        /* Setores descartados: linhas somem sem gravação */
+        const uint32_t *range = (const uint32_t *)buff;
+        for (uint32_t i = 0; i < n_lines; i++) {
+            sd_cache_line_t *l = &c->lines[i];
+            if ((l->flags & LINE_VALID) && l->lba >= range[0] && l->lba <= range[1]) {
+                l->flags = 0;
+            }
+        }
+        return blockdev_ioctl(&c->lower, cmd, buff);
+    }
+
+    case SD_CACHE_IOCTL_GET_STATS:
+        *(sd_cache_stats_t *)buff = c->stats;
+        return BLOCKDEV_OK;
+
+    case SD_CACHE_IOCTL_RESET_STATS:
+        memset(&c->stats, 0, sizeof c->stats);
+        return BLOCKDEV_OK;
+
+    case SD_CACHE_IOCTL_PIN: {
+        const uint32_t *range = (const uint32_t *)buff;
+        return sd_cache_pin(c, range[0], range[1]) ? BLOCKDEV_OK : BLOCKDEV_PARERR;
+    }
+
+    case SD_CACHE_IOCTL_UNPIN_ALL:
+        c->n_pins = 0;
+        return BLOCKDEV_OK;
+
+    case SD_CACHE_IOCTL_INVALIDATE:
+        r = sd_cache_flush(c);
+        if (r != BLOCKDEV_OK) {
+            return r;
+        }
+        for (uint32_t i = 0; i < n_lines; i++) {
+            c->lines[i].flags = 0;
+        }
+        c->last_read_end = UINT32_MAX;
+        return BLOCKDEV_OK;
+
+    default:
+        return blockdev_ioctl(&c->lower, cmd, buff);
+    }
+}
+
+static blockdev_result_t bd_read(void *ctx, uint8_t *buf, uint32_t lba, uint32_t count) {
+    return sd_cache_read((sd_cache_t *)ctx, buf, lba, count);
+}
+
+static blockdev_result_t bd_write(void *ctx, const uint8_t *buf, uint32_t lba, uint32_t count) {
+    return sd_cache_write((sd_cache_t *)ctx, buf, lba, count);
+}
+
+static blockdev_result_t bd_ioctl(void *ctx, uint8_t cmd, void *buff) {
+    return sd_cache_ioctl((sd_cache_t *)ctx, cmd, buff);
+}
+
+void sd_cache_blockdev(sd_cache_t *c, blockdev_t *dev) {
+    dev->ctx = c;
+    dev->read = bd_read;
+    dev->write = bd_write;
+    dev->ioctl = bd_ioctl;
+}
@@ -0,0 +1,206 @@
+/**
+ * =============================================================================
+ * @file    sd_cache.h
+ * @brief   Cache de setores N-way LRU com write-back e read-ahead
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Fica entre o FatFS (diskio.c) e o cartão, ambos vistos como
+ *          blockdev_t. Em gravações de log com append, os setores da FAT e
+ *          do diretório são lidos e regravados a cada f_write/f_sync; o cache
+ *          absorve essas repetições e só grava no cartão no CTRL_SYNC ou
+ *          quando a linha é despejada.
+ *
+ *          ORGANIZAÇÃO (associativa por conjunto):
+ *          ┌──────────────┬──────────────────────────────────────────────┐
+ *          │ Conjunto     │ lba % n_sets (n_sets potência de 2)          │
+ *          │ Vias         │ n_ways linhas de 512 bytes por conjunto      │
+ *          │ Substituição │ LRU por carimbo de acesso; linhas de faixas  │
+ *          │              │ fixadas (FAT) só saem se o conjunto inteiro  │
+ *          │              │ estiver fixado                               │
+ *          └──────────────┴──────────────────────────────────────────────┘
+ *          Setores consecutivos caem em conjuntos consecutivos, então um
+ *          trecho sequencial nunca disputa o mesmo conjunto.
+ *
+ *          POLÍTICAS:
+ *          - Write-back: escrita marca a linha como suja; CTRL_SYNC grava
+ *            todas as sujas em ordem crescente de LBA (o sd_stream coalesce
+ *            as contíguas num único CMD25) e repassa o sync.
+ *          - Read-ahead: uma falta logo após o fim da leitura anterior traz
+ *            também os `readahead` setores seguintes, sem despejar linhas sujas
+ *            nem fixadas.
+ *          - Bypass: transferências com >= bypass setores vão direto ao
+ *            dispositivo (mantendo a coerência com as linhas em cache).
+ *
+ *          Contadores de acerto/falta: ioctl SD_CACHE_IOCTL_GET_STATS.
+ * =============================================================================
+ */
+
+#ifndef SD_CACHE_H
+#define SD_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "blockdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** Número máximo de faixas fixadas (ex.: FAT1 + FAT2 de dois volumes) */
+#ifndef SD_CACHE_MAX_PINS
+#define SD_CACHE_MAX_PINS 4
+#endif
+
+/** Transferências a partir deste número de setores ignoram o cache */
+#ifndef SD_CACHE_DEFAULT_BYPASS
+#define SD_CACHE_DEFAULT_BYPASS 8u
+#endif
+
+/** Setores trazidos por read-ahead em leituras sequenciais */
+#ifndef SD_CACHE_DEFAULT_READAHEAD
+#define SD_CACHE_DEFAULT_READAHEAD 4u
+#endif
+
+/** ioctls do cache (faixa BLOCKDEV_IOCTL_USER + 0x00 .. 0x0F) */
+#define SD_CACHE_IOCTL_GET_STATS   (BLOCKDEV_IOCTL_USER + 0x00u) /**< buff: sd_cache_stats_t* */
+#define SD_CACHE_IOCTL_RESET_STATS (BLOCKDEV_IOCTL_USER + 0x01u) /**< buff: ignorado */
+#define SD_CACHE_IOCTL_PIN         (BLOCKDEV_IOCTL_USER + 0x02u) /**< buff: uint32_t[2] {lba, count} */
+#define SD_CACHE_IOCTL_UNPIN_ALL   (BLOCKDEV_IOCTL_USER + 0x03u) /**< buff: ignorado */
+#define SD_CACHE_IOCTL_INVALIDATE  (BLOCKDEV_IOCTL_USER + 0x04u) /**< Grava as sujas e esvazia */
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct sd_cache_line_t
+ * @brief Metadados de uma linha (os 512 bytes ficam no buffer de dados)
+ */
+typedef struct {
+    uint32_t lba;
+    uint32_t stamp;   /**< Carimbo do último acesso (LRU) */
+    uint8_t flags;    /**< Bits internos: válida, suja, trazida por read-ahead */
+} sd_cache_line_t;
+
+/**
+ * @struct sd_cache_stats_t
+ * @brief Contadores do cache
+ *
+ * @var sd_cache_stats_t::read_hits       Setores lidos do cache
+ * @var sd_cache_stats_t::read_misses     Setores lidos do dispositivo
+ * @var sd_cache_stats_t::write_hits      Escritas em linha já presente
+ * @var sd_cache_stats_t::write_misses    Escritas que alocaram linha
+ * @var sd_cache_stats_t::readahead       Setores trazidos por read-ahead
+ * @var sd_cache_stats_t::readahead_hits  Setores de read-ahead depois lidos
+ * @var sd_cache_stats_t::writebacks      Setores sujos gravados no dispositivo
+ * @var sd_cache_stats_t::evictions       Linhas válidas substituídas
+ * @var sd_cache_stats_t::bypass_sectors  Setores transferidos sem passar pelo cache
+ */
+typedef struct {
+    uint32_t read_hits;
+    uint32_t read_misses;
+    uint32_t write_hits;
+    uint32_t write_misses;
+    uint32_t readahead;
+    uint32_t readahead_hits;
+    uint32_t writebacks;
+    uint32_t evictions;
+    uint32_t bypass_sectors;
+} sd_cache_stats_t;
+
+/**
+ * @struct sd_cache_t
+ * @brief Estado do cache (instância e buffers estáticos, sem malloc)
+ */
+typedef struct {
+    blockdev_t lower;             /**< Dispositivo abaixo do cache */
+    sd_cache_line_t *lines;       /**< n_sets * n_ways linhas */
+    uint8_t *data;                /**< n_sets * n_ways * 512 bytes */
+    uint16_t n_sets;
+    uint8_t n_ways;
+    uint8_t readahead;            /**< 0 desliga o read-ahead */
+    uint16_t bypass;              /**< 0 desliga o bypass */
+    uint32_t tick;                /**< Relógio LRU */
+    uint32_t last_read_end;       /**< LBA seguinte à última leitura */
+
+    uint32_t pin_lba[SD_CACHE_MAX_PINS];
+    uint32_t pin_count[SD_CACHE_MAX_PINS];
+    uint8_t n_pins;
+
+    sd_cache_stats_t stats;
+} sd_cache_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o cache vazio
+ *
+ * @param c      Instância
+ * @param lower  Dispositivo abaixo (copiado)
+ * @param lines  n_sets * n_ways metadados
+ * @param data   n_sets * n_ways * 512 bytes
+ * @param n_sets Conjuntos (potência de 2)
+ * @param n_ways Vias por conjunto (>= 1)
+ * @return true se os parâmetros forem válidos
+ */
+bool sd_cache_init(sd_cache_t *c, const blockdev_t *lower, sd_cache_line_t *lines,
+                   uint8_t *data, uint16_t n_sets, uint8_t n_ways);
+
+/** Setores de read-ahead (0 desliga) */
+void sd_cache_set_readahead(sd_cache_t *c, uint8_t sectors);
+
+/** Limiar de bypass em setores (0 desliga) */
+void sd_cache_set_bypass(sd_cache_t *c, uint16_t sectors);
+
+/**
+ * @brief Fixa uma faixa de setores (ex.: a FAT)
+ *
+ * @details Com FatFS: sd_cache_pin(&cache, fs.fatbase, fs.fsize * fs.n_fats).
+ * @return false se não houver espaço para mais faixas
+ */
+bool sd_cache_pin(sd_cache_t *c, uint32_t lba, uint32_t count);
+
+/**
+ * @brief Fixa as FATs descritas por um setor de boot FAT12/16/32
+ *
+ * @param vbr     Conteúdo do setor de boot do volume (512 bytes)
+ * @param vbr_lba LBA desse setor
+ * @return false se o setor não parecer um BPB FAT válido
+ */
+bool sd_cache_pin_fat(sd_cache_t *c, const uint8_t *vbr, uint32_t vbr_lba);
+
+blockdev_result_t sd_cache_read(sd_cache_t *c, uint8_t *buf, uint32_t lba, uint32_t count);
+blockdev_result_t sd_cache_write(sd_cache_t *c, const uint8_t *buf, uint32_t lba, uint32_t count);
+
+/** Grava as linhas sujas em ordem de LBA (sem repassar o sync) */
+blockdev_result_t sd_cache_flush(sd_cache_t *c);
+
+/**
+ * @brief ioctl: CTRL_SYNC grava as sujas e repassa; SD_CACHE_IOCTL_* são
+ *        atendidos aqui; os demais comandos vão para o dispositivo abaixo
+ */
+blockdev_result_t sd_cache_ioctl(sd_cache_t *c, uint8_t cmd, void *buff);
+
+/** Preenche um blockdev_t que passa pelo cache */
+void sd_cache_blockdev(sd_cache_t *c, blockdev_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SD_CACHE_H */
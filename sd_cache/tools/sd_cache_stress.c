@@ -0,0 +1,423 @@
+/**
+ * =============================================================================
+ * @file    sd_cache_stress.c
+ * @brief   (Host) Teste aleatório do sd_cache contra uma cópia do disco
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Abaixo do cache fica um disco em RAM que registra cada acesso.
+ *          A cópia (`model`) guarda o que a aplicação escreveu; o disco só
+ *          deve alcançá-la por write-back. Verificações:
+ *
+ *          - Coerência: toda leitura devolve a cópia, com ou sem bypass,
+ *            read-ahead, TRIM e INVALIDATE no meio.
+ *          - Write-back: toda gravação que chega ao disco já traz o dado mais
+ *            novo daquele setor (o cache nunca grava uma linha velha).
+ *          - CTRL_SYNC: as sujas descem em ordem crescente de LBA, cada uma
+ *            uma vez, e só depois o sync é repassado. Nesse momento o disco
+ *            já é igual à cópia. Um segundo sync não grava nada.
+ *          - Fixação: linhas de faixas fixadas sobrevivem a qualquer número
+ *            de faltas no conjunto enquanto houver uma via não fixada. Com o
+ *            conjunto inteiro fixado, sai a fixada LRU numa falta; o read-ahead
+ *            não despeja linhas sujas nem fixadas.
+ *
+ *          O laço aleatório roda em algumas geometrias (conjuntos x vias,
+ *          read-ahead, bypass e faixas fixadas).
+ *
+ *          Uso: sd_cache_stress [-q]
+ *            -q  menos operações por geometria
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "sd_cache.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS     2048u
+#define SECTOR BLOCKDEV_SECTOR_SIZE
+#define MAX_N  24u                /* Maior transferência do laço aleatório */
+
+/* =============================================================================
+ * SEÇÃO 1: DISCO EM RAM COM REGISTRO DE ACESSOS
+ * =============================================================================
+ */
+
+static uint8_t disk[NS][SECTOR];
+static uint8_t model[NS][SECTOR];
+
+typedef struct {
+    uint32_t reads;          /**< Setores lidos */
+    uint32_t writes;         /**< Setores gravados */
+    uint32_t syncs;
+    bool syncing;            /**< Dentro de um CTRL_SYNC do teste */
+    bool synced;             /**< O sync já foi repassado */
+    uint32_t sync_writes;    /**< Setores gravados pelo CTRL_SYNC atual */
+    int64_t sync_prev;       /**< Último LBA gravado pelo CTRL_SYNC atual */
+    unsigned stale;          /**< Gravações com dado diferente da cópia */
+} lower_t;
+
+static lower_t low;
+
+/* Escrita em andamento: enquanto ela não termina, um setor dela ainda sujo
+ * no cache com o conteúdo anterior pode ser despejado por outro setor da
+ * mesma chamada (conteúdo anterior, não velho) */
+static uint32_t pending_lba, pending_n;
+static uint8_t pending_before[MAX_N * SECTOR];
+
+/** O dado gravado é o mais novo do setor (ou o anterior à escrita em andamento) */
+static bool current(const uint8_t *p, uint32_t lba) {
+    if (memcmp(p, model[lba], SECTOR) == 0) {
+        return true;
+    }
+    return lba - pending_lba < pending_n &&
+           memcmp(p, pending_before + (size_t)(lba - pending_lba) * SECTOR, SECTOR) == 0;
+}
+
+static blockdev_result_t low_read(void *ctx, uint8_t *buf, uint32_t lba, uint32_t count) {
+    (void)ctx;
+    if (lba >= NS || count > NS - lba) {
+        return BLOCKDEV_PARERR;
+    }
+    memcpy(buf, disk[lba], (size_t)count * SECTOR);
+    low.reads += count;
+    return BLOCKDEV_OK;
+}
+
+static blockdev_result_t low_write(void *ctx, const uint8_t *buf, uint32_t lba, uint32_t count) {
+    (void)ctx;
+    if (lba >= NS || count > NS - lba) {
+        return BLOCKDEV_PARERR;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        if (!current(buf + (size_t)i * SECTOR, lba + i) && low.stale++ < 4u) {
+            printf("FALHA: gravou dado velho em %u\n", lba + i);
+        }
+    }
+    if (low.syncing) {
+        CHECK(!low.synced, "gravação em %u depois do sync repassado", lba);
+        CHECK((int64_t)lba > low.sync_prev, "CTRL_SYNC fora de ordem: %u depois de %lld", lba,
+              (long long)low.sync_prev);
+        low.sync_prev = (int64_t)(lba + count - 1u);
+        low.sync_writes += count;
+    }
+    memcpy(disk[lba], buf, (size_t)count * SECTOR);
+    low.writes += count;
+    return BLOCKDEV_OK;
+}
+
+static blockdev_result_t low_ioctl(void *ctx, uint8_t cmd, void *buff) {
+    (void)ctx;
+    switch (cmd) {
+    case BLOCKDEV_CTRL_SYNC:
+        low.syncs++;
+        if (low.syncing) {
+            low.synced = true;
+            CHECK(memcmp(disk, model, sizeof disk) == 0, "sync repassado com sujas no cache");
+        }
+        return BLOCKDEV_OK;
+    case BLOCKDEV_GET_SECTOR_COUNT:
+        *(uint32_t *)buff = NS;
+        return BLOCKDEV_OK;
+    case BLOCKDEV_CTRL_TRIM:
+        return BLOCKDEV_OK;  /* Conteúdo descartado fica como está */
+    default:
+        return BLOCKDEV_PARERR;
+    }
+}
+
+static const blockdev_t lower_dev = { NULL, low_read, low_write, low_ioctl };
+
+/* =============================================================================
+ * SEÇÃO 2: OPERAÇÕES VERIFICADAS
+ * =============================================================================
+ */
+
+static sd_cache_t cache;
+static sd_cache_line_t lines[64];
+static uint8_t data[64 * SECTOR];
+static blockdev_t dev;
+static uint8_t buf[MAX_N * SECTOR];
+
+static void fill_random(uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)rand();
+    }
+}
+
+static bool read_ok(uint32_t lba, uint32_t n) {
+    if (blockdev_read(&dev, buf, lba, n) != BLOCKDEV_OK) {
+        return false;
+    }
+    return memcmp(buf, model[lba], (size_t)n * SECTOR) == 0;
+}
+
+/** A cópia é atualizada antes: o disco em RAM confere cada gravação contra ela */
+static bool write_new(uint32_t lba, uint32_t n) {
+    fill_random(buf, (size_t)n * SECTOR);
+    memcpy(pending_before, model[lba], (size_t)n * SECTOR);
+    memcpy(model[lba], buf, (size_t)n * SECTOR);
+    pending_lba = lba;
+    pending_n = n;
+    const bool ok = blockdev_write(&dev, buf, lba, n) == BLOCKDEV_OK;
+    pending_n = 0;
+    return ok;
+}
+
+/** CTRL_SYNC com as verificações de ordem; devolve os setores gravados */
+static uint32_t checked_sync(const char *tag) {
+    low.syncing = true;
+    low.synced = false;
+    low.sync_writes = 0;
+    low.sync_prev = -1;
+    CHECK(blockdev_sync(&dev) == BLOCKDEV_OK, "%s: CTRL_SYNC", tag);
+    CHECK(low.synced, "%s: CTRL_SYNC não foi repassado", tag);
+    low.syncing = false;
+    CHECK(memcmp(disk, model, sizeof disk) == 0, "%s: disco difere após CTRL_SYNC", tag);
+    return low.sync_writes;
+}
+
+static void cache_setup(uint16_t sets, uint8_t ways, uint8_t readahead, uint16_t bypass) {
+    CHECK(sd_cache_init(&cache, &lower_dev, lines, data, sets, ways), "init %ux%u", sets, ways);
+    sd_cache_set_readahead(&cache, readahead);
+    sd_cache_set_bypass(&cache, bypass);
+    sd_cache_blockdev(&cache, &dev);
+}
+
+static void disk_reset(void) {
+    memset(&low, 0, sizeof low);
+    fill_random(&disk[0][0], sizeof disk);
+    memcpy(model, disk, sizeof disk);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: LAÇO ALEATÓRIO
+ * =============================================================================
+ */
+
+typedef struct {
+    uint16_t sets;
+    uint8_t ways;
+    uint8_t readahead;
+    uint16_t bypass;
+    bool pins;
+} geometry_t;
+
+/** LBA com localidade: região quente, faixas fixadas ou qualquer lugar */
+static uint32_t pick_lba(uint32_t n) {
+    uint32_t lba;
+    switch (rand() % 4) {
+    case 0:
+        lba = (uint32_t)rand() % 64u;
+        break;
+    case 1:
+        lba = 10u + (uint32_t)rand() % 8u;
+        break;
+    case 2:
+        lba = 512u + (uint32_t)rand() % 64u;
+        break;
+    default:
+        lba = (uint32_t)rand() % NS;
+        break;
+    }
+    return (lba > NS - n) ? NS - n : lba;
+}
+
+static void random_run(const geometry_t *g, unsigned ops) {
+    char tag[48];
+    snprintf(tag, sizeof tag, "%ux%u ra %u bypass %u%s", g->sets, g->ways, g->readahead,
+             g->bypass, g->pins ? " fixadas" : "");
+    const unsigned fail0 = failures;
+
+    disk_reset();
+    cache_setup(g->sets, g->ways, g->readahead, g->bypass);
+    if (g->pins) {
+        uint32_t range[2] = { 512u, 64u };
+        CHECK(sd_cache_pin(&cache, 10u, 8u), "%s: pin", tag);
+        CHECK(blockdev_ioctl(&dev, SD_CACHE_IOCTL_PIN, range) == BLOCKDEV_OK, "%s: ioctl PIN", tag);
+    }
+
+    uint32_t seq = 0;       /* Próximo LBA de uma leitura sequencial */
+    unsigned syncs = 0;
+    for (unsigned t = 0; t < ops && failures == fail0; t++) {
+        const uint32_t n = (rand() % 4 == 0) ? 1u + (uint32_t)rand() % MAX_N
+                                             : 1u + (uint32_t)rand() % 3u;
+        const uint32_t lba = pick_lba(n);
+        const int op = rand() % 100;
+        if (op < 30) {
+            CHECK(read_ok(lba, n), "%s: op %u: leitura %u+%u difere da cópia", tag, t, lba, n);
+        } else if (op < 40) {
+            /* Leitura sequencial: dispara o read-ahead */
+            if (seq + n > NS) {
+                seq = (uint32_t)rand() % (NS / 2u);
+            }
+            CHECK(read_ok(seq, n), "%s: op %u: leitura sequencial %u+%u", tag, t, seq, n);
+            seq += n;
+        } else if (op < 94) {
+            CHECK(write_new(lba, n), "%s: op %u: escrita %u+%u", tag, t, lba, n);
+        } else if (op < 97) {
+            checked_sync(tag);
+            CHECK(checked_sync(tag) == 0u, "%s: segundo CTRL_SYNC gravou setores", tag);
+            syncs++;
+        } else if (op < 99) {
+            /* TRIM: as sujas da faixa somem e o conteúdo fica o do disco */
+            uint32_t range[2] = { lba, lba + n - 1u };
+            CHECK(blockdev_ioctl(&dev, BLOCKDEV_CTRL_TRIM, range) == BLOCKDEV_OK, "%s: TRIM", tag);
+            memcpy(model[lba], disk[lba], (size_t)n * SECTOR);
+        } else {
+            CHECK(blockdev_ioctl(&dev, SD_CACHE_IOCTL_INVALIDATE, NULL) == BLOCKDEV_OK,
+                  "%s: INVALIDATE", tag);
+            CHECK(memcmp(disk, model, sizeof disk) == 0, "%s: INVALIDATE deixou sujas", tag);
+        }
+    }
+    checked_sync(tag);
+    CHECK(low.stale == 0u, "%s: %u gravações com dado velho", tag, low.stale);
+
+    sd_cache_stats_t st;
+    blockdev_ioctl(&dev, SD_CACHE_IOCTL_GET_STATS, &st);
+    printf("%-28s acertos %6u faltas %6u read-ahead %5u write-backs %6u syncs %4u: %s\n", tag,
+           st.read_hits + st.write_hits, st.read_misses + st.write_misses, st.readahead,
+           st.writebacks, syncs, failures == fail0 ? "ok" : "FALHA");
+}
+
+/* =============================================================================
+ * SEÇÃO 4: CENÁRIOS DETERMINÍSTICOS
+ * =============================================================================
+ */
+
+/** Sujas gravadas no CTRL_SYNC: todas, uma vez cada, em ordem crescente */
+static void scenario_sync_order(void) {
+    disk_reset();
+    cache_setup(16, 4, 0, 0);
+    static const uint32_t order[] = { 900, 3, 47, 2, 901, 35, 19, 600, 4, 902 };
+    for (unsigned i = 0; i < sizeof order / sizeof order[0]; i++) {
+        CHECK(write_new(order[i], 1), "ordem: escrita %u", order[i]);
+    }
+    CHECK(low.writes == 0u, "ordem: %u setores gravados antes do sync", low.writes);
+    const uint32_t w = checked_sync("ordem");
+    CHECK(w == sizeof order / sizeof order[0], "ordem: %u setores no sync, esperado %u", w,
+          (unsigned)(sizeof order / sizeof order[0]));
+    CHECK(low.syncs == 1u, "ordem: %u syncs repassados", low.syncs);
+    printf("CTRL_SYNC: %u sujas em ordem crescente, sync repassado depois\n", w);
+}
+
+/** Fixadas sobrevivem a faltas no conjunto; conjunto todo fixado: sai a LRU */
+static void scenario_pins(void) {
+    const uint16_t sets = 8;
+    disk_reset();
+    cache_setup(sets, 4, 0, 0);
+
+    /* Conjunto 3: três vias fixadas (3, 11, 19), uma livre */
+    CHECK(sd_cache_pin(&cache, 3u, 17u), "fixação: pin");
+    for (uint32_t k = 0; k < 3; k++) {
+        CHECK(read_ok(3u + k * sets, 1), "fixação: leitura fixada");
+    }
+    for (uint32_t k = 0; k < 200; k++) {
+        const uint32_t lba = 3u + (40u + k) * sets;
+        if (k & 1u) {
+            CHECK(write_new(lba, 1), "fixação: escrita %u", lba);
+        } else {
+            CHECK(read_ok(lba, 1), "fixação: leitura %u", lba);
+        }
+    }
+    const uint32_t reads = low.reads;
+    for (uint32_t k = 0; k < 3; k++) {
+        CHECK(read_ok(3u + k * sets, 1), "fixação: leitura fixada após faltas");
+    }
+    CHECK(low.reads == reads, "fixação: %u fixadas despejadas por linhas comuns",
+          low.reads - reads);
+
+    /* Conjunto 5 inteiro fixado (5, 13 + faixa nova 21, 29, 37): sai a LRU */
+    CHECK(sd_cache_pin(&cache, 21u, 24u), "fixação: segunda faixa");
+    static const uint32_t pinned[] = { 5, 13, 21, 29 };
+    for (unsigned i = 0; i < 4; i++) {
+        CHECK(read_ok(pinned[i], 1), "fixação: conjunto 5");
+    }
+    CHECK(read_ok(5, 1), "fixação: toque em 5");          /* LRU agora é 13 */
+    CHECK(read_ok(37, 1), "fixação: quinta fixada");
+    const uint32_t before = low.reads;
+    CHECK(read_ok(5, 1) && read_ok(21, 1) && read_ok(29, 1) && read_ok(37, 1),
+          "fixação: releitura");
+    CHECK(low.reads == before, "fixação: despejou fixada recente (%u leituras)",
+          low.reads - before);
+    CHECK(read_ok(13, 1) && low.reads == before + 1u, "fixação: a LRU (13) não foi despejada");
+
+    checked_sync("fixação");
+
+    /* Read-ahead não despeja sujas: conjuntos de 102..105 cheios de sujas */
+    cache_setup(sets, 4, 4, 0);
+    for (uint32_t s = 102; s < 106; s++) {
+        for (uint32_t k = 0; k < 4; k++) {
+            CHECK(write_new(s + (k + 1u) * sets * 20u, 1), "read-ahead: escrita suja");
+        }
+    }
+    const uint32_t writes = low.writes;
+    CHECK(read_ok(100, 1) && read_ok(101, 1), "read-ahead: leitura sequencial");
+    sd_cache_stats_t st;
+    blockdev_ioctl(&dev, SD_CACHE_IOCTL_GET_STATS, &st);
+    CHECK(low.writes == writes && st.readahead == 0u,
+          "read-ahead despejou sujas: %u gravações, %u setores trazidos", low.writes - writes,
+          st.readahead);
+    checked_sync("read-ahead");
+
+    /* Read-ahead não despeja fixadas: conjunto 0 todo fixado (200, 208, 216,
+     * 224); a leitura sequencial 230, 231 pede o read-ahead de 232 nele */
+    cache_setup(sets, 4, 1, 0);
+    CHECK(sd_cache_pin(&cache, 200u, 32u), "read-ahead: pin");
+    for (uint32_t k = 0; k < 4; k++) {
+        CHECK(read_ok(200u + k * sets, 1), "read-ahead: leitura fixada");
+    }
+    blockdev_ioctl(&dev, SD_CACHE_IOCTL_GET_STATS, &st);
+    const uint32_t prefetched = st.readahead;
+    const uint32_t pin_reads = low.reads;
+    CHECK(read_ok(230, 1) && read_ok(231, 1), "read-ahead: leitura sequencial fixada");
+    blockdev_ioctl(&dev, SD_CACHE_IOCTL_GET_STATS, &st);
+    CHECK(low.reads == pin_reads + 2u && st.readahead == prefetched,
+          "read-ahead despejou fixada: %u leituras, %u setores trazidos", low.reads - pin_reads,
+          st.readahead - prefetched);
+    for (uint32_t k = 0; k < 4; k++) {
+        CHECK(read_ok(200u + k * sets, 1), "read-ahead: releitura fixada");
+    }
+    CHECK(low.reads == pin_reads + 2u, "read-ahead: fixada %u leituras depois",
+          low.reads - pin_reads - 2u);
+    checked_sync("read-ahead fixado");
+    printf("fixação: fixadas sobrevivem a 200 faltas; conjunto fixado despeja a LRU; "
+           "read-ahead não despeja sujas nem fixadas\n");
+}
+
+int main(int argc, char **argv) {
+    unsigned ops = 40000u;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            ops = 5000u;
+        } else {
+            fprintf(stderr, "uso: %s [-q]\n", argv[0]);
+            return 2;
+        }
+    }
+    srand(2026u);
+
+    scenario_sync_order();
+    scenario_pins();
+
+    static const geometry_t geometries[] = {
+        { 16, 4, 4, 8, true },
+        { 16, 4, 0, 0, false },
+        { 8, 2, 4, 4, true },
+        { 1, 8, 2, 0, true },
+        { 64, 1, 4, 8, false },
+    };
+    for (unsigned i = 0; i < sizeof geometries / sizeof geometries[0]; i++) {
+        random_run(&geometries[i], ops);
+    }
+
+    return test_check_summary();
+}
@@ -0,0 +1,182 @@
+/**
+ * =============================================================================
+ * @file    sd_crc.c
+ * @brief   Implementação dos CRCs do SD (referência, tabelas e sniffer)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details SLICE-BY-N PARA UM CRC16 MSB-FIRST:
+ *          T0[x] é o CRC de um byte x; Tk[x] é a contribuição do mesmo byte
+ *          seguido de k bytes zero: Tk[x] = (Tk-1[x] << 8) ^ T0[Tk-1[x] >> 8].
+ *          Para 8 bytes b0..b7 com CRC atual c:
+ *
+ *            c' = T7[(c >> 8) ^ b0] ^ T6[(c & 0xFF) ^ b1]
+ *               ^ T5[b2] ^ T4[b3] ^ T3[b4] ^ T2[b5] ^ T1[b6] ^ T0[b7]
+ *
+ *          Os bytes são lidos um a um (o Cortex-M0+ não aceita acesso
+ *          desalinhado), mas as 8 consultas são independentes entre si.
+ * =============================================================================
+ */
+
+#include "sd_crc.h"
+
+#include <stdbool.h>
+
+#if SD_CRC_HAS_SNIFFER
+#include "hardware/dma.h"
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: TABELAS
+ * =============================================================================
+ */
+
+#define CRC16_POLY 0x1021u
+#define CRC7_POLY  0x09u
+
+static uint16_t crc16_table[8][256];
+static uint8_t crc7_table[256];
+static volatile bool tables_ready = false;
+
+void sd_crc_init(void) {
+    if (tables_ready) {
+        return;
+    }
+    for (uint32_t x = 0; x < 256u; x++) {
+        uint16_t c = (uint16_t)(x << 8);
+        for (int i = 0; i < 8; i++) {
+            c = (uint16_t)((c & 0x8000u) ? ((unsigned)c << 1) ^ CRC16_POLY : ((unsigned)c << 1));
+        }
+        crc16_table[0][x] = c;
+
+        /* CRC7 alinhado à esquerda no byte: o bit 7 é o mais significativo */
+        uint8_t c7 = (uint8_t)x;
+        for (int i = 0; i < 8; i++) {
+            c7 = (uint8_t)((c7 & 0x80u) ? ((unsigned)c7 << 1) ^ (CRC7_POLY << 1) : ((unsigned)c7 << 1));
+        }
+        crc7_table[x] = c7;
+    }
+    for (uint32_t k = 1; k < 8u; k++) {
+        for (uint32_t x = 0; x < 256u; x++) {
+            const uint16_t prev = crc16_table[k - 1][x];
+            crc16_table[k][x] = (uint16_t)((prev << 8) ^ crc16_table[0][prev >> 8]);
+        }
+    }
+    /* Um core pode montar as tabelas enquanto o outro também monta: os
+     * valores escritos são idênticos, então a corrida é inofensiva */
+    __sync_synchronize();
+    tables_ready = true;
+}
+
+static inline void ensure_tables(void) {
+    if (!tables_ready) {
+        sd_crc_init();
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: CRC7
+ * =============================================================================
+ */
+
+uint8_t sd_crc7_ref(const uint8_t *p, size_t n) {
+    uint8_t crc = 0;
+    while (n--) {
+        uint8_t d = *p++;
+        for (int i = 0; i < 8; i++) {
+            crc = (uint8_t)(crc << 1);
+            if ((d ^ crc) & 0x80u) {
+                crc ^= CRC7_POLY;
+            }
+            d = (uint8_t)(d << 1);
+        }
+    }
+    return crc & 0x7Fu;
+}
+
+uint8_t sd_crc7(const uint8_t *p, size_t n) {
+    ensure_tables();
+    uint8_t crc = 0;  /* Mantido deslocado 1 bit à esquerda */
+    while (n--) {
+        crc = crc7_table[crc ^ *p++];
+    }
+    return crc >> 1;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: CRC16
+ * =============================================================================
+ */
+
+uint16_t sd_crc16_ref(const uint8_t *p, size_t n) {
+    uint16_t crc = 0;
+    while (n--) {
+        crc ^= (uint16_t)(*p++ << 8);
+        for (int i = 0; i < 8; i++) {
+            crc = (uint16_t)((crc & 0x8000u) ? ((unsigned)crc << 1) ^ CRC16_POLY : ((unsigned)crc << 1));
+        }
+    }
+    return crc;
+}
+
+uint16_t sd_crc16_update(uint16_t crc, const uint8_t *p, size_t n) {
+    ensure_tables();
+    while (n--) {
+        crc = (uint16_t)((crc << 8) ^ crc16_table[0][(crc >> 8) ^ *p++]);
+    }
+    return crc;
+}
+
+uint16_t sd_crc16_slice4(uint16_t crc, const uint8_t *p, size_t n) {
+    ensure_tables();
+    while (n >= 4u) {
+        crc = crc16_table[3][(crc >> 8) ^ p[0]] ^ crc16_table[2][(crc & 0xFFu) ^ p[1]] ^
+              crc16_table[1][p[2]] ^ crc16_table[0][p[3]];
+        p += 4;
+        n -= 4u;
+    }
+    return sd_crc16_update(crc, p, n);
+}
+
+uint16_t sd_crc16_slice8(uint16_t crc, const uint8_t *p, size_t n) {
+    ensure_tables();
+    while (n >= 8u) {
+        crc = crc16_table[7][(crc >> 8) ^ p[0]] ^ crc16_table[6][(crc & 0xFFu) ^ p[1]] ^
+              crc16_table[5][p[2]] ^ crc16_table[4][p[3]] ^
+              crc16_table[3][p[4]] ^ crc16_table[2][p[5]] ^
+              crc16_table[1][p[6]] ^ crc16_table[0][p[7]];
+        p += 8;
+        n -= 8u;
+    }
+    return sd_crc16_update(crc, p, n);
+}
+
+/* =============================================================================
+ * SEÇÃO 4: SNIFFER DO DMA
+ * =============================================================================
+ */
+
+#if SD_CRC_HAS_SNIFFER
+
+/** Modo CRC-16-CCITT do registrador SNIFF_CTRL.CALC */
+#define SNIFF_CALC_CRC16 0x2u
+
+void sd_crc_sniff_start(unsigned dma_chan) {
+    dma_sniffer_set_data_accumulator(0);
+    dma_sniffer_enable(dma_chan, SNIFF_CALC_CRC16, true);
+}
+
+uint16_t sd_crc_sniff_result(void) {
+    return (uint16_t)dma_sniffer_get_data_accumulator();
+}
+
+void sd_crc_sniff_stop(void) {
+    dma_sniffer_disable();
+}
+
+#endif /* SD_CRC_HAS_SNIFFER */
@@ -0,0 +1,122 @@
+/**
+ * =============================================================================
+ * @file    sd_crc.h
+ * @brief   CRC7 e CRC16 do protocolo SD: tabelas slice-by-4/8 e sniffer de DMA
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details O SD usa dois CRCs:
+ *          ┌────────┬────────────────────────────┬──────────────────────────┐
+ *          │ CRC    │ Polinômio / valor inicial  │ Onde                     │
+ *          ├────────┼────────────────────────────┼──────────────────────────┤
+ *          │ CRC7   │ x^7 + x^3 + 1 (0x09) / 0   │ 5 bytes de cada comando  │
+ *          │ CRC16  │ 0x1021 (CCITT, XMODEM) / 0 │ 512 bytes de cada bloco  │
+ *          └────────┴────────────────────────────┴──────────────────────────┘
+ *
+ *          O CRC16 do bloco fica no caminho crítico de toda transferência.
+ *          Implementações disponíveis (todas bit a bit idênticas):
+ *          - sd_crc16_ref():    bit a bit, referência;
+ *          - sd_crc16_update(): tabela de 256 entradas, 1 byte por passo;
+ *          - sd_crc16_slice4(): 4 tabelas, 4 bytes por passo;
+ *          - sd_crc16_slice8(): 8 tabelas, 8 bytes por passo (padrão de sd_crc16());
+ *          - RP2040/RP2350: o sniffer do DMA calcula o CRC16 durante a
+ *            própria transferência SPI, sem custo de CPU.
+ *
+ *          As tabelas (4 KiB para slice-by-8) são montadas em RAM na primeira
+ *          chamada, evitando a latência do XIP em flash.
+ * =============================================================================
+ */
+
+#ifndef SD_CRC_H
+#define SD_CRC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#define SD_CRC_HAS_SNIFFER 1
+#else
+#define SD_CRC_HAS_SNIFFER 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: TABELAS
+ * =============================================================================
+ */
+
+/**
+ * @brief Monta as tabelas em RAM
+ *
+ * @details Chamada automaticamente pelas funções tabeladas; pode ser chamada
+ *          antecipadamente no boot para tirar o custo do primeiro bloco.
+ */
+void sd_crc_init(void);
+
+/* =============================================================================
+ * SEÇÃO 2: CRC7 (COMANDOS)
+ * =============================================================================
+ */
+
+/** CRC7 bit a bit (referência) */
+uint8_t sd_crc7_ref(const uint8_t *p, size_t n);
+
+/** CRC7 tabelado: devolve os 7 bits (o byte do comando é (crc << 1) | 1) */
+uint8_t sd_crc7(const uint8_t *p, size_t n);
+
+/* =============================================================================
+ * SEÇÃO 3: CRC16 (BLOCOS DE DADOS)
+ * =============================================================================
+ */
+
+/** CRC16 bit a bit (referência) */
+uint16_t sd_crc16_ref(const uint8_t *p, size_t n);
+
+/** Continua um CRC16 com a tabela de 1 byte (crc = 0 para começar) */
+uint16_t sd_crc16_update(uint16_t crc, const uint8_t *p, size_t n);
+
+/** Continua um CRC16 processando 4 bytes por passo */
+uint16_t sd_crc16_slice4(uint16_t crc, const uint8_t *p, size_t n);
+
+/** Continua um CRC16 processando 8 bytes por passo */
+uint16_t sd_crc16_slice8(uint16_t crc, const uint8_t *p, size_t n);
+
+/** CRC16 de um bloco com a implementação mais rápida em software */
+static inline uint16_t sd_crc16(const uint8_t *p, size_t n) {
+    return sd_crc16_slice8(0, p, n);
+}
+
+/* =============================================================================
+ * SEÇÃO 4: SNIFFER DO DMA (RP2040/RP2350)
+ * =============================================================================
+ */
+
+#if SD_CRC_HAS_SNIFFER
+/**
+ * @brief Liga o sniffer em modo CRC16-CCITT no canal `dma_chan` (semente 0)
+ *
+ * @details Chamar antes de disparar o canal; o sniffer acompanha cada byte
+ *          transferido pelo canal (TX na escrita, RX na leitura).
+ */
+void sd_crc_sniff_start(unsigned dma_chan);
+
+/** CRC16 acumulado desde sd_crc_sniff_start() (chamar após o fim do DMA) */
+uint16_t sd_crc_sniff_result(void);
+
+/** Desliga o sniffer */
+void sd_crc_sniff_stop(void);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SD_CRC_H */
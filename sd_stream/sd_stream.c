@@ -0,0 +1,549 @@
+/**
+ * =============================================================================
+ * @file    sd_stream.c
+ * @brief   Protocolo SD em modo SPI: inicialização e fluxos CMD18/CMD25
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details FORMATO DOS BLOCOS NO BARRAMENTO:
+ *          ┌───────────────┬───────────────────────────────────────────────┐
+ *          │ Leitura CMD18 │ ... 0xFF* │ 0xFE │ 512 dados │ CRC16 (2) │ ...│
+ *          │ Escrita CMD25 │ 0xFC │ 512 dados │ CRC16 (2) │ resp │ busy(0) │
+ *          │ Fim da escrita│ 0xFD │ busy (0x00 até 0xFF)                   │
+ *          │ Fim da leitura│ CMD12 │ byte de enchimento │ R1 │ busy        │
+ *          └───────────────┴───────────────────────────────────────────────┘
+ *
+ *          A espera do busy de um bloco escrito é feita só antes do próximo
+ *          token (ou no sync), de modo que o cartão grava enquanto o chamador
+ *          prepara o próximo buffer.
+ * =============================================================================
+ */
+
+#include "sd_stream.h"
+#include "sd_crc.h"
+
+#include <string.h>   /* Para memset */
+
+/* =============================================================================
+ * SEÇÃO 1: CONSTANTES DO PROTOCOLO
+ * =============================================================================
+ */
+
+#define CMD0    0u     /* GO_IDLE_STATE */
+#define CMD8    8u     /* SEND_IF_COND */
+#define CMD9    9u     /* SEND_CSD */
+#define CMD12   12u    /* STOP_TRANSMISSION */
+#define CMD16   16u    /* SET_BLOCKLEN */
+#define CMD18   18u    /* READ_MULTIPLE_BLOCK */
+#define CMD25   25u    /* WRITE_MULTIPLE_BLOCK */
+#define CMD55   55u    /* APP_CMD */
+#define CMD58   58u    /* READ_OCR */
+#define CMD59   59u    /* CRC_ON_OFF */
+#define ACMD23  (0x80u | 23u)  /* SET_WR_BLK_ERASE_COUNT */
+#define ACMD41  (0x80u | 41u)  /* SD_SEND_OP_COND */
+
+#define R1_IDLE         0x01u
+#define R1_ILLEGAL_CMD  0x04u
+
+#define TOKEN_START_BLOCK  0xFEu  /* Leitura e escrita de bloco único */
+#define TOKEN_START_MULTI  0xFCu  /* Escrita multibloco */
+#define TOKEN_STOP_TRAN    0xFDu
+
+#define DATA_RESP_MASK     0x1Fu
+#define DATA_RESP_ACCEPTED 0x05u
+#define DATA_RESP_CRC_ERR  0x0Bu
+
+#define BLOCK  BLOCKDEV_SECTOR_SIZE
+
+/* =============================================================================
+ * SEÇÃO 2: TRANSPORTE
+ * =============================================================================
+ */
+
+static inline void xfer(sd_stream_t *s, const uint8_t *tx, uint8_t *rx, size_t n) {
+    s->io.xfer(s->io.ctx, tx, rx, n);
+}
+
+static inline uint8_t rx_byte(sd_stream_t *s) {
+    uint8_t b;
+    s->io.xfer(s->io.ctx, NULL, &b, 1);
+    return b;
+}
+
+static inline void tx_byte(sd_stream_t *s, uint8_t b) {
+    s->io.xfer(s->io.ctx, &b, NULL, 1);
+}
+
+static inline uint32_t now_ms(sd_stream_t *s) {
+    return s->io.millis(s->io.ctx);
+}
+
+static void select_card(sd_stream_t *s) {
+    s->io.select(s->io.ctx, true);
+}
+
+/** Libera o CS e gera 8 clocks para o cartão soltar o MISO */
+static void deselect_card(sd_stream_t *s) {
+    s->io.select(s->io.ctx, false);
+    (void)rx_byte(s);
+}
+
+/** Espera o cartão sair do busy (MISO em 0xFF) */
+static bool wait_ready(sd_stream_t *s, uint32_t timeout_ms) {
+    const uint32_t t0 = now_ms(s);
+    do {
+        if (rx_byte(s) == 0xFFu) {
+            return true;
+        }
+    } while (now_ms(s) - t0 < timeout_ms);
+    return false;
+}
+
+/**
+ * @brief Envia um comando (ACMD = 0x80 | n) e devolve a resposta R1
+ *
+ * @return R1, ou 0xFF se o cartão não respondeu
+ */
+static uint8_t send_cmd(sd_stream_t *s, uint8_t cmd, uint32_t arg) {
+    if (cmd & 0x80u) {
+        cmd &= 0x7Fu;
+        const uint8_t r = send_cmd(s, CMD55, 0);
+        if (r > R1_IDLE) {
+            return r;
+        }
+    }
+    if (cmd != CMD0 && cmd != CMD12 && !wait_ready(s, SD_STREAM_WRITE_TIMEOUT_MS)) {
+        return 0xFFu;
+    }
+
+    uint8_t frame[6];
+    frame[0] = (uint8_t)(0x40u | cmd);
+    frame[1] = (uint8_t)(arg >> 24);
+    frame[2] = (uint8_t)(arg >> 16);
+    frame[3] = (uint8_t)(arg >> 8);
+    frame[4] = (uint8_t)arg;
+    frame[5] = (uint8_t)((sd_crc7(frame, 5) << 1) | 1u);
+    xfer(s, frame, NULL, sizeof frame);
+    s->stats.commands++;
+
+    if (cmd == CMD12) {
+        (void)rx_byte(s);  /* Byte de enchimento após STOP_TRANSMISSION */
+    }
+    uint8_t r = 0xFFu;
+    for (int i = 0; i < 10 && (r & 0x80u); i++) {
+        r = rx_byte(s);
+    }
+    return r;
+}
+
+/** Endereço do comando: bloco (SDHC/SDXC) ou byte (SDSC) */
+static inline uint32_t card_addr(const sd_stream_t *s, uint32_t lba) {
+    return s->high_capacity ? lba : lba * BLOCK;
+}
+
+/** Espera o token de início de bloco */
+static sd_stream_status_t wait_token(sd_stream_t *s) {
+    const uint32_t t0 = now_ms(s);
+    uint8_t t;
+    while ((t = rx_byte(s)) == 0xFFu) {
+        if (now_ms(s) - t0 >= SD_STREAM_READ_TIMEOUT_MS) {
+            return SD_STREAM_ERR_TIMEOUT;
+        }
+    }
+    return (t == TOKEN_START_BLOCK) ? SD_STREAM_OK : SD_STREAM_ERR_TOKEN;
+}
+
+/** Fase de dados de um bloco: por DMA (se disponível) ou bloqueante */
+static inline void data_start(sd_stream_t *s, const uint8_t *tx, uint8_t *rx, size_t n) {
+    if (s->io.xfer_start) {
+        s->io.xfer_start(s->io.ctx, tx, rx, n);
+    } else {
+        s->io.xfer(s->io.ctx, tx, rx, n);
+    }
+}
+
+static inline void data_wait(sd_stream_t *s) {
+    if (s->io.xfer_start) {
+        s->io.xfer_wait(s->io.ctx);
+    }
+}
+
+/** CRC16 da última fase de dados calculado pelo transporte (sniffer do DMA) */
+static inline bool data_crc16(sd_stream_t *s, uint16_t *crc) {
+    return s->crc_enabled && s->io.xfer_crc16 && s->io.xfer_crc16(s->io.ctx, crc);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: FLUXOS
+ * =============================================================================
+ */
+
+/** Fecha o fluxo aberto, se houver */
+static sd_stream_status_t stream_close(sd_stream_t *s) {
+    sd_stream_status_t st = SD_STREAM_OK;
+
+    if (s->mode == SD_STREAM_READING) {
+        /* R1 do CMD12 pode trazer OUT_OF_RANGE se o cartão já pré-buscou
+         * além do último bloco: só a falta de resposta é erro aqui */
+        if (send_cmd(s, CMD12, 0) == 0xFFu || !wait_ready(s, SD_STREAM_READ_TIMEOUT_MS)) {
+            st = SD_STREAM_ERR_TIMEOUT;
+        }
+    } else if (s->mode == SD_STREAM_WRITING) {
+        if (!wait_ready(s, SD_STREAM_WRITE_TIMEOUT_MS)) {
+            st = SD_STREAM_ERR_TIMEOUT;
+        }
+        tx_byte(s, TOKEN_STOP_TRAN);
+        (void)rx_byte(s);
+        if (!wait_ready(s, SD_STREAM_WRITE_TIMEOUT_MS)) {
+            st = SD_STREAM_ERR_TIMEOUT;
+        }
+    } else {
+        return SD_STREAM_OK;
+    }
+    s->mode = SD_STREAM_IDLE;
+    deselect_card(s);
+    return st;
+}
+
+/** Encerra o fluxo após um erro, preservando o código do erro original */
+static sd_stream_status_t stream_abort(sd_stream_t *s, sd_stream_status_t err) {
+    (void)stream_close(s);
+    return err;
+}
+
+/** Confere o CRC16 recebido de um bloco lido */
+static bool check_block(sd_stream_t *s, const uint8_t *blk, uint16_t crc_rx) {
+    if (sd_crc16(blk, BLOCK) == crc_rx) {
+        return true;
+    }
+    s->stats.crc_errors++;
+    return false;
+}
+
+static sd_stream_status_t validate(const sd_stream_t *s, const void *buf, uint32_t lba,
+                                   uint32_t count) {
+    if (!s->initialized || !buf || count == 0) {
+        return SD_STREAM_ERR_PARAM;
+    }
+    if (s->sectors && (lba >= s->sectors || count > s->sectors - lba)) {
+        return SD_STREAM_ERR_PARAM;
+    }
+    return SD_STREAM_OK;
+}
+
+sd_stream_status_t sd_stream_read(sd_stream_t *s, uint8_t *buf, uint32_t lba, uint32_t count) {
+    sd_stream_status_t st = validate(s, buf, lba, count);
+    if (st != SD_STREAM_OK) {
+        return st;
+    }
+
+    if (s->mode == SD_STREAM_READING && lba == s->next_lba) {
+        s->stats.coalesced++;
+    } else {
+        st = stream_close(s);
+        if (st != SD_STREAM_OK) {
+            return st;
+        }
+        select_card(s);
+        if (send_cmd(s, CMD18, card_addr(s, lba)) != 0) {
+            deselect_card(s);
+            return SD_STREAM_ERR_RESPONSE;
+        }
+        s->mode = SD_STREAM_READING;
+        s->next_lba = lba;
+        s->stats.read_streams++;
+    }
+
+    /* Com o sniffer, o CRC do bloco i chega junto com os dados; sem ele, o
+     * CRC do bloco i - 1 é conferido enquanto o DMA recebe o bloco i */
+    const uint8_t *prev = NULL;
+    uint16_t prev_crc = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t *blk = buf + (size_t)i * BLOCK;
+        st = wait_token(s);
+        if (st != SD_STREAM_OK) {
+            return stream_abort(s, st);
+        }
+        data_start(s, NULL, blk, BLOCK);
+        if (prev && s->crc_enabled && !check_block(s, prev, prev_crc)) {
+            data_wait(s);
+            return stream_abort(s, SD_STREAM_ERR_CRC);
+        }
+        data_wait(s);
+        uint16_t hw_crc;
+        const bool sniffed = data_crc16(s, &hw_crc);
+
+        uint8_t crc_bytes[2];
+        xfer(s, NULL, crc_bytes, 2);
+        const uint16_t crc_rx = (uint16_t)(crc_bytes[0] << 8 | crc_bytes[1]);
+        if (sniffed) {
+            if (hw_crc != crc_rx) {
+                s->stats.crc_errors++;
+                return stream_abort(s, SD_STREAM_ERR_CRC);
+            }
+            prev = NULL;
+        } else {
+            prev = blk;
+            prev_crc = crc_rx;
+        }
+        s->next_lba++;
+        s->stats.blocks_read++;
+    }
+    if (prev && s->crc_enabled && !check_block(s, prev, prev_crc)) {
+        return stream_abort(s, SD_STREAM_ERR_CRC);
+    }
+
+    /* O cartão não pode pré-buscar além do último bloco */
+    if (s->sectors && s->next_lba >= s->sectors) {
+        return stream_close(s);
+    }
+    return SD_STREAM_OK;
+}
+
+sd_stream_status_t sd_stream_write(sd_stream_t *s, const uint8_t *buf, uint32_t lba,
+                                   uint32_t count) {
+    sd_stream_status_t st = validate(s, buf, lba, count);
+    if (st != SD_STREAM_OK) {
+        return st;
+    }
+
+    if (s->mode == SD_STREAM_WRITING && lba == s->next_lba) {
+        s->stats.coalesced++;
+    } else {
+        st = stream_close(s);
+        if (st != SD_STREAM_OK) {
+            return st;
+        }
+        select_card(s);
+        /* Pré-apagamento: apenas uma dica; falha não impede a escrita */
+        const uint32_t pre = s->write_hint ? s->write_hint : count;
+        s->write_hint = 0;
+        (void)send_cmd(s, ACMD23, pre & 0x7FFFFFu);
+        if (send_cmd(s, CMD25, card_addr(s, lba)) != 0) {
+            deselect_card(s);
+            return SD_STREAM_ERR_RESPONSE;
+        }
+        s->mode = SD_STREAM_WRITING;
+        s->next_lba = lba;
+        s->stats.write_streams++;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        const uint8_t *blk = buf + (size_t)i * BLOCK;
+        /* Busy do bloco anterior (ou do comando) */
+        if (!wait_ready(s, SD_STREAM_WRITE_TIMEOUT_MS)) {
+            return stream_abort(s, SD_STREAM_ERR_TIMEOUT);
+        }
+        tx_byte(s, TOKEN_START_MULTI);
+
+        /* Sem sniffer, o CRC do bloco é calculado enquanto o DMA envia o
+         * próprio bloco; com ele, o DMA entrega o CRC pronto no fim */
+        data_start(s, blk, NULL, BLOCK);
+        uint16_t crc = 0xFFFFu;
+        if (s->crc_enabled && !s->io.xfer_crc16) {
+            crc = sd_crc16(blk, BLOCK);
+        }
+        data_wait(s);
+        if (s->crc_enabled && s->io.xfer_crc16 && !data_crc16(s, &crc)) {
+            crc = sd_crc16(blk, BLOCK);
+        }
+
+        const uint8_t crc_bytes[2] = { (uint8_t)(crc >> 8), (uint8_t)crc };
+        xfer(s, crc_bytes, NULL, 2);
+
+        const uint8_t resp = rx_byte(s) & DATA_RESP_MASK;
+        if (resp != DATA_RESP_ACCEPTED) {
+            if (resp == DATA_RESP_CRC_ERR) {
+                s->stats.crc_errors++;
+                return stream_abort(s, SD_STREAM_ERR_CRC);
+            }
+            return stream_abort(s, SD_STREAM_ERR_WRITE);
+        }
+        s->next_lba++;
+        s->stats.blocks_written++;
+    }
+    return SD_STREAM_OK;
+}
+
+void sd_stream_set_write_hint(sd_stream_t *s, uint32_t blocks) {
+    s->write_hint = blocks;
+}
+
+sd_stream_status_t sd_stream_sync(sd_stream_t *s) {
+    if (!s->initialized) {
+        return SD_STREAM_ERR_PARAM;
+    }
+    return stream_close(s);
+}
+
+void sd_stream_get_stats(const sd_stream_t *s, sd_stream_stats_t *out) {
+    *out = s->stats;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: INICIALIZAÇÃO
+ * =============================================================================
+ */
+
+/** Capacidade em setores a partir do registrador CSD (versões 1.0 e 2.0) */
+static uint32_t csd_sectors(const uint8_t *csd) {
+    if ((csd[0] >> 6) == 1u) {
+        const uint32_t c_size = ((uint32_t)(csd[7] & 0x3Fu) << 16) |
+                                ((uint32_t)csd[8] << 8) | csd[9];
+        return (c_size + 1u) * 1024u;
+    }
+    const uint32_t read_bl_len = csd[5] & 0x0Fu;
+    const uint32_t c_size = ((uint32_t)(csd[6] & 0x03u) << 10) | ((uint32_t)csd[7] << 2) |
+                            (csd[8] >> 6);
+    const uint32_t c_size_mult = ((uint32_t)(csd[9] & 0x03u) << 1) | (csd[10] >> 7);
+    const uint32_t blocks = (c_size + 1u) << (c_size_mult + 2u);
+    return (read_bl_len >= 9u) ? blocks << (read_bl_len - 9u) : blocks;
+}
+
+/** Executa a sequência de inicialização com o cartão já selecionado */
+static sd_stream_status_t init_sequence(sd_stream_t *s) {
+    uint8_t r = 0xFFu;
+    for (int i = 0; i < 10 && r != R1_IDLE; i++) {
+        r = send_cmd(s, CMD0, 0);
+    }
+    if (r != R1_IDLE) {
+        return SD_STREAM_ERR_NO_CARD;
+    }
+
+    /* CMD8: só cartões v2 respondem; v1 devolvem ILLEGAL_COMMAND */
+    bool v2 = false;
+    r = send_cmd(s, CMD8, 0x1AAu);
+    if (r == R1_IDLE) {
+        uint8_t r7[4];
+        xfer(s, NULL, r7, sizeof r7);
+        if ((r7[2] & 0x0Fu) != 0x01u || r7[3] != 0xAAu) {
+            return SD_STREAM_ERR_NO_CARD;  /* Faixa de tensão não suportada */
+        }
+        v2 = true;
+    } else if (!(r & R1_ILLEGAL_CMD)) {
+        return SD_STREAM_ERR_NO_CARD;
+    }
+
+    const uint32_t t0 = now_ms(s);
+    do {
+        r = send_cmd(s, ACMD41, v2 ? 0x40000000u : 0u);  /* HCS em cartões v2 */
+    } while (r == R1_IDLE && now_ms(s) - t0 < SD_STREAM_INIT_TIMEOUT_MS);
+    if (r != 0) {
+        return SD_STREAM_ERR_NO_CARD;
+    }
+
+    s->high_capacity = false;
+    if (v2) {
+        uint8_t ocr[4];
+        if (send_cmd(s, CMD58, 0) != 0) {
+            return SD_STREAM_ERR_RESPONSE;
+        }
+        xfer(s, NULL, ocr, sizeof ocr);
+        s->high_capacity = (ocr[0] & 0x40u) != 0;  /* CCS */
+    }
+    if (!s->high_capacity && send_cmd(s, CMD16, BLOCK) != 0) {
+        return SD_STREAM_ERR_RESPONSE;
+    }
+    if (send_cmd(s, CMD59, s->crc_enabled ? 1u : 0u) != 0) {
+        return SD_STREAM_ERR_RESPONSE;
+    }
+
+    uint8_t csd[16];
+    uint8_t crc_bytes[2];
+    if (send_cmd(s, CMD9, 0) != 0 || wait_token(s) != SD_STREAM_OK) {
+        return SD_STREAM_ERR_RESPONSE;
+    }
+    xfer(s, NULL, csd, sizeof csd);
+    xfer(s, NULL, crc_bytes, sizeof crc_bytes);
+    if (s->crc_enabled && sd_crc16(csd, sizeof csd) != (uint16_t)(crc_bytes[0] << 8 | crc_bytes[1])) {
+        s->stats.crc_errors++;
+        return SD_STREAM_ERR_CRC;
+    }
+    s->sectors = csd_sectors(csd);
+    return SD_STREAM_OK;
+}
+
+sd_stream_status_t sd_stream_init(sd_stream_t *s, const sd_stream_io_t *io,
+                                  uint32_t clock_hz, bool crc_enabled) {
+    if (!s || !io || !io->select || !io->xfer || !io->set_clock || !io->millis ||
+        (io->xfer_start && !io->xfer_wait) || (io->xfer_crc16 && !io->xfer_start)) {
+        return SD_STREAM_ERR_PARAM;
+    }
+    memset(s, 0, sizeof *s);
+    s->io = *io;
+    s->clock_hz = clock_hz;
+    s->crc_enabled = crc_enabled;
+
+    /* >= 74 clocks com CS em nível alto para o cartão entrar em modo nativo */
+    s->io.set_clock(s->io.ctx, SD_STREAM_INIT_HZ);
+    s->io.select(s->io.ctx, false);
+    for (int i = 0; i < 10; i++) {
+        (void)rx_byte(s);
+    }
+
+    select_card(s);
+    const sd_stream_status_t st = init_sequence(s);
+    deselect_card(s);
+    if (st != SD_STREAM_OK) {
+        return st;
+    }
+    s->io.set_clock(s->io.ctx, clock_hz);
+    s->initialized = true;
+    return SD_STREAM_OK;
+}
+
+/* =============================================================================
+ * SEÇÃO 5: ADAPTADOR blockdev_t
+ * =============================================================================
+ */
+
+static blockdev_result_t to_blockdev(sd_stream_status_t st) {
+    switch (st) {
+    case SD_STREAM_OK:        return BLOCKDEV_OK;
+    case SD_STREAM_ERR_PARAM: return BLOCKDEV_PARERR;
+    case SD_STREAM_ERR_NO_CARD: return BLOCKDEV_NOTRDY;
+    default:                  return BLOCKDEV_ERROR;
+    }
+}
+
+static blockdev_result_t bd_read(void *ctx, uint8_t *buf, uint32_t lba, uint32_t count) {
+    return to_blockdev(sd_stream_read((sd_stream_t *)ctx, buf, lba, count));
+}
+
+static blockdev_result_t bd_write(void *ctx, const uint8_t *buf, uint32_t lba, uint32_t count) {
+    return to_blockdev(sd_stream_write((sd_stream_t *)ctx, buf, lba, count));
+}
+
+static blockdev_result_t bd_ioctl(void *ctx, uint8_t cmd, void *buff) {
+    sd_stream_t *s = (sd_stream_t *)ctx;
+    if (!s->initialized) {
+        return BLOCKDEV_NOTRDY;
+    }
+    switch (cmd) {
+    case BLOCKDEV_CTRL_SYNC:
+        return to_blockdev(sd_stream_sync(s));
+    case BLOCKDEV_GET_SECTOR_COUNT:
+        *(uint32_t *)buff = s->sectors;
+        return BLOCKDEV_OK;
+    case BLOCKDEV_GET_SECTOR_SIZE:
+        *(uint16_t *)buff = (uint16_t)BLOCK;
+        return BLOCKDEV_OK;
+    case BLOCKDEV_GET_BLOCK_SIZE:
+        *(uint32_t *)buff = 1u;  /* Bloco de apagamento desconhecido (convenção do FatFS) */
+        return BLOCKDEV_OK;
+    default:
+        return BLOCKDEV_PARERR;
+    }
+}
+
+void sd_stream_blockdev(sd_stream_t *s, blockdev_t *dev) {
+    dev->ctx = s;
+    dev->read = bd_read;
+    dev->write = bd_write;
+    dev->ioctl = bd_ioctl;
+}
@@ -0,0 +1,227 @@
+/**
+ * =============================================================================
+ * @file    sd_stream.h
+ * @brief   Cartão SD em modo SPI com leitura/escrita multibloco contínua
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Com comandos de bloco único (CMD17/CMD24) cada setor de 512 bytes
+ *          paga um comando, a espera do token e o CRC. Este driver mantém
+ *          um fluxo multibloco aberto entre chamadas:
+ *
+ *          ┌──────────────────────────────────────────────────────────────┐
+ *          │ read(lba = L, n)     → CMD18(L), lê n blocos, fluxo ABERTO   │
+ *          │ read(lba = L + n, m) → continua o mesmo CMD18 (coalescido)   │
+ *          │ write(lba = W, n)    → CMD12 encerra a leitura;              │
+ *          │                        [ACMD23(dica)] CMD25(W), n blocos     │
+ *          │ write(lba = W + n, m)→ continua o mesmo CMD25 (coalescido)   │
+ *          │ sync()               → token de parada 0xFD, espera o busy   │
+ *          └──────────────────────────────────────────────────────────────┘
+ *
+ *          Chamadas consecutivas de disk_read/disk_write do FatFS viram
+ *          portanto uma única transação enquanto os endereços forem
+ *          contíguos. CTRL_SYNC (ou qualquer acesso não contíguo) fecha o
+ *          fluxo.
+ *
+ *          FASE DE DADOS POR DMA:
+ *          Se o transporte oferecer xfer_start/xfer_wait, os 512 bytes de
+ *          cada bloco vão por DMA enquanto a CPU calcula o CRC16: na escrita,
+ *          o CRC do próprio bloco (enviado logo após os dados); na leitura,
+ *          o CRC do bloco anterior. Se o transporte oferecer também
+ *          xfer_crc16 (sniffer do DMA no RP2040/RP2350), o CRC16 sai pronto
+ *          do próprio DMA e a CPU não toca nos dados. Os CRCs em software
+ *          vêm do módulo sd_crc (slice-by-8).
+ *
+ *          O transporte (sd_stream_io_t) isola o protocolo do hardware; a
+ *          implementação para o SPI + DMA do RP2040/RP2350 está em
+ *          sd_stream_pico.h.
+ * =============================================================================
+ */
+
+#ifndef SD_STREAM_H
+#define SD_STREAM_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "blockdev.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** Clock SPI durante a inicialização (a especificação exige <= 400 kHz) */
+#ifndef SD_STREAM_INIT_HZ
+#define SD_STREAM_INIT_HZ 400000u
+#endif
+
+/** Timeouts em ms (valores máximos da especificação simplificada) */
+#define SD_STREAM_INIT_TIMEOUT_MS  1000u
+#define SD_STREAM_READ_TIMEOUT_MS  100u
+#define SD_STREAM_WRITE_TIMEOUT_MS 500u
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct sd_stream_io_t
+ * @brief Transporte SPI usado pelo driver
+ *
+ * @var sd_stream_io_t::select     Ativa (true) ou libera (false) o chip select
+ * @var sd_stream_io_t::xfer       Transferência full-duplex bloqueante; tx NULL
+ *                                 envia 0xFF, rx NULL descarta o recebido
+ * @var sd_stream_io_t::xfer_start (Opcional) inicia a mesma transferência por DMA
+ * @var sd_stream_io_t::xfer_wait  (Opcional) espera o fim de xfer_start
+ * @var sd_stream_io_t::xfer_crc16 (Opcional, exige xfer_start) CRC16 dos dados
+ *                                 da última xfer_start; false se indisponível
+ * @var sd_stream_io_t::set_clock  Ajusta o clock SPI em Hz
+ * @var sd_stream_io_t::millis     Relógio em ms para os timeouts
+ */
+typedef struct {
+    void *ctx;
+    void (*select)(void *ctx, bool on);
+    void (*xfer)(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n);
+    void (*xfer_start)(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n);
+    void (*xfer_wait)(void *ctx);
+    bool (*xfer_crc16)(void *ctx, uint16_t *crc);
+    void (*set_clock)(void *ctx, uint32_t hz);
+    uint32_t (*millis)(void *ctx);
+} sd_stream_io_t;
+
+/**
+ * @enum sd_stream_status_t
+ * @brief Resultado das operações do driver
+ */
+typedef enum {
+    SD_STREAM_OK = 0,
+    SD_STREAM_ERR_PARAM,     /**< Parâmetro inválido ou cartão não inicializado */
+    SD_STREAM_ERR_TIMEOUT,   /**< Cartão não respondeu / busy além do limite */
+    SD_STREAM_ERR_RESPONSE,  /**< Resposta R1 com bit de erro */
+    SD_STREAM_ERR_TOKEN,     /**< Token de erro de dados na leitura */
+    SD_STREAM_ERR_CRC,       /**< CRC16 de dados incorreto (leitura ou escrita) */
+    SD_STREAM_ERR_WRITE,     /**< Cartão rejeitou o bloco escrito */
+    SD_STREAM_ERR_NO_CARD,   /**< Cartão ausente ou não suportado */
+} sd_stream_status_t;
+
+/** Estado do fluxo multibloco */
+typedef enum {
+    SD_STREAM_IDLE = 0,
+    SD_STREAM_READING,       /**< CMD18 em andamento */
+    SD_STREAM_WRITING,       /**< CMD25 em andamento */
+} sd_stream_mode_t;
+
+/**
+ * @struct sd_stream_stats_t
+ * @brief Contadores de desempenho
+ *
+ * @var sd_stream_stats_t::commands        Comandos enviados (inclui CMD12/ACMD23)
+ * @var sd_stream_stats_t::read_streams    Fluxos CMD18 abertos
+ * @var sd_stream_stats_t::write_streams   Fluxos CMD25 abertos
+ * @var sd_stream_stats_t::coalesced       Chamadas que continuaram um fluxo aberto
+ * @var sd_stream_stats_t::blocks_read     Blocos lidos
+ * @var sd_stream_stats_t::blocks_written  Blocos escritos
+ * @var sd_stream_stats_t::crc_errors      Blocos com CRC16 incorreto
+ */
+typedef struct {
+    uint32_t commands;
+    uint32_t read_streams;
+    uint32_t write_streams;
+    uint32_t coalesced;
+    uint32_t blocks_read;
+    uint32_t blocks_written;
+    uint32_t crc_errors;
+} sd_stream_stats_t;
+
+/**
+ * @struct sd_stream_t
+ * @brief Estado do driver (instância estática, sem malloc)
+ */
+typedef struct {
+    sd_stream_io_t io;
+    uint32_t clock_hz;        /**< Clock após a inicialização */
+    bool crc_enabled;         /**< CMD59: CRC de dados verificado nos dois sentidos */
+    bool initialized;
+    bool high_capacity;       /**< SDHC/SDXC: endereço em blocos; senão em bytes */
+    uint32_t sectors;         /**< Capacidade (lida do CSD) */
+
+    sd_stream_mode_t mode;
+    uint32_t next_lba;        /**< Próximo bloco do fluxo aberto */
+    uint32_t write_hint;      /**< Blocos a pré-apagar no próximo CMD25 (ACMD23) */
+
+    sd_stream_stats_t stats;
+} sd_stream_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o cartão (CMD0, CMD8, ACMD41, CMD58, CMD9 e CMD59)
+ *
+ * @param s           Instância
+ * @param io          Transporte
+ * @param clock_hz    Clock SPI após a inicialização (ex.: 25 MHz)
+ * @param crc_enabled true liga a verificação de CRC (CMD59)
+ */
+sd_stream_status_t sd_stream_init(sd_stream_t *s, const sd_stream_io_t *io,
+                                  uint32_t clock_hz, bool crc_enabled);
+
+/**
+ * @brief Lê `count` blocos, continuando o fluxo CMD18 se `lba` for contíguo
+ */
+sd_stream_status_t sd_stream_read(sd_stream_t *s, uint8_t *buf, uint32_t lba, uint32_t count);
+
+/**
+ * @brief Grava `count` blocos, continuando o fluxo CMD25 se `lba` for contíguo
+ *
+ * @details Os dados só estão garantidos no cartão após sd_stream_sync().
+ */
+sd_stream_status_t sd_stream_write(sd_stream_t *s, const uint8_t *buf, uint32_t lba,
+                                   uint32_t count);
+
+/**
+ * @brief Define quantos blocos pré-apagar (ACMD23) ao abrir o próximo CMD25
+ *
+ * @details Útil quando a aplicação sabe o tamanho de uma gravação sequencial
+ *          (ex.: arquivo pré-alocado com f_expand). A dica vale para um único
+ *          fluxo. Blocos pré-apagados e não escritos ficam com conteúdo
+ *          indefinido, portanto a dica não deve ultrapassar a área que de
+ *          fato será gravada. Sem dica, o pré-apagamento cobre apenas os
+ *          blocos da chamada que abre o fluxo.
+ */
+void sd_stream_set_write_hint(sd_stream_t *s, uint32_t blocks);
+
+/**
+ * @brief Fecha o fluxo aberto (CMD12 ou token de parada + espera do busy)
+ */
+sd_stream_status_t sd_stream_sync(sd_stream_t *s);
+
+/** Copia os contadores */
+void sd_stream_get_stats(const sd_stream_t *s, sd_stream_stats_t *out);
+
+/**
+ * @brief Preenche um blockdev_t que encaminha para o driver
+ *
+ * @details read/write usam os fluxos coalescidos; ioctl atende CTRL_SYNC,
+ *          GET_SECTOR_COUNT, GET_SECTOR_SIZE e GET_BLOCK_SIZE.
+ */
+void sd_stream_blockdev(sd_stream_t *s, blockdev_t *dev);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SD_STREAM_H */
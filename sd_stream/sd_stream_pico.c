@@ -0,0 +1,144 @@
+/**
+ * =============================================================================
+ * @file    sd_stream_pico.c
+ * @brief   Implementação do transporte SPI + DMA (RP2040/RP2350)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ * =============================================================================
+ */
+
+#include "sd_stream_pico.h"
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+
+#include "hardware/dma.h"
+#include "sd_crc.h"
+#include "hardware/gpio.h"
+#include "pico/time.h"
+
+/* =============================================================================
+ * SEÇÃO 1: OPERAÇÕES BLOQUEANTES
+ * =============================================================================
+ */
+
+static void pico_select(void *ctx, bool on) {
+    const sd_stream_pico_t *p = (const sd_stream_pico_t *)ctx;
+    gpio_put(p->cs_pin, !on);  /* CS ativo em nível baixo */
+}
+
+static void pico_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n) {
+    const sd_stream_pico_t *p = (const sd_stream_pico_t *)ctx;
+    if (tx && rx) {
+        spi_write_read_blocking(p->spi, tx, rx, n);
+    } else if (tx) {
+        spi_write_blocking(p->spi, tx, n);
+    } else if (rx) {
+        spi_read_blocking(p->spi, 0xFF, rx, n);
+    } else {
+        uint8_t dummy;
+        for (size_t i = 0; i < n; i++) {
+            spi_read_blocking(p->spi, 0xFF, &dummy, 1);
+        }
+    }
+}
+
+static void pico_set_clock(void *ctx, uint32_t hz) {
+    const sd_stream_pico_t *p = (const sd_stream_pico_t *)ctx;
+    spi_set_baudrate(p->spi, hz);
+}
+
+static uint32_t pico_millis(void *ctx) {
+    (void)ctx;
+    return to_ms_since_boot(get_absolute_time());
+}
+
+/* =============================================================================
+ * SEÇÃO 2: FASE DE DADOS POR DMA
+ * =============================================================================
+ */
+
+/** Fonte constante para leituras e destino descartável para escritas */
+static const uint8_t fill_ff = 0xFF;
+static uint8_t sink;
+
+static void pico_xfer_start(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n) {
+    sd_stream_pico_t *p = (sd_stream_pico_t *)ctx;
+    volatile void *dr = &spi_get_hw(p->spi)->dr;
+
+    dma_channel_config c = dma_channel_get_default_config((uint)p->dma_rx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(p->spi, false));
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, rx != NULL);
+    dma_channel_configure((uint)p->dma_rx, &c, rx ? (void *)rx : (void *)&sink, dr, n, false);
+
+    c = dma_channel_get_default_config((uint)p->dma_tx);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_dreq(&c, spi_get_dreq(p->spi, true));
+    channel_config_set_read_increment(&c, tx != NULL);
+    channel_config_set_write_increment(&c, false);
+    dma_channel_configure((uint)p->dma_tx, &c, dr, tx ? (const void *)tx : (const void *)&fill_ff,
+                          n, false);
+
+    /* O sniffer acompanha o canal que carrega os dados do bloco */
+    p->sniffing = (tx != NULL) || (rx != NULL);
+    if (p->sniffing) {
+        sd_crc_sniff_start((unsigned)(tx ? p->dma_tx : p->dma_rx));
+    }
+
+    /* Dispara os dois juntos: RX precisa estar armado antes do primeiro byte */
+    dma_start_channel_mask((1u << (uint)p->dma_tx) | (1u << (uint)p->dma_rx));
+}
+
+static void pico_xfer_wait(void *ctx) {
+    const sd_stream_pico_t *p = (const sd_stream_pico_t *)ctx;
+    /* RX termina por último: todos os bytes já saíram e voltaram */
+    dma_channel_wait_for_finish_blocking((uint)p->dma_rx);
+}
+
+static bool pico_xfer_crc16(void *ctx, uint16_t *crc) {
+    sd_stream_pico_t *p = (sd_stream_pico_t *)ctx;
+    if (!p->sniffing) {
+        return false;
+    }
+    *crc = sd_crc_sniff_result();
+    sd_crc_sniff_stop();
+    p->sniffing = false;
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: INICIALIZAÇÃO
+ * =============================================================================
+ */
+
+void sd_stream_pico_init(sd_stream_pico_t *p, spi_inst_t *spi, uint cs_pin, sd_stream_io_t *io) {
+    p->spi = spi;
+    p->cs_pin = cs_pin;
+    p->dma_tx = dma_claim_unused_channel(true);
+    p->dma_rx = dma_claim_unused_channel(true);
+    p->sniffing = false;
+    sd_crc_init();
+
+    gpio_init(cs_pin);
+    gpio_put(cs_pin, 1);
+    gpio_set_dir(cs_pin, GPIO_OUT);
+    spi_init(spi, SD_STREAM_INIT_HZ);
+    spi_set_format(spi, 8, SPI_CPOL_0, SPI_CPHA_0, SPI_MSB_FIRST);
+
+    io->ctx = p;
+    io->select = pico_select;
+    io->xfer = pico_xfer;
+    io->xfer_start = pico_xfer_start;
+    io->xfer_wait = pico_xfer_wait;
+    io->xfer_crc16 = pico_xfer_crc16;
+    io->set_clock = pico_set_clock;
+    io->millis = pico_millis;
+}
+
+#endif /* PICO_ON_DEVICE */
@@ -0,0 +1,66 @@
+/**
+ * =============================================================================
+ * @file    sd_stream_pico.h
+ * @brief   Transporte SPI + DMA do RP2040/RP2350 para o sd_stream
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Dois canais de DMA por transferência de dados: TX lê o buffer (ou
+ *          um byte 0xFF fixo, sem incremento) e escreve no SSPDR; RX lê o
+ *          SSPDR e escreve no buffer (ou num byte descartável). Os dois usam o
+ *          DREQ do próprio SPI, então o FIFO nunca transborda.
+ *
+ *          Comandos, tokens e respostas (poucos bytes) usam
+ *          spi_write_read_blocking(); apenas os 512 bytes de cada bloco vão
+ *          por DMA. O sniffer do DMA acompanha o canal do bloco e entrega o
+ *          CRC16 ao fim da transferência (xfer_crc16), sem custo de CPU.
+ * =============================================================================
+ */
+
+#ifndef SD_STREAM_PICO_H
+#define SD_STREAM_PICO_H
+
+#include "sd_stream.h"
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+
+#include "hardware/spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @struct sd_stream_pico_t
+ * @brief Contexto do transporte (pinos já configurados para a função SPI)
+ */
+typedef struct {
+    spi_inst_t *spi;
+    uint cs_pin;
+    int dma_tx;
+    int dma_rx;
+    bool sniffing;    /**< Sniffer do DMA armado pela última xfer_start */
+} sd_stream_pico_t;
+
+/**
+ * @brief Configura o CS, reivindica os canais de DMA e preenche o transporte
+ *
+ * @param p      Contexto
+ * @param spi    spi0 ou spi1 (pinos SCK/MOSI/MISO já em GPIO_FUNC_SPI)
+ * @param cs_pin GPIO do chip select
+ * @param io     Transporte a preencher para sd_stream_init()
+ */
+void sd_stream_pico_init(sd_stream_pico_t *p, spi_inst_t *spi, uint cs_pin, sd_stream_io_t *io);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PICO_ON_DEVICE */
+
+#endif /* SD_STREAM_PICO_H */
@@ -0,0 +1,747 @@
+/**
+ * =============================================================================
+ * @file    sd_stream_sim.c
+ * @brief   (Host) Teste do sd_stream contra um cartão SD simulado byte a byte
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details O transporte (sd_stream_io_t) é ligado a um cartão simulado no
+ *          nível do barramento SPI: cada byte enviado pelo driver passa pela
+ *          máquina de estados do cartão (comandos com CRC7, respostas R1/R3/
+ *          R7, tokens de dados, CRC16, resposta de dados, busy, CMD12 e token
+ *          de parada). O cartão acusa violações de protocolo: comando ou token
+ *          com o cartão ocupado, CRC7 errado, CMD25 sem ACMD23, CS liberado
+ *          com um fluxo aberto, xfer com DMA pendente.
+ *
+ *          Os cenários rodam com três transportes (bloqueante, DMA e DMA com
+ *          CRC do sniffer), em cartão SDHC, e com o bloqueante em SDSC
+ *          (endereço em bytes) e sem CRC:
+ *
+ *          1. Inicialização: capacidade lida do CSD.
+ *          2. Sequencial: leituras e escritas contíguas viram um CMD18 e um
+ *             CMD25 (chamadas coalescidas).
+ *          3. Dica ACMD23: vale para um fluxo; sem dica, o tamanho da
+ *             primeira chamada.
+ *          4. Misto: leitura → escrita → leitura fecha cada fluxo (CMD12,
+ *             token de parada).
+ *          5. Aleatório: leituras, escritas e syncs contra uma cópia do disco.
+ *          6. Fim do cartão: lê os últimos blocos e fecha o fluxo; pedidos
+ *             além do fim dão parâmetro inválido.
+ *          7. Erros: CRC16 errado na leitura (bloco do meio e último),
+ *             token de erro, CRC recusado e bloco rejeitado na escrita.
+ *          8. Adaptador blockdev_t: CTRL_SYNC e GET_SECTOR_COUNT.
+ *
+ *          Uso: sd_stream_sim
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "sd_stream.h"
+#include "sd_crc.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NS       4096u          /* Setores do cartão simulado */
+#define BLOCK    BLOCKDEV_SECTOR_SIZE
+#define QLEN     1024u          /* Fila de saída do cartão (potência de 2) */
+#define BUSY_BLK 16u            /* Bytes de busy após cada bloco escrito */
+#define BUSY_END 24u            /* Bytes de busy após o token de parada */
+#define NONE     0xFFFFFFFFu    /* Sem injeção de erro */
+
+/* =============================================================================
+ * SEÇÃO 1: CARTÃO SIMULADO
+ * =============================================================================
+ */
+
+typedef enum { CARD_IDLE, CARD_READ, CARD_WRITE } card_mode_t;
+
+typedef struct {
+    bool high_capacity;           /**< SDHC (bloco) ou SDSC (byte) */
+    bool cs;
+    bool crc_on;                  /**< CMD59 */
+    bool idle;                    /**< R1 in_idle_state */
+    bool app;                     /**< Último comando foi CMD55 */
+    unsigned acmd41_left;         /**< ACMD41 que ainda respondem "idle" */
+
+    uint8_t q[QLEN];              /**< Bytes que o cartão vai enviar */
+    unsigned qh, qt;
+    unsigned busy;                /**< Bytes 0x00 restantes */
+
+    uint8_t cmd[6];
+    unsigned cmd_n;
+
+    card_mode_t mode;
+    uint32_t lba;                 /**< Próximo bloco do fluxo */
+    bool out_of_range;            /**< Pré-busca passou do fim */
+    bool in_block;                /**< Recebendo um bloco do CMD25 */
+    uint8_t blk[BLOCK + 2];
+    unsigned blk_n;
+    bool hint_pending;            /**< ACMD23 logo antes do CMD25 */
+
+    /* Injeção de erros (um bloco, consumida ao ocorrer) */
+    uint32_t bad_read_crc;
+    uint32_t error_token;
+    uint32_t bad_write_crc;
+    uint32_t reject;
+
+    /* Contadores observados no barramento */
+    uint64_t bytes;
+    unsigned cmd18, cmd25, cmd12, acmd23, stop_tokens, violations;
+    uint32_t hint;                /**< Argumento do último ACMD23 */
+} card_t;
+
+static card_t card;
+static uint8_t disk[NS][BLOCK];
+static uint8_t shadow[NS][BLOCK];
+
+static void violation(const char *what) {
+    if (card.violations++ < 8u) {
+        printf("FALHA: protocolo: %s\n", what);
+    }
+    failures++;
+}
+
+static void push(uint8_t b) {
+    card.q[card.qt++ % QLEN] = b;
+}
+
+static void push_crc16(const uint8_t *p, size_t n, bool corrupt) {
+    uint16_t crc = sd_crc16_ref(p, n);
+    if (corrupt) {
+        crc ^= 0x0100u;
+    }
+    push((uint8_t)(crc >> 8));
+    push((uint8_t)crc);
+}
+
+/** CSD v2 (SDHC) ou v1 (SDSC, READ_BL_LEN = 9) com NS setores */
+static void push_csd(void) {
+    uint8_t csd[16] = { 0 };
+    if (card.high_capacity) {
+        const uint32_t c_size = NS / 1024u - 1u;
+        csd[0] = 0x40u;
+        csd[7] = (uint8_t)((c_size >> 16) & 0x3Fu);
+        csd[8] = (uint8_t)(c_size >> 8);
+        csd[9] = (uint8_t)c_size;
+    } else {
+        const uint32_t c_size = NS / 4u - 1u;  /* C_SIZE_MULT = 0: x4 */
+        csd[5] = 0x09u;
+        csd[6] = (uint8_t)((c_size >> 10) & 0x03u);
+        csd[7] = (uint8_t)(c_size >> 2);
+        csd[8] = (uint8_t)((c_size & 0x03u) << 6);
+    }
+    push(0xFFu);
+    push(0xFEu);
+    for (unsigned i = 0; i < sizeof csd; i++) {
+        push(csd[i]);
+    }
+    push_crc16(csd, sizeof csd, false);
+}
+
+/** Próximo bloco do CMD18 (gerado só quando o driver continua a clocar) */
+static void push_read_block(void) {
+    if (card.lba >= NS) {
+        card.out_of_range = true;   /* Cartão real: OUT_OF_RANGE, sem token */
+        push(0xFFu);
+        return;
+    }
+    push(0xFFu);
+    if (card.lba == card.error_token) {
+        card.error_token = NONE;
+        push(0x08u);                /* Token de erro: out of range */
+        card.lba++;
+        return;
+    }
+    push(0xFEu);
+    for (unsigned i = 0; i < BLOCK; i++) {
+        push(disk[card.lba][i]);
+    }
+    const bool corrupt = (card.lba == card.bad_read_crc);
+    if (corrupt) {
+        card.bad_read_crc = NONE;
+    }
+    push_crc16(disk[card.lba], BLOCK, corrupt);
+    card.lba++;
+}
+
+static uint32_t cmd_block(uint32_t arg) {
+    if (card.high_capacity) {
+        return arg;
+    }
+    if (arg % BLOCK) {
+        violation("endereço SDSC não alinhado a 512");
+    }
+    return arg / BLOCK;
+}
+
+static void do_cmd(void) {
+    const uint8_t c = card.cmd[0] & 0x3Fu;
+    const uint32_t arg = (uint32_t)card.cmd[1] << 24 | (uint32_t)card.cmd[2] << 16 |
+                         (uint32_t)card.cmd[3] << 8 | card.cmd[4];
+    if (card.cmd[5] != (uint8_t)((sd_crc7_ref(card.cmd, 5) << 1) | 1u)) {
+        violation("CRC7 do comando");
+    }
+    const bool app = card.app;
+    card.app = false;
+    const bool hint = card.hint_pending;
+    card.hint_pending = false;
+
+    if (c == 12u) {
+        if (card.mode != CARD_READ) {
+            violation("CMD12 fora do CMD18");
+        }
+        card.cmd12++;
+        card.mode = CARD_IDLE;
+        card.qh = card.qt;          /* Descarta a pré-busca */
+        push(0xFFu);                /* Byte de enchimento */
+        push(card.out_of_range ? 0x40u : 0x00u);
+        card.busy = 4u;
+        return;
+    }
+    if (card.mode != CARD_IDLE) {
+        violation("comando com fluxo aberto");
+    }
+
+    const uint8_t r1 = card.idle ? 0x01u : 0x00u;
+    push(0xFFu);                    /* NCR */
+    switch (c) {
+    case 0u:
+        card.idle = true;
+        push(0x01u);
+        break;
+    case 8u:
+        push(0x01u);
+        push(0x00u);
+        push(0x00u);
+        push((uint8_t)((arg >> 8) & 0x0Fu));
+        push((uint8_t)arg);
+        break;
+    case 55u:
+        card.app = true;
+        push(r1);
+        break;
+    case 41u:
+        if (!app) {
+            violation("CMD41 sem CMD55");
+        }
+        if (card.acmd41_left) {
+            card.acmd41_left--;
+        } else {
+            card.idle = false;
+        }
+        push(card.idle ? 0x01u : 0x00u);
+        break;
+    case 58u:
+        push(r1);
+        push(card.high_capacity ? 0xC0u : 0x80u);
+        push(0xFFu);
+        push(0x80u);
+        push(0x00u);
+        break;
+    case 16u:
+        if (arg != BLOCK) {
+            violation("CMD16 com bloco diferente de 512");
+        }
+        push(r1);
+        break;
+    case 59u:
+        card.crc_on = (arg & 1u) != 0;
+        push(r1);
+        break;
+    case 9u:
+        push(r1);
+        push_csd();
+        break;
+    case 23u:
+        if (!app) {
+            violation("CMD23 sem CMD55");
+        }
+        card.acmd23++;
+        card.hint = arg;
+        card.hint_pending = true;
+        push(r1);
+        break;
+    case 18u:
+        push(r1);
+        card.mode = CARD_READ;
+        card.lba = cmd_block(arg);
+        card.out_of_range = false;
+        card.cmd18++;
+        break;
+    case 25u:
+        if (!hint) {
+            violation("CMD25 sem ACMD23");
+        }
+        push(r1);
+        card.mode = CARD_WRITE;
+        card.lba = cmd_block(arg);
+        card.in_block = false;
+        card.cmd25++;
+        break;
+    default:
+        violation("comando desconhecido");
+        push(0x04u);
+        break;
+    }
+}
+
+/** Fim de um bloco do CMD25: resposta de dados e busy */
+static void end_write_block(void) {
+    card.in_block = false;
+    const uint16_t crc_rx = (uint16_t)(card.blk[BLOCK] << 8 | card.blk[BLOCK + 1]);
+    bool bad_crc = card.crc_on && crc_rx != sd_crc16_ref(card.blk, BLOCK);
+    if (card.lba == card.bad_write_crc) {
+        card.bad_write_crc = NONE;
+        bad_crc = true;
+    }
+    if (bad_crc) {
+        push(0xEBu);                /* xxx0 101 1: CRC recusado */
+        return;
+    }
+    if (card.lba >= NS || card.lba == card.reject) {
+        card.reject = NONE;
+        push(0xEDu);                /* xxx0 110 1: erro de escrita */
+        return;
+    }
+    memcpy(disk[card.lba++], card.blk, BLOCK);
+    push(0xE5u);                    /* xxx0 010 1: aceito */
+    card.busy = BUSY_BLK;
+}
+
+/** Um byte full-duplex: devolve o que o cartão coloca no MISO */
+static uint8_t card_byte(uint8_t in) {
+    card.bytes++;
+    if (!card.cs) {
+        return 0xFFu;
+    }
+
+    uint8_t out = 0xFFu;
+    bool busy_now = false;
+    if (card.qh != card.qt) {
+        out = card.q[card.qh++ % QLEN];
+    } else if (card.busy) {
+        card.busy--;
+        busy_now = true;
+        out = 0x00u;
+    } else if (card.mode == CARD_READ && card.cmd_n == 0) {
+        push_read_block();
+        out = card.q[card.qh++ % QLEN];
+    }
+
+    if (card.cmd_n) {
+        card.cmd[card.cmd_n++] = in;
+        if (card.cmd_n == sizeof card.cmd) {
+            card.cmd_n = 0;
+            do_cmd();
+        }
+        return out;
+    }
+    if (card.mode == CARD_WRITE) {
+        if (card.in_block) {
+            card.blk[card.blk_n++] = in;
+            if (card.blk_n == sizeof card.blk) {
+                end_write_block();
+            }
+        } else if (in == 0xFFu) {
+            /* Espera */
+        } else if (busy_now) {
+            violation("token com o cartão ocupado");
+        } else if (in == 0xFCu) {
+            card.in_block = true;
+            card.blk_n = 0;
+        } else if (in == 0xFDu) {
+            card.stop_tokens++;
+            card.mode = CARD_IDLE;
+            push(0xFFu);
+            card.busy = BUSY_END;
+        } else {
+            violation("byte inesperado no CMD25");
+        }
+        return out;
+    }
+    if ((in & 0xC0u) == 0x40u) {
+        if (busy_now) {
+            violation("comando com o cartão ocupado");
+        }
+        card.cmd[0] = in;
+        card.cmd_n = 1;
+    }
+    return out;
+}
+
+static void card_reset(bool high_capacity) {
+    memset(&card, 0, sizeof card);
+    card.high_capacity = high_capacity;
+    card.acmd41_left = 3u;
+    card.bad_read_crc = card.error_token = card.bad_write_crc = card.reject = NONE;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: TRANSPORTE (stub do SPI + DMA + sniffer)
+ * =============================================================================
+ */
+
+typedef enum { BUS_BLOCKING, BUS_DMA, BUS_DMA_SNIFF } bus_kind_t;
+
+static const char *const bus_name[] = { "bloqueante", "DMA", "DMA + sniffer" };
+
+typedef struct {
+    const uint8_t *tx;
+    uint8_t *rx;
+    size_t n;
+    bool pending;
+    bool sniff_ok;
+    uint16_t sniff;
+} bus_t;
+
+static bus_t bus;
+
+static void io_select(void *ctx, bool on) {
+    (void)ctx;
+    if (!on && card.mode != CARD_IDLE) {
+        violation("CS liberado com fluxo aberto");
+    }
+    card.cs = on;
+}
+
+static void io_xfer(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n) {
+    (void)ctx;
+    if (bus.pending) {
+        violation("xfer com DMA pendente");
+    }
+    for (size_t i = 0; i < n; i++) {
+        const uint8_t b = card_byte(tx ? tx[i] : 0xFFu);
+        if (rx) {
+            rx[i] = b;
+        }
+    }
+}
+
+/** O "DMA" só move os bytes em xfer_wait: o driver não pode ler antes */
+static void io_xfer_start(void *ctx, const uint8_t *tx, uint8_t *rx, size_t n) {
+    (void)ctx;
+    if (bus.pending) {
+        violation("xfer_start com DMA pendente");
+    }
+    bus.tx = tx;
+    bus.rx = rx;
+    bus.n = n;
+    bus.pending = true;
+    bus.sniff_ok = false;
+}
+
+static void io_xfer_wait(void *ctx) {
+    if (!bus.pending) {
+        violation("xfer_wait sem xfer_start");
+        return;
+    }
+    bus.pending = false;
+    io_xfer(ctx, bus.tx, bus.rx, bus.n);
+    bus.sniff = sd_crc16_ref(bus.tx ? bus.tx : bus.rx, bus.n);
+    bus.sniff_ok = true;
+}
+
+static bool io_xfer_crc16(void *ctx, uint16_t *crc) {
+    (void)ctx;
+    if (!bus.sniff_ok) {
+        return false;
+    }
+    bus.sniff_ok = false;
+    *crc = bus.sniff;
+    return true;
+}
+
+static void io_set_clock(void *ctx, uint32_t hz) {
+    (void)ctx;
+    (void)hz;
+}
+
+/** Tempo virtual: 25 MHz / 8 bits = 3125 bytes por ms */
+static uint32_t io_millis(void *ctx) {
+    (void)ctx;
+    return (uint32_t)(card.bytes / 3125u);
+}
+
+static sd_stream_io_t make_io(bus_kind_t kind) {
+    sd_stream_io_t io = {
+        .ctx = NULL,
+        .select = io_select,
+        .xfer = io_xfer,
+        .set_clock = io_set_clock,
+        .millis = io_millis,
+    };
+    if (kind != BUS_BLOCKING) {
+        io.xfer_start = io_xfer_start;
+        io.xfer_wait = io_xfer_wait;
+    }
+    if (kind == BUS_DMA_SNIFF) {
+        io.xfer_crc16 = io_xfer_crc16;
+    }
+    return io;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: CENÁRIOS
+ * =============================================================================
+ */
+
+static sd_stream_t sd;
+static uint8_t buf[32 * BLOCK];
+
+static void fill_random(uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        p[i] = (uint8_t)rand();
+    }
+}
+
+static bool disk_matches(void) {
+    return memcmp(disk, shadow, sizeof disk) == 0;
+}
+
+/** Lê e confere contra a cópia */
+static sd_stream_status_t read_check(uint32_t lba, uint32_t n) {
+    const sd_stream_status_t st = sd_stream_read(&sd, buf, lba, n);
+    if (st == SD_STREAM_OK) {
+        CHECK(memcmp(buf, shadow[lba], (size_t)n * BLOCK) == 0, "dados lidos em %u+%u", lba, n);
+    }
+    return st;
+}
+
+/** Escreve dados novos e atualiza a cópia */
+static sd_stream_status_t write_new(uint32_t lba, uint32_t n) {
+    fill_random(buf, (size_t)n * BLOCK);
+    const sd_stream_status_t st = sd_stream_write(&sd, buf, lba, n);
+    if (st == SD_STREAM_OK) {
+        memcpy(shadow[lba], buf, (size_t)n * BLOCK);
+    }
+    return st;
+}
+
+static void scenario_sequential(const char *tag) {
+    const unsigned c18 = card.cmd18, c25 = card.cmd25, coal = sd.stats.coalesced;
+    for (uint32_t l = 100; l < 200; l += 4) {
+        CHECK(read_check(l, 4) == SD_STREAM_OK, "%s: leitura sequencial em %u", tag, l);
+    }
+    CHECK(card.cmd18 == c18 + 1u, "%s: %u CMD18 para 25 leituras contíguas", tag,
+          card.cmd18 - c18);
+    CHECK(sd.stats.coalesced == coal + 24u, "%s: %u leituras coalescidas", tag,
+          sd.stats.coalesced - coal);
+
+    for (uint32_t l = 500; l < 596; l += 8) {
+        CHECK(write_new(l, 8) == SD_STREAM_OK, "%s: escrita sequencial em %u", tag, l);
+    }
+    CHECK(card.cmd25 == c25 + 1u, "%s: %u CMD25 para 12 escritas contíguas", tag,
+          card.cmd25 - c25);
+    CHECK(card.hint == 8u, "%s: ACMD23(%u) sem dica, esperado 8", tag, card.hint);
+    CHECK(sd.stats.coalesced == coal + 24u + 11u, "%s: escritas coalescidas", tag);
+
+    const unsigned stops = card.stop_tokens;
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK, "%s: sync", tag);
+    CHECK(card.stop_tokens == stops + 1u && card.mode == CARD_IDLE, "%s: sync sem token de parada",
+          tag);
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK && card.stop_tokens == stops + 1u,
+          "%s: sync com fluxo fechado enviou algo", tag);
+    CHECK(disk_matches(), "%s: disco difere após escrita sequencial", tag);
+}
+
+static void scenario_hint(const char *tag) {
+    const unsigned a23 = card.acmd23;
+    sd_stream_set_write_hint(&sd, 32);
+    CHECK(write_new(1000, 4) == SD_STREAM_OK && write_new(1004, 4) == SD_STREAM_OK,
+          "%s: escrita com dica", tag);
+    CHECK(card.acmd23 == a23 + 1u && card.hint == 32u, "%s: ACMD23(%u), esperado 32", tag,
+          card.hint);
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK, "%s: sync após dica", tag);
+    /* A dica vale para um único fluxo */
+    CHECK(write_new(2000, 2) == SD_STREAM_OK && card.hint == 2u,
+          "%s: dica reaproveitada: ACMD23(%u), esperado 2", tag, card.hint);
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK, "%s: sync", tag);
+}
+
+static void scenario_mixed(const char *tag) {
+    const unsigned c12 = card.cmd12, stops = card.stop_tokens, c18 = card.cmd18;
+    CHECK(read_check(10, 4) == SD_STREAM_OK, "%s: misto: leitura", tag);
+    CHECK(write_new(20, 2) == SD_STREAM_OK, "%s: misto: escrita", tag);
+    CHECK(card.cmd12 == c12 + 1u, "%s: escrita não fechou o CMD18", tag);
+    CHECK(read_check(14, 4) == SD_STREAM_OK, "%s: misto: leitura após escrita", tag);
+    CHECK(card.stop_tokens == stops + 1u, "%s: leitura não fechou o CMD25", tag);
+    CHECK(card.cmd18 == c18 + 2u, "%s: leitura após escrita coalesceu", tag);
+    /* Ler o que acabou de ser escrito no mesmo fluxo aberto */
+    CHECK(write_new(30, 1) == SD_STREAM_OK && read_check(30, 1) == SD_STREAM_OK,
+          "%s: misto: releitura", tag);
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK, "%s: sync", tag);
+}
+
+static void scenario_random(const char *tag, unsigned ops) {
+    for (unsigned t = 0; t < ops; t++) {
+        const uint32_t n = 1u + (uint32_t)rand() % 16u;
+        const uint32_t lba = (uint32_t)rand() % (NS - n + 1u);
+        sd_stream_status_t st;
+        switch (rand() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            st = read_check(lba, n);
+            break;
+        case 3:
+            /* Continuação contígua do fluxo aberto, se houver */
+            if (sd.mode != SD_STREAM_IDLE && sd.next_lba + n <= NS) {
+                st = (sd.mode == SD_STREAM_READING) ? read_check(sd.next_lba, n)
+                                                    : write_new(sd.next_lba, n);
+            } else {
+                st = read_check(lba, n);
+            }
+            break;
+        case 7:
+            st = sd_stream_sync(&sd);
+            break;
+        default:
+            if (rand() % 4 == 0) {
+                sd_stream_set_write_hint(&sd, n);
+            }
+            st = write_new(lba, n);
+            break;
+        }
+        CHECK(st == SD_STREAM_OK, "%s: aleatório: operação %u deu %d", tag, t, (int)st);
+        if (st != SD_STREAM_OK) {
+            return;
+        }
+    }
+    CHECK(sd_stream_sync(&sd) == SD_STREAM_OK, "%s: sync", tag);
+    CHECK(disk_matches(), "%s: aleatório: disco difere da cópia", tag);
+}
+
+static void scenario_end_of_card(const char *tag) {
+    const unsigned c12 = card.cmd12;
+    CHECK(read_check(NS - 8u, 4) == SD_STREAM_OK && read_check(NS - 4u, 4) == SD_STREAM_OK,
+          "%s: leitura até o fim", tag);
+    CHECK(sd.mode == SD_STREAM_IDLE && card.mode == CARD_IDLE,
+          "%s: fluxo aberto após o último bloco", tag);
+    CHECK(card.cmd12 == c12 + 1u, "%s: fim do cartão sem CMD12", tag);
+
+    CHECK(sd_stream_read(&sd, buf, NS - 2u, 4) == SD_STREAM_ERR_PARAM,
+          "%s: leitura além do fim aceita", tag);
+    CHECK(sd_stream_read(&sd, buf, NS, 1) == SD_STREAM_ERR_PARAM, "%s: LBA = NS aceito", tag);
+    CHECK(sd_stream_write(&sd, buf, NS - 1u, 2) == SD_STREAM_ERR_PARAM,
+          "%s: escrita além do fim aceita", tag);
+    CHECK(write_new(NS - 1u, 1) == SD_STREAM_OK && sd_stream_sync(&sd) == SD_STREAM_OK,
+          "%s: escrita no último bloco", tag);
+    CHECK(read_check(NS - 1u, 1) == SD_STREAM_OK && read_check(0, 2) == SD_STREAM_OK,
+          "%s: leitura após o fim", tag);
+}
+
+static void scenario_errors(const char *tag) {
+    const uint32_t crc0 = sd.stats.crc_errors;
+
+    /* CRC16 errado num bloco do meio e no último bloco da chamada */
+    card.bad_read_crc = 702;
+    CHECK(sd_stream_read(&sd, buf, 700, 4) == SD_STREAM_ERR_CRC, "%s: CRC de leitura aceito", tag);
+    CHECK(sd.mode == SD_STREAM_IDLE && card.mode == CARD_IDLE, "%s: fluxo aberto após CRC", tag);
+    card.bad_read_crc = 703;
+    CHECK(sd_stream_read(&sd, buf, 700, 4) == SD_STREAM_ERR_CRC,
+          "%s: CRC do último bloco aceito", tag);
+    CHECK(sd.stats.crc_errors == crc0 + 2u, "%s: %u erros de CRC contados", tag,
+          sd.stats.crc_errors - crc0);
+    CHECK(read_check(700, 4) == SD_STREAM_OK, "%s: releitura após CRC", tag);
+
+    card.error_token = 801;
+    CHECK(sd_stream_read(&sd, buf, 800, 4) == SD_STREAM_ERR_TOKEN, "%s: token de erro aceito", tag);
+    CHECK(sd.mode == SD_STREAM_IDLE && card.mode == CARD_IDLE, "%s: fluxo aberto após token", tag);
+    CHECK(read_check(800, 4) == SD_STREAM_OK, "%s: releitura após token", tag);
+
+    /* CRC recusado na escrita: blocos anteriores gravados, o recusado não,
+     * fluxo fechado com o token de parada */
+    const unsigned stops = card.stop_tokens;
+    fill_random(buf, 4u * BLOCK);
+    card.bad_write_crc = 902;
+    CHECK(sd_stream_write(&sd, buf, 900, 4) == SD_STREAM_ERR_CRC, "%s: CRC de escrita aceito", tag);
+    CHECK(card.stop_tokens == stops + 1u && card.mode == CARD_IDLE,
+          "%s: escrita recusada sem token de parada", tag);
+    CHECK(sd.stats.crc_errors == crc0 + 3u, "%s: CRC de escrita não contado", tag);
+    CHECK(memcmp(disk[900], buf, 2u * BLOCK) == 0 && memcmp(disk[902], shadow[902], BLOCK) == 0,
+          "%s: blocos gravados após CRC recusado", tag);
+    memcpy(shadow[900], buf, 2u * BLOCK);
+    CHECK(write_new(902, 2) == SD_STREAM_OK && sd_stream_sync(&sd) == SD_STREAM_OK,
+          "%s: reescrita após CRC", tag);
+
+    card.reject = 951;
+    CHECK(write_new(950, 1) == SD_STREAM_OK, "%s: escrita antes da rejeição", tag);
+    fill_random(buf, BLOCK);
+    CHECK(sd_stream_write(&sd, buf, 951, 1) == SD_STREAM_ERR_WRITE, "%s: rejeição aceita", tag);
+    CHECK(sd.mode == SD_STREAM_IDLE && card.mode == CARD_IDLE, "%s: fluxo aberto após rejeição",
+          tag);
+    CHECK(disk_matches(), "%s: disco difere após erros", tag);
+}
+
+static void scenario_blockdev(const char *tag) {
+    blockdev_t dev;
+    sd_stream_blockdev(&sd, &dev);
+    uint32_t count = 0;
+    CHECK(blockdev_ioctl(&dev, BLOCKDEV_GET_SECTOR_COUNT, &count) == BLOCKDEV_OK && count == NS,
+          "%s: GET_SECTOR_COUNT %u", tag, count);
+
+    fill_random(buf, 3u * BLOCK);
+    CHECK(blockdev_write(&dev, buf, 1200, 3) == BLOCKDEV_OK, "%s: blockdev_write", tag);
+    memcpy(shadow[1200], buf, 3u * BLOCK);
+    const unsigned stops = card.stop_tokens;
+    CHECK(blockdev_sync(&dev) == BLOCKDEV_OK && card.stop_tokens == stops + 1u,
+          "%s: CTRL_SYNC não fechou o CMD25", tag);
+    CHECK(disk_matches(), "%s: disco difere após CTRL_SYNC", tag);
+    CHECK(blockdev_read(&dev, buf, NS - 1u, 2) == BLOCKDEV_PARERR, "%s: PARERR além do fim", tag);
+}
+
+/** Inicializa e roda todos os cenários com um transporte */
+static void run(bus_kind_t kind, bool high_capacity, bool crc, unsigned random_ops) {
+    char tag[48];
+    snprintf(tag, sizeof tag, "%s%s%s", bus_name[kind], high_capacity ? "" : ", SDSC",
+             crc ? "" : ", sem CRC");
+    const unsigned fail0 = failures;
+
+    card_reset(high_capacity);
+    memset(&bus, 0, sizeof bus);
+    srand(1234u);
+    fill_random(&disk[0][0], sizeof disk);
+    memcpy(shadow, disk, sizeof disk);
+
+    const sd_stream_io_t io = make_io(kind);
+    const sd_stream_status_t st = sd_stream_init(&sd, &io, 25000000u, crc);
+    CHECK(st == SD_STREAM_OK, "%s: init deu %d", tag, (int)st);
+    if (st != SD_STREAM_OK) {
+        return;
+    }
+    CHECK(sd.sectors == NS && sd.high_capacity == high_capacity && card.crc_on == crc,
+          "%s: init: %u setores, SDHC %d, CRC %d", tag, sd.sectors, sd.high_capacity, card.crc_on);
+
+    scenario_sequential(tag);
+    scenario_hint(tag);
+    scenario_mixed(tag);
+    scenario_random(tag, random_ops);
+    scenario_end_of_card(tag);
+    if (crc) {
+        scenario_errors(tag);
+    }
+    scenario_blockdev(tag);
+
+    CHECK(card.violations == 0u, "%s: %u violações de protocolo", tag, card.violations);
+    printf("%-24s %5u CMD18 %5u CMD25 %5u CMD12 %5u ACMD23, %u coalescidas, %u erros de CRC: %s\n",
+           tag, card.cmd18, card.cmd25, card.cmd12, card.acmd23, sd.stats.coalesced,
+           sd.stats.crc_errors, failures == fail0 ? "ok" : "FALHA");
+}
+
+int main(void) {
+    run(BUS_BLOCKING, true, true, 2000u);
+    run(BUS_DMA, true, true, 2000u);
+    run(BUS_DMA_SNIFF, true, true, 2000u);
+    run(BUS_BLOCKING, false, true, 500u);
+    run(BUS_DMA, true, false, 500u);
+
+    return test_check_summary();
+}
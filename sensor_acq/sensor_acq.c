@@ -0,0 +1,352 @@
+/**
+ * =============================================================================
+ * @file    sensor_acq.c
+ * @brief   Filas SPSC, agendador das fontes e laço do core1
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details ORDEM DE MEMÓRIA DA FILA:
+ *          O produtor copia a amostra para o slot e só então publica head
+ *          (release); o consumidor lê head (acquire) antes de copiar o slot e
+ *          publica tail (release) depois. Os builtins __atomic de 32 bits
+ *          viram LDR/STR + DMB no Cortex-M0+ e não exigem LDREX/STREX.
+ *
+ *          Quem escreve o quê:
+ *          ┌──────────────┬─────────────────────────────────────────────────┐
+ *          │ core1        │ head, pushes, overruns, depth_max, next_due,    │
+ *          │              │ seq, samples, read_errors, skipped, late[]      │
+ *          │ core0        │ tail, pops                                      │
+ *          └──────────────┴─────────────────────────────────────────────────┘
+ *          Os contadores são de 32 bits: a leitura pelo outro lado nunca vê
+ *          um valor rasgado.
+ * =============================================================================
+ */
+
+#include "sensor_acq.h"
+
+#include <string.h>   /* Para memset */
+
+#if SENSOR_ACQ_USE_MULTICORE
+#include "hardware/sync.h"
+#include "pico/multicore.h"
+#include "pico/stdlib.h"
+#else
+#include <time.h>     /* Para clock_gettime e nanosleep */
+#endif
+
+#include "prof_zone_hooks.h"   /* PROF_ZONE_ID(), vazia sem PROF_ZONE_ENABLE */
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+#include <stdio.h>    /* Para snprintf */
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: FILA SPSC
+ * =============================================================================
+ */
+
+#define LOAD_ACQ(p)      __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define STORE_REL(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define LOAD_RLX(p)      __atomic_load_n((p), __ATOMIC_RELAXED)
+#define STORE_RLX(p, v)  __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+
+/** Incrementa um contador lido pelo outro lado (só quem o escreve chama) */
+static inline void bump(uint32_t *p, uint32_t v) {
+    STORE_RLX(p, *p + v);
+}
+
+bool sensor_acq_ring_init(sensor_acq_ring_t *r, sensor_acq_sample_t *slots, uint32_t capacity) {
+    if (!r || !slots || capacity < 2u || (capacity & (capacity - 1u)) != 0) {
+        return false;
+    }
+    memset(r, 0, sizeof *r);
+    r->slots = slots;
+    r->mask = capacity - 1u;
+    return true;
+}
+
+bool sensor_acq_ring_push(sensor_acq_ring_t *r, const sensor_acq_sample_t *s) {
+    const uint32_t head = r->head;
+    uint32_t used = head - r->tail_cache;
+    if (used > r->mask) {
+        /* A cópia diz cheia: relê o índice do consumidor */
+        r->tail_cache = LOAD_ACQ(&r->tail);
+        used = head - r->tail_cache;
+        if (used > r->mask) {
+            bump(&r->overruns, 1u);
+            return false;
+        }
+    }
+    r->slots[head & r->mask] = *s;
+    STORE_REL(&r->head, head + 1u);
+    bump(&r->pushes, 1u);
+    if (used + 1u > r->depth_max) {
+        /* A cópia superestima a ocupação: confirma antes de um novo máximo */
+        r->tail_cache = LOAD_ACQ(&r->tail);
+        used = head - r->tail_cache;
+        if (used + 1u > r->depth_max) {
+            STORE_RLX(&r->depth_max, used + 1u);
+        }
+    }
+    return true;
+}
+
+bool sensor_acq_ring_pop(sensor_acq_ring_t *r, sensor_acq_sample_t *out) {
+    const uint32_t tail = r->tail;
+    if (tail == r->head_cache) {
+        /* A cópia diz vazia: relê o índice do produtor */
+        r->head_cache = LOAD_ACQ(&r->head);
+        if (tail == r->head_cache) {
+            return false;
+        }
+    }
+    *out = r->slots[tail & r->mask];
+    STORE_REL(&r->tail, tail + 1u);
+    bump(&r->pops, 1u);
+    return true;
+}
+
+uint32_t sensor_acq_ring_depth(const sensor_acq_ring_t *r) {
+    const uint32_t tail = LOAD_ACQ(&r->tail);
+    const uint32_t head = LOAD_ACQ(&r->head);
+    return head - tail;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: AGENDADOR
+ * =============================================================================
+ */
+
+static uint64_t default_clock(void) {
+#if SENSOR_ACQ_USE_MULTICORE
+    return time_us_64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+#endif
+}
+
+static void count_late(sensor_acq_channel_t *c, uint64_t late) {
+    const uint8_t b = late < 10u ? 0u : late < 100u ? 1u : late < 1000u ? 2u : 3u;
+    bump(&c->late[b], 1u);
+}
+
+void sensor_acq_init(sensor_acq_t *a, sensor_acq_clock_fn_t clock) {
+    memset(a, 0, sizeof *a);
+    a->clock = clock ? clock : default_clock;
+}
+
+int sensor_acq_add(sensor_acq_t *a, const sensor_acq_source_t *src, sensor_acq_sample_t *slots,
+                   uint32_t capacity) {
+    if (a->running || a->n_sources >= SENSOR_ACQ_MAX_SOURCES || !src || !src->read ||
+        src->period_us == 0 || src->n_values == 0 || src->n_values > SENSOR_ACQ_MAX_VALUES) {
+        return -1;
+    }
+    sensor_acq_channel_t *c = &a->ch[a->n_sources];
+    memset(c, 0, sizeof *c);
+    if (!sensor_acq_ring_init(&c->ring, slots, capacity)) {
+        return -1;
+    }
+    c->src = *src;
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+    char zone[PROF_ZONE_NAME_LEN];
+    snprintf(zone, sizeof zone, "%s_read", src->name ? src->name : "sensor");
+    c->prof_zone = prof_zone_register(zone);
+#endif
+    return a->n_sources++;
+}
+
+/** Reinicia a agenda: todas as fontes vencem agora */
+static void schedule_all(sensor_acq_t *a) {
+    const uint64_t now = a->clock();
+    for (uint8_t i = 0; i < a->n_sources; i++) {
+        a->ch[i].next_due = now;
+    }
+}
+
+uint32_t sensor_acq_poll(sensor_acq_t *a) {
+    uint64_t next = UINT64_MAX;
+    a->polls++;
+
+    for (uint8_t i = 0; i < a->n_sources; i++) {
+        sensor_acq_channel_t *c = &a->ch[i];
+        /* Relógio relido por fonte: a leitura I2C da anterior leva centenas de us */
+        const uint64_t now = a->clock();
+        if (now >= c->next_due) {
+            const uint64_t late = now - c->next_due;
+            sensor_acq_sample_t s;
+            s.t_us = now;
+            s.source = i;
+            s.n_values = c->src.n_values;
+            s.late_us = late > UINT16_MAX ? UINT16_MAX : (uint16_t)late;
+            memset(s.v, 0, sizeof s.v);
+            bool ok;
+            {
+                PROF_ZONE_ID(c->prof_zone);
+                ok = c->src.read(c->src.ctx, s.v);
+            }
+            if (ok) {
+                s.seq = c->seq++;
+                bump(&c->samples, 1u);
+                count_late(c, late);
+                sensor_acq_ring_push(&c->ring, &s);
+            } else {
+                bump(&c->read_errors, 1u);
+            }
+
+            /* Próximo instante pela grade do período, sem acumular deriva */
+            uint64_t due = c->next_due + c->src.period_us;
+            if (due <= now) {
+                const uint64_t lost = (now - c->next_due) / c->src.period_us;
+                bump(&c->skipped, (uint32_t)lost);
+                due = c->next_due + (lost + 1u) * c->src.period_us;
+            }
+            c->next_due = due;
+        }
+        if (c->next_due < next) {
+            next = c->next_due;
+        }
+    }
+
+    if (next == UINT64_MAX) {
+        return UINT32_MAX;
+    }
+    const uint64_t now = a->clock();
+    return next > now ? (uint32_t)(next - now) : 0u;
+}
+
+bool sensor_acq_pop(sensor_acq_t *a, uint8_t source, sensor_acq_sample_t *out) {
+    return source < a->n_sources && sensor_acq_ring_pop(&a->ch[source].ring, out);
+}
+
+void sensor_acq_get_stats(const sensor_acq_t *a, uint8_t source, sensor_acq_stats_t *out) {
+    memset(out, 0, sizeof *out);
+    if (source >= a->n_sources) {
+        return;
+    }
+    const sensor_acq_channel_t *c = &a->ch[source];
+    out->samples = LOAD_RLX(&c->samples);
+    out->read_errors = LOAD_RLX(&c->read_errors);
+    out->skipped = LOAD_RLX(&c->skipped);
+    out->overruns = LOAD_RLX(&c->ring.overruns);
+    out->popped = LOAD_RLX(&c->ring.pops);
+    out->depth = sensor_acq_ring_depth(&c->ring);
+    out->depth_max = LOAD_RLX(&c->ring.depth_max);
+    for (uint8_t b = 0; b < SENSOR_ACQ_LATE_BUCKETS; b++) {
+        out->late[b] = LOAD_RLX(&c->late[b]);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: AMOSTRADOR (CORE1 NO RP2040, THREAD NO HOST)
+ * =============================================================================
+ */
+
+#if SENSOR_ACQ_USE_MULTICORE
+
+/** Instância atendida pelo core1 (multicore_launch_core1 não recebe contexto) */
+static sensor_acq_t *core1_acq = NULL;
+
+static volatile bool alarm_pending = false;
+
+static int64_t wake_alarm(alarm_id_t id, void *user) {
+    (void)id;
+    (void)user;
+    alarm_pending = false;
+    return 0;  /* A própria entrada na IRQ tira o core1 do WFE */
+}
+
+static void sensor_acq_core1_entry(void) {
+    sensor_acq_t *a = core1_acq;
+    /* Pool próprio: o IRQ do alarme fica no core1, sem depender do core0 */
+    alarm_pool_t *pool = alarm_pool_create_with_unused_hardware_alarm(2);
+
+    schedule_all(a);
+    while (LOAD_ACQ(&a->running)) {
+        const uint32_t wait = sensor_acq_poll(a);
+        if (wait <= SENSOR_ACQ_SPIN_US) {
+            continue;
+        }
+        if (!alarm_pending) {
+            alarm_pending = true;
+            if (alarm_pool_add_alarm_in_us(pool, wait, wake_alarm, NULL, true) <= 0) {
+                alarm_pending = false;
+                continue;
+            }
+        }
+        /* Um alarme que dispare antes do WFE deixa o evento marcado */
+        __wfe();
+    }
+    alarm_pool_destroy(pool);
+    alarm_pending = false;
+    STORE_REL(&a->exited, true);
+}
+
+bool sensor_acq_start(sensor_acq_t *a) {
+    if (a->running || a->n_sources == 0) {
+        return false;
+    }
+    core1_acq = a;
+    a->exited = false;
+    a->running = true;
+    multicore_reset_core1();
+    multicore_launch_core1(sensor_acq_core1_entry);
+    return true;
+}
+
+void sensor_acq_stop(sensor_acq_t *a) {
+    if (!a->running) {
+        return;
+    }
+    STORE_REL(&a->running, false);
+    while (!LOAD_ACQ(&a->exited)) {
+        __sev();  /* Acorda o core1 se estiver esperando o alarme */
+        tight_loop_contents();
+    }
+    multicore_reset_core1();
+}
+
+#else
+
+static void *sensor_acq_thread_main(void *arg) {
+    sensor_acq_t *a = (sensor_acq_t *)arg;
+
+    schedule_all(a);
+    while (LOAD_ACQ(&a->running)) {
+        const uint32_t wait = sensor_acq_poll(a);
+        if (wait > SENSOR_ACQ_SPIN_US) {
+            const struct timespec ts = { (time_t)(wait / 1000000u), (long)(wait % 1000000u) * 1000L };
+            nanosleep(&ts, NULL);
+        }
+    }
+    STORE_REL(&a->exited, true);
+    return NULL;
+}
+
+bool sensor_acq_start(sensor_acq_t *a) {
+    if (a->running || a->n_sources == 0) {
+        return false;
+    }
+    a->exited = false;
+    a->running = true;
+    if (pthread_create(&a->thread, NULL, sensor_acq_thread_main, a) != 0) {
+        a->running = false;
+        return false;
+    }
+    return true;
+}
+
+void sensor_acq_stop(sensor_acq_t *a) {
+    if (!a->running) {
+        return;
+    }
+    STORE_REL(&a->running, false);
+    pthread_join(a->thread, NULL);
+}
+
+#endif /* SENSOR_ACQ_USE_MULTICORE */
@@ -0,0 +1,290 @@
+/**
+ * =============================================================================
+ * @file    sensor_acq.h
+ * @brief   Aquisição de sensores no core1 com filas SPSC sem trava
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Os exemplos dos sensores leem, formatam e imprimem no mesmo laço
+ *          com sleep_ms: o instante de cada leitura passa a depender do
+ *          tempo de impressão. Aqui a amostragem fica sozinha no core1:
+ *
+ *          ┌───────────────────────────┐   fila SPSC   ┌──────────────────┐
+ *          │ core1                     │──────────────▶│ core0            │
+ *          │ alarme → lê as fontes     │ uma por fonte │ exibição, log,   │
+ *          │ vencidas → carimba o      │               │ fusão            │
+ *          │ instante → empurra        │               │                  │
+ *          └───────────────────────────┘               └──────────────────┘
+ *
+ *          FILAS:
+ *          - Um produtor (core1) e um consumidor (core0) por fila: só cargas
+ *            e armazenamentos de 32 bits com acquire/release, sem LDREX/STREX
+ *            (ausentes no Cortex-M0+) nem spinlock.
+ *          - Índices livres (crescem sem máscara); a capacidade é potência
+ *            de 2. Cada lado guarda uma cópia do índice do outro e só relê o
+ *            original quando a cópia indica fila cheia/vazia.
+ *          - Os campos de cada lado ficam em linhas de cache separadas. O
+ *            RP2040 não tem cache de dados, mas no host (teste com threads)
+ *            isso evita o false sharing entre os dois núcleos.
+ *          - Fila cheia: a amostra nova é descartada e conta como overrun; o
+ *            número de sequência avança mesmo assim, então o consumidor vê o
+ *            buraco.
+ *
+ *          No firmware o core1 dorme em WFE até um alarme do seu próprio
+ *          pool de alarmes; no host o mesmo laço roda numa thread POSIX.
+ * =============================================================================
+ */
+
+#ifndef SENSOR_ACQ_H
+#define SENSOR_ACQ_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "pico/time.h"
+#define SENSOR_ACQ_USE_MULTICORE 1
+#else
+#include <pthread.h>
+#define SENSOR_ACQ_USE_MULTICORE 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO
+ * =============================================================================
+ */
+
+/** Máximo de fontes (sensores) por instância */
+#ifndef SENSOR_ACQ_MAX_SOURCES
+#define SENSOR_ACQ_MAX_SOURCES 4u
+#endif
+
+/** Valores por amostra (o MPU6050 usa 7) */
+#define SENSOR_ACQ_MAX_VALUES 8u
+
+/** Alinhamento dos campos de cada lado da fila */
+#ifndef SENSOR_ACQ_CACHE_LINE
+#define SENSOR_ACQ_CACHE_LINE 64u
+#endif
+
+#define SENSOR_ACQ_ALIGNED __attribute__((aligned(SENSOR_ACQ_CACHE_LINE)))
+
+/** Esperas menores que isto são feitas em laço, sem alarme */
+#ifndef SENSOR_ACQ_SPIN_US
+#define SENSOR_ACQ_SPIN_US 20u
+#endif
+
+/** Faixas do histograma de atraso: < 10 us, < 100 us, < 1 ms, >= 1 ms */
+#define SENSOR_ACQ_LATE_BUCKETS 4u
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct sensor_acq_sample_t
+ * @brief Uma leitura (32 bytes)
+ *
+ * @var sensor_acq_sample_t::t_us     time_us_64() no início da leitura
+ * @var sensor_acq_sample_t::seq      Sequência da fonte; um salto = amostras perdidas
+ * @var sensor_acq_sample_t::late_us  Atraso em relação ao instante agendado (satura)
+ */
+typedef struct {
+    uint64_t t_us;
+    uint32_t seq;
+    uint8_t source;
+    uint8_t n_values;
+    uint16_t late_us;
+    int16_t v[SENSOR_ACQ_MAX_VALUES];
+} sensor_acq_sample_t;
+
+/**
+ * @brief Lê um sensor
+ *
+ * @param values Recebe n_values valores brutos (mesma ordem do esquema do
+ *               sensor_log, ex.: ax ay az temp gx gy gz)
+ * @return false em erro de barramento (nada é empurrado)
+ */
+typedef bool (*sensor_acq_read_fn_t)(void *ctx, int16_t *values);
+
+/** Relógio em microssegundos */
+typedef uint64_t (*sensor_acq_clock_fn_t)(void);
+
+/**
+ * @struct sensor_acq_source_t
+ * @brief Uma fonte amostrada periodicamente pelo core1
+ */
+typedef struct {
+    const char *name;
+    sensor_acq_read_fn_t read;
+    void *ctx;
+    uint32_t period_us;
+    uint8_t n_values;
+} sensor_acq_source_t;
+
+/**
+ * @struct sensor_acq_ring_t
+ * @brief Fila SPSC de amostras
+ */
+typedef struct {
+    /* Produtor (core1) */
+    SENSOR_ACQ_ALIGNED uint32_t head;
+    uint32_t tail_cache;
+    uint32_t pushes;
+    uint32_t overruns;
+    uint32_t depth_max;
+
+    /* Consumidor (core0) */
+    SENSOR_ACQ_ALIGNED uint32_t tail;
+    uint32_t head_cache;
+    uint32_t pops;
+
+    /* Constantes após a inicialização */
+    SENSOR_ACQ_ALIGNED sensor_acq_sample_t *slots;
+    uint32_t mask;
+} sensor_acq_ring_t;
+
+/**
+ * @struct sensor_acq_stats_t
+ * @brief Métricas de uma fonte
+ *
+ * @var sensor_acq_stats_t::samples     Leituras bem-sucedidas
+ * @var sensor_acq_stats_t::read_errors Leituras que falharam
+ * @var sensor_acq_stats_t::skipped     Períodos inteiros perdidos (core1 atrasado)
+ * @var sensor_acq_stats_t::overruns    Amostras descartadas com a fila cheia
+ * @var sensor_acq_stats_t::popped      Amostras retiradas pelo consumidor
+ * @var sensor_acq_stats_t::depth       Ocupação atual da fila
+ * @var sensor_acq_stats_t::depth_max   Maior ocupação vista pelo produtor
+ * @var sensor_acq_stats_t::late        Histograma do atraso da leitura
+ */
+typedef struct {
+    uint32_t samples;
+    uint32_t read_errors;
+    uint32_t skipped;
+    uint32_t overruns;
+    uint32_t popped;
+    uint32_t depth;
+    uint32_t depth_max;
+    uint32_t late[SENSOR_ACQ_LATE_BUCKETS];
+} sensor_acq_stats_t;
+
+/** Estado de uma fonte */
+typedef struct {
+    sensor_acq_ring_t ring;
+    sensor_acq_source_t src;
+    uint64_t next_due;                        /**< Só o core1 acessa */
+    uint32_t seq;                             /**< Só o core1 acessa */
+    uint32_t samples;
+    uint32_t read_errors;
+    uint32_t skipped;
+    uint32_t late[SENSOR_ACQ_LATE_BUCKETS];
+#if defined(PROF_ZONE_ENABLED) && PROF_ZONE_ENABLED
+    uint16_t prof_zone;                       /**< Zona "<fonte>_read" do prof_zone */
+#endif
+} sensor_acq_channel_t;
+
+/**
+ * @struct sensor_acq_t
+ * @brief Motor de aquisição (instância estática, sem malloc)
+ */
+typedef struct {
+    sensor_acq_channel_t ch[SENSOR_ACQ_MAX_SOURCES];
+    uint8_t n_sources;
+    sensor_acq_clock_fn_t clock;
+    volatile bool running;
+    volatile bool exited;                     /**< Laço do amostrador terminou */
+    uint32_t polls;                           /**< Passadas do laço do core1 */
+#if !SENSOR_ACQ_USE_MULTICORE
+    pthread_t thread;
+#endif
+} sensor_acq_t;
+
+/* =============================================================================
+ * SEÇÃO 3: FILA SPSC
+ * =============================================================================
+ */
+
+/**
+ * @brief Prepara uma fila sobre `slots`
+ *
+ * @param capacity Potência de 2
+ * @return false se a capacidade for inválida
+ */
+bool sensor_acq_ring_init(sensor_acq_ring_t *r, sensor_acq_sample_t *slots, uint32_t capacity);
+
+/** (Produtor) Empurra uma cópia; false e overrun contado se estiver cheia */
+bool sensor_acq_ring_push(sensor_acq_ring_t *r, const sensor_acq_sample_t *s);
+
+/** (Consumidor) Retira a amostra mais antiga; false se estiver vazia */
+bool sensor_acq_ring_pop(sensor_acq_ring_t *r, sensor_acq_sample_t *out);
+
+/** Ocupação atual (qualquer lado; é um instantâneo) */
+uint32_t sensor_acq_ring_depth(const sensor_acq_ring_t *r);
+
+/* =============================================================================
+ * SEÇÃO 4: MOTOR
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o motor
+ *
+ * @param clock Relógio; NULL usa time_us_64() (firmware) ou CLOCK_MONOTONIC (host)
+ */
+void sensor_acq_init(sensor_acq_t *a, sensor_acq_clock_fn_t clock);
+
+/**
+ * @brief Registra uma fonte (antes de iniciar o core1)
+ *
+ * @param slots    Memória da fila; declare com SENSOR_ACQ_ALIGNED
+ * @param capacity Potência de 2 (ex.: 256 amostras = 256 ms do MPU6050 a 1 kHz)
+ * @return Índice da fonte, ou -1 se os parâmetros forem inválidos
+ */
+int sensor_acq_add(sensor_acq_t *a, const sensor_acq_source_t *src, sensor_acq_sample_t *slots,
+                   uint32_t capacity);
+
+/**
+ * @brief Uma passada do amostrador: lê e empurra as fontes vencidas
+ *
+ * @details Chamada pelo laço do core1; pode ser chamada diretamente num
+ *          sistema de um core só. Agenda pelo instante previsto (sem deriva);
+ *          se um período inteiro passou, pula-o e conta em `skipped`.
+ *
+ * @return Microssegundos até a próxima fonte vencer
+ */
+uint32_t sensor_acq_poll(sensor_acq_t *a);
+
+/** (Consumidor) Retira a amostra mais antiga da fonte `source` */
+bool sensor_acq_pop(sensor_acq_t *a, uint8_t source, sensor_acq_sample_t *out);
+
+/** Métricas de uma fonte (leitura sem trava; cada campo é coerente) */
+void sensor_acq_get_stats(const sensor_acq_t *a, uint8_t source, sensor_acq_stats_t *out);
+
+/**
+ * @brief Começa a amostrar no outro núcleo
+ *
+ * @details Firmware: multicore_launch_core1() (o core1 precisa estar livre).
+ *          Host: uma thread POSIX.
+ *
+ * @return false se não foi possível iniciar
+ */
+bool sensor_acq_start(sensor_acq_t *a);
+
+/** Para o amostrador e espera o laço terminar */
+void sensor_acq_stop(sensor_acq_t *a);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_ACQ_H */
@@ -0,0 +1,555 @@
+/**
+ * =============================================================================
+ * @file    sensor_log.c
+ * @brief   Implementação do formato binário de sensores e do gravador
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ * =============================================================================
+ */
+
+#include "sensor_log.h"
+#include "sd_crc.h"
+
+#include <string.h>
+
+/* Campos do cabeçalho do arquivo */
+#define HDR_MAGIC      0
+#define HDR_VERSION    4
+#define HDR_SIZE       6
+#define HDR_BLOCK      8
+#define HDR_NCH        10
+#define HDR_ENCODING   11
+#define HDR_PERIOD     12
+#define HDR_START      16
+#define HDR_TITLE      24
+#define HDR_CRC        62
+#define HDR_CHANNELS   64
+#define CH_BYTES       32
+
+/* Campos do cabeçalho do bloco */
+#define BLK_MAGIC      0
+#define BLK_ENCODING   2
+#define BLK_NCH        3
+#define BLK_SEQ        4
+#define BLK_T_FIRST    8
+#define BLK_T_SPAN     16
+#define BLK_SAMPLES    20
+#define BLK_PAYLOAD    22
+#define BLK_CRC        24
+
+#define DELTA8_ESCAPE  0x80u
+
+/* =============================================================================
+ * SEÇÃO 1: ESQUEMAS PRONTOS
+ * =============================================================================
+ */
+
+const sensor_log_channel_t SENSOR_LOG_MPU6050[7] = {
+    { "accel_x", "g",   SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 16384.0f, 0.0f },
+    { "accel_y", "g",   SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 16384.0f, 0.0f },
+    { "accel_z", "g",   SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 16384.0f, 0.0f },
+    { "temp",    "C",   SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 340.0f,   36.53f },
+    { "gyro_x",  "dps", SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 131.0f,   0.0f },
+    { "gyro_y",  "dps", SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 131.0f,   0.0f },
+    { "gyro_z",  "dps", SENSOR_LOG_SRC_MPU6050, 0, 1.0f / 131.0f,   0.0f },
+};
+
+const sensor_log_channel_t SENSOR_LOG_BH1750[1] = {
+    { "lux", "lx", SENSOR_LOG_SRC_BH1750, SENSOR_LOG_CH_UNSIGNED, 1.0f / 1.2f, 0.0f },
+};
+
+const sensor_log_channel_t SENSOR_LOG_VL53L0X[1] = {
+    { "range", "mm", SENSOR_LOG_SRC_VL53L0X, SENSOR_LOG_CH_UNSIGNED, 1.0f, 0.0f },
+};
+
+/* =============================================================================
+ * SEÇÃO 2: SERIALIZAÇÃO
+ * =============================================================================
+ */
+
+static inline void put16(uint8_t *p, uint16_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void put32(uint8_t *p, uint32_t v) {
+    put16(p, (uint16_t)v);
+    put16(p + 2, (uint16_t)(v >> 16));
+}
+
+static inline void put64(uint8_t *p, uint64_t v) {
+    put32(p, (uint32_t)v);
+    put32(p + 4, (uint32_t)(v >> 32));
+}
+
+static inline uint16_t get16(const uint8_t *p) {
+    return (uint16_t)(p[0] | p[1] << 8);
+}
+
+static inline uint32_t get32(const uint8_t *p) {
+    return (uint32_t)get16(p) | (uint32_t)get16(p + 2) << 16;
+}
+
+static inline uint64_t get64(const uint8_t *p) {
+    return (uint64_t)get32(p) | (uint64_t)get32(p + 4) << 32;
+}
+
+static inline uint32_t float_bits(float f) {
+    uint32_t u;
+    memcpy(&u, &f, sizeof u);
+    return u;
+}
+
+static inline float bits_float(uint32_t u) {
+    float f;
+    memcpy(&f, &u, sizeof f);
+    return f;
+}
+
+/** Copia uma string para um campo fixo, sempre terminado em zero */
+static void put_str(char *dst, size_t size, const char *src) {
+    size_t i = 0;
+    for (; src && src[i] && i + 1u < size; i++) {
+        dst[i] = src[i];
+    }
+    memset(dst + i, 0, size - i);
+}
+
+/** CRC16 de uma área com o campo de CRC (2 bytes em crc_off) tratado como zero */
+static uint16_t crc_skip(const uint8_t *p, size_t n, size_t crc_off) {
+    static const uint8_t zero[2] = { 0, 0 };
+    uint16_t crc = sd_crc16_slice8(0, p, crc_off);
+    crc = sd_crc16_update(crc, zero, 2);
+    return sd_crc16_slice8(crc, p + crc_off + 2u, n - crc_off - 2u);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: CABEÇALHO
+ * =============================================================================
+ */
+
+void sensor_log_header_init(sensor_log_header_t *h, const char *title, uint32_t period_us,
+                            uint64_t start_us) {
+    memset(h, 0, sizeof *h);
+    h->block_bytes = SENSOR_LOG_DEFAULT_BLOCK;
+    h->encoding = SENSOR_LOG_DELTA8;
+    h->period_us = period_us;
+    h->start_us = start_us;
+    put_str(h->title, sizeof h->title, title);
+}
+
+bool sensor_log_header_add(sensor_log_header_t *h, const sensor_log_channel_t *ch, uint8_t n) {
+    if (h->n_channels + n > SENSOR_LOG_MAX_CHANNELS) {
+        return false;
+    }
+    memcpy(&h->channels[h->n_channels], ch, n * sizeof *ch);
+    h->n_channels = (uint8_t)(h->n_channels + n);
+    return true;
+}
+
+void sensor_log_header_encode(const sensor_log_header_t *h, uint8_t *sector) {
+    memset(sector, 0, SENSOR_LOG_HEADER_BYTES);
+    memcpy(sector + HDR_MAGIC, "SLOG", 4);
+    put16(sector + HDR_VERSION, SENSOR_LOG_VERSION);
+    put16(sector + HDR_SIZE, SENSOR_LOG_HEADER_BYTES);
+    put16(sector + HDR_BLOCK, h->block_bytes);
+    sector[HDR_NCH] = h->n_channels;
+    sector[HDR_ENCODING] = h->encoding;
+    put32(sector + HDR_PERIOD, h->period_us);
+    put64(sector + HDR_START, h->start_us);
+    put_str((char *)sector + HDR_TITLE, sizeof h->title, h->title);
+
+    for (uint8_t i = 0; i < h->n_channels; i++) {
+        const sensor_log_channel_t *ch = &h->channels[i];
+        uint8_t *c = sector + HDR_CHANNELS + i * CH_BYTES;
+        put_str((char *)c, sizeof ch->name, ch->name);
+        put_str((char *)c + 12, sizeof ch->unit, ch->unit);
+        c[20] = ch->source;
+        c[21] = ch->flags;
+        put32(c + 24, float_bits(ch->scale));
+        put32(c + 28, float_bits(ch->offset));
+    }
+    put16(sector + HDR_CRC, crc_skip(sector, SENSOR_LOG_HEADER_BYTES, HDR_CRC));
+}
+
+bool sensor_log_header_decode(const uint8_t *sector, sensor_log_header_t *h) {
+    if (memcmp(sector + HDR_MAGIC, "SLOG", 4) != 0 ||
+        get16(sector + HDR_VERSION) != SENSOR_LOG_VERSION ||
+        get16(sector + HDR_SIZE) != SENSOR_LOG_HEADER_BYTES ||
+        get16(sector + HDR_CRC) != crc_skip(sector, SENSOR_LOG_HEADER_BYTES, HDR_CRC)) {
+        return false;
+    }
+    memset(h, 0, sizeof *h);
+    h->block_bytes = get16(sector + HDR_BLOCK);
+    h->n_channels = sector[HDR_NCH];
+    h->encoding = sector[HDR_ENCODING];
+    h->period_us = get32(sector + HDR_PERIOD);
+    h->start_us = get64(sector + HDR_START);
+    put_str(h->title, sizeof h->title, (const char *)sector + HDR_TITLE);
+    if (h->block_bytes < 512u || h->block_bytes % 512u != 0 || h->n_channels == 0 ||
+        h->n_channels > SENSOR_LOG_MAX_CHANNELS) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < h->n_channels; i++) {
+        sensor_log_channel_t *ch = &h->channels[i];
+        const uint8_t *c = sector + HDR_CHANNELS + i * CH_BYTES;
+        put_str(ch->name, sizeof ch->name, (const char *)c);
+        put_str(ch->unit, sizeof ch->unit, (const char *)c + 12);
+        ch->source = c[20];
+        ch->flags = c[21];
+        ch->scale = bits_float(get32(c + 24));
+        ch->offset = bits_float(get32(c + 28));
+    }
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: CODIFICAÇÃO DAS AMOSTRAS
+ * =============================================================================
+ */
+
+/**
+ * @brief Codifica uma amostra em `dst` (até 3 bytes por canal); devolve o tamanho
+ *
+ * O laço é limitado a SENSOR_LOG_MAX_CHANNELS, o tamanho de `dst`: o
+ * sensor_log_writer_open() já recusa mais canais, e o limite explícito deixa
+ * isso visível ao compilador.
+ */
+static uint32_t encode_sample(const sensor_log_writer_t *w, const int16_t *v,
+                              uint8_t dst[3u * SENSOR_LOG_MAX_CHANNELS]) {
+    uint8_t *p = dst;
+    const bool key = (w->n_samples == 0) || (w->encoding == SENSOR_LOG_RAW16);
+    const uint8_t n_ch = w->n_channels < SENSOR_LOG_MAX_CHANNELS ? w->n_channels
+                                                                 : SENSOR_LOG_MAX_CHANNELS;
+
+    for (uint8_t c = 0; c < n_ch; c++) {
+        if (key) {
+            put16(p, (uint16_t)v[c]);
+            p += 2;
+            continue;
+        }
+        /* Diferença em aritmética de 16 bits: reversível mesmo com estouro */
+        const int16_t d = (int16_t)(uint16_t)((uint16_t)v[c] - (uint16_t)w->prev[c]);
+        if (d >= -127 && d <= 127) {
+            *p++ = (uint8_t)(int8_t)d;
+        } else {
+            *p++ = DELTA8_ESCAPE;
+            put16(p, (uint16_t)d);
+            p += 2;
+        }
+    }
+    return (uint32_t)(p - dst);
+}
+
+/* =============================================================================
+ * SEÇÃO 5: GRAVADOR
+ * =============================================================================
+ */
+
+static inline uint16_t capacity(const sensor_log_writer_t *w) {
+    return (uint16_t)(w->block_bytes - SENSOR_LOG_BLOCK_HDR);
+}
+
+/** Fecha o bloco ativo: cabeçalho, zeros no fim e CRC; marca para gravação */
+static void finalize_block(sensor_log_writer_t *w) {
+    uint8_t *b = w->buf[w->active];
+    memset(b + SENSOR_LOG_BLOCK_HDR + w->fill, 0, (size_t)capacity(w) - w->fill);
+    memset(b, 0, SENSOR_LOG_BLOCK_HDR);
+    put16(b + BLK_MAGIC, SENSOR_LOG_BLOCK_MAGIC);
+    b[BLK_ENCODING] = w->encoding;
+    b[BLK_NCH] = w->n_channels;
+    put32(b + BLK_SEQ, w->seq++);
+    put64(b + BLK_T_FIRST, w->t_first);
+    put32(b + BLK_T_SPAN, (uint32_t)(w->t_last - w->t_first));
+    put16(b + BLK_SAMPLES, w->n_samples);
+    put16(b + BLK_PAYLOAD, w->fill);
+    put16(b + BLK_CRC, crc_skip(b, w->block_bytes, BLK_CRC));
+
+    __sync_synchronize();
+    w->ready[w->active] = 1u;
+    w->stalled = true;
+}
+
+/** Passa para o outro buffer, se ele já tiver sido gravado */
+static bool try_swap(sensor_log_writer_t *w) {
+    const uint8_t other = w->active ^ 1u;
+    if (w->ready[other]) {
+        return false;
+    }
+    w->active = other;
+    w->fill = 0;
+    w->n_samples = 0;
+    w->stalled = false;
+    return true;
+}
+
+/* -----------------------------------------------------------------------------
+ * PACKED: a primeira amostra do bloco vai direto como quadro-chave; as demais
+ * esperam em `stage` até completar um grupo, que é empacotado de uma vez
+ * (custo fixo: SENSOR_PACK_GROUP * n_channels valores). Se o grupo não couber,
+ * o bloco é fechado e o grupo recomeça o próximo.
+ * -----------------------------------------------------------------------------
+ */
+
+static void put_key(sensor_log_writer_t *w, uint64_t t_us, const int16_t *values) {
+    uint8_t *p = w->buf[w->active] + SENSOR_LOG_BLOCK_HDR;
+    for (uint8_t c = 0; c < w->n_channels; c++) {
+        put16(p + 2u * c, (uint16_t)values[c]);
+    }
+    memcpy(w->prev, values, w->n_channels * sizeof values[0]);
+    w->fill = (uint16_t)(2u * w->n_channels);
+    w->n_samples = 1;
+    w->t_first = t_us;
+    w->t_last = t_us;
+}
+
+/** Empacota as amostras pendentes no bloco ativo; false se não couberem */
+static bool pack_stage(sensor_log_writer_t *w) {
+    const uint8_t n = w->staged;
+    const int16_t *s = w->stage;
+    const uint32_t room = (uint32_t)capacity(w) - w->fill;
+    if ((uint32_t)w->n_samples + n > UINT16_MAX ||
+        (room < SENSOR_PACK_GROUP_MAX(w->n_channels) &&
+         room < sensor_pack_group_size(s, w->n_channels, n, w->prev))) {
+        return false;
+    }
+    uint8_t *dst = w->buf[w->active] + SENSOR_LOG_BLOCK_HDR + w->fill;
+    w->fill = (uint16_t)(w->fill + sensor_pack_encode_group(s, w->n_channels, n, w->prev, dst));
+    w->n_samples = (uint16_t)(w->n_samples + n);
+    w->t_last = w->t_stage[n - 1u];
+    w->staged = 0;
+    return true;
+}
+
+/** Bloco novo e vazio: a primeira pendente vira o quadro-chave */
+static void rebase_stage(sensor_log_writer_t *w) {
+    if (w->staged == 0) {
+        return;
+    }
+    const uint8_t n_ch = w->n_channels;
+    put_key(w, w->t_stage[0], w->stage);
+    w->staged--;
+    memmove(w->stage, w->stage + n_ch, (size_t)w->staged * n_ch * sizeof w->stage[0]);
+    memmove(&w->t_stage[0], &w->t_stage[1], w->staged * sizeof w->t_stage[0]);
+}
+
+static bool append_packed(sensor_log_writer_t *w, uint64_t t_us, const int16_t *values) {
+    if (w->stalled) {
+        if (!try_swap(w)) {
+            /* Um bloco não pode ter lacunas: as pendentes vão junto */
+            w->stats.samples -= w->staged;
+            w->stats.dropped += w->staged + 1u;
+            w->staged = 0;
+            return false;
+        }
+        rebase_stage(w);
+    }
+    if (w->n_samples == 0) {
+        put_key(w, t_us, values);
+        w->stats.samples++;
+        return true;
+    }
+
+    memcpy(w->stage + (size_t)w->staged * w->n_channels, values,
+           w->n_channels * sizeof values[0]);
+    w->t_stage[w->staged++] = t_us;
+    w->stats.samples++;
+    if (w->staged == SENSOR_PACK_GROUP && !pack_stage(w)) {
+        finalize_block(w);
+        if (try_swap(w)) {
+            rebase_stage(w);
+        }
+    }
+    return true;
+}
+
+bool sensor_log_writer_open(sensor_log_writer_t *w, const sensor_log_sink_t *sink,
+                            const sensor_log_header_t *h, uint8_t *buffers,
+                            uint64_t prealloc_bytes) {
+    if (!w || !sink || !sink->write || !h || !buffers || h->n_channels == 0 ||
+        h->n_channels > SENSOR_LOG_MAX_CHANNELS || h->block_bytes < 512u ||
+        h->block_bytes % 512u != 0 || h->encoding > SENSOR_LOG_PACKED) {
+        return false;
+    }
+    if (h->encoding == SENSOR_LOG_PACKED &&
+        h->block_bytes - SENSOR_LOG_BLOCK_HDR < 2u * h->n_channels +
+                                                 SENSOR_PACK_GROUP_MAX(h->n_channels)) {
+        return false;
+    }
+    memset(w, 0, sizeof *w);
+    w->sink = *sink;
+    w->block_bytes = h->block_bytes;
+    w->encoding = h->encoding;
+    w->n_channels = h->n_channels;
+    w->buf[0] = buffers;
+    w->buf[1] = buffers + h->block_bytes;
+
+    if (prealloc_bytes && w->sink.prealloc && !w->sink.prealloc(w->sink.ctx, prealloc_bytes)) {
+        w->stats.write_errors++;
+        return false;
+    }
+
+    /* O cabeçalho usa o segundo buffer antes de os blocos começarem */
+    sensor_log_header_encode(h, w->buf[1]);
+    if (!w->sink.write(w->sink.ctx, w->buf[1], SENSOR_LOG_HEADER_BYTES)) {
+        w->stats.write_errors++;
+        return false;
+    }
+    w->stats.bytes = SENSOR_LOG_HEADER_BYTES;
+    return true;
+}
+
+bool sensor_log_append(sensor_log_writer_t *w, uint64_t t_us, const int16_t *values) {
+    if (w->encoding == SENSOR_LOG_PACKED) {
+        return append_packed(w, t_us, values);
+    }
+    if (w->stalled && !try_swap(w)) {
+        w->stats.dropped++;
+        return false;
+    }
+
+    uint8_t tmp[3u * SENSOR_LOG_MAX_CHANNELS];
+    uint32_t n = encode_sample(w, values, tmp);
+    if (w->fill + n > capacity(w)) {
+        finalize_block(w);
+        if (!try_swap(w)) {
+            w->stats.dropped++;
+            return false;
+        }
+        n = encode_sample(w, values, tmp);  /* Novo bloco: quadro-chave */
+    }
+
+    memcpy(w->buf[w->active] + SENSOR_LOG_BLOCK_HDR + w->fill, tmp, n);
+    w->fill = (uint16_t)(w->fill + n);
+    if (w->n_samples == 0) {
+        w->t_first = t_us;
+    }
+    w->t_last = t_us;
+    w->n_samples++;
+    memcpy(w->prev, values, w->n_channels * sizeof values[0]);
+    w->stats.samples++;
+    return true;
+}
+
+bool sensor_log_service(sensor_log_writer_t *w) {
+    while (w->ready[w->next_write]) {
+        __sync_synchronize();
+        if (!w->sink.write(w->sink.ctx, w->buf[w->next_write], w->block_bytes)) {
+            w->stats.write_errors++;
+            return false;
+        }
+        w->stats.blocks++;
+        w->stats.bytes += w->block_bytes;
+        w->ready[w->next_write] = 0;
+        w->next_write ^= 1u;
+    }
+    return true;
+}
+
+bool sensor_log_writer_close(sensor_log_writer_t *w) {
+    for (;;) {
+        if (w->stalled) {
+            if (!sensor_log_service(w)) {
+                return false;
+            }
+            try_swap(w);
+            rebase_stage(w);
+        }
+        if (w->staged && !pack_stage(w)) {
+            finalize_block(w);
+            continue;
+        }
+        break;
+    }
+    if (w->n_samples > 0) {
+        finalize_block(w);
+    }
+    if (!sensor_log_service(w)) {
+        return false;
+    }
+    if (w->sink.sync && !w->sink.sync(w->sink.ctx)) {
+        w->stats.write_errors++;
+        return false;
+    }
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 6: LEITURA
+ * =============================================================================
+ */
+
+bool sensor_log_block_decode(const sensor_log_header_t *h, const uint8_t *blk,
+                             sensor_log_block_t *info, int16_t *out, uint32_t max_samples) {
+    const uint8_t n_ch = h->n_channels;
+    const uint16_t payload = get16(blk + BLK_PAYLOAD);
+    if (get16(blk + BLK_MAGIC) != SENSOR_LOG_BLOCK_MAGIC || blk[BLK_NCH] != n_ch ||
+        blk[BLK_ENCODING] > SENSOR_LOG_PACKED ||
+        payload > h->block_bytes - SENSOR_LOG_BLOCK_HDR ||
+        get16(blk + BLK_CRC) != crc_skip(blk, h->block_bytes, BLK_CRC)) {
+        return false;
+    }
+    info->seq = get32(blk + BLK_SEQ);
+    info->t_first_us = get64(blk + BLK_T_FIRST);
+    info->t_span_us = get32(blk + BLK_T_SPAN);
+    info->n_samples = get16(blk + BLK_SAMPLES);
+    info->encoding = blk[BLK_ENCODING];
+    if (info->n_samples > max_samples) {
+        return false;
+    }
+    if (info->encoding == SENSOR_LOG_PACKED) {
+        return info->n_samples > 0 &&
+               sensor_pack_decode_block(blk + SENSOR_LOG_BLOCK_HDR, payload, info->n_samples,
+                                        n_ch, out);
+    }
+
+    const uint8_t *p = blk + SENSOR_LOG_BLOCK_HDR;
+    const uint8_t *end = p + payload;
+    for (uint16_t s = 0; s < info->n_samples; s++) {
+        int16_t *v = out + (size_t)s * n_ch;
+        const bool key = (s == 0) || (info->encoding == SENSOR_LOG_RAW16);
+        for (uint8_t c = 0; c < n_ch; c++) {
+            if (key) {
+                if (end - p < 2) {
+                    return false;
+                }
+                v[c] = (int16_t)get16(p);
+                p += 2;
+                continue;
+            }
+            if (p >= end) {
+                return false;
+            }
+            int16_t d;
+            if (*p == DELTA8_ESCAPE) {
+                if (end - p < 3) {
+                    return false;
+                }
+                d = (int16_t)get16(p + 1);
+                p += 3;
+            } else {
+                d = (int8_t)*p++;
+            }
+            v[c] = (int16_t)(uint16_t)((uint16_t)v[c - (int)n_ch] + (uint16_t)d);
+        }
+    }
+    return p == end;
+}
+
+uint64_t sensor_log_sample_time(const sensor_log_block_t *info, uint16_t i) {
+    if (info->n_samples < 2u) {
+        return info->t_first_us;
+    }
+    return info->t_first_us + (uint64_t)info->t_span_us * i / (info->n_samples - 1u);
+}
+
+float sensor_log_value(const sensor_log_channel_t *ch, int16_t raw) {
+    const float r = (ch->flags & SENSOR_LOG_CH_UNSIGNED) ? (float)(uint16_t)raw : (float)raw;
+    return r * ch->scale + ch->offset;
+}
@@ -0,0 +1,309 @@
+/**
+ * =============================================================================
+ * @file    sensor_log.h
+ * @brief   Formato binário de gravação de sensores e gravador com buffer duplo
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Substitui linhas de texto (f_printf por amostra) por blocos
+ *          binários de tamanho fixo, alinhados a setor. Para 7 canais do
+ *          MPU6050 uma linha CSV ocupa ~60 bytes; aqui, ~8 a 14 bytes.
+ *
+ *          ARQUIVO (little-endian):
+ *          ┌──────────────────────────┬──────────────────────────────────────┐
+ *          │ Cabeçalho (512 bytes)    │ "SLOG", versão, block_bytes, período │
+ *          │                          │ nominal, início, título, esquema dos │
+ *          │                          │ canais (nome, unidade, sensor,       │
+ *          │                          │ escala, offset) e CRC16              │
+ *          │ Bloco 0 (block_bytes)    │ Cabeçalho do bloco (32 bytes) +      │
+ *          │ Bloco 1 ...              │ amostras codificadas                 │
+ *          └──────────────────────────┴──────────────────────────────────────┘
+ *
+ *          BLOCO (independente dos demais):
+ *          ┌────┬────────────────────────────────────────────────────────────┐
+ *          │  0 │ u16 0x4B42 ("BK"), u8 codificação, u8 canais               │
+ *          │  4 │ u32 número de sequência                                    │
+ *          │  8 │ u64 instante da primeira amostra (us)                      │
+ *          │ 16 │ u32 duração até a última amostra (us)                      │
+ *          │ 20 │ u16 amostras, u16 bytes de payload                         │
+ *          │ 24 │ u16 CRC16 (XMODEM) do bloco inteiro com este campo zerado  │
+ *          │ 32 │ payload; o resto do bloco é preenchido com zeros           │
+ *          └────┴────────────────────────────────────────────────────────────┘
+ *
+ *          CODIFICAÇÕES DO PAYLOAD:
+ *          - RAW16:  int16 por canal, amostra após amostra;
+ *          - DELTA8: a primeira amostra do bloco em int16 (quadro-chave); as
+ *            seguintes como diferença por canal em int8, ou 0x80 seguido da
+ *            diferença em int16 quando não couber;
+ *          - PACKED: bloco do sensor_pack (quadro-chave + grupos de 16
+ *            amostras com delta, zig-zag e bit packing por canal).
+ *          Cada bloco recomeça do quadro-chave, então um bloco corrompido
+ *          (CRC inválido) não impede a leitura dos outros.
+ *
+ *          O instante de cada amostra é interpolado entre o primeiro e o
+ *          último do bloco (laços de amostragem periódicos).
+ * =============================================================================
+ */
+
+#ifndef SENSOR_LOG_H
+#define SENSOR_LOG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sensor_pack.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONSTANTES DO FORMATO
+ * =============================================================================
+ */
+
+#define SENSOR_LOG_VERSION       1u
+#define SENSOR_LOG_HEADER_BYTES  512u
+#define SENSOR_LOG_BLOCK_HDR     32u
+#define SENSOR_LOG_MAX_CHANNELS  14u     /**< Cabem no setor do cabeçalho */
+#define SENSOR_LOG_BLOCK_MAGIC   0x4B42u
+
+/**
+ * Máximo de valores (amostras * canais) num bloco. Pior caso: PACKED com
+ * canais constantes, 2 bytes por canal a cada 16 amostras.
+ */
+#define SENSOR_LOG_MAX_VALUES(block_bytes) (((block_bytes) - SENSOR_LOG_BLOCK_HDR) * 8u)
+
+/** Tamanho padrão dos blocos: um setor */
+#ifndef SENSOR_LOG_DEFAULT_BLOCK
+#define SENSOR_LOG_DEFAULT_BLOCK 512u
+#endif
+
+/**
+ * @enum sensor_log_encoding_t
+ * @brief Codificação do payload de um bloco
+ */
+typedef enum {
+    SENSOR_LOG_RAW16 = 0,
+    SENSOR_LOG_DELTA8 = 1,
+    SENSOR_LOG_PACKED = 2,  /**< Exige block_bytes >= 32 + 2 * canais + SENSOR_PACK_GROUP_MAX(canais) */
+} sensor_log_encoding_t;
+
+/**
+ * @enum sensor_log_source_t
+ * @brief Sensor de origem de um canal
+ */
+typedef enum {
+    SENSOR_LOG_SRC_GENERIC = 0,
+    SENSOR_LOG_SRC_MPU6050 = 1,
+    SENSOR_LOG_SRC_BH1750 = 2,
+    SENSOR_LOG_SRC_VL53L0X = 3,
+} sensor_log_source_t;
+
+/** Flag de canal: os 16 bits são sem sinal (ex.: lux bruto do BH1750) */
+#define SENSOR_LOG_CH_UNSIGNED 0x01u
+
+/* =============================================================================
+ * SEÇÃO 2: ESQUEMA
+ * =============================================================================
+ */
+
+/**
+ * @struct sensor_log_channel_t
+ * @brief Descrição de um canal: valor físico = bruto * scale + offset
+ */
+typedef struct {
+    char name[12];
+    char unit[8];
+    uint8_t source;     /**< sensor_log_source_t */
+    uint8_t flags;      /**< SENSOR_LOG_CH_* */
+    float scale;
+    float offset;
+} sensor_log_channel_t;
+
+/**
+ * @struct sensor_log_header_t
+ * @brief Conteúdo do cabeçalho do arquivo
+ */
+typedef struct {
+    uint16_t block_bytes;           /**< Múltiplo de 512 */
+    uint8_t encoding;               /**< sensor_log_encoding_t dos blocos */
+    uint8_t n_channels;
+    uint32_t period_us;             /**< Período nominal (0 = irregular) */
+    uint64_t start_us;
+    char title[24];
+    sensor_log_channel_t channels[SENSOR_LOG_MAX_CHANNELS];
+} sensor_log_header_t;
+
+/** Esquemas prontos (escalas das configurações padrão dos drivers) */
+extern const sensor_log_channel_t SENSOR_LOG_MPU6050[7];  /**< ax ay az (±2 g), temp, gx gy gz (±250 °/s) */
+extern const sensor_log_channel_t SENSOR_LOG_BH1750[1];   /**< lux (modo H-resolution) */
+extern const sensor_log_channel_t SENSOR_LOG_VL53L0X[1];  /**< distância em mm */
+
+/**
+ * @brief Prepara um cabeçalho vazio
+ *
+ * @param title Título livre (truncado em 23 caracteres)
+ */
+void sensor_log_header_init(sensor_log_header_t *h, const char *title, uint32_t period_us,
+                            uint64_t start_us);
+
+/** Acrescenta canais ao esquema; false se passar de SENSOR_LOG_MAX_CHANNELS */
+bool sensor_log_header_add(sensor_log_header_t *h, const sensor_log_channel_t *ch, uint8_t n);
+
+/** Serializa o cabeçalho nos 512 bytes de `sector` */
+void sensor_log_header_encode(const sensor_log_header_t *h, uint8_t *sector);
+
+/** Lê um cabeçalho; false se assinatura, versão, CRC ou campos forem inválidos */
+bool sensor_log_header_decode(const uint8_t *sector, sensor_log_header_t *h);
+
+/* =============================================================================
+ * SEÇÃO 3: GRAVADOR (BUFFER DUPLO)
+ * =============================================================================
+ */
+
+/**
+ * @struct sensor_log_sink_t
+ * @brief Destino dos blocos (ex.: f_write/f_expand/f_sync do FatFS)
+ *
+ * @var sensor_log_sink_t::write    Grava `bytes` bytes (sempre múltiplo de 512)
+ * @var sensor_log_sink_t::prealloc (Opcional) reserva o arquivo inteiro
+ *                                  (f_expand) antes do primeiro bloco
+ * @var sensor_log_sink_t::sync     (Opcional) f_sync
+ */
+typedef struct {
+    void *ctx;
+    bool (*write)(void *ctx, const uint8_t *buf, uint32_t bytes);
+    bool (*prealloc)(void *ctx, uint64_t bytes);
+    bool (*sync)(void *ctx);
+} sensor_log_sink_t;
+
+/**
+ * @struct sensor_log_stats_t
+ * @brief Contadores do gravador
+ *
+ * @var sensor_log_stats_t::samples      Amostras aceitas
+ * @var sensor_log_stats_t::dropped      Amostras descartadas (os dois buffers cheios)
+ * @var sensor_log_stats_t::blocks       Blocos gravados
+ * @var sensor_log_stats_t::bytes        Bytes gravados (cabeçalho incluso)
+ * @var sensor_log_stats_t::write_errors Falhas do destino
+ */
+typedef struct {
+    uint32_t samples;
+    uint32_t dropped;
+    uint32_t blocks;
+    uint64_t bytes;
+    uint32_t write_errors;
+} sensor_log_stats_t;
+
+/**
+ * @struct sensor_log_writer_t
+ * @brief Estado do gravador
+ *
+ * @details sensor_log_append() só codifica no buffer ativo (sem E/S) e pode
+ *          ser chamado no laço de amostragem ou numa interrupção;
+ *          sensor_log_service() grava os buffers completos e pode rodar no
+ *          laço principal ou no outro core. Enquanto um buffer é gravado o
+ *          outro continua recebendo amostras.
+ */
+typedef struct {
+    sensor_log_sink_t sink;
+    uint16_t block_bytes;
+    uint8_t encoding;
+    uint8_t n_channels;
+
+    uint8_t *buf[2];
+    volatile uint8_t ready[2];     /**< Bloco fechado, aguardando gravação */
+    uint8_t active;                /**< Buffer recebendo amostras */
+    uint8_t next_write;            /**< Próximo buffer a gravar (ordem) */
+    bool stalled;                  /**< Ativo cheio e o outro ainda pendente */
+
+    uint16_t fill;                 /**< Bytes de payload no ativo */
+    uint16_t n_samples;
+    uint64_t t_first;
+    uint64_t t_last;
+    int16_t prev[SENSOR_LOG_MAX_CHANNELS];
+    uint32_t seq;
+
+    /* PACKED: amostras aguardando completar um grupo */
+    int16_t stage[SENSOR_PACK_GROUP * SENSOR_LOG_MAX_CHANNELS];  /**< n_channels por amostra */
+    uint64_t t_stage[SENSOR_PACK_GROUP];
+    uint8_t staged;
+
+    sensor_log_stats_t stats;
+} sensor_log_writer_t;
+
+/**
+ * @brief Abre o gravador: reserva o arquivo e grava o cabeçalho
+ *
+ * @param buffers        2 * h->block_bytes bytes
+ * @param prealloc_bytes Tamanho a reservar com sink->prealloc (0 = não reserva)
+ * @return false se o cabeçalho for inválido ou o destino falhar
+ */
+bool sensor_log_writer_open(sensor_log_writer_t *w, const sensor_log_sink_t *sink,
+                            const sensor_log_header_t *h, uint8_t *buffers,
+                            uint64_t prealloc_bytes);
+
+/**
+ * @brief Acrescenta uma amostra (n_channels valores) sem fazer E/S
+ *
+ * @details Em PACKED, a cada SENSOR_PACK_GROUP amostras a chamada empacota o
+ *          grupo pendente (custo limitado a SENSOR_PACK_GROUP * n_channels
+ *          valores); nas demais só copia a amostra.
+ *
+ * @return false se a amostra foi descartada (os dois buffers cheios)
+ */
+bool sensor_log_append(sensor_log_writer_t *w, uint64_t t_us, const int16_t *values);
+
+/** Grava os blocos completos, em ordem; false se o destino falhar */
+bool sensor_log_service(sensor_log_writer_t *w);
+
+/** Fecha o bloco parcial, grava tudo e chama sink->sync */
+bool sensor_log_writer_close(sensor_log_writer_t *w);
+
+/* =============================================================================
+ * SEÇÃO 4: LEITURA
+ * =============================================================================
+ */
+
+/**
+ * @struct sensor_log_block_t
+ * @brief Metadados de um bloco decodificado
+ */
+typedef struct {
+    uint32_t seq;
+    uint64_t t_first_us;
+    uint32_t t_span_us;
+    uint16_t n_samples;
+    uint8_t encoding;
+} sensor_log_block_t;
+
+/**
+ * @brief Valida e decodifica um bloco
+ *
+ * @param blk         block_bytes bytes
+ * @param out         Amostras decodificadas, n_channels valores por amostra
+ * @param max_samples Capacidade de `out` em amostras (basta
+ *                    SENSOR_LOG_MAX_VALUES(block_bytes) / n_channels)
+ * @return false se o CRC, a assinatura ou o payload forem inválidos
+ */
+bool sensor_log_block_decode(const sensor_log_header_t *h, const uint8_t *blk,
+                             sensor_log_block_t *info, int16_t *out, uint32_t max_samples);
+
+/** Instante da amostra `i` de um bloco (interpolado entre o primeiro e o último) */
+uint64_t sensor_log_sample_time(const sensor_log_block_t *info, uint16_t i);
+
+/** Valor físico de um valor bruto do canal */
+float sensor_log_value(const sensor_log_channel_t *ch, int16_t raw);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_LOG_H */
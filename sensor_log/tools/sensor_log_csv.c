@@ -0,0 +1,132 @@
+/**
+ * =============================================================================
+ * @file    sensor_log_csv.c
+ * @brief   (Host) Converte um arquivo sensor_log para CSV
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Imprime uma linha por amostra: t_us e um valor por canal, em
+ *          unidades físicas (ou brutos, com -r). Blocos com CRC inválido são
+ *          pulados com aviso; a leitura termina no primeiro bloco vazio
+ *          (parte do arquivo reservada pelo f_expand e nunca gravada).
+ *
+ *          Uso: sensor_log_csv [-r] entrada.slog [saida.csv]
+ *          Retorno: 0 sem blocos inválidos, 1 se algum foi pulado, 2 erro.
+ * =============================================================================
+ */
+
+#include "sensor_log.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_BLOCK 65024u
+
+static uint8_t block[MAX_BLOCK];
+static int16_t values[SENSOR_LOG_MAX_VALUES(MAX_BLOCK)];
+
+static bool all_zero(const uint8_t *p, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        if (p[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    bool raw = false;
+    int arg = 1;
+    if (arg < argc && strcmp(argv[arg], "-r") == 0) {
+        raw = true;
+        arg++;
+    }
+    if (arg >= argc || argc - arg > 2) {
+        fprintf(stderr, "uso: %s [-r] entrada.slog [saida.csv]\n", argv[0]);
+        return 2;
+    }
+
+    FILE *in = fopen(argv[arg], "rb");
+    if (!in) {
+        perror(argv[arg]);
+        return 2;
+    }
+    FILE *out = stdout;
+    if (arg + 1 < argc) {
+        out = fopen(argv[arg + 1], "w");
+        if (!out) {
+            perror(argv[arg + 1]);
+            fclose(in);
+            return 2;
+        }
+    }
+
+    sensor_log_header_t h;
+    if (fread(block, 1, SENSOR_LOG_HEADER_BYTES, in) != SENSOR_LOG_HEADER_BYTES ||
+        !sensor_log_header_decode(block, &h) || h.block_bytes > MAX_BLOCK) {
+        fprintf(stderr, "%s: cabeçalho inválido\n", argv[arg]);
+        fclose(in);
+        return 2;
+    }
+
+    fprintf(out, "t_us");
+    for (uint8_t c = 0; c < h.n_channels; c++) {
+        if (raw || h.channels[c].unit[0] == '\0') {
+            fprintf(out, ",%s", h.channels[c].name);
+        } else {
+            fprintf(out, ",%s_%s", h.channels[c].name, h.channels[c].unit);
+        }
+    }
+    fprintf(out, "\n");
+
+    const uint32_t max_samples = SENSOR_LOG_MAX_VALUES(h.block_bytes) / h.n_channels;
+    unsigned long blocks = 0, bad = 0, samples = 0, gaps = 0;
+    uint32_t expect_seq = 0;
+    while (fread(block, 1, h.block_bytes, in) == h.block_bytes) {
+        if (all_zero(block, h.block_bytes)) {
+            break;
+        }
+        sensor_log_block_t info;
+        if (!sensor_log_block_decode(&h, block, &info, values, max_samples)) {
+            fprintf(stderr, "aviso: bloco %lu inválido, pulado\n", blocks + bad);
+            bad++;
+            continue;
+        }
+        if (info.seq != expect_seq) {
+            gaps++;
+        }
+        expect_seq = info.seq + 1u;
+        blocks++;
+
+        for (uint16_t s = 0; s < info.n_samples; s++) {
+            const int16_t *v = values + (size_t)s * h.n_channels;
+            fprintf(out, "%llu", (unsigned long long)sensor_log_sample_time(&info, s));
+            for (uint8_t c = 0; c < h.n_channels; c++) {
+                const sensor_log_channel_t *ch = &h.channels[c];
+                if (raw) {
+                    fprintf(out, ",%d",
+                            (ch->flags & SENSOR_LOG_CH_UNSIGNED) ? (int)(uint16_t)v[c] : v[c]);
+                } else {
+                    fprintf(out, ",%.6g", (double)sensor_log_value(ch, v[c]));
+                }
+            }
+            fprintf(out, "\n");
+        }
+        samples += info.n_samples;
+    }
+
+    fprintf(stderr, "%s: \"%s\", %u canais, %lu blocos, %lu amostras, %lu inválidos, "
+            "%lu saltos de sequência\n",
+            argv[arg], h.title, h.n_channels, blocks, samples, bad, gaps);
+    fclose(in);
+    if (out != stdout) {
+        fclose(out);
+    }
+    return bad ? 1 : 0;
+}
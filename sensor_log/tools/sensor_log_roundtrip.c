@@ -0,0 +1,342 @@
+/**
+ * =============================================================================
+ * @file    sensor_log_roundtrip.c
+ * @brief   (Host) Grava logs em RAM e confere a decodificação amostra a amostra
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Um destino em RAM recebe o arquivo do gravador; o teste lê o
+ *          cabeçalho e os blocos de volta e compara com as amostras aceitas
+ *          pelo sensor_log_append(). Para RAW16 e DELTA8 (e PACKED, quando
+ *          não há descarte), com 1, 7 e 14 canais e blocos de 512 e 1024
+ *          bytes:
+ *          - sinal com passos pequenos, saltos que exigem o escape do DELTA8
+ *            e valores que atravessam o limite de 16 bits;
+ *          - descarte: o serviço para por um tempo, as amostras recusadas não
+ *            podem aparecer na leitura e o contador `dropped` confere;
+ *          - bloco corrompido: um byte trocado invalida só aquele bloco (os
+ *            outros continuam legíveis) e um cabeçalho corrompido é recusado.
+ *
+ *          Uso: sensor_log_roundtrip
+ *          Retorno: 0 se tudo conferiu, 1 caso contrário.
+ * =============================================================================
+ */
+
+#include "sensor_log.h"
+#include "test_check.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define MAX_BLOCK    1024u
+#define MAX_SAMPLES  4000u
+#define MAX_FILE     (SENSOR_LOG_HEADER_BYTES + 256u * MAX_BLOCK)
+
+/* =============================================================================
+ * SEÇÃO 1: DESTINO EM RAM
+ * =============================================================================
+ */
+
+typedef struct {
+    uint8_t data[MAX_FILE];
+    uint32_t size;
+    uint64_t reserved;
+    unsigned syncs;
+} ram_file_t;
+
+static ram_file_t file;
+
+static bool ram_write(void *ctx, const uint8_t *buf, uint32_t bytes) {
+    ram_file_t *f = ctx;
+    if (bytes % 512u != 0 || f->size + bytes > sizeof f->data) {
+        return false;
+    }
+    memcpy(f->data + f->size, buf, bytes);
+    f->size += bytes;
+    return true;
+}
+
+static bool ram_prealloc(void *ctx, uint64_t bytes) {
+    ((ram_file_t *)ctx)->reserved = bytes;
+    return true;
+}
+
+static bool ram_sync(void *ctx) {
+    ((ram_file_t *)ctx)->syncs++;
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: SINAL E REFERÊNCIA
+ * =============================================================================
+ */
+
+static uint32_t rng_state;
+
+static uint32_t rng(void) {
+    rng_state = rng_state * 1664525u + 1013904223u;
+    return rng_state >> 8;
+}
+
+/** Próxima amostra: passos pequenos, saltos grandes e passagens por ±32767 */
+static void next_sample(int16_t *v, uint8_t n_ch) {
+    for (uint8_t c = 0; c < n_ch; c++) {
+        const uint32_t r = rng() % 100u;
+        int32_t x = v[c];
+        if (r < 80u) {
+            x += (int32_t)(rng() % 201u) - 100;
+        } else if (r < 95u) {
+            x += (int32_t)(rng() % 20001u) - 10000;
+        } else {
+            x = (r & 1u) ? 32767 - (int32_t)(rng() % 50u) : -32768 + (int32_t)(rng() % 50u);
+        }
+        v[c] = (int16_t)(uint16_t)(uint32_t)x;   /* Estouro proposital */
+    }
+}
+
+/** Amostras aceitas pelo gravador, na ordem */
+static int16_t ref[MAX_SAMPLES * SENSOR_LOG_MAX_CHANNELS];
+static uint64_t ref_t[MAX_SAMPLES];
+static uint32_t n_ref;
+
+/** Amostras lidas de volta */
+static int16_t got[MAX_SAMPLES * SENSOR_LOG_MAX_CHANNELS];
+static uint64_t got_t[MAX_SAMPLES];
+static uint32_t n_got;
+
+static uint8_t buffers[2u * MAX_BLOCK];
+static int16_t values[SENSOR_LOG_MAX_VALUES(MAX_BLOCK)];
+
+/* Primeira amostra (índice em ref) e tamanho de cada bloco da gravação íntegra */
+static uint32_t block_first[256];
+static uint16_t block_samples[256];
+
+/* =============================================================================
+ * SEÇÃO 3: LEITURA
+ * =============================================================================
+ */
+
+typedef struct {
+    unsigned blocks;
+    unsigned bad;
+    unsigned gaps;
+} read_result_t;
+
+/**
+ * @brief Lê o arquivo em RAM para `got`
+ *
+ * @param skip Bloco que não deve ser lido (corrompido), ou -1
+ */
+static read_result_t read_back(const sensor_log_header_t *h, int skip) {
+    read_result_t r = { 0, 0, 0 };
+    sensor_log_header_t hd;
+    n_got = 0;
+    if (!sensor_log_header_decode(file.data, &hd)) {
+        CHECK(0, "cabeçalho ilegível");
+        return r;
+    }
+    CHECK(hd.n_channels == h->n_channels && hd.encoding == h->encoding &&
+              hd.block_bytes == h->block_bytes && hd.period_us == h->period_us &&
+              hd.start_us == h->start_us && strcmp(hd.title, h->title) == 0,
+          "cabeçalho lido difere do gravado");
+    for (uint8_t c = 0; c < hd.n_channels; c++) {
+        CHECK(memcmp(&hd.channels[c], &h->channels[c], sizeof hd.channels[c]) == 0,
+              "canal %u lido difere do gravado", c);
+    }
+
+    const uint32_t max_samples = SENSOR_LOG_MAX_VALUES(hd.block_bytes) / hd.n_channels;
+    uint32_t expect_seq = 0;
+    for (uint32_t off = SENSOR_LOG_HEADER_BYTES; off + hd.block_bytes <= file.size;
+         off += hd.block_bytes) {
+        const unsigned index = r.blocks + r.bad;
+        sensor_log_block_t info;
+        if (!sensor_log_block_decode(&hd, file.data + off, &info, values, max_samples)) {
+            CHECK((int)index == skip, "bloco %u íntegro recusado", index);
+            r.bad++;
+            continue;
+        }
+        CHECK((int)index != skip, "bloco %u corrompido aceito", index);
+        CHECK(info.encoding == hd.encoding, "bloco %u com codificação %u", index, info.encoding);
+        if (info.seq != expect_seq) {
+            r.gaps++;
+        }
+        expect_seq = info.seq + 1u;
+        if (n_got + info.n_samples > MAX_SAMPLES) {
+            CHECK(0, "amostras demais na leitura");
+            return r;
+        }
+        memcpy(got + (size_t)n_got * hd.n_channels, values,
+               (size_t)info.n_samples * hd.n_channels * sizeof values[0]);
+        for (uint16_t s = 0; s < info.n_samples; s++) {
+            got_t[n_got + s] = sensor_log_sample_time(&info, s);
+        }
+        if (skip < 0 && index < 256u) {
+            block_first[index] = n_got;
+            block_samples[index] = info.n_samples;
+        }
+        n_got += info.n_samples;
+        r.blocks++;
+    }
+    return r;
+}
+
+/** Compara `got` com `ref` sem as `hole_len` amostras a partir de `hole_first` */
+static void compare(uint8_t n_ch, uint32_t hole_first, uint32_t hole_len) {
+    CHECK(n_got + hole_len == n_ref, "%u amostras lidas, %u esperadas", (unsigned)n_got,
+          (unsigned)(n_ref - hole_len));
+    for (uint32_t i = 0, j = 0; i < n_got && j < n_ref; i++, j++) {
+        if (j == hole_first) {
+            j += hole_len;
+        }
+        if (memcmp(&got[(size_t)i * n_ch], &ref[(size_t)j * n_ch], n_ch * sizeof ref[0]) != 0) {
+            CHECK(0, "amostra %u difere (canal 0: %d, esperado %d)", (unsigned)j,
+                  got[(size_t)i * n_ch], ref[(size_t)j * n_ch]);
+            return;
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: CENÁRIOS
+ * =============================================================================
+ */
+
+typedef struct {
+    uint8_t encoding;
+    uint8_t n_channels;
+    uint16_t block_bytes;
+    uint32_t samples;
+    bool stall;          /**< Para o serviço no meio e força descarte */
+} run_t;
+
+static const char *const enc_name[] = { "RAW16", "DELTA8", "PACKED" };
+
+static void make_header(sensor_log_header_t *h, const run_t *r) {
+    sensor_log_header_init(h, "roundtrip", 1000u, 123456789012ull);
+    h->encoding = r->encoding;
+    h->block_bytes = r->block_bytes;
+    uint8_t left = r->n_channels;
+    while (left) {
+        const uint8_t n = left < 7u ? left : 7u;
+        sensor_log_header_add(h, SENSOR_LOG_MPU6050, n);
+        left = (uint8_t)(left - n);
+    }
+}
+
+/** Grava `r->samples` amostras; devolve o número de descartes */
+static uint32_t record(const run_t *r, const sensor_log_header_t *h, sensor_log_writer_t *w) {
+    const sensor_log_sink_t sink = { &file, ram_write, ram_prealloc, ram_sync };
+    memset(&file, 0, sizeof file);
+    n_ref = 0;
+    rng_state = 0x5EED0000u + r->encoding * 31u + r->n_channels * 7u + r->block_bytes;
+
+    const uint64_t prealloc = (uint64_t)MAX_FILE;
+    if (!sensor_log_writer_open(w, &sink, h, buffers, prealloc)) {
+        CHECK(0, "sensor_log_writer_open falhou");
+        return 0;
+    }
+    CHECK(file.reserved == prealloc && file.size == SENSOR_LOG_HEADER_BYTES,
+          "abertura: reserva %llu, %u bytes gravados", (unsigned long long)file.reserved,
+          (unsigned)file.size);
+
+    int16_t v[SENSOR_LOG_MAX_CHANNELS] = { 0 };
+    uint32_t refused = 0;
+    uint64_t t = h->start_us;
+    for (uint32_t i = 0; i < r->samples; i++) {
+        next_sample(v, r->n_channels);
+        t += h->period_us + rng() % 50u;
+        if (sensor_log_append(w, t, v)) {
+            memcpy(&ref[(size_t)n_ref * r->n_channels], v, r->n_channels * sizeof v[0]);
+            ref_t[n_ref++] = t;
+        } else {
+            refused++;
+        }
+        /* O serviço roda a cada 5 amostras, exceto na janela de parada */
+        const bool stalled = r->stall && i >= r->samples / 3u && i < r->samples / 2u;
+        if (!stalled && i % 5u == 4u) {
+            CHECK(sensor_log_service(w), "sensor_log_service falhou");
+        }
+    }
+    CHECK(sensor_log_writer_close(w), "sensor_log_writer_close falhou");
+    CHECK(file.syncs == 1u, "%u sync no fechamento", file.syncs);
+    return refused;
+}
+
+static void run(const run_t *r) {
+    static sensor_log_writer_t w;
+    sensor_log_header_t h;
+    make_header(&h, r);
+    const unsigned before = failures;
+
+    const uint32_t refused = record(r, &h, &w);
+    const uint32_t blocks = (file.size - SENSOR_LOG_HEADER_BYTES) / r->block_bytes;
+    CHECK((file.size - SENSOR_LOG_HEADER_BYTES) % r->block_bytes == 0,
+          "arquivo de %u bytes não é múltiplo do bloco", (unsigned)file.size);
+    CHECK(w.stats.samples == n_ref && w.stats.dropped == refused && w.stats.blocks == blocks &&
+              w.stats.bytes == file.size && w.stats.write_errors == 0,
+          "contadores: %u amostras (%u aceitas), %u descartes (%u recusadas), %u blocos (%u)",
+          (unsigned)w.stats.samples, (unsigned)n_ref, (unsigned)w.stats.dropped,
+          (unsigned)refused, (unsigned)w.stats.blocks, (unsigned)blocks);
+    if (r->stall) {
+        CHECK(refused > 0, "a parada do serviço não causou descarte");
+    } else {
+        CHECK(refused == 0, "%u descartes sem parada do serviço", (unsigned)refused);
+    }
+
+    /* Leitura íntegra */
+    const read_result_t full = read_back(&h, -1);
+    CHECK(full.blocks == blocks && full.bad == 0 && full.gaps == 0,
+          "leitura: %u blocos, %u inválidos, %u saltos", full.blocks, full.bad, full.gaps);
+    compare(r->n_channels, n_ref, 0);
+    for (unsigned b = 0; b < full.blocks && b < 256u; b++) {
+        const uint32_t first = block_first[b];
+        const uint32_t last = first + block_samples[b] - 1u;
+        CHECK(got_t[first] == ref_t[first] && got_t[last] == ref_t[last],
+              "bloco %u: instantes das pontas diferem", b);
+    }
+
+    /* Bloco do meio corrompido: só ele some */
+    const unsigned bad_block = blocks / 2u;
+    uint8_t *target = file.data + SENSOR_LOG_HEADER_BYTES + (size_t)bad_block * r->block_bytes +
+                      SENSOR_LOG_BLOCK_HDR + 1u;
+    *target ^= 0x40u;
+    const read_result_t cut = read_back(&h, (int)bad_block);
+    CHECK(cut.bad == 1u && cut.blocks == blocks - 1u && cut.gaps == 1u,
+          "corrompido: %u blocos, %u inválidos, %u saltos", cut.blocks, cut.bad, cut.gaps);
+    compare(r->n_channels, block_first[bad_block], block_samples[bad_block]);
+    *target ^= 0x40u;
+
+    /* Cabeçalho corrompido */
+    sensor_log_header_t hd;
+    file.data[30] ^= 0x01u;
+    CHECK(!sensor_log_header_decode(file.data, &hd), "cabeçalho corrompido aceito");
+    file.data[30] ^= 0x01u;
+
+    printf("%-6s %2u canais, bloco %4u: %5u amostras, %3u blocos, %4u descartes: %s\n",
+           enc_name[r->encoding], r->n_channels, r->block_bytes, (unsigned)n_ref, blocks,
+           (unsigned)refused, failures == before ? "ok" : "FALHA");
+}
+
+int main(void) {
+    static const run_t runs[] = {
+        { SENSOR_LOG_RAW16,  7,  512, 2000, false },
+        { SENSOR_LOG_RAW16,  7,  512, 2000, true },
+        { SENSOR_LOG_RAW16,  14, 1024, 1500, true },
+        { SENSOR_LOG_RAW16,  1,  512, 3000, false },
+        { SENSOR_LOG_DELTA8, 7,  512, 2000, false },
+        { SENSOR_LOG_DELTA8, 7,  512, 2000, true },
+        { SENSOR_LOG_DELTA8, 14, 1024, 1500, true },
+        { SENSOR_LOG_DELTA8, 1,  512, 3000, false },
+        { SENSOR_LOG_PACKED, 7,  512, 2000, false },
+        { SENSOR_LOG_PACKED, 14, 1024, 1500, false },
+    };
+    for (size_t i = 0; i < sizeof runs / sizeof runs[0]; i++) {
+        run(&runs[i]);
+    }
+    return test_check_summary();
+}
@@ -0,0 +1,223 @@
+/**
+ * =============================================================================
+ * @file    sensor_pack.c
+ * @brief   Implementação do codec delta + zig-zag + bit packing
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ * =============================================================================
+ */
+
+#include "sensor_pack.h"
+
+/* =============================================================================
+ * SEÇÃO 1: AUXILIARES
+ * =============================================================================
+ */
+
+static inline uint16_t zigzag(int16_t v) {
+    return (uint16_t)(((uint16_t)v << 1) ^ (v < 0 ? 0xFFFFu : 0u));
+}
+
+static inline int16_t unzigzag(uint16_t z) {
+    return (int16_t)((z >> 1) ^ (uint16_t)(0u - (z & 1u)));
+}
+
+static inline uint32_t varint_len(uint16_t v) {
+    return v < 0x80u ? 1u : (v < 0x4000u ? 2u : 3u);
+}
+
+/** Bits necessários para `v` (0 a 16); o M0+ não tem CLZ */
+static inline uint8_t bit_width(uint16_t v) {
+    uint8_t w = 0;
+    if (v & 0xFF00u) { w = 8; v >>= 8; }
+    if (v & 0x00F0u) { w += 4; v >>= 4; }
+    if (v & 0x000Cu) { w += 2; v >>= 2; }
+    if (v & 0x0002u) { w += 1; v >>= 1; }
+    return (uint8_t)(w + v);
+}
+
+/** Menor delta e largura de um canal do grupo */
+static void scan_channel(const int16_t *samples, uint8_t n_ch, uint8_t n, int16_t prev,
+                         int16_t *ref, uint8_t *width) {
+    int16_t lo = 0x7FFF;
+    int16_t hi = (int16_t)-0x8000;
+    for (uint8_t i = 0; i < n; i++) {
+        const int16_t x = samples[(uint32_t)i * n_ch];
+        const int16_t d = (int16_t)(uint16_t)((uint16_t)x - (uint16_t)prev);
+        lo = d < lo ? d : lo;
+        hi = d > hi ? d : hi;
+        prev = x;
+    }
+    /* Todos os valores ficam em [0, hi - lo] */
+    *ref = lo;
+    *width = bit_width((uint16_t)((uint16_t)hi - (uint16_t)lo));
+}
+
+/* =============================================================================
+ * SEÇÃO 2: GRUPOS
+ * =============================================================================
+ */
+
+uint32_t sensor_pack_group_size(const int16_t *samples, uint8_t n_ch, uint8_t n,
+                                const int16_t *prev) {
+    uint32_t bytes = 0;
+    for (uint8_t c = 0; c < n_ch; c++) {
+        int16_t ref;
+        uint8_t w;
+        scan_channel(samples + c, n_ch, n, prev[c], &ref, &w);
+        bytes += 1u + varint_len(zigzag(ref)) + (((uint32_t)n * w + 7u) >> 3);
+    }
+    return bytes;
+}
+
+uint32_t sensor_pack_encode_group(const int16_t *samples, uint8_t n_ch, uint8_t n,
+                                  int16_t *prev, uint8_t *dst) {
+    uint8_t *p = dst;
+    for (uint8_t c = 0; c < n_ch; c++) {
+        const int16_t *s = samples + c;
+        int16_t ref;
+        uint8_t w;
+        scan_channel(s, n_ch, n, prev[c], &ref, &w);
+
+        *p++ = w;
+        uint16_t z = zigzag(ref);
+        while (z >= 0x80u) {
+            *p++ = (uint8_t)(z | 0x80u);
+            z >>= 7;
+        }
+        *p++ = (uint8_t)z;
+
+        /* Acumulador de 32 bits: no máximo 7 + 16 bits pendentes */
+        uint32_t acc = 0;
+        uint32_t bits = 0;
+        int16_t last = prev[c];
+        for (uint8_t i = 0; i < n; i++) {
+            const int16_t x = s[(uint32_t)i * n_ch];
+            const uint16_t u = (uint16_t)((uint16_t)x - (uint16_t)last - (uint16_t)ref);
+            last = x;
+            acc |= (uint32_t)u << bits;
+            bits += w;
+            while (bits >= 8u) {
+                *p++ = (uint8_t)acc;
+                acc >>= 8;
+                bits -= 8u;
+            }
+        }
+        if (bits) {
+            *p++ = (uint8_t)acc;
+        }
+        prev[c] = last;
+    }
+    return (uint32_t)(p - dst);
+}
+
+uint32_t sensor_pack_decode_group(const uint8_t *src, uint32_t len, uint8_t n_ch, uint8_t n,
+                                  int16_t *prev, int16_t *out) {
+    const uint8_t *p = src;
+    const uint8_t *end = src + len;
+    for (uint8_t c = 0; c < n_ch; c++) {
+        if (p >= end || *p > 16u) {
+            return 0;
+        }
+        const uint8_t w = *p++;
+
+        uint32_t z = 0;
+        for (uint32_t shift = 0;; shift += 7u) {
+            if (p >= end || shift > 14u) {
+                return 0;
+            }
+            const uint8_t b = *p++;
+            z |= (uint32_t)(b & 0x7Fu) << shift;
+            if (!(b & 0x80u)) {
+                break;
+            }
+        }
+        if (z > 0xFFFFu) {
+            return 0;
+        }
+        const uint16_t ref = (uint16_t)unzigzag((uint16_t)z);
+
+        const uint32_t packed = ((uint32_t)n * w + 7u) >> 3;
+        if ((uint32_t)(end - p) < packed) {
+            return 0;
+        }
+        const uint32_t mask = (1u << w) - 1u;
+        uint32_t acc = 0;
+        uint32_t bits = 0;
+        uint16_t last = (uint16_t)prev[c];
+        for (uint8_t i = 0; i < n; i++) {
+            while (bits < w) {
+                acc |= (uint32_t)*p++ << bits;
+                bits += 8u;
+            }
+            last = (uint16_t)(last + ref + (uint16_t)(acc & mask));
+            out[(uint32_t)i * n_ch + c] = (int16_t)last;
+            acc >>= w;
+            bits -= w;
+        }
+        prev[c] = (int16_t)last;
+    }
+    return (uint32_t)(p - src);
+}
+
+/* =============================================================================
+ * SEÇÃO 3: BLOCOS
+ * =============================================================================
+ */
+
+uint32_t sensor_pack_encode_block(const int16_t *samples, uint32_t n_samples, uint8_t n_ch,
+                                  uint8_t *dst, uint32_t cap) {
+    if (n_samples == 0 || n_ch == 0 || cap < 2u * n_ch) {
+        return 0;
+    }
+    int16_t prev[255];
+    uint32_t pos = 0;
+    for (uint8_t c = 0; c < n_ch; c++) {
+        prev[c] = samples[c];
+        dst[pos++] = (uint8_t)samples[c];
+        dst[pos++] = (uint8_t)((uint16_t)samples[c] >> 8);
+    }
+
+    for (uint32_t i = 1; i < n_samples; i += SENSOR_PACK_GROUP) {
+        const uint32_t left = n_samples - i;
+        const uint8_t n = (uint8_t)(left < SENSOR_PACK_GROUP ? left : SENSOR_PACK_GROUP);
+        const int16_t *s = samples + i * n_ch;
+        if (cap - pos < SENSOR_PACK_GROUP_MAX(n_ch) &&
+            cap - pos < sensor_pack_group_size(s, n_ch, n, prev)) {
+            return 0;
+        }
+        pos += sensor_pack_encode_group(s, n_ch, n, prev, dst + pos);
+    }
+    return pos;
+}
+
+bool sensor_pack_decode_block(const uint8_t *src, uint32_t len, uint32_t n_samples,
+                              uint8_t n_ch, int16_t *out) {
+    if (n_samples == 0 || n_ch == 0 || len < 2u * n_ch) {
+        return false;
+    }
+    int16_t prev[255];
+    uint32_t pos = 0;
+    for (uint8_t c = 0; c < n_ch; c++) {
+        prev[c] = (int16_t)(uint16_t)(src[pos] | src[pos + 1u] << 8);
+        out[c] = prev[c];
+        pos += 2u;
+    }
+
+    for (uint32_t i = 1; i < n_samples; i += SENSOR_PACK_GROUP) {
+        const uint32_t left = n_samples - i;
+        const uint8_t n = (uint8_t)(left < SENSOR_PACK_GROUP ? left : SENSOR_PACK_GROUP);
+        const uint32_t used = sensor_pack_decode_group(src + pos, len - pos, n_ch, n, prev,
+                                                       out + i * n_ch);
+        if (used == 0) {
+            return false;
+        }
+        pos += used;
+    }
+    return pos == len;
+}
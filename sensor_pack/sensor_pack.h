@@ -0,0 +1,125 @@
+/**
+ * =============================================================================
+ * @file    sensor_pack.h
+ * @brief   Compressão sem perdas de séries int16: delta + zig-zag + bit packing
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Codec para amostras multicanal de sensores (MPU6050, VL53L0X...),
+ *          pensado para o Cortex-M0+: só somas, deslocamentos e comparações,
+ *          sem divisão, sem tabelas e com custo fixo por grupo.
+ *
+ *          BLOCO (decodificável sozinho):
+ *          ┌──────────────────┬─────────────────────────────────────────────┐
+ *          │ Quadro-chave     │ 1ª amostra, int16 little-endian por canal   │
+ *          │ Grupo 0          │ até SENSOR_PACK_GROUP amostras seguintes    │
+ *          │ Grupo 1 ...      │ (só o último grupo pode ser incompleto)     │
+ *          └──────────────────┴─────────────────────────────────────────────┘
+ *
+ *          GRUPO (um trecho por canal, canal após canal):
+ *          ┌──────────────────┬─────────────────────────────────────────────┐
+ *          │ u8 largura w     │ bits por valor (0 a 16)                     │
+ *          │ referência m     │ menor delta do grupo, zig-zag em varint     │
+ *          │                  │ (1 a 3 bytes)                               │
+ *          │ n valores        │ delta - m em w bits, LSB primeiro           │
+ *          └──────────────────┴─────────────────────────────────────────────┘
+ *
+ *          O delta é a diferença para a amostra anterior do mesmo canal em
+ *          aritmética de 16 bits (reversível mesmo com estouro). Subtrair o
+ *          menor delta (frame of reference) faz uma rampa ou uma deriva
+ *          custarem só a largura do ruído. Um canal constante custa 2 bytes
+ *          a cada 16 amostras.
+ * =============================================================================
+ */
+
+#ifndef SENSOR_PACK_H
+#define SENSOR_PACK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Amostras por grupo: 16 valores de w bits ocupam exatamente 2w bytes */
+#define SENSOR_PACK_GROUP 16u
+
+/** Pior caso de um grupo completo de `n_ch` canais (w = 16) */
+#define SENSOR_PACK_GROUP_MAX(n_ch) ((uint32_t)(n_ch) * (4u + 2u * SENSOR_PACK_GROUP))
+
+/** Pior caso de um bloco de `n` amostras de `n_ch` canais */
+#define SENSOR_PACK_BLOCK_MAX(n, n_ch) \
+    (2u * (uint32_t)(n_ch) + \
+     (((n) + SENSOR_PACK_GROUP - 2u) / SENSOR_PACK_GROUP) * SENSOR_PACK_GROUP_MAX(n_ch))
+
+/* =============================================================================
+ * SEÇÃO 1: GRUPOS
+ * =============================================================================
+ */
+
+/**
+ * @brief Tamanho exato que um grupo ocuparia, sem codificar
+ *
+ * @param samples n amostras intercaladas (n_ch valores por amostra)
+ * @param n       1 a SENSOR_PACK_GROUP
+ * @param prev    Última amostra antes do grupo (n_ch valores)
+ */
+uint32_t sensor_pack_group_size(const int16_t *samples, uint8_t n_ch, uint8_t n,
+                                const int16_t *prev);
+
+/**
+ * @brief Codifica um grupo em `dst` (até SENSOR_PACK_GROUP_MAX(n_ch) bytes)
+ *
+ * @param prev Última amostra antes do grupo; sai com a última do grupo
+ * @return Bytes escritos
+ */
+uint32_t sensor_pack_encode_group(const int16_t *samples, uint8_t n_ch, uint8_t n,
+                                  int16_t *prev, uint8_t *dst);
+
+/**
+ * @brief Decodifica um grupo de `n` amostras
+ *
+ * @param len  Bytes disponíveis em `src`
+ * @param prev Última amostra antes do grupo; sai com a última do grupo
+ * @param out  n amostras intercaladas
+ * @return Bytes consumidos, ou 0 se o grupo for inválido ou truncado
+ */
+uint32_t sensor_pack_decode_group(const uint8_t *src, uint32_t len, uint8_t n_ch, uint8_t n,
+                                  int16_t *prev, int16_t *out);
+
+/* =============================================================================
+ * SEÇÃO 2: BLOCOS
+ * =============================================================================
+ */
+
+/**
+ * @brief Codifica um bloco (quadro-chave + grupos)
+ *
+ * @param samples   n_samples amostras intercaladas
+ * @param n_samples Pelo menos 1
+ * @param cap       Capacidade de `dst`
+ * @return Bytes escritos, ou 0 se não couber
+ */
+uint32_t sensor_pack_encode_block(const int16_t *samples, uint32_t n_samples, uint8_t n_ch,
+                                  uint8_t *dst, uint32_t cap);
+
+/**
+ * @brief Decodifica um bloco inteiro
+ *
+ * @param len Tamanho exato do bloco codificado
+ * @return false se o bloco for inválido, truncado ou tiver bytes sobrando
+ */
+bool sensor_pack_decode_block(const uint8_t *src, uint32_t len, uint32_t n_samples,
+                              uint8_t n_ch, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SENSOR_PACK_H */
@@ -0,0 +1,368 @@
+/**
+ * =============================================================================
+ * @file    sensor_pack_bench.c
+ * @brief   (Host) Razão de compressão e vazão do sensor_pack e do sensor_log
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Para cada conjunto de dados grava um arquivo sensor_log em memória
+ *          com RAW16, DELTA8 e PACKED, relê e confere cada amostra. Imprime
+ *          bytes por amostra, razão sobre o int16 bruto, MB/s de gravação e
+ *          leitura (bytes brutos por segundo) e o p99,9 do tempo de
+ *          sensor_log_append(), medido numa segunda passada (o máximo só
+ *          mostraria as preempções do sistema operacional).
+ *          Depois mede o codec sozinho em blocos de 256 amostras.
+ *
+ *          Os conjuntos sintéticos imitam o MPU6050 a 1 kHz (gravidade,
+ *          vibração e ruído), o VL53L0X (degraus com ruído) e o BH1750. Um
+ *          arquivo .slog gravado no kit pode ser passado para medir dados
+ *          reais.
+ *
+ *          Uso: sensor_pack_bench [-q] [gravacao.slog]
+ *            -q  conjuntos menores (rápido)
+ *          Retorno: 0 se todas as amostras forem recuperadas.
+ * =============================================================================
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "bench_report.h"
+#include "sensor_log.h"
+#include "sensor_pack.h"
+#include "test_check.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_VALUES  (600000u * 7u)
+#define FILE_BYTES  (16u << 20)
+#define BLOCK       512u
+
+static int16_t data[MAX_VALUES];
+static uint64_t stamps[MAX_VALUES];
+static int16_t decoded[SENSOR_LOG_MAX_VALUES(65024u)];
+static uint8_t file[FILE_BYTES];
+static uint8_t bufs[2 * 65024u];
+static float append_ns[600000u];
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/* =============================================================================
+ * SEÇÃO 1: CONJUNTOS DE DADOS
+ * =============================================================================
+ */
+
+typedef struct {
+    const char *name;
+    const sensor_log_channel_t *channels;
+    uint8_t n_channels;
+    uint32_t n_samples;
+    uint32_t period_us;
+} dataset_t;
+
+static uint32_t rng = 12345u;
+
+/** Ruído triangular em [-amp, amp] */
+static int32_t noise(int32_t amp) {
+    rng = rng * 1103515245u + 12345u;
+    const int32_t a = (int32_t)((rng >> 16) % (uint32_t)(amp + 1));
+    rng = rng * 1103515245u + 12345u;
+    const int32_t b = (int32_t)((rng >> 16) % (uint32_t)(amp + 1));
+    return a - b;
+}
+
+static int16_t clamp16(double v) {
+    return (int16_t)(v > 32767.0 ? 32767 : (v < -32768.0 ? -32768 : lround(v)));
+}
+
+static void synth_mpu6050(dataset_t *d, uint32_t n) {
+    const double pi = 3.14159265358979;
+    *d = (dataset_t){ "mpu6050", SENSOR_LOG_MPU6050, 7, n, 1000u };
+    for (uint32_t i = 0; i < n; i++) {
+        const double t = i * 1e-3;
+        const double tilt = 0.3 * sin(2 * pi * 0.2 * t);        /* movimento lento */
+        const double vib = 250.0 * sin(2 * pi * 37.0 * t);     /* motor */
+        int16_t *v = data + (size_t)i * 7u;
+        v[0] = clamp16(16384.0 * sin(tilt) + vib + noise(12));
+        v[1] = clamp16(0.3 * vib + noise(12));
+        v[2] = clamp16(16384.0 * cos(tilt) + noise(16));
+        v[3] = clamp16((30.0 + t / 60.0 - 36.53) * 340.0 + noise(2));
+        v[4] = clamp16(131.0 * 0.3 * 2 * pi * 0.2 * cos(2 * pi * 0.2 * t) * 57.3 / 10 + noise(6));
+        v[5] = clamp16(noise(6));
+        v[6] = clamp16(40.0 * sin(2 * pi * 1.5 * t) + noise(6));
+        stamps[i] = (uint64_t)i * 1000u;
+    }
+}
+
+static void synth_vl53l0x(dataset_t *d, uint32_t n) {
+    *d = (dataset_t){ "vl53l0x", SENSOR_LOG_VL53L0X, 1, n, 33000u };
+    int32_t target = 400;
+    for (uint32_t i = 0; i < n; i++) {
+        if (i % 90u == 0) {
+            target = 100 + (int32_t)((rng >> 8) % 1500u);
+        }
+        data[i] = (int16_t)(target + noise(4));
+        stamps[i] = (uint64_t)i * 33000u;
+    }
+}
+
+static void synth_bh1750(dataset_t *d, uint32_t n) {
+    const double pi = 3.14159265358979;
+    *d = (dataset_t){ "bh1750", SENSOR_LOG_BH1750, 1, n, 120000u };
+    for (uint32_t i = 0; i < n; i++) {
+        const double lux = 300.0 + 250.0 * sin(2 * pi * i / 5000.0);
+        data[i] = (int16_t)(uint16_t)lround(lux * 1.2 + noise(1) + 10);
+        stamps[i] = (uint64_t)i * 120000u;
+    }
+}
+
+/** Carrega todas as amostras válidas de um arquivo .slog */
+static bool load_slog(const char *path, dataset_t *d, sensor_log_header_t *h) {
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return false;
+    }
+    static uint8_t blk[65024u];
+    static sensor_log_channel_t channels[SENSOR_LOG_MAX_CHANNELS];
+    bool ok = fread(blk, 1, SENSOR_LOG_HEADER_BYTES, f) == SENSOR_LOG_HEADER_BYTES &&
+              sensor_log_header_decode(blk, h) && h->block_bytes <= sizeof blk;
+    uint32_t n = 0;
+    while (ok && fread(blk, 1, h->block_bytes, f) == h->block_bytes) {
+        sensor_log_block_t info;
+        const uint32_t room = (MAX_VALUES / h->n_channels) - n;
+        if (!sensor_log_block_decode(h, blk, &info, decoded,
+                                     SENSOR_LOG_MAX_VALUES(h->block_bytes) / h->n_channels)) {
+            continue;
+        }
+        const uint32_t take = info.n_samples < room ? info.n_samples : room;
+        memcpy(data + (size_t)n * h->n_channels, decoded,
+               (size_t)take * h->n_channels * sizeof data[0]);
+        for (uint32_t i = 0; i < take; i++) {
+            stamps[n + i] = sensor_log_sample_time(&info, (uint16_t)i);
+        }
+        n += take;
+    }
+    fclose(f);
+    if (!ok || n == 0) {
+        fprintf(stderr, "%s: arquivo inválido ou vazio\n", path);
+        return false;
+    }
+    memcpy(channels, h->channels, sizeof channels);
+    *d = (dataset_t){ "gravacao", channels, h->n_channels, n, h->period_us };
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 2: GRAVAÇÃO E LEITURA PELO sensor_log
+ * =============================================================================
+ */
+
+typedef struct {
+    uint32_t used;
+} mem_sink_t;
+
+static bool mem_write(void *ctx, const uint8_t *buf, uint32_t bytes) {
+    mem_sink_t *m = (mem_sink_t *)ctx;
+    if (m->used + bytes > FILE_BYTES) {
+        return false;
+    }
+    memcpy(file + m->used, buf, bytes);
+    m->used += bytes;
+    return true;
+}
+
+static int cmp_float(const void *a, const void *b) {
+    const float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+/** Grava o conjunto inteiro; com `timed`, guarda a duração de cada append */
+static double write_log(const dataset_t *d, const sensor_log_header_t *h, mem_sink_t *mem,
+                        sensor_log_writer_t *w, bool timed) {
+    const sensor_log_sink_t sink = { mem, mem_write, NULL, NULL };
+    mem->used = 0;
+    if (!sensor_log_writer_open(w, &sink, h, bufs, 0)) {
+        return -1.0;
+    }
+    const uint32_t n_timed = sizeof append_ns / sizeof append_ns[0];
+    const double t0 = now_s();
+    for (uint32_t i = 0; i < d->n_samples; i++) {
+        if (timed && i < n_timed) {
+            const double a = now_s();
+            sensor_log_append(w, stamps[i], data + (size_t)i * d->n_channels);
+            append_ns[i] = (float)((now_s() - a) * 1e9);
+        } else {
+            sensor_log_append(w, stamps[i], data + (size_t)i * d->n_channels);
+        }
+        sensor_log_service(w);
+    }
+    sensor_log_writer_close(w);
+    return now_s() - t0;
+}
+
+static int run_log(const dataset_t *d, uint8_t encoding, uint16_t block_bytes) {
+    static const char *const names[] = { "RAW16", "DELTA8", "PACKED" };
+    sensor_log_header_t h;
+    sensor_log_header_init(&h, d->name, d->period_us, 0);
+    sensor_log_header_add(&h, d->channels, d->n_channels);
+    h.encoding = encoding;
+    h.block_bytes = block_bytes;
+
+    mem_sink_t mem;
+    static sensor_log_writer_t w;
+    if (write_log(d, &h, &mem, &w, true) < 0.0) {
+        printf("FALHA %s/%s: abertura\n", d->name, names[encoding]);
+        return 1;
+    }
+    uint32_t n_timed = sizeof append_ns / sizeof append_ns[0];
+    n_timed = d->n_samples < n_timed ? d->n_samples : n_timed;
+    qsort(append_ns, n_timed, sizeof append_ns[0], cmp_float);
+    const double p999 = append_ns[(size_t)((n_timed - 1u) * 0.999)];
+
+    const double t_write = write_log(d, &h, &mem, &w, false);
+    if (w.stats.dropped || w.stats.samples != d->n_samples) {
+        printf("FALHA %s/%s: %u descartadas\n", d->name, names[encoding], w.stats.dropped);
+        return 1;
+    }
+
+    /* Leitura e conferência, bloco a bloco */
+    const double t1 = now_s();
+    uint32_t pos = 0;
+    int errors = 0;
+    for (uint32_t off = SENSOR_LOG_HEADER_BYTES; off < mem.used; off += block_bytes) {
+        sensor_log_block_t info;
+        if (!sensor_log_block_decode(&h, file + off, &info, decoded,
+                                     SENSOR_LOG_MAX_VALUES(block_bytes) / d->n_channels) ||
+            pos + info.n_samples > d->n_samples ||
+            memcmp(decoded, data + (size_t)pos * d->n_channels,
+                   (size_t)info.n_samples * d->n_channels * sizeof data[0]) != 0) {
+            errors++;
+            break;
+        }
+        pos += info.n_samples;
+    }
+    const double t_read = now_s() - t1;
+    if (errors || pos != d->n_samples) {
+        printf("FALHA %s/%s: leitura diverge na amostra %u\n", d->name, names[encoding], pos);
+        return 1;
+    }
+
+    const double raw = (double)d->n_samples * d->n_channels * 2.0;
+    const double stored = (double)(mem.used - SENSOR_LOG_HEADER_BYTES);
+    printf("%-9s %6u %9u %-7s %5u %9.2f %6.2fx %9.1f %9.1f %8.0f\n", d->name, d->n_channels,
+           d->n_samples, names[encoding], block_bytes, stored / d->n_samples, raw / stored,
+           raw / t_write * 1e-6, raw / t_read * 1e-6, p999);
+
+    static const char *const slugs[] = { "raw16", "delta8", "packed" };
+    char metric[64];
+    const int m = snprintf(metric, sizeof metric, "%s_%s_%u", d->name, slugs[encoding],
+                           block_bytes);
+    snprintf(metric + m, sizeof metric - (size_t)m, "_ratio");
+    bench_report("sensor_pack_bench", metric, raw / stored, "x");
+    snprintf(metric + m, sizeof metric - (size_t)m, "_write_mb_s");
+    bench_report("sensor_pack_bench", metric, raw / t_write * 1e-6, "MB/s");
+    snprintf(metric + m, sizeof metric - (size_t)m, "_append_p999_ns");
+    bench_report("sensor_pack_bench", metric, p999, "ns");
+    return 0;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: CODEC SOZINHO
+ * =============================================================================
+ */
+
+static int run_codec(const dataset_t *d) {
+    enum { CHUNK = 256 };
+    static uint8_t enc[SENSOR_PACK_BLOCK_MAX(CHUNK, SENSOR_LOG_MAX_CHANNELS)];
+    const uint32_t n_ch = d->n_channels;
+    const uint32_t chunks = d->n_samples / CHUNK;
+    if (chunks == 0) {
+        return 0;
+    }
+
+    uint64_t packed = 0;
+    int errors = 0;
+    double t_enc = 0.0, t_dec = 0.0;
+    for (uint32_t c = 0; c < chunks; c++) {
+        const int16_t *src = data + (size_t)c * CHUNK * n_ch;
+        double a = now_s();
+        const uint32_t len = sensor_pack_encode_block(src, CHUNK, (uint8_t)n_ch, enc, sizeof enc);
+        t_enc += now_s() - a;
+        a = now_s();
+        const bool ok = sensor_pack_decode_block(enc, len, CHUNK, (uint8_t)n_ch, decoded);
+        t_dec += now_s() - a;
+        if (!len || !ok || memcmp(decoded, src, (size_t)CHUNK * n_ch * sizeof src[0]) != 0) {
+            errors++;
+        }
+        packed += len;
+    }
+    const double raw = (double)chunks * CHUNK * n_ch * 2.0;
+    printf("%-9s codec, blocos de %d amostras: %6.2fx  codifica %8.1f MB/s  "
+           "decodifica %8.1f MB/s%s\n",
+           d->name, CHUNK, raw / (double)packed, raw / t_enc * 1e-6, raw / t_dec * 1e-6,
+           errors ? "  FALHA" : "");
+
+    char metric[64];
+    snprintf(metric, sizeof metric, "%s_codec_encode_mb_s", d->name);
+    bench_report("sensor_pack_bench", metric, raw / t_enc * 1e-6, "MB/s");
+    snprintf(metric, sizeof metric, "%s_codec_decode_mb_s", d->name);
+    bench_report("sensor_pack_bench", metric, raw / t_dec * 1e-6, "MB/s");
+    return errors ? 1 : 0;
+}
+
+static void run_all(const dataset_t *d) {
+    failures += (unsigned)run_log(d, SENSOR_LOG_RAW16, BLOCK);
+    failures += (unsigned)run_log(d, SENSOR_LOG_DELTA8, BLOCK);
+    failures += (unsigned)run_log(d, SENSOR_LOG_PACKED, BLOCK);
+    failures += (unsigned)run_log(d, SENSOR_LOG_PACKED, 4096u);
+    failures += (unsigned)run_codec(d);
+}
+
+int main(int argc, char **argv) {
+    bool quick = false;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-q") == 0) {
+            quick = true;
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            fprintf(stderr, "uso: %s [-q] [gravacao.slog]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    printf("%-9s %6s %9s %-7s %5s %9s %7s %9s %9s %8s\n", "conjunto", "canais", "amostras",
+           "codif", "bloco", "B/amostra", "razao", "grava MB/s", "le MB/s", "p99.9 ns");
+
+    dataset_t d;
+    if (path) {
+        sensor_log_header_t h;
+        if (!load_slog(path, &d, &h)) {
+            return 2;
+        }
+        run_all(&d);
+    } else {
+        synth_mpu6050(&d, quick ? 20000u : 600000u);
+        run_all(&d);
+        synth_vl53l0x(&d, quick ? 5000u : 100000u);
+        run_all(&d);
+        synth_bh1750(&d, quick ? 5000u : 100000u);
+        run_all(&d);
+    }
+
+    return test_check_summary();
+}
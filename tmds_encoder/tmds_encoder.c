@@ -0,0 +1,223 @@
+/**
+ * =============================================================================
+ * @file    tmds_encoder.c
+ * @brief   Implementação do codificador TMDS tabelado e da referência bit a bit
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details As tabelas são geradas em tmds_tables_init() pelo próprio
+ *          codificador de referência, de modo que o caminho tabelado é
+ *          bit a bit idêntico a ele por construção. No laço quente, um pixel
+ *          custa uma leitura de tabela, uma máscara e um deslocamento.
+ * =============================================================================
+ */
+
+#include "tmds_encoder.h"
+
+/* =============================================================================
+ * SEÇÃO 1: TABELAS
+ * =============================================================================
+ */
+
+/** [estado][byte] = símbolo | (próximo estado << 10) */
+static uint16_t tmds_table[TMDS_N_STATES][256];
+
+#define SYM(e)   ((uint32_t)(e) & 0x3FFu)
+#define NEXT(e)  ((uint8_t)((e) >> 10))
+
+/** Conta os bits em 1 de um byte */
+static inline int popcount8(uint32_t v) {
+    int n = 0;
+    for (; v; v &= v - 1u) {
+        n++;
+    }
+    return n;
+}
+
+uint16_t tmds_encode_ref(uint8_t d, int *cnt) {
+    /* Estágio 1: minimização de transições (XOR ou XNOR encadeado) */
+    const int n1d = popcount8(d);
+    const int use_xnor = (n1d > 4) || (n1d == 4 && (d & 1u) == 0);
+    uint32_t q_m = d & 1u;
+    for (int i = 1; i < 8; i++) {
+        uint32_t b = ((q_m >> (i - 1)) ^ ((uint32_t)d >> i)) & 1u;
+        if (use_xnor) {
+            b ^= 1u;
+        }
+        q_m |= b << i;
+    }
+    if (!use_xnor) {
+        q_m |= 1u << 8;
+    }
+
+    /* Estágio 2: balanceamento DC pela disparidade acumulada */
+    const int n1q = popcount8(q_m & 0xFFu);
+    const int n0q = 8 - n1q;
+    const uint32_t q8 = (q_m >> 8) & 1u;
+    uint32_t q_out;
+
+    if (*cnt == 0 || n1q == n0q) {
+        q_out = (q8 ? 0u : 1u) << 9 | q8 << 8 | (q8 ? (q_m & 0xFFu) : (~q_m & 0xFFu));
+        if (q8) {
+            *cnt += n1q - n0q;
+        } else {
+            *cnt += n0q - n1q;
+        }
+    } else if ((*cnt > 0 && n1q > n0q) || (*cnt < 0 && n0q > n1q)) {
+        q_out = 1u << 9 | q8 << 8 | (~q_m & 0xFFu);
+        *cnt += 2 * (int)q8 + (n0q - n1q);
+    } else {
+        q_out = q8 << 8 | (q_m & 0xFFu);
+        *cnt += -2 * (int)(1u - q8) + (n1q - n0q);
+    }
+    return (uint16_t)q_out;
+}
+
+void tmds_tables_init(void) {
+    for (int s = 0; s < TMDS_N_STATES; s++) {
+        for (int d = 0; d < 256; d++) {
+            int cnt = (s - TMDS_STATE_ZERO) * 2;
+            const uint16_t sym = tmds_encode_ref((uint8_t)d, &cnt);
+            tmds_table[s][d] = (uint16_t)(sym | (uint16_t)((cnt / 2 + TMDS_STATE_ZERO) << 10));
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: CODIFICAÇÃO TABELADA
+ * =============================================================================
+ */
+
+uint16_t tmds_encode_symbol(tmds_encoder_t *enc, uint8_t d) {
+    const uint16_t e = tmds_table[enc->state][d];
+    enc->state = NEXT(e);
+    return (uint16_t)SYM(e);
+}
+
+void tmds_encode_lane(tmds_encoder_t *enc, const uint8_t *data, size_t stride,
+                      size_t n, uint32_t *out) {
+    uint8_t s = enc->state;
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        const uint16_t e0 = tmds_table[s][data[0]];
+        const uint16_t e1 = tmds_table[NEXT(e0)][data[stride]];
+        *out++ = SYM(e0) | SYM(e1) << 10;
+        s = NEXT(e1);
+        data += 2 * stride;
+    }
+    enc->state = s;
+}
+
+void tmds_encode_run(tmds_encoder_t *enc, uint8_t d, size_t npairs, uint32_t *out) {
+    /*
+     * first[s]: par em que o estado s apareceu pela primeira vez no início
+     * de um par; hist[k]: estado no início do par k. Pelo princípio da casa
+     * dos pombos um estado se repete em no máximo TMDS_N_STATES pares.
+     */
+    int8_t first[TMDS_N_STATES] = { -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    uint8_t hist[TMDS_N_STATES];
+    uint8_t s = enc->state;
+
+    for (size_t k = 0; k < npairs; k++) {
+        if (first[s] >= 0) {
+            /* Ciclo de período p a partir do par j: o resto é cópia */
+            const size_t j = (size_t)first[s];
+            const size_t p = k - j;
+            for (size_t i = k; i < npairs; i++) {
+                out[i] = out[i - p];
+            }
+            s = hist[j + (npairs - j) % p];
+            break;
+        }
+        first[s] = (int8_t)k;
+        hist[k] = s;
+
+        const uint16_t e0 = tmds_table[s][d];
+        const uint16_t e1 = tmds_table[NEXT(e0)][d];
+        out[k] = SYM(e0) | SYM(e1) << 10;
+        s = NEXT(e1);
+    }
+    enc->state = s;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: LINHA RGB565
+ * =============================================================================
+ */
+
+/** Runs menores que isto não compensam a detecção de ciclo */
+#define TMDS_RUN_MIN_PAIRS 4u
+
+static inline uint8_t expand_r(uint16_t p) {
+    return (uint8_t)(((p >> 11) & 0x1Fu) << 3 | ((p >> 13) & 0x07u));
+}
+
+static inline uint8_t expand_g(uint16_t p) {
+    return (uint8_t)(((p >> 5) & 0x3Fu) << 2 | ((p >> 9) & 0x03u));
+}
+
+static inline uint8_t expand_b(uint16_t p) {
+    return (uint8_t)((p & 0x1Fu) << 3 | ((p >> 2) & 0x07u));
+}
+
+void tmds_encode_rgb565(tmds_encoder_t enc[3], const uint16_t *pix, size_t n,
+                        uint32_t *out_b, uint32_t *out_g, uint32_t *out_r) {
+    uint8_t sb = enc[0].state;
+    uint8_t sg = enc[1].state;
+    uint8_t sr = enc[2].state;
+    const size_t npairs = n / 2;
+    size_t k = 0;
+
+    while (k < npairs) {
+        const uint16_t p0 = pix[2 * k];
+        const uint16_t p1 = pix[2 * k + 1];
+
+        /* Mede o run de pares cujos dois pixels são iguais a p0 */
+        size_t run = 0;
+        if (p0 == p1) {
+            run = 1;
+            while (k + run < npairs && pix[2 * (k + run)] == p0 &&
+                   pix[2 * (k + run) + 1] == p0) {
+                run++;
+            }
+        }
+
+        if (run >= TMDS_RUN_MIN_PAIRS) {
+            enc[0].state = sb;
+            enc[1].state = sg;
+            enc[2].state = sr;
+            tmds_encode_run(&enc[0], expand_b(p0), run, out_b + k);
+            tmds_encode_run(&enc[1], expand_g(p0), run, out_g + k);
+            tmds_encode_run(&enc[2], expand_r(p0), run, out_r + k);
+            sb = enc[0].state;
+            sg = enc[1].state;
+            sr = enc[2].state;
+            k += run;
+            continue;
+        }
+
+        uint16_t e0 = tmds_table[sb][expand_b(p0)];
+        uint16_t e1 = tmds_table[NEXT(e0)][expand_b(p1)];
+        out_b[k] = SYM(e0) | SYM(e1) << 10;
+        sb = NEXT(e1);
+
+        e0 = tmds_table[sg][expand_g(p0)];
+        e1 = tmds_table[NEXT(e0)][expand_g(p1)];
+        out_g[k] = SYM(e0) | SYM(e1) << 10;
+        sg = NEXT(e1);
+
+        e0 = tmds_table[sr][expand_r(p0)];
+        e1 = tmds_table[NEXT(e0)][expand_r(p1)];
+        out_r[k] = SYM(e0) | SYM(e1) << 10;
+        sr = NEXT(e1);
+
+        k++;
+    }
+    enc[0].state = sb;
+    enc[1].state = sg;
+    enc[2].state = sr;
+}
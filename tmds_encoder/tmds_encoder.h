@@ -0,0 +1,160 @@
+/**
+ * =============================================================================
+ * @file    tmds_encoder.h
+ * @brief   Codificador TMDS (8b/10b do DVI/HDMI) orientado a tabelas
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Cada byte de cor vira um símbolo de 10 bits escolhido em função
+ *          da disparidade acumulada (running disparity) do canal. Calcular
+ *          isso bit a bit por pixel é o laço mais caro de qualquer conteúdo
+ *          HDMI além dos padrões estáticos de HDMI-RP2040-RP2350/main.c.
+ *
+ *          TABELAS POR ESTADO DE DISPARIDADE:
+ *          A disparidade só assume os valores pares -8..+8, ou seja, 9
+ *          estados. Para cada estado e cada byte a tabela guarda o símbolo e
+ *          o próximo estado num uint16_t:
+ *
+ *          ┌──────────────── entrada da tabela (uint16_t) ───────────────┐
+ *          │ bits 15..14: 0 │ bits 13..10: próximo estado │ 9..0: símbolo │
+ *          └─────────────────────────────────────────────────────────────┘
+ *          Tamanho: 9 x 256 x 2 = 4,5 KiB (em RAM, evitando a latência do XIP).
+ *
+ *          SAÍDA EMPACOTADA (2 símbolos por palavra):
+ *          ┌──────────────────────────── uint32_t ───────────────────────┐
+ *          │ 31..20: 0 │ 19..10: símbolo do pixel ímpar │ 9..0: par      │
+ *          └─────────────────────────────────────────────────────────────┘
+ *          O bit 0 é o primeiro transmitido: com a PIO deslocando para a
+ *          direita (out_shift_right) 10 bits por vez, uma palavra alimenta
+ *          dois pixels de uma lane.
+ *
+ *          CAMINHO RÁPIDO PARA RUNS:
+ *          Repetindo o mesmo byte, a sequência de estados no início de cada
+ *          par de pixels entra em ciclo em no máximo 9 pares. Ao detectar o
+ *          ciclo, o resto do run é apenas cópia das palavras do ciclo.
+ *
+ *          LANES: D0 = azul, D1 = verde, D2 = vermelho.
+ * =============================================================================
+ */
+
+#ifndef TMDS_ENCODER_H
+#define TMDS_ENCODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONSTANTES
+ * =============================================================================
+ */
+
+/** Número de estados de disparidade (-8, -6, ..., +8) */
+#define TMDS_N_STATES 9
+
+/** Índice do estado de disparidade zero (início de cada linha ativa) */
+#define TMDS_STATE_ZERO 4
+
+/** Símbolos de controle (período de blanking), indexados por (C1 << 1) | C0 */
+#define TMDS_CTRL_00 0x354u  /* 0b1101010100 */
+#define TMDS_CTRL_01 0x0ABu  /* 0b0010101011 */
+#define TMDS_CTRL_10 0x154u  /* 0b0101010100 */
+#define TMDS_CTRL_11 0x2ABu  /* 0b1010101011 */
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+/**
+ * @struct tmds_encoder_t
+ * @brief Estado de uma lane (disparidade acumulada como índice 0..8)
+ */
+typedef struct {
+    uint8_t state;
+} tmds_encoder_t;
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Monta as tabelas a partir do codificador de referência
+ *
+ * @details Deve ser chamada uma vez antes de qualquer tmds_encode_*()
+ *          tabelado. As tabelas ficam em RAM.
+ */
+void tmds_tables_init(void);
+
+/**
+ * @brief Codificador de referência, bit a bit, conforme a especificação DVI 1.0
+ *
+ * @param d   Byte de dado
+ * @param cnt Disparidade acumulada (entrada e saída)
+ * @return Símbolo de 10 bits
+ */
+uint16_t tmds_encode_ref(uint8_t d, int *cnt);
+
+/** Zera a disparidade (usar no início de cada período de dados) */
+static inline void tmds_encoder_reset(tmds_encoder_t *enc) {
+    enc->state = TMDS_STATE_ZERO;
+}
+
+/** Disparidade atual em unidades de bit (-8 .. +8) */
+static inline int tmds_encoder_disparity(const tmds_encoder_t *enc) {
+    return ((int)enc->state - TMDS_STATE_ZERO) * 2;
+}
+
+/**
+ * @brief Codifica um único byte pela tabela
+ */
+uint16_t tmds_encode_symbol(tmds_encoder_t *enc, uint8_t d);
+
+/**
+ * @brief Codifica n bytes (n par) de uma lane em n/2 palavras empacotadas
+ *
+ * @param enc    Estado da lane
+ * @param data   Primeiro byte
+ * @param stride Distância em bytes entre amostras consecutivas (ex.: 3 para
+ *               extrair uma componente de RGB888 intercalado)
+ * @param n      Número de amostras (par)
+ * @param out    n/2 palavras de saída
+ */
+void tmds_encode_lane(tmds_encoder_t *enc, const uint8_t *data, size_t stride,
+                      size_t n, uint32_t *out);
+
+/**
+ * @brief Codifica `npairs` pares de pixels iguais a `d` (caminho rápido)
+ */
+void tmds_encode_run(tmds_encoder_t *enc, uint8_t d, size_t npairs, uint32_t *out);
+
+/**
+ * @brief Codifica uma linha RGB565 nas três lanes
+ *
+ * @details As componentes são expandidas para 8 bits replicando os bits mais
+ *          significativos. Sequências de pixels iguais usam tmds_encode_run().
+ *
+ * @param enc   Estados das lanes [0] = azul (D0), [1] = verde (D1), [2] = vermelho (D2)
+ * @param pix   n pixels RGB565 (n par)
+ * @param n     Número de pixels
+ * @param out_b n/2 palavras da lane D0
+ * @param out_g n/2 palavras da lane D1
+ * @param out_r n/2 palavras da lane D2
+ */
+void tmds_encode_rgb565(tmds_encoder_t enc[3], const uint16_t *pix, size_t n,
+                        uint32_t *out_b, uint32_t *out_g, uint32_t *out_r);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TMDS_ENCODER_H */
@@ -0,0 +1,208 @@
+/**
+ * =============================================================================
+ * @file    tmds_bench.c
+ * @brief   (Host) Verificação bit a bit e benchmark do codificador TMDS
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Primeiro compara o caminho tabelado com tmds_encode_ref() em
+ *          todos os estados x bytes e em linhas com runs; depois mede a
+ *          vazão em pixels por segundo para linhas 720 px de barras de cor
+ *          (runs longos) e de ruído (sem runs).
+ *
+ *          Uso: tmds_bench [linhas]   (padrão: 20000)
+ *          Retorno: 0 se bit-exato, 1 caso contrário.
+ * =============================================================================
+ */
+
+#include "tmds_encoder.h"
+#include "bench_report.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define WIDTH 720u
+
+/* =============================================================================
+ * SEÇÃO 1: REFERÊNCIA
+ * =============================================================================
+ */
+
+static uint8_t expand(uint16_t p, int lane) {
+    switch (lane) {
+    case 0:  return (uint8_t)((p & 0x1Fu) << 3 | ((p >> 2) & 0x07u));
+    case 1:  return (uint8_t)(((p >> 5) & 0x3Fu) << 2 | ((p >> 9) & 0x03u));
+    default: return (uint8_t)(((p >> 11) & 0x1Fu) << 3 | ((p >> 13) & 0x07u));
+    }
+}
+
+/** Codifica uma lane da linha pela referência, no mesmo empacotamento */
+static void ref_lane(const uint16_t *pix, size_t n, int lane, int *cnt, uint32_t *out) {
+    for (size_t i = 0; i + 1 < n; i += 2) {
+        const uint32_t s0 = tmds_encode_ref(expand(pix[i], lane), cnt);
+        const uint32_t s1 = tmds_encode_ref(expand(pix[i + 1], lane), cnt);
+        out[i / 2] = s0 | s1 << 10;
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 2: LINHAS DE TESTE
+ * =============================================================================
+ */
+
+static void make_bars(uint16_t *pix, size_t n) {
+    static const uint16_t colors[8] = {
+        0xFFFF, 0xFFE0, 0x07FF, 0x07E0, 0xF81F, 0xF800, 0x001F, 0x0000,
+    };
+    for (size_t x = 0; x < n; x++) {
+        pix[x] = colors[x * 8 / n];
+    }
+}
+
+static void make_noise(uint16_t *pix, size_t n, uint32_t *seed) {
+    for (size_t x = 0; x < n; x++) {
+        *seed = *seed * 1664525u + 1013904223u;
+        pix[x] = (uint16_t)(*seed >> 16);
+    }
+}
+
+/** Runs de comprimento aleatório (1 a 40 pixels) com cores aleatórias */
+static void make_runs(uint16_t *pix, size_t n, uint32_t *seed) {
+    size_t x = 0;
+    while (x < n) {
+        *seed = *seed * 1664525u + 1013904223u;
+        const uint16_t c = (uint16_t)(*seed >> 16);
+        size_t len = 1 + (*seed >> 8) % 40u;
+        while (len-- && x < n) {
+            pix[x++] = c;
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: VERIFICAÇÃO
+ * =============================================================================
+ */
+
+static int check_tables(void) {
+    int errors = 0;
+    for (int s = 0; s < TMDS_N_STATES; s++) {
+        for (int d = 0; d < 256; d++) {
+            int cnt = (s - TMDS_STATE_ZERO) * 2;
+            tmds_encoder_t enc = { (uint8_t)s };
+            const uint16_t ref = tmds_encode_ref((uint8_t)d, &cnt);
+            const uint16_t got = tmds_encode_symbol(&enc, (uint8_t)d);
+            if (ref != got || cnt != tmds_encoder_disparity(&enc) || cnt < -8 || cnt > 8) {
+                errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+static int check_lines(void) {
+    static uint16_t pix[WIDTH];
+    static uint32_t got[3][WIDTH / 2];
+    static uint32_t ref[WIDTH / 2];
+    uint32_t seed = 12345u;
+    int errors = 0;
+
+    for (int t = 0; t < 3000; t++) {
+        if (t % 3 == 0) {
+            make_bars(pix, WIDTH);
+        } else if (t % 3 == 1) {
+            make_noise(pix, WIDTH, &seed);
+        } else {
+            make_runs(pix, WIDTH, &seed);
+        }
+
+        /* Disparidade inicial arbitrária, como no meio de uma linha */
+        tmds_encoder_t enc[3];
+        int cnt[3];
+        for (int l = 0; l < 3; l++) {
+            enc[l].state = (uint8_t)((t + l) % TMDS_N_STATES);
+            cnt[l] = tmds_encoder_disparity(&enc[l]);
+        }
+        tmds_encode_rgb565(enc, pix, WIDTH, got[0], got[1], got[2]);
+
+        for (int l = 0; l < 3; l++) {
+            ref_lane(pix, WIDTH, l, &cnt[l], ref);
+            for (size_t i = 0; i < WIDTH / 2; i++) {
+                errors += got[l][i] != ref[i];
+            }
+            errors += cnt[l] != tmds_encoder_disparity(&enc[l]);
+        }
+    }
+    return errors;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: BENCHMARK
+ * =============================================================================
+ */
+
+static double now_s(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/** Vazão em pixels/s de uma função de codificação de linha */
+static double bench(const char *name, const uint16_t *pix, unsigned lines, int use_ref) {
+    static uint32_t out[3][WIDTH / 2];
+    tmds_encoder_t enc[3] = { { TMDS_STATE_ZERO }, { TMDS_STATE_ZERO }, { TMDS_STATE_ZERO } };
+    int cnt[3] = { 0, 0, 0 };
+    uint32_t sink = 0;
+
+    const double t0 = now_s();
+    for (unsigned y = 0; y < lines; y++) {
+        if (use_ref) {
+            for (int l = 0; l < 3; l++) {
+                ref_lane(pix, WIDTH, l, &cnt[l], out[l]);
+            }
+        } else {
+            tmds_encode_rgb565(enc, pix, WIDTH, out[0], out[1], out[2]);
+        }
+        sink += out[0][y % (WIDTH / 2)] ^ out[2][(y * 7u) % (WIDTH / 2)];
+    }
+    const double dt = now_s() - t0;
+    const double px_s = (double)lines * WIDTH / dt;
+    printf("%-22s %10.2f Mpixel/s  (sink %08x)\n", name, px_s * 1e-6, (unsigned)sink);
+    return px_s;
+}
+
+int main(int argc, char **argv) {
+    const unsigned lines = (argc > 1) ? (unsigned)strtoul(argv[1], NULL, 10) : 20000u;
+    static uint16_t bars[WIDTH];
+    static uint16_t noise[WIDTH];
+    uint32_t seed = 1u;
+
+    tmds_tables_init();
+
+    const int table_errors = check_tables();
+    const int line_errors = check_lines();
+    printf("tabelas: %s (%d erros)\n", table_errors ? "FALHA" : "ok", table_errors);
+    printf("linhas:  %s (%d erros)\n", line_errors ? "FALHA" : "ok", line_errors);
+
+    make_bars(bars, WIDTH);
+    make_noise(noise, WIDTH, &seed);
+
+    const double ref_bars = bench("referencia / barras", bars, lines / 10u + 1u, 1);
+    const double tab_bars = bench("tabela / barras", bars, lines, 0);
+    const double ref_noise = bench("referencia / ruido", noise, lines / 10u + 1u, 1);
+    const double tab_noise = bench("tabela / ruido", noise, lines, 0);
+    printf("ganho: barras %.1fx, ruido %.1fx\n", tab_bars / ref_bars, tab_noise / ref_noise);
+
+    bench_report("tmds_bench", "bars_mpixel_s", tab_bars * 1e-6, "Mpixel/s");
+    bench_report("tmds_bench", "noise_mpixel_s", tab_noise * 1e-6, "Mpixel/s");
+    bench_report("tmds_bench", "bars_speedup", tab_bars / ref_bars, "x");
+    bench_report("tmds_bench", "noise_speedup", tab_noise / ref_noise, "x");
+
+    return (table_errors || line_errors) ? 1 : 0;
+}
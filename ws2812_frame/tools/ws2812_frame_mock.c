@@ -0,0 +1,457 @@
+/**
+ * =============================================================================
+ * @file    ws2812_frame_mock.c
+ * @brief   (Host) Confere a forma de onda e a temporização do ws2812_frame
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Simula em tempo virtual o timer do refresh, o DMA (FIFO de 8
+ *          palavras, latência de IRQ variável) e o laço principal chamando a
+ *          animação, incluindo um trecho em que o laço trava. Cada quadro
+ *          enviado passa por um interpretador do programa PIO
+ *          (ws2812_frame_pio_program) e a forma de onda é conferida:
+ *          - T0H/T0L/T1H/T1L dentro das janelas do WS2812B (±150 ns);
+ *          - os bits decodificados batem com o quadro entregue;
+ *          - o quadro bate com gamma e brilho calculados em double;
+ *          - entre dois quadros o pino fica baixo pelo menos o latch;
+ *          - cada envio sai num tick ou no fim do latch que o adiou.
+ *
+ *          Uso: ws2812_frame_mock [-v]
+ *          Retorno: 0 se todas as verificações passarem.
+ * =============================================================================
+ */
+
+#include "ws2812_frame.h"
+#include "bench_report.h"
+
+/* O laço de quadros pode falhar milhares de vezes: imprime só as primeiras */
+#define TEST_CHECK_MAX_REPORTS 20u
+#include "test_check.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define W          5u
+#define H          5u
+#define N_LEDS     (W * H)
+#define FIFO_WORDS 9u             /* FIFO TX unido (8) + registrador de deslocamento */
+#define WORD_NS    (24u * WS2812_FRAME_BIT_NS)
+#define CYCLE_NS   (WS2812_FRAME_BIT_NS / WS2812_FRAME_PIO_CYCLES)
+#define MAX_FRAMES 4096u
+
+static bool verbose = false;
+
+/* =============================================================================
+ * SEÇÃO 1: INTERPRETADOR DA PIO
+ * =============================================================================
+ */
+
+typedef struct {
+    uint8_t level;
+    uint32_t cycles;
+} run_t;
+
+static run_t runs[N_LEDS * 24u * 2u + 8u];
+
+/**
+ * @brief Executa o programa até os dados acabarem
+ *
+ * @details Subconjunto usado pelo programa: OUT x, JMP (sempre e !x) e
+ *          MOV (nop), com side-set obrigatório de 1 bit e atraso de 4 bits.
+ *          Autopull com limiar de 24 bits e deslocamento à esquerda. Com o
+ *          FIFO vazio o OUT trava e o pino fica no valor do side-set dele.
+ *
+ * @return Número de trechos (nível, ciclos) gerados
+ */
+static uint32_t pio_run(const uint16_t *prog, const uint32_t *words, uint32_t n) {
+    uint32_t n_runs = 0;
+    uint32_t pc = 0, x = 0, osr = 0, shifted = 24, next = 0;
+
+    for (;;) {
+        const uint16_t ins = prog[pc];
+        const uint8_t side = (uint8_t)((ins >> 12) & 1u);
+        const uint32_t delay = (ins >> 8) & 0xFu;
+        const uint16_t op = ins >> 13;
+
+        if (op == 3u && shifted >= 24u) {  /* OUT com OSR vazio: autopull */
+            if (next == n) {
+                break;                     /* FIFO vazio: trava com o pino baixo */
+            }
+            osr = words[next++];
+            shifted = 0;
+        }
+
+        uint32_t new_pc = (pc + 1u) % WS2812_FRAME_PIO_LEN;
+        switch (op) {
+        case 0: {                          /* JMP */
+            const uint16_t cond = (ins >> 5) & 7u;
+            if (cond == 0 || (cond == 1 && x == 0)) {
+                new_pc = ins & 0x1Fu;
+            }
+            break;
+        }
+        case 3: {                          /* OUT */
+            const uint32_t bits = (ins & 0x1Fu) ? (ins & 0x1Fu) : 32u;
+            const uint32_t v = osr >> (32u - bits);
+            osr <<= bits;
+            shifted += bits;
+            if (((ins >> 5) & 7u) == 1u) {
+                x = v;
+            }
+            break;
+        }
+        case 5:                            /* MOV (nop) */
+            break;
+        default:
+            CHECK(false, "instrução 0x%04X fora do subconjunto", ins);
+            return 0;
+        }
+
+        const uint32_t cycles = 1u + delay;
+        if (n_runs && runs[n_runs - 1u].level == side) {
+            runs[n_runs - 1u].cycles += cycles;
+        } else {
+            runs[n_runs++] = (run_t){ side, cycles };
+        }
+        pc = new_pc;
+    }
+    return n_runs;
+}
+
+typedef struct {
+    uint32_t t0h, t0l, t1h, t1l;   /* Últimos valores medidos (ns) */
+} bit_timing_t;
+
+/** Decodifica os trechos em palavras e confere as janelas de cada bit */
+static void check_waveform(const uint32_t *words, uint32_t n, bit_timing_t *bt) {
+    const uint32_t n_runs = pio_run(ws2812_frame_pio_program, words, n);
+    uint32_t decoded[N_LEDS] = { 0 };
+    uint32_t bit = 0;
+
+    /* O primeiro trecho é o pino baixo antes do primeiro dado */
+    for (uint32_t r = 1; r < n_runs; r += 2) {
+        CHECK(runs[r].level == 1, "trecho %u deveria ser alto", r);
+        const uint32_t high = runs[r].cycles * CYCLE_NS;
+        /* O último trecho baixo é cortado quando o OUT trava: vira o latch */
+        const bool last = (r + 2u >= n_runs);
+        const uint32_t low = last ? 0 : runs[r + 1u].cycles * CYCLE_NS;
+        const bool one = high > 600u;
+
+        if (one) {
+            CHECK(high >= 650u && high <= 950u, "T1H %u ns", high);
+            CHECK(last || (low >= 300u && low <= 600u), "T1L %u ns", low);
+            bt->t1h = high;
+            bt->t1l = last ? bt->t1l : low;
+        } else {
+            CHECK(high >= 250u && high <= 550u, "T0H %u ns", high);
+            CHECK(last || (low >= 700u && low <= 1000u), "T0L %u ns", low);
+            bt->t0h = high;
+            bt->t0l = last ? bt->t0l : low;
+        }
+        if (bit / 24u < N_LEDS) {
+            decoded[bit / 24u] |= (uint32_t)one << (31u - bit % 24u);
+        }
+        bit++;
+    }
+    CHECK(bit == n * 24u, "%u bits na forma de onda, esperados %u", bit, n * 24u);
+    CHECK(memcmp(decoded, words, n * sizeof words[0]) == 0, "bits decodificados divergem do quadro");
+}
+
+/* =============================================================================
+ * SEÇÃO 2: ANIMAÇÃO E REFERÊNCIA
+ * =============================================================================
+ */
+
+/** Cor do LED (x, y) no quadro `f`: gradiente que anda e um ponto que gira */
+static void pattern(uint32_t f, uint8_t x, uint8_t y, uint8_t *r, uint8_t *g, uint8_t *b) {
+    *r = (uint8_t)((x * 60u + f * 7u) & 0xFFu);
+    *g = (uint8_t)((y * 60u + f * 3u) & 0xFFu);
+    *b = (x == f % W && y == (f / W) % H) ? 255u : (uint8_t)(f & 0x3Fu);
+}
+
+static bool animate(ws2812_frame_t *e, uint32_t f, void *ctx) {
+    uint32_t *frame_of = (uint32_t *)ctx;
+    for (uint8_t y = 0; y < H; y++) {
+        for (uint8_t x = 0; x < W; x++) {
+            uint8_t r, g, b;
+            pattern(f, x, y, &r, &g, &b);
+            ws2812_frame_set_xy(e, x, y, r, g, b);
+        }
+    }
+    frame_of[e->front ^ 1u] = f;
+    return true;
+}
+
+static uint8_t ref_level(uint8_t c, double gamma, uint8_t brightness) {
+    return (uint8_t)(pow(c / 255.0, gamma) * brightness + 0.5);
+}
+
+static int diff8(uint32_t a, uint32_t b, unsigned shift) {
+    return abs((int)((a >> shift) & 0xFFu) - (int)((b >> shift) & 0xFFu));
+}
+
+/** Confere o quadro contra a referência em double (tolerância de 1 LSB) */
+static void check_content(const uint32_t *words, uint32_t f, double gamma, uint8_t brightness) {
+    for (uint8_t y = 0; y < H; y++) {
+        for (uint8_t x = 0; x < W; x++) {
+            uint8_t r, g, b;
+            pattern(f, x, y, &r, &g, &b);
+            const uint32_t want = (uint32_t)ref_level(g, gamma, brightness) << 24 |
+                                  (uint32_t)ref_level(r, gamma, brightness) << 16 |
+                                  (uint32_t)ref_level(b, gamma, brightness) << 8;
+            const uint32_t got = words[ws2812_frame_xy_index(W, H, x, y)];
+            CHECK(diff8(got, want, 24) <= 1 && diff8(got, want, 16) <= 1 &&
+                      diff8(got, want, 8) <= 1 && (got & 0xFFu) == 0,
+                  "quadro %u, LED (%u,%u): 0x%08X != 0x%08X", f, x, y, got, want);
+        }
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 3: SIMULAÇÃO EM TEMPO VIRTUAL
+ * =============================================================================
+ */
+
+typedef struct {
+    uint64_t start_ns;
+    uint32_t frame;
+    uint32_t words[N_LEDS];
+} sent_t;
+
+typedef struct {
+    uint64_t now_ns;
+    uint64_t dma_done_ns;      /* 0 = sem DMA em andamento */
+    uint64_t wire_end_ns;
+    uint32_t frame_of[2];      /* Quadro da animação em cada buffer */
+    ws2812_frame_t *e;
+    sent_t sent[MAX_FRAMES];
+    uint32_t n_sent;
+    uint32_t rng;
+} sim_t;
+
+static uint32_t sim_rand(sim_t *s, uint32_t mod) {
+    s->rng = s->rng * 1103515245u + 12345u;
+    return (s->rng >> 16) % mod;
+}
+
+static void mock_start(void *ctx, const uint32_t *words, uint16_t n) {
+    sim_t *s = (sim_t *)ctx;
+    CHECK(s->dma_done_ns == 0, "DMA disparado com outro em andamento");
+    if (s->n_sent < MAX_FRAMES) {
+        sent_t *f = &s->sent[s->n_sent++];
+        f->start_ns = s->now_ns;
+        f->frame = s->frame_of[s->e->front];
+        memcpy(f->words, words, n * sizeof words[0]);
+    }
+    /* O DMA termina quando a última palavra entra no FIFO; o IRQ atrasa até 40 us */
+    const uint32_t early = n > FIFO_WORDS ? n - FIFO_WORDS : 0;
+    s->wire_end_ns = s->now_ns + (uint64_t)n * WORD_NS;
+    s->dma_done_ns = s->now_ns + (uint64_t)early * WORD_NS + 1000u * sim_rand(s, 41u);
+}
+
+typedef struct {
+    uint32_t refresh_hz;
+    uint64_t duration_ms;
+    uint64_t stall_from_ms;    /* Laço principal travado neste intervalo */
+    uint64_t stall_to_ms;
+    uint32_t tick_jitter_us;   /* Atraso aleatório do IRQ do timer */
+    uint8_t brightness;
+} scenario_t;
+
+static sim_t sim;
+
+static void run_scenario(const char *name, const char *slug, const scenario_t *sc) {
+    static uint32_t buffers[2 * N_LEDS];
+    static ws2812_frame_t e;
+    memset(&sim, 0, sizeof sim);
+    sim.rng = 1u;
+    sim.e = &e;
+
+    const ws2812_frame_io_t io = { &sim, mock_start };
+    if (!ws2812_frame_init(&e, buffers, W, H, sc->refresh_hz, &io)) {
+        CHECK(false, "%s: init recusou %u Hz", name, sc->refresh_hz);
+        return;
+    }
+    ws2812_frame_set_brightness(&e, sc->brightness);
+    ws2812_frame_set_animation(&e, animate, sim.frame_of);
+
+    const uint64_t period_ns = (uint64_t)e.period_us * 1000u;
+    const uint64_t end_ns = sc->duration_ms * 1000000u;
+    uint64_t tick_base = period_ns;
+    uint64_t next_tick = tick_base + 1000u * sim_rand(&sim, sc->tick_jitter_us + 1u);
+    uint64_t next_loop = 0;
+    uint64_t alarm_ns = 0;
+    uint32_t ticks = 0;
+    uint64_t tick_times[MAX_FRAMES];   /* Instante do tick que originou cada envio */
+    uint64_t pending_tick = 0;
+
+    while (sim.now_ns < end_ns) {
+        /* Próximo evento: DMA, alarme de latch, tick ou volta do laço */
+        uint64_t t = next_tick;
+        if (alarm_ns && alarm_ns < t) t = alarm_ns;
+        if (sim.dma_done_ns && sim.dma_done_ns < t) t = sim.dma_done_ns;
+        if (next_loop < t) t = next_loop;
+        sim.now_ns = t;
+
+        if (sim.dma_done_ns && t == sim.dma_done_ns) {
+            const uint64_t left = sim.wire_end_ns > t ? sim.wire_end_ns - t : 0;
+            sim.dma_done_ns = 0;
+            ws2812_frame_dma_done(&e, t / 1000u, (uint32_t)((left + WORD_NS - 1u) / WORD_NS));
+        } else if (alarm_ns && t == alarm_ns) {
+            const uint32_t before = sim.n_sent;
+            const uint32_t wait = ws2812_frame_tick(&e, t / 1000u);
+            alarm_ns = wait ? t + (uint64_t)wait * 1000u : 0;
+            if (sim.n_sent != before && before < MAX_FRAMES) {
+                tick_times[before] = pending_tick;
+            }
+        } else if (t == next_tick) {
+            ticks++;
+            if (!alarm_ns) {
+                const uint32_t before = sim.n_sent;
+                const uint32_t wait = ws2812_frame_tick(&e, t / 1000u);
+                if (wait) {
+                    alarm_ns = t + (uint64_t)wait * 1000u;
+                    pending_tick = t;
+                } else if (sim.n_sent != before && before < MAX_FRAMES) {
+                    tick_times[before] = t;
+                }
+            }
+            /* Atraso independente por tick: um tick em dia logo após um atrasado */
+            tick_base += period_ns;
+            next_tick = tick_base + 1000u * sim_rand(&sim, sc->tick_jitter_us + 1u);
+        } else {
+            const uint64_t ms = t / 1000000u;
+            if (ms < sc->stall_from_ms || ms >= sc->stall_to_ms) {
+                ws2812_frame_service(&e);
+            }
+            next_loop = t + 1000000u;      /* Laço principal a cada 1 ms */
+        }
+    }
+
+    /* Conferências por quadro */
+    bit_timing_t bt = { 0 };
+    uint64_t min_gap = UINT64_MAX, max_delay = 0;
+    for (uint32_t i = 0; i < sim.n_sent; i++) {
+        const sent_t *f = &sim.sent[i];
+        check_waveform(f->words, N_LEDS, &bt);
+        check_content(f->words, f->frame, 2.2, sc->brightness);
+        if (i > 0) {
+            const sent_t *p = &sim.sent[i - 1u];
+            const uint64_t gap = f->start_ns - (p->start_ns + (uint64_t)N_LEDS * WORD_NS);
+            min_gap = gap < min_gap ? gap : min_gap;
+            CHECK(f->start_ns >= p->start_ns + (uint64_t)N_LEDS * WORD_NS +
+                                     (uint64_t)WS2812_FRAME_LATCH_US * 1000u,
+                  "%s: quadro %u começou %llu ns depois do anterior (latch violado)", name, i,
+                  (unsigned long long)(f->start_ns - p->start_ns));
+            CHECK(f->frame > p->frame, "%s: quadros fora de ordem (%u depois de %u)", name,
+                  f->frame, p->frame);
+        }
+        const uint64_t delay = f->start_ns - tick_times[i];
+        max_delay = delay > max_delay ? delay : max_delay;
+        CHECK(delay <= (uint64_t)(WS2812_FRAME_LATCH_US + 100u) * 1000u,
+              "%s: quadro %u saiu %llu us depois do tick", name, i,
+              (unsigned long long)(delay / 1000u));
+    }
+
+    ws2812_frame_stats_t st;
+    ws2812_frame_get_stats(&e, &st);
+    CHECK(st.frames_sent == sim.n_sent, "%s: frames_sent %u != %u", name, st.frames_sent,
+          sim.n_sent);
+    CHECK(st.frames_sent + st.missed + st.overruns == ticks - (alarm_ns ? 1u : 0u),
+          "%s: ticks %u != enviados %u + perdidos %u + overruns %u", name, ticks,
+          st.frames_sent, st.missed, st.overruns);
+    if (sc->stall_to_ms > sc->stall_from_ms) {
+        CHECK(st.missed > 0, "%s: travamento do laço não apareceu em missed", name);
+    }
+
+    printf("%-10s %5u Hz  %5u quadros  %4u perdidos  %4u adiados  folga min %6.1f us  "
+           "atraso max %5.1f us\n",
+           name, sc->refresh_hz, st.frames_sent, st.missed, st.latch_waits,
+           min_gap == UINT64_MAX ? 0.0 : min_gap / 1000.0, max_delay / 1000.0);
+
+    /* Tempo virtual com semente fixa: métricas deterministas */
+    char metric[48];
+    snprintf(metric, sizeof metric, "%s_frames", slug);
+    bench_report("ws2812_frame_mock", metric, st.frames_sent, "quadros");
+    snprintf(metric, sizeof metric, "%s_missed", slug);
+    bench_report("ws2812_frame_mock", metric, st.missed, "ticks");
+    snprintf(metric, sizeof metric, "%s_max_delay_us", slug);
+    bench_report("ws2812_frame_mock", metric, max_delay / 1000.0, "us");
+    if (verbose) {
+        printf("           T0H %u ns  T0L %u ns  T1H %u ns  T1L %u ns\n", bt.t0h, bt.t0l, bt.t1h,
+               bt.t1l);
+    }
+}
+
+/* =============================================================================
+ * SEÇÃO 4: CASOS DIRETOS
+ * =============================================================================
+ */
+
+static void check_api(void) {
+    static uint32_t buffers[2 * N_LEDS];
+    ws2812_frame_t e;
+    const ws2812_frame_io_t io = { &sim, mock_start };
+
+    /* 25 LEDs: 750 us de quadro + 280 us de latch */
+    CHECK(!ws2812_frame_init(&e, buffers, W, H, 1000u, &io), "1000 Hz deveria ser recusado");
+    CHECK(ws2812_frame_init(&e, buffers, W, H, 960u, &io), "960 Hz deveria ser aceito");
+
+    CHECK(ws2812_frame_xy_index(W, H, 0, 0) == 24u, "xy (0,0)");
+    CHECK(ws2812_frame_xy_index(W, H, 4, 0) == 20u, "xy (4,0)");
+    CHECK(ws2812_frame_xy_index(W, H, 0, 1) == 15u, "xy (0,1)");
+    CHECK(ws2812_frame_xy_index(W, H, 4, 4) == 0u, "xy (4,4)");
+
+    ws2812_frame_set_gamma(&e, 1.0f);
+    ws2812_frame_set_brightness(&e, 128u);
+    CHECK(ws2812_frame_grb(&e, 255, 0, 0) == 0x00800000u, "GRB de vermelho com brilho 128");
+    CHECK(ws2812_frame_grb(&e, 0, 255, 0) == 0x80000000u, "GRB de verde com brilho 128");
+
+    /* Tick no meio do latch: adiado exatamente até o fim */
+    memset(&sim, 0, sizeof sim);
+    sim.e = &e;
+    ws2812_frame_fill(&e, 1, 2, 3);
+    ws2812_frame_submit(&e);
+    CHECK(ws2812_frame_back(&e) == NULL, "buffer de trás deveria estar bloqueado");
+    const uint32_t submitted = e.buf[e.front ^ 1u][0];
+    CHECK(!ws2812_frame_set_pixel(&e, 0, 9, 9, 9) && !ws2812_frame_set_xy(&e, 1, 1, 9, 9, 9) &&
+              !ws2812_frame_fill(&e, 9, 9, 9),
+          "desenho com o buffer de trás bloqueado deveria ser recusado");
+    for (unsigned i = 0; i < N_LEDS; i++) {
+        CHECK(e.buf[e.front ^ 1u][i] == submitted, "quadro submetido alterado no LED %u", i);
+    }
+    CHECK(ws2812_frame_tick(&e, 0) == 0 && sim.n_sent == 1, "primeiro tick deveria enviar");
+    CHECK(ws2812_frame_back(&e) != NULL, "buffer de trás deveria estar livre após a troca");
+    CHECK(ws2812_frame_set_pixel(&e, 0, 1, 2, 3) && ws2812_frame_fill(&e, 1, 2, 3),
+          "desenho após a troca deveria ser aceito");
+    CHECK(ws2812_frame_tick(&e, 100) == 0 && e.stats.overruns == 1, "tick com DMA ativo");
+    sim.dma_done_ns = 0;
+    ws2812_frame_dma_done(&e, 500, 9);     /* 9 palavras = 270 us no fio */
+    ws2812_frame_submit(&e);
+    const uint32_t wait = ws2812_frame_tick(&e, 600);
+    CHECK(wait == 500u + 270u + WS2812_FRAME_LATCH_US - 600u, "espera do latch: %u us", wait);
+    CHECK(e.stats.latch_waits == 1, "latch_waits");
+    CHECK(ws2812_frame_tick(&e, 600 + wait) == 0 && sim.n_sent == 2, "envio no fim do latch");
+}
+
+int main(int argc, char **argv) {
+    verbose = argc > 1 && strcmp(argv[1], "-v") == 0;
+
+    check_api();
+
+    static const scenario_t normal = { 60u, 2000u, 0, 0, 20u, 64u };
+    static const scenario_t stall = { 100u, 2000u, 700u, 760u, 20u, 255u };
+    static const scenario_t limit = { 960u, 500u, 0, 0, 40u, 16u };
+    run_scenario("60 Hz", "60hz", &normal);
+    run_scenario("travamento", "stall", &stall);
+    run_scenario("limite", "960hz", &limit);
+
+    return test_check_summary();
+}
@@ -0,0 +1,321 @@
+/**
+ * =============================================================================
+ * @file    ws2812_frame.c
+ * @brief   Implementação do motor de quadros WS2812
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details Quem toca em quê:
+ *          ┌──────────────────┬──────────────────────────────────────────┐
+ *          │ laço principal   │ buffer de trás; liga back_ready          │
+ *          │ IRQ do timer     │ troca front, desliga back_ready, liga    │
+ *          │                  │ busy e dispara o DMA                     │
+ *          │ IRQ do DMA       │ grava latch_until e desliga busy         │
+ *          └──────────────────┴──────────────────────────────────────────┘
+ *          O tick só lê latch_until com busy desligado, e o DMA só volta a
+ *          escrevê-lo depois de um novo envio: não há corrida no valor de
+ *          64 bits do M0+.
+ * =============================================================================
+ */
+
+#include "ws2812_frame.h"
+
+#include <math.h>     /* Para powf */
+#include <string.h>   /* Para memset */
+
+#if WS2812_FRAME_USE_PIO
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#endif
+
+const uint16_t ws2812_frame_pio_program[WS2812_FRAME_PIO_LEN] = {
+    0x6221,  /* 0: out x, 1        side 0 [2] */
+    0x1223,  /* 1: jmp !x, 3       side 1 [2] */
+    0x1300,  /* 2: jmp 0           side 1 [3] */
+    0xA342,  /* 3: nop             side 0 [3] */
+};
+
+/* =============================================================================
+ * SEÇÃO 1: TABELAS DE GAMMA E BRILHO
+ * =============================================================================
+ */
+
+static void build_lut(ws2812_frame_t *e) {
+    for (int i = 0; i < 256; i++) {
+        const float v = powf((float)i / 255.0f, e->gamma) * (float)e->brightness;
+        e->lut[i] = (uint8_t)(v + 0.5f);
+    }
+}
+
+void ws2812_frame_set_gamma(ws2812_frame_t *e, float gamma) {
+    e->gamma = gamma > 0.0f ? gamma : 1.0f;
+    build_lut(e);
+}
+
+void ws2812_frame_set_brightness(ws2812_frame_t *e, uint8_t brightness) {
+    e->brightness = brightness;
+    build_lut(e);
+}
+
+/* =============================================================================
+ * SEÇÃO 2: QUADROS
+ * =============================================================================
+ */
+
+bool ws2812_frame_init(ws2812_frame_t *e, uint32_t *buffers, uint8_t width, uint8_t height,
+                       uint32_t refresh_hz, const ws2812_frame_io_t *io) {
+    const uint32_t n = (uint32_t)width * height;
+    if (!e || !buffers || (io && !io->start) || n == 0 || n > WS2812_FRAME_MAX_LEDS ||
+        refresh_hz == 0) {
+        return false;
+    }
+    /* O quadro inteiro e o latch precisam caber num período */
+    const uint32_t period_us = 1000000u / refresh_hz;
+    const uint32_t frame_us = (n * 24u * WS2812_FRAME_BIT_NS + 999u) / 1000u;
+    if (period_us < frame_us + WS2812_FRAME_LATCH_US) {
+        return false;
+    }
+
+    memset(e, 0, sizeof *e);
+    if (io) {
+        e->io = *io;
+    }
+    e->buf[0] = buffers;
+    e->buf[1] = buffers + n;
+    e->n_leds = (uint16_t)n;
+    e->width = width;
+    e->height = height;
+    e->period_us = period_us;
+    e->latch_us = WS2812_FRAME_LATCH_US;
+    e->gamma = 2.2f;
+    e->brightness = 255u;
+    build_lut(e);
+    memset(buffers, 0, 2u * n * sizeof buffers[0]);
+    return true;
+}
+
+void ws2812_frame_set_animation(ws2812_frame_t *e, ws2812_frame_anim_fn_t anim, void *ctx) {
+    e->anim = anim;
+    e->anim_ctx = ctx;
+}
+
+uint32_t *ws2812_frame_back(ws2812_frame_t *e) {
+    return e->back_ready ? NULL : e->buf[e->front ^ 1u];
+}
+
+bool ws2812_frame_set_pixel(ws2812_frame_t *e, uint16_t index, uint8_t r, uint8_t g, uint8_t b) {
+    /* Quadro submetido e ainda não trocado: o tick pode estar lendo-o */
+    if (e->back_ready) {
+        return false;
+    }
+    if (index < e->n_leds) {
+        e->buf[e->front ^ 1u][index] = ws2812_frame_grb(e, r, g, b);
+    }
+    return true;
+}
+
+bool ws2812_frame_set_xy(ws2812_frame_t *e, uint8_t x, uint8_t y, uint8_t r, uint8_t g,
+                         uint8_t b) {
+    if (x < e->width && y < e->height) {
+        return ws2812_frame_set_pixel(e, ws2812_frame_xy_index(e->width, e->height, x, y), r, g,
+                                      b);
+    }
+    return !e->back_ready;
+}
+
+bool ws2812_frame_fill(ws2812_frame_t *e, uint8_t r, uint8_t g, uint8_t b) {
+    uint32_t *back = ws2812_frame_back(e);
+    if (!back) {
+        return false;
+    }
+    const uint32_t w = ws2812_frame_grb(e, r, g, b);
+    for (uint16_t i = 0; i < e->n_leds; i++) {
+        back[i] = w;
+    }
+    return true;
+}
+
+void ws2812_frame_submit(ws2812_frame_t *e) {
+    /* O quadro precisa estar na memória antes de o IRQ ver back_ready */
+    __sync_synchronize();
+    e->back_ready = true;
+}
+
+bool ws2812_frame_service(ws2812_frame_t *e) {
+    if (!e->anim || e->back_ready) {
+        return false;
+    }
+    if (!e->anim(e, e->frame, e->anim_ctx)) {
+        return false;
+    }
+    e->frame++;
+    e->stats.renders++;
+    ws2812_frame_submit(e);
+    return true;
+}
+
+/* =============================================================================
+ * SEÇÃO 3: TEMPORIZAÇÃO
+ * =============================================================================
+ */
+
+uint32_t ws2812_frame_tick(ws2812_frame_t *e, uint64_t now_us) {
+    if (e->busy) {
+        e->stats.overruns++;
+        return 0;
+    }
+    if (!e->back_ready) {
+        if (e->anim) {
+            e->stats.missed++;
+        }
+        return 0;
+    }
+    if (now_us < e->latch_until) {
+        e->stats.latch_waits++;
+        return (uint32_t)(e->latch_until - now_us);
+    }
+
+    e->front ^= 1u;
+    e->back_ready = false;
+    e->busy = true;
+    e->stats.frames_sent++;
+    e->io.start(e->io.ctx, e->buf[e->front], e->n_leds);
+    return 0;
+}
+
+void ws2812_frame_dma_done(ws2812_frame_t *e, uint64_t now_us, uint32_t pending_words) {
+    const uint32_t drain_us = (pending_words * 24u * WS2812_FRAME_BIT_NS + 999u) / 1000u;
+    e->latch_until = now_us + drain_us + e->latch_us;
+    __sync_synchronize();
+    e->busy = false;
+}
+
+void ws2812_frame_get_stats(const ws2812_frame_t *e, ws2812_frame_stats_t *out) {
+    *out = e->stats;
+}
+
+/* =============================================================================
+ * SEÇÃO 4: PIO, DMA E TIMER (RP2040/RP2350)
+ * =============================================================================
+ */
+
+#if WS2812_FRAME_USE_PIO
+
+static const pio_program_t ws2812_program = {
+    .instructions = ws2812_frame_pio_program,
+    .length = WS2812_FRAME_PIO_LEN,
+    .origin = -1,
+};
+
+/** Instância atendida pelo IRQ do DMA (uma matriz por sistema) */
+static ws2812_frame_t *dma_owner = NULL;
+
+static void pio_start(void *ctx, const uint32_t *words, uint16_t n) {
+    ws2812_frame_t *e = (ws2812_frame_t *)ctx;
+    dma_channel_transfer_from_buffer_now((uint)e->dma_chan, words, n);
+}
+
+static void __isr ws2812_frame_dma_irq(void) {
+    ws2812_frame_t *e = dma_owner;
+    if (!e || !dma_channel_get_irq0_status((uint)e->dma_chan)) {
+        return;
+    }
+    dma_channel_acknowledge_irq0((uint)e->dma_chan);
+    /* O que ainda está no FIFO mais a palavra no registrador de deslocamento */
+    ws2812_frame_dma_done(e, time_us_64(), pio_sm_get_tx_fifo_level(e->pio, e->sm) + 1u);
+}
+
+static int64_t latch_alarm(alarm_id_t id, void *user) {
+    (void)id;
+    ws2812_frame_t *e = (ws2812_frame_t *)user;
+    const uint32_t wait = ws2812_frame_tick(e, time_us_64());
+    e->alarm = wait ? e->alarm : 0;
+    return wait ? -(int64_t)wait : 0;
+}
+
+static bool refresh_timer(repeating_timer_t *t) {
+    ws2812_frame_t *e = (ws2812_frame_t *)t->user_data;
+    /* Com um alarme de latch pendente, ele mesmo fará o envio */
+    if (e->alarm == 0) {
+        const uint32_t wait = ws2812_frame_tick(e, time_us_64());
+        if (wait) {
+            e->alarm = add_alarm_in_us(wait, latch_alarm, e, true);
+        }
+    }
+    return true;
+}
+
+bool ws2812_frame_start_pio(ws2812_frame_t *e, PIO pio, uint pin) {
+    if (!pio_can_add_program(pio, &ws2812_program)) {
+        return false;
+    }
+    const int sm = pio_claim_unused_sm(pio, false);
+    const int chan = dma_claim_unused_channel(false);
+    if (sm < 0 || chan < 0) {
+        if (sm >= 0) {
+            pio_sm_unclaim(pio, (uint)sm);
+        }
+        return false;
+    }
+    e->pio = pio;
+    e->sm = (uint)sm;
+    e->offset = pio_add_program(pio, &ws2812_program);
+    e->dma_chan = chan;
+    e->alarm = 0;
+
+    pio_gpio_init(pio, pin);
+    pio_sm_set_consecutive_pindirs(pio, e->sm, pin, 1, true);
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, e->offset, e->offset + WS2812_FRAME_PIO_LEN - 1u);
+    sm_config_set_sideset(&c, 1, false, false);
+    sm_config_set_sideset_pins(&c, pin);
+    sm_config_set_out_shift(&c, false, true, 24);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_TX);
+    const float bit_hz = 1e9f / (float)WS2812_FRAME_BIT_NS;
+    sm_config_set_clkdiv(&c, (float)clock_get_hz(clk_sys) / (bit_hz * WS2812_FRAME_PIO_CYCLES));
+    pio_sm_init(pio, e->sm, e->offset, &c);
+    pio_sm_set_enabled(pio, e->sm, true);
+
+    dma_channel_config d = dma_channel_get_default_config((uint)chan);
+    channel_config_set_transfer_data_size(&d, DMA_SIZE_32);
+    channel_config_set_read_increment(&d, true);
+    channel_config_set_write_increment(&d, false);
+    channel_config_set_dreq(&d, pio_get_dreq(pio, e->sm, true));
+    dma_channel_configure((uint)chan, &d, &pio->txf[e->sm], NULL, 0, false);
+
+    e->io.ctx = e;
+    e->io.start = pio_start;
+    dma_owner = e;
+    dma_channel_set_irq0_enabled((uint)chan, true);
+    irq_add_shared_handler(DMA_IRQ_0, ws2812_frame_dma_irq,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    return add_repeating_timer_us(-(int64_t)e->period_us, refresh_timer, e, &e->timer);
+}
+
+void ws2812_frame_stop_pio(ws2812_frame_t *e) {
+    cancel_repeating_timer(&e->timer);
+    if (e->alarm) {
+        cancel_alarm(e->alarm);
+        e->alarm = 0;
+    }
+    dma_channel_set_irq0_enabled((uint)e->dma_chan, false);
+    dma_channel_abort((uint)e->dma_chan);
+    irq_remove_handler(DMA_IRQ_0, ws2812_frame_dma_irq);
+    dma_owner = NULL;
+    dma_channel_unclaim((uint)e->dma_chan);
+
+    pio_sm_set_enabled(e->pio, e->sm, false);
+    pio_remove_program(e->pio, &ws2812_program, e->offset);
+    pio_sm_unclaim(e->pio, e->sm);
+    e->busy = false;
+}
+
+#endif /* WS2812_FRAME_USE_PIO */
@@ -0,0 +1,288 @@
+/**
+ * =============================================================================
+ * @file    ws2812_frame.h
+ * @brief   Motor de quadros para a matriz WS2812 (PIO + DMA, buffer duplo)
+ * @version 1.0.0
+ * @date    2026
+ *
+ * @project Sensores_e_Atuadores_do_Kit_BitDogLab
+ * @url     https://github.com/RapportTecnologia/Sensores_e_Atuadores_do_Kit_BitDogLab
+ *
+ * @license CC BY 4.0 - https://creativecommons.org/licenses/by/4.0/
+ *
+ * @details A matriz 5x5 da BitDogLab costuma ser atualizada com a CPU
+ *          empurrando cada pixel para o FIFO da PIO e dormindo o tempo de
+ *          reset (latch) no fim. Este módulo mantém os quadros prontos em
+ *          GRB, já com gamma e brilho aplicados por tabela:
+ *
+ *          ┌──────────────┐ service() ┌───────────┐ tick() ┌───────────┐ DMA ┌─────────┐
+ *          │ animação     │──────────▶│ quadro de │───────▶│ quadro da │────▶│ FIFO TX │
+ *          │ (callback)   │  desenha  │ trás      │  troca │ frente    │     │ da PIO  │
+ *          └──────────────┘           └───────────┘        └───────────┘     └─────────┘
+ *
+ *          TEMPORIZAÇÃO:
+ *          - Um timer repetitivo chama ws2812_frame_tick() no período do
+ *            refresh; se houver quadro novo, os buffers são trocados e o DMA
+ *            começa a enviar a frente.
+ *          - O IRQ de fim do DMA chama ws2812_frame_dma_done() com as
+ *            palavras que ainda estão no FIFO; o motor calcula quando o
+ *            último bit sai do pino e soma o tempo de latch.
+ *          - Um tick antes do fim do latch não envia: devolve quanto falta e
+ *            um alarme chama o tick de novo. Nenhum sleep na CPU.
+ *
+ *          O núcleo não depende do Pico SDK: no host, um mock entrega o
+ *          quadro a um interpretador do programa PIO e confere a forma de
+ *          onda e a temporização.
+ * =============================================================================
+ */
+
+#ifndef WS2812_FRAME_H
+#define WS2812_FRAME_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#if defined(PICO_ON_DEVICE) && PICO_ON_DEVICE
+#include "hardware/pio.h"
+#include "pico/time.h"
+#define WS2812_FRAME_USE_PIO 1
+#else
+#define WS2812_FRAME_USE_PIO 0
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =============================================================================
+ * SEÇÃO 1: CONFIGURAÇÃO E PROGRAMA PIO
+ * =============================================================================
+ */
+
+/** Período de um bit (800 kHz) */
+#define WS2812_FRAME_BIT_NS 1250u
+
+/** Tempo mínimo de reset (latch): 280 us cobre o WS2812B-V5; o antigo pede 50 us */
+#ifndef WS2812_FRAME_LATCH_US
+#define WS2812_FRAME_LATCH_US 280u
+#endif
+
+/** Maior matriz suportada (a da BitDogLab tem 25 LEDs) */
+#ifndef WS2812_FRAME_MAX_LEDS
+#define WS2812_FRAME_MAX_LEDS 256u
+#endif
+
+/**
+ * Ciclos da PIO por bit e fases (T1 alto, T2 dado, T3 baixo):
+ * bit 0 = T1 alto + T2 + T3 baixos (375 / 875 ns);
+ * bit 1 = T1 + T2 altos + T3 baixo (875 / 375 ns).
+ */
+#define WS2812_FRAME_PIO_T1     3u
+#define WS2812_FRAME_PIO_T2     4u
+#define WS2812_FRAME_PIO_T3     3u
+#define WS2812_FRAME_PIO_CYCLES (WS2812_FRAME_PIO_T1 + WS2812_FRAME_PIO_T2 + WS2812_FRAME_PIO_T3)
+
+/**
+ * Programa PIO (side-set de 1 pino, autopull de 24 bits, deslocamento à
+ * esquerda), montado:
+ *
+ *     .wrap_target
+ *     bitloop: out x, 1       side 0 [T3 - 1]
+ *              jmp !x do_zero side 1 [T1 - 1]
+ *     do_one:  jmp bitloop    side 1 [T2 - 1]
+ *     do_zero: nop            side 0 [T2 - 1]
+ *     .wrap
+ */
+#define WS2812_FRAME_PIO_LEN 4u
+extern const uint16_t ws2812_frame_pio_program[WS2812_FRAME_PIO_LEN];
+
+/* =============================================================================
+ * SEÇÃO 2: TIPOS
+ * =============================================================================
+ */
+
+typedef struct ws2812_frame ws2812_frame_t;
+
+/**
+ * @brief Desenha o quadro `frame` no buffer de trás
+ *
+ * @return false se não houver quadro novo (o anterior continua na matriz)
+ */
+typedef bool (*ws2812_frame_anim_fn_t)(ws2812_frame_t *e, uint32_t frame, void *ctx);
+
+/**
+ * @struct ws2812_frame_io_t
+ * @brief Envio de um quadro (DMA para a PIO no firmware; mock no host)
+ *
+ * @var ws2812_frame_io_t::start Começa a enviar `n` palavras GRB << 8 e
+ *      retorna sem esperar; o fim é informado por ws2812_frame_dma_done()
+ */
+typedef struct {
+    void *ctx;
+    void (*start)(void *ctx, const uint32_t *words, uint16_t n);
+} ws2812_frame_io_t;
+
+/**
+ * @struct ws2812_frame_stats_t
+ * @brief Contadores do motor
+ *
+ * @var ws2812_frame_stats_t::frames_sent  Quadros enviados
+ * @var ws2812_frame_stats_t::renders      Quadros desenhados pela animação
+ * @var ws2812_frame_stats_t::missed       Ticks sem quadro novo (animação atrasada)
+ * @var ws2812_frame_stats_t::latch_waits  Ticks adiados até o fim do latch
+ * @var ws2812_frame_stats_t::overruns     Ticks com o quadro anterior ainda no DMA
+ */
+typedef struct {
+    uint32_t frames_sent;
+    uint32_t renders;
+    uint32_t missed;
+    uint32_t latch_waits;
+    uint32_t overruns;
+} ws2812_frame_stats_t;
+
+/**
+ * @struct ws2812_frame
+ * @brief Estado do motor (instância estática, sem malloc)
+ */
+struct ws2812_frame {
+    ws2812_frame_io_t io;
+    uint32_t *buf[2];                /**< Quadros GRB << 8, n_leds palavras cada */
+    uint16_t n_leds;
+    uint8_t width;
+    uint8_t height;
+    uint32_t period_us;
+    uint32_t latch_us;
+
+    uint8_t lut[256];                /**< Gamma e brilho combinados */
+    float gamma;
+    uint8_t brightness;
+
+    volatile uint8_t front;          /**< Buffer em envio (ou o último enviado) */
+    volatile bool back_ready;        /**< Buffer de trás completo, aguardando o tick */
+    volatile bool busy;              /**< DMA ativo */
+    volatile uint64_t latch_until;   /**< Antes disso o pino ainda não travou */
+
+    ws2812_frame_anim_fn_t anim;
+    void *anim_ctx;
+    uint32_t frame;                  /**< Próximo quadro da animação */
+
+    ws2812_frame_stats_t stats;
+
+#if WS2812_FRAME_USE_PIO
+    PIO pio;
+    uint sm;
+    uint offset;
+    int dma_chan;
+    repeating_timer_t timer;
+    alarm_id_t alarm;
+#endif
+};
+
+/* =============================================================================
+ * SEÇÃO 3: API
+ * =============================================================================
+ */
+
+/**
+ * @brief Inicializa o motor (gamma 2,2, brilho máximo, quadros apagados)
+ *
+ * @param buffers    2 * width * height palavras
+ * @param refresh_hz Quadros por segundo; o período precisa caber o quadro
+ *                   inteiro mais o latch
+ * @param io         Envio dos quadros; NULL no firmware (preenchido por
+ *                   ws2812_frame_start_pio())
+ * @return false se os parâmetros forem inválidos
+ */
+bool ws2812_frame_init(ws2812_frame_t *e, uint32_t *buffers, uint8_t width, uint8_t height,
+                       uint32_t refresh_hz, const ws2812_frame_io_t *io);
+
+/** Curva de gamma (1,0 = linear); vale para os próximos pixels desenhados */
+void ws2812_frame_set_gamma(ws2812_frame_t *e, float gamma);
+
+/** Brilho global 0..255; vale para os próximos pixels desenhados */
+void ws2812_frame_set_brightness(ws2812_frame_t *e, uint8_t brightness);
+
+/** Registra a animação chamada por ws2812_frame_service() (NULL desliga) */
+void ws2812_frame_set_animation(ws2812_frame_t *e, ws2812_frame_anim_fn_t anim, void *ctx);
+
+/** Índice do LED (x, y) na matriz em serpentina da BitDogLab; (0, 0) no canto superior esquerdo */
+static inline uint16_t ws2812_frame_xy_index(uint8_t width, uint8_t height, uint8_t x, uint8_t y) {
+    const uint16_t row = (uint16_t)(y * width);
+    const uint16_t col = (y & 1u) ? (uint16_t)(width - 1u - x) : x;
+    return (uint16_t)(width * height - 1u - (row + col));
+}
+
+/** Palavra GRB << 8 de uma cor, pelas tabelas atuais */
+static inline uint32_t ws2812_frame_grb(const ws2812_frame_t *e, uint8_t r, uint8_t g, uint8_t b) {
+    return (uint32_t)e->lut[g] << 24 | (uint32_t)e->lut[r] << 16 | (uint32_t)e->lut[b] << 8;
+}
+
+/**
+ * @brief Buffer de trás para desenhar
+ *
+ * @return NULL se o último quadro submetido ainda não foi trocado pelo tick
+ */
+uint32_t *ws2812_frame_back(ws2812_frame_t *e);
+
+/**
+ * @brief Pinta o LED `index` do buffer de trás
+ *
+ * @return false (sem escrever) enquanto o quadro submetido não foi trocado
+ */
+bool ws2812_frame_set_pixel(ws2812_frame_t *e, uint16_t index, uint8_t r, uint8_t g, uint8_t b);
+
+/** Pinta o LED (x, y) do buffer de trás; false como em ws2812_frame_set_pixel() */
+bool ws2812_frame_set_xy(ws2812_frame_t *e, uint8_t x, uint8_t y, uint8_t r, uint8_t g,
+                         uint8_t b);
+
+/** Pinta todo o buffer de trás; false como em ws2812_frame_set_pixel() */
+bool ws2812_frame_fill(ws2812_frame_t *e, uint8_t r, uint8_t g, uint8_t b);
+
+/** Entrega o buffer de trás; o próximo tick o envia */
+void ws2812_frame_submit(ws2812_frame_t *e);
+
+/**
+ * @brief Chama a animação se o buffer de trás estiver livre
+ *
+ * @details Deve rodar no laço principal (ou no outro core).
+ *
+ * @return true se um quadro novo foi desenhado e submetido
+ */
+bool ws2812_frame_service(ws2812_frame_t *e);
+
+/**
+ * @brief Tick do refresh (IRQ do timer)
+ *
+ * @return 0 se o tick terminou, ou os microssegundos até o fim do latch
+ *         (chame de novo depois disso)
+ */
+uint32_t ws2812_frame_tick(ws2812_frame_t *e, uint64_t now_us);
+
+/**
+ * @brief Fim do DMA (IRQ)
+ *
+ * @param pending_words Palavras ainda não transmitidas (FIFO + registrador
+ *                      de deslocamento)
+ */
+void ws2812_frame_dma_done(ws2812_frame_t *e, uint64_t now_us, uint32_t pending_words);
+
+/** Cópia dos contadores */
+void ws2812_frame_get_stats(const ws2812_frame_t *e, ws2812_frame_stats_t *out);
+
+#if WS2812_FRAME_USE_PIO
+/**
+ * @brief Carrega o programa, configura a state machine, o DMA e o timer
+ *
+ * @return false se não houver state machine, memória de instruções ou canal de DMA livre
+ */
+bool ws2812_frame_start_pio(ws2812_frame_t *e, PIO pio, uint pin);
+
+/** Para o timer e o DMA e libera os recursos */
+void ws2812_frame_stop_pio(ws2812_frame_t *e);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WS2812_FRAME_H */